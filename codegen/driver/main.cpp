@@ -4,7 +4,9 @@
 #include <string>
 #include <unordered_map>
 #include <vector>
+#include "ck/host/device_batched_gemm_multiple_d/operation.hpp"
 #include "ck/host/device_gemm_multiple_d/operation.hpp"
+#include "ck/host/device_grouped_gemm_multiple_d/operation.hpp"
 #include "ck/host/device_grouped_conv_fwd_multiple_d/conv_fwd_op.hpp"
 #include "ck/host/stringutils.hpp"
 
@@ -79,6 +81,10 @@ struct Epilogue
     Emitters e;
     e.Register<ck::host::device_gemm_multiple_d::Operation_Xdl_CShuffle>(
         "DeviceGemmMultipleD_Xdl_CShuffle", prologue, epilogue);
+    e.Register<ck::host::device_batched_gemm_multiple_d::Operation_Xdl_CShuffle>(
+        "DeviceBatchedGemmMultiD_Xdl", prologue, epilogue);
+    e.Register<ck::host::device_grouped_gemm_multiple_d::Operation_Xdl_CShuffle_Tile_Loop>(
+        "DeviceGroupedGemmMultipleDXdlCShuffleTileLoop", prologue, epilogue);
 
     if(args.empty() or std::any_of(args.begin(), args.end(), [](auto arg) {
            return arg == "-h" or arg == "--help";
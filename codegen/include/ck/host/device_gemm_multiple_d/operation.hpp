@@ -6,6 +6,7 @@
 #include <cstdlib>
 #include <vector>
 #include <string>
+#include <unordered_map>
 #include "ck/host/types.hpp"
 #include "ck/host/operation/gemm.hpp"
 #include "ck/host/device_gemm_multiple_d/problem.hpp"
@@ -46,6 +47,8 @@ struct Operation_Xdl_CShuffle
     void update_prologue(const std::string& prologue);
     void update_epilogue(const std::string& epilogue);
     /**constexpr**/ bool IsSupported(std::size_t MRaw_, std::size_t NRaw_, std::size_t KRaw_);
+    // returns the values of the template parameters, by name
+    std::unordered_map<std::string, std::string> GetTemplateValues() const;
     // returns a templated instance
     Solution ToSolution() const;
 };
@@ -0,0 +1,37 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <cstdlib>
+#include <vector>
+#include <string>
+#include "ck/host/types.hpp"
+#include "ck/host/device_gemm_multiple_d/operation.hpp"
+#include "ck/host/device_grouped_gemm_multiple_d/problem.hpp"
+
+namespace ck {
+namespace host {
+namespace device_grouped_gemm_multiple_d {
+
+// defines all values need for an instance of grouped gemm whose workgroups loop over the tiles
+// of all the groups, the group shapes are read from device memory
+struct Operation_Xdl_CShuffle_Tile_Loop : device_gemm_multiple_d::Operation_Xdl_CShuffle
+{
+    // returns a vector of instances, only given fusion operators: will use default problem spec
+    static std::vector<std::vector<Operation_Xdl_CShuffle_Tile_Loop>>
+    CreateOperations(const std::string& prologue, const std::string& epilogue);
+    // returns a vector of instances, given a problem spec and fusion operators
+    static std::vector<Operation_Xdl_CShuffle_Tile_Loop>
+    CreateOperations(const Problem& prob, const std::string& prologue, const std::string& epilogue);
+
+    std::string block_gemm_pipeline_scheduler = "ck::BlockGemmPipelineScheduler::Intrawave";
+    std::string block_gemm_pipeline_version   = "ck::BlockGemmPipelineVersion::v1";
+
+    // returns a templated instance
+    Solution ToSolution() const;
+};
+
+} // namespace device_grouped_gemm_multiple_d
+} // namespace host
+} // namespace ck
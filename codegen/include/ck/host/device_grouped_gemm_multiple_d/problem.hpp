@@ -0,0 +1,32 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <cstdlib>
+#include <vector>
+#include <string>
+#include "ck/host/types.hpp"
+#include "ck/host/device_gemm_multiple_d/problem.hpp"
+
+namespace ck {
+namespace host {
+namespace device_grouped_gemm_multiple_d {
+
+// defines the problem specification for a group of GEMM operations sharing layouts, data types
+// and element operations; M, N and K are those of every group, a dimension left at zero differs
+// between the groups or is only known at run time and is always padded
+struct Problem : device_gemm_multiple_d::Problem
+{
+    // returns the correct device op file for the operation
+    std::string GetIncludeHeader() const;
+
+    // returns a list of instances based on the problem spec and provided fusion operations
+    std::vector<Solution> GetSolutions(const std::string& arch,
+                                       const std::string& prologue,
+                                       const std::string& epilogue) const;
+};
+
+} // namespace device_grouped_gemm_multiple_d
+} // namespace host
+} // namespace ck
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <utility>
 #include <unordered_map>
 #include <vector>
@@ -13,5 +14,13 @@ namespace host {
 
 std::unordered_map<std::string_view, std::string_view> GetHeaders();
 
+// the embedded headers that a header includes directly, paths relative to the include directory
+const std::vector<std::string_view>& GetIncludes(std::string_view header);
+
+// the given headers and every embedded header they include, directly or not; for the device op
+// header of a Solution it is all a JIT compile of the Solution needs
+std::unordered_map<std::string_view, std::string_view>
+GetHeaders(const std::vector<std::string>& roots);
+
 } // namespace host
 } // namespace ck
@@ -265,10 +265,10 @@ static const char* const DeviceGemmMultipleD_Xdl_CShuffleTemplate =
     "${CDEBlockTransferClusterLengths_MBlock_MPerBlock_NBlock_NPerBlock}, "
     "${CDEBlockTransferScalarPerVector_NPerBlock}>";
 
-// use hardcoded instances from vector of operations to substitute values into instance template
-Solution Operation_Xdl_CShuffle::ToSolution() const
+// the values of the instance template parameters, keyed by the parameter names
+std::unordered_map<std::string, std::string> Operation_Xdl_CShuffle::GetTemplateValues() const
 {
-    std::unordered_map<std::string, std::string> values = {
+    return {
         {"name",
          std::to_string(this->tile_desc.block_size) + "_" +
              std::to_string(this->tile_desc.m_per_block) + "_" +
@@ -337,7 +337,12 @@ Solution Operation_Xdl_CShuffle::ToSolution() const
         {"CDEBlockTransferScalarPerVector_NPerBlock",
          std::to_string(this->c_block_transfer.scalar_per_vector_n_wave_n_per_Xdl)},
     };
+}
 
+// use hardcoded instances from vector of operations to substitute values into instance template
+Solution Operation_Xdl_CShuffle::ToSolution() const
+{
+    auto values = this->GetTemplateValues();
     return Solution{InterpolateString(DeviceGemmMultipleD_Xdl_CShuffleTemplate, values),
                     std::move(values)};
 }
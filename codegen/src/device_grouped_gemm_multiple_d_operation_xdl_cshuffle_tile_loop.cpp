@@ -0,0 +1,105 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+
+#include "ck/host/device_grouped_gemm_multiple_d/operation.hpp"
+#include "ck/host/stringutils.hpp"
+#include "ck/host/types.hpp"
+#include "ck/host/utils.hpp"
+
+namespace ck {
+namespace host {
+namespace device_grouped_gemm_multiple_d {
+
+// calculate appropriate Gemm Specification based on the dimensions shared by all the groups, the
+// ones differing between the groups are zero
+static std::string GetGemmSpec(const Problem& prob, const operation::TileDesc& tile_desc)
+{
+    auto needs_padding = [](std::size_t x, std::size_t per_block) {
+        return x == 0 or integer_divide_ceil(x, per_block) * per_block - x != 0;
+    };
+
+    std::string spec = "";
+    if(needs_padding(prob.M, tile_desc.m_per_block))
+        spec += "M";
+    if(needs_padding(prob.N, tile_desc.n_per_block))
+        spec += "N";
+    if(needs_padding(prob.K, tile_desc.k_per_block))
+        spec += "K";
+    if(spec == "")
+        return "ck::tensor_operation::device::GemmSpecialization::Default";
+
+    return "ck::tensor_operation::device::GemmSpecialization::" + spec + "Padding";
+}
+
+// the instances of the gemm of one group, padded where the groups differ
+std::vector<Operation_Xdl_CShuffle_Tile_Loop> Operation_Xdl_CShuffle_Tile_Loop::CreateOperations(
+    const Problem& prob, const std::string& prologue, const std::string& epilogue)
+{
+    return Transform(
+        device_gemm_multiple_d::Operation_Xdl_CShuffle::CreateOperations(prob, prologue, epilogue),
+        [&](const auto& op) {
+            Operation_Xdl_CShuffle_Tile_Loop x{op};
+            x.gemm_specialization = GetGemmSpec(prob, x.tile_desc);
+            return x;
+        });
+}
+
+// set up instances when not provided with a problem specification, use default operation values and
+// all possible layout combinations
+std::vector<std::vector<Operation_Xdl_CShuffle_Tile_Loop>>
+Operation_Xdl_CShuffle_Tile_Loop::CreateOperations(const std::string& prologue,
+                                                   const std::string& epilogue)
+{
+    std::vector<Problem> problems;
+    for(bool TransA : {true, false})
+        for(bool TransB : {true, false})
+        {
+            Problem prob;
+            prob.TransA = TransA;
+            prob.TransB = TransB;
+            problems.push_back(prob);
+        }
+    return Transform(problems,
+                     [&](const Problem& p) { return CreateOperations(p, prologue, epilogue); });
+}
+
+static const char* const DeviceGroupedGemmMultipleDXdlCShuffleTileLoopTemplate =
+    "ck::tensor_operation::device::DeviceGroupedGemmMultipleDXdlCShuffleTileLoop<${LayoutA}, "
+    "${LayoutB}, ${LayoutDs}, ${LayoutE}, ${ADataType}, ${BDataType}, ${AccDataType}, "
+    "${CShuffleDataType}, ${DsDataType}, ${EDataType}, ${AElementwiseOperation}, "
+    "${BElementwiseOperation}, ${CDEElementwiseOperation}, ${GemmSpecialization}, "
+    "${NumGemmkPrefetchStage}, ${BlockSize}, ${MPerBlock}, ${NPerBlock}, ${KPerBlock}, ${AK1}, "
+    "${BK1}, ${MPerXDL}, ${NPerXDL}, ${MXdlPerWave}, ${NXdlPerWave}, "
+    "${ABlockTransferThreadClusterLengths_AK0_M_AK1}, ${ABlockTransferThreadClusterArrangeOrder}, "
+    "${ABlockTransferSrcAccessOrder}, ${ABlockTransferSrcVectorDim}, "
+    "${ABlockTransferSrcScalarPerVector}, ${ABlockTransferDstScalarPerVector_AK1}, "
+    "${ABlockLdsExtraM}, ${BBlockTransferThreadClusterLengths_BK0_N_BK1}, "
+    "${BBlockTransferThreadClusterArrangeOrder}, ${BBlockTransferSrcAccessOrder}, "
+    "${BBlockTransferSrcVectorDim}, ${BBlockTransferSrcScalarPerVector}, "
+    "${BBlockTransferDstScalarPerVector_BK1}, ${BBlockLdsExtraN}, "
+    "${CShuffleMXdlPerWavePerShuffle}, ${CShuffleNXdlPerWavePerShuffle}, "
+    "${CDEBlockTransferClusterLengths_MBlock_MPerBlock_NBlock_NPerBlock}, "
+    "${CDEShuffleBlockTransferScalarPerVectors}, ${BlkGemmPipeSched}, ${BlkGemmPipelineVer}>";
+
+// use hardcoded instances from vector of operations to substitute values into instance template
+Solution Operation_Xdl_CShuffle_Tile_Loop::ToSolution() const
+{
+    auto values = this->GetTemplateValues();
+
+    // one vector width for each of the Ds and for E
+    const std::vector<int> scalar_per_vectors(
+        this->Ds.size() + 1, this->c_block_transfer.scalar_per_vector_n_wave_n_per_Xdl);
+    values.emplace("CDEShuffleBlockTransferScalarPerVectors", SequenceStr(scalar_per_vectors));
+    values.emplace("BlkGemmPipeSched", this->block_gemm_pipeline_scheduler);
+    values.emplace("BlkGemmPipelineVer", this->block_gemm_pipeline_version);
+    values.emplace("Prologue", this->prologue);
+    values.emplace("Epilogue", this->epilogue);
+
+    return Solution{
+        InterpolateString(DeviceGroupedGemmMultipleDXdlCShuffleTileLoopTemplate, values),
+        std::move(values)};
+}
+
+} // namespace device_grouped_gemm_multiple_d
+} // namespace host
+} // namespace ck
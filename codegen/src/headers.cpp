@@ -1,5 +1,11 @@
 #include "ck/host/headers.hpp"
+#include "ck/host/stringutils.hpp"
 #include "ck_headers.hpp"
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
 
 namespace ck {
 namespace host {
@@ -16,5 +22,153 @@ std::unordered_map<std::string_view, std::string_view> GetHeaders()
     return headers;
 }
 
+namespace {
+
+const std::unordered_map<std::string_view, std::string_view>& GetAllHeaders()
+{
+    static const auto headers = GetHeaders();
+    return headers;
+}
+
+// removes the "." and ".." components of a path
+std::string NormalizePath(const std::string& path)
+{
+    std::vector<std::string> parts;
+    std::stringstream ss(path);
+    for(std::string part; std::getline(ss, part, '/');)
+    {
+        if(part.empty() or part == ".")
+            continue;
+        if(part == ".." and not parts.empty() and parts.back() != "..")
+            parts.pop_back();
+        else
+            parts.push_back(part);
+    }
+    return JoinStrings(parts, "/");
+}
+
+// the file names of the #include directives of a header, conditional ones included
+std::vector<std::string> ParseIncludes(std::string_view content)
+{
+    std::vector<std::string> result;
+    for(std::size_t pos = 0; pos < content.size();)
+    {
+        const auto eol  = std::min(content.find('\n', pos), content.size());
+        const auto line = content.substr(pos, eol - pos);
+        pos             = eol + 1;
+
+        const auto hash = line.find_first_not_of(" \t");
+        if(hash == std::string_view::npos or line[hash] != '#')
+            continue;
+        const auto directive = line.find_first_not_of(" \t", hash + 1);
+        if(directive == std::string_view::npos or line.substr(directive, 7) != "include")
+            continue;
+        const auto open = line.find_first_of("\"<", directive + 7);
+        if(open == std::string_view::npos)
+            continue;
+        const auto close = line.find(line[open] == '"' ? '"' : '>', open + 1);
+        if(close == std::string_view::npos)
+            continue;
+        result.emplace_back(line.substr(open + 1, close - open - 1));
+    }
+    return result;
+}
+
+std::unordered_map<std::string_view, std::vector<std::string_view>> MakeIncludeGraph()
+{
+    const auto& headers = GetAllHeaders();
+
+    std::unordered_map<std::string_view, std::vector<std::string_view>> graph;
+    for(const auto& [path, content] : headers)
+    {
+        auto& includes        = graph[path];
+        const auto slash      = path.rfind('/');
+        const std::string dir = slash == std::string_view::npos
+                                    ? std::string{}
+                                    : std::string{path.substr(0, slash + 1)};
+
+        // as the compiler does, next to the including header first, then in the include
+        // directory; system headers are not embedded and are skipped
+        for(const auto& name : ParseIncludes(content))
+        {
+            for(const auto& candidate : {NormalizePath(dir + name), NormalizePath(name)})
+            {
+                const auto it = headers.find(candidate);
+                if(it != headers.end())
+                {
+                    includes.push_back(it->first);
+                    break;
+                }
+            }
+        }
+    }
+    return graph;
+}
+
+const std::unordered_map<std::string_view, std::vector<std::string_view>>& GetIncludeGraph()
+{
+    static const auto graph = MakeIncludeGraph();
+    return graph;
+}
+
+} // namespace
+
+const std::vector<std::string_view>& GetIncludes(std::string_view header)
+{
+    static const std::vector<std::string_view> none;
+
+    const auto& graph = GetIncludeGraph();
+    const auto it     = graph.find(header);
+    return it == graph.end() ? none : it->second;
+}
+
+std::unordered_map<std::string_view, std::string_view>
+GetHeaders(const std::vector<std::string>& roots)
+{
+    // closures are computed once, a test or a tuning run asks for the same few device ops
+    static std::mutex mutex;
+    static std::map<std::vector<std::string>, std::vector<std::string_view>> closures;
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto it = closures.find(roots);
+    if(it == closures.end())
+    {
+        const auto& headers = GetAllHeaders();
+
+        std::vector<std::string_view> closure;
+        std::unordered_map<std::string_view, bool> visited;
+        for(const auto& root : roots)
+        {
+            const auto root_it = headers.find(NormalizePath(root));
+            if(root_it == headers.end())
+                throw std::runtime_error("Unknown header: " + root);
+            if(not visited[root_it->first])
+            {
+                visited[root_it->first] = true;
+                closure.push_back(root_it->first);
+            }
+        }
+        for(std::size_t i = 0; i < closure.size(); ++i)
+        {
+            for(auto include : GetIncludes(closure[i]))
+            {
+                if(not visited[include])
+                {
+                    visited[include] = true;
+                    closure.push_back(include);
+                }
+            }
+        }
+        it = closures.emplace(roots, std::move(closure)).first;
+    }
+
+    std::unordered_map<std::string_view, std::string_view> result;
+    const auto& headers = GetAllHeaders();
+    for(auto header : it->second)
+        result.emplace(header, headers.at(header));
+    return result;
+}
+
 } // namespace host
 } // namespace ck
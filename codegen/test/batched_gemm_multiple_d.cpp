@@ -0,0 +1,80 @@
+#include "ck/host/device_batched_gemm_multiple_d/problem.hpp"
+#include "ck/host/device_batched_gemm_multiple_d/operation.hpp"
+#include "ck/host/device_gemm_multiple_d/problem.hpp"
+#include "ck/host/headers.hpp"
+#include <test.hpp>
+
+const std::string epilogue = R"(
+struct Epilogue
+{
+    template <typename E, typename D>
+    __host__ __device__ constexpr void operator()(E& e, const E& c, const D& d) const
+    {
+        e = c + d;
+    }
+};
+using CDEElementOp = Epilogue;
+)";
+
+ck::host::device_batched_gemm_multiple_d::Problem make_problem()
+{
+    ck::host::device_batched_gemm_multiple_d::Problem prob;
+    prob.M          = 1024;
+    prob.N          = 1000;
+    prob.K          = 512;
+    prob.BatchCount = 16;
+    prob.TransB     = true;
+    prob.DsTrans    = {false};
+    prob.DsDataType = {ck::host::DataType::Half};
+    return prob;
+}
+
+TEST_CASE(test_batched_template)
+{
+    auto prob      = make_problem();
+    auto solutions = prob.GetSolutions("gfx90a", "", epilogue);
+    EXPECT(not solutions.empty());
+
+    // the batched op has the tuning parameters of the gemm one
+    ck::host::device_gemm_multiple_d::Problem gemm = prob;
+    auto gemm_solutions                            = gemm.GetSolutions("gfx90a", "", epilogue);
+    EXPECT(solutions.size() == gemm_solutions.size());
+
+    for(std::size_t i = 0; i < solutions.size(); i++)
+    {
+        const auto s      = solutions[i].ToTemplateString();
+        const auto gemm_s = gemm_solutions[i].ToTemplateString();
+        EXPECT(s.find("ck::tensor_operation::device::DeviceBatchedGemmMultiD_Xdl<") == 0);
+        EXPECT(s.find("${") == std::string::npos);
+        EXPECT(s.substr(s.find('<')) == gemm_s.substr(gemm_s.find('<')));
+        EXPECT(solutions[i].GetTemplateParameter("LayoutB") ==
+               "ck::tensor_layout::gemm::ColumnMajor");
+        EXPECT(solutions[i].GetTemplateParameter("CDEElementwiseOperation") == "CDEElementOp");
+        EXPECT(solutions[i].GetTemplateParameter("Epilogue") == epilogue);
+    }
+}
+
+TEST_CASE(test_batched_gemm_spec)
+{
+    auto prob = make_problem();
+    for(const auto& solution : prob.GetSolutions("gfx90a", "", ""))
+    {
+        auto n_per_block = solution.GetTemplateParameter<std::size_t>("NPerBlock");
+        auto spec        = solution.GetTemplateParameter("GemmSpecialization");
+        EXPECT(spec.find(prob.N % n_per_block == 0 ? "Default" : "NPadding") != std::string::npos);
+        EXPECT(solution.GetTemplateParameter("CDEElementwiseOperation") ==
+               "ck::tensor_operation::element_wise::PassThrough");
+    }
+}
+
+TEST_CASE(test_batched_unsupported_arch)
+{
+    EXPECT(make_problem().GetSolutions("gfx1100", "", "").empty());
+}
+
+TEST_CASE(test_batched_header)
+{
+    EXPECT(ck::host::GetHeaders().count(make_problem().GetIncludeHeader()) == 1);
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
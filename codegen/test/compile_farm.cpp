@@ -0,0 +1,176 @@
+#include <rtc/compile_farm.hpp>
+#include <rtc/tmp_dir.hpp>
+#include <deque>
+#include <fstream>
+#include <test.hpp>
+
+namespace rtc {
+std::ostream& operator<<(std::ostream& os, compile_status s)
+{
+    return os << static_cast<int>(s);
+}
+} // namespace rtc
+
+// a stand-in for the device compiler: copies the source to the object file, after sleeping for
+// the seconds of a "// sleep" line and failing on an "// error" line, and counts its runs
+struct fake_compiler
+{
+    rtc::tmp_dir td{"fake-compiler"};
+    // the jobs point into the sources
+    std::deque<std::string> sources;
+
+    fake_compiler()
+    {
+        std::ofstream os((td.path / "cc.sh").string());
+        os << "#!/bin/sh\n"
+           << "while [ $# -gt 0 ]; do\n"
+           << "  case \"$1\" in -c) src=$2; shift;; -o) out=$2; shift;; esac; shift\n"
+           << "done\n"
+           << "echo run >> " << runs_file() << "\n"
+           << "s=$(sed -n 's|^// sleep ||p' \"$src\")\n"
+           << "[ -n \"$s\" ] && sleep \"$s\"\n"
+           << "grep -q '^// error' \"$src\" && { echo \"$src: error\"; exit 1; }\n"
+           << "cp \"$src\" \"$out\"\n";
+    }
+
+    std::string runs_file() const { return (td.path / "runs").string(); }
+
+    std::size_t runs() const
+    {
+        std::ifstream is(runs_file());
+        std::size_t n = 0;
+        for(std::string line; std::getline(is, line);)
+            n++;
+        return n;
+    }
+
+    rtc::compile_job job(const std::string& src)
+    {
+        rtc::compile_job j;
+        j.srcs             = {{"main.cpp", sources.emplace_back(src)}};
+        j.options.compiler = "sh " + (td.path / "cc.sh").string();
+        j.options.arch     = "gfx942";
+        return j;
+    }
+};
+
+std::string as_string(const rtc::compile_result& r)
+{
+    return {r.code_object.begin(), r.code_object.end()};
+}
+
+bool is_quick(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::steady_clock::now() - start < std::chrono::seconds{5};
+}
+
+TEST_CASE(test_batch)
+{
+    fake_compiler cc;
+    rtc::compile_farm farm{{4, ""}};
+    EXPECT(farm.workers() == 4u);
+
+    std::vector<rtc::compile_job> jobs;
+    for(int i = 0; i < 16; i++)
+        jobs.push_back(cc.job("// kernel " + std::to_string(i) + "\n"));
+
+    auto handles = farm.submit(jobs);
+    EXPECT(handles.size() == jobs.size());
+    for(std::size_t i = 0; i < handles.size(); i++)
+    {
+        const auto& r = handles[i].result.get();
+        EXPECT(r.status == rtc::compile_status::success);
+        EXPECT(as_string(r) == "// kernel " + std::to_string(i) + "\n");
+    }
+    EXPECT(cc.runs() == jobs.size());
+    EXPECT(farm.in_flight() == 0u);
+}
+
+TEST_CASE(test_dedup)
+{
+    fake_compiler cc;
+    rtc::compile_farm farm{{2, ""}};
+
+    auto a = farm.submit(cc.job("// sleep 1\n"));
+    auto b = farm.submit(cc.job("// sleep 1\n"));
+    auto c = farm.submit(cc.job("// other\n"));
+    EXPECT(a.key == b.key);
+    EXPECT(a.key != c.key);
+
+    EXPECT(a.result.get().status == rtc::compile_status::success);
+    EXPECT(b.result.get().status == rtc::compile_status::success);
+    EXPECT(c.result.get().status == rtc::compile_status::success);
+    EXPECT(cc.runs() == 2u);
+}
+
+TEST_CASE(test_failure)
+{
+    fake_compiler cc;
+    rtc::compile_farm farm{{1, ""}};
+
+    const auto r = farm.submit(cc.job("// error\n")).result.get();
+    EXPECT(r.status == rtc::compile_status::failed);
+    EXPECT(r.code_object.empty());
+    EXPECT(r.log.find("error") != std::string::npos);
+}
+
+TEST_CASE(test_timeout)
+{
+    fake_compiler cc;
+    rtc::compile_farm farm{{1, ""}};
+
+    auto job    = cc.job("// sleep 10\n");
+    job.timeout = std::chrono::milliseconds{200};
+
+    const auto start = std::chrono::steady_clock::now();
+    EXPECT(farm.submit(job).result.get().status == rtc::compile_status::timeout);
+    EXPECT(is_quick(start));
+}
+
+TEST_CASE(test_cancel)
+{
+    fake_compiler cc;
+    rtc::compile_farm farm{{1, ""}};
+
+    auto running = farm.submit(cc.job("// sleep 10\n"));
+    auto queued  = farm.submit(cc.job("// queued\n"));
+    auto shared  = farm.submit(cc.job("// sleep 10\n"));
+
+    // the queued job never runs
+    farm.cancel(queued);
+    EXPECT(queued.result.get().status == rtc::compile_status::cancelled);
+
+    // the running job has a second submission left
+    farm.cancel(running);
+    const bool ready =
+        running.result.wait_for(std::chrono::milliseconds{100}) == std::future_status::ready;
+    EXPECT(not ready);
+
+    const auto start = std::chrono::steady_clock::now();
+    farm.cancel(shared);
+    EXPECT(shared.result.get().status == rtc::compile_status::cancelled);
+    EXPECT(is_quick(start));
+    EXPECT(cc.runs() == 1u);
+
+    // the sources of a cancelled job compile again
+    auto again = farm.submit(cc.job("// queued\n"));
+    EXPECT(again.result.get().status == rtc::compile_status::success);
+}
+
+TEST_CASE(test_cache)
+{
+    fake_compiler cc;
+    rtc::tmp_dir cache{"cache"};
+    {
+        rtc::compile_farm farm{{1, cache.path.string()}};
+        EXPECT(farm.submit(cc.job("// cached\n")).result.get().status ==
+               rtc::compile_status::success);
+    }
+    rtc::compile_farm farm{{1, cache.path.string()}};
+    const auto r = farm.submit(cc.job("// cached\n")).result.get();
+    EXPECT(r.status == rtc::compile_status::success);
+    EXPECT(as_string(r) == "// cached\n");
+    EXPECT(cc.runs() == 1u);
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -15,10 +15,11 @@
 using half = _Float16;
 // using half = __fp16;
 
-std::vector<rtc::src_file> get_headers_for_test()
+// the headers a kernel including the device op header needs
+std::vector<rtc::src_file> get_headers_for_test(const std::string& include_header)
 {
     std::vector<rtc::src_file> result;
-    auto hs = ck::host::GetHeaders();
+    auto hs = ck::host::GetHeaders({include_header});
     std::transform(
         hs.begin(), hs.end(), std::back_inserter(result), [&](const auto& p) -> rtc::src_file {
             return {p.first, p.second};
@@ -171,9 +172,10 @@ TEST_CASE(test_problem_kernel)
                                                 {"m", std::to_string(prob.M)},
                                                 {"n", std::to_string(prob.N)},
                                                 {"k", std::to_string(prob.K)}});
-        auto srcs = get_headers_for_test();
+        auto srcs = get_headers_for_test(prob.GetIncludeHeader());
         srcs.push_back({"main.cpp", src});
         rtc::compile_options options;
+        options.prelude     = {prob.GetIncludeHeader()};
         options.kernel_name = "f";
         auto k              = rtc::compile_kernel(srcs, options);
         auto block_size     = solution.GetTemplateParameter<std::size_t>("BlockSize");
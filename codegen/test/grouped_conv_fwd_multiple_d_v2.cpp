@@ -165,9 +165,10 @@ struct Epilogue
             conv_compile_check,
             {{"include", prob.GetIncludeHeader()}, {"template", solution.ToTemplateString()}});
 
-        auto srcs = get_headers_for_test();
+        auto srcs = get_headers_for_test(prob.GetIncludeHeader());
         srcs.push_back({"main.cpp", src});
         rtc::compile_options options;
+        options.prelude     = {prob.GetIncludeHeader()};
         auto name           = solution.GetTemplateParameter<std::string>("name");
         options.kernel_name = "run_" + name;
         auto k              = rtc::compile_kernel(srcs, options);
@@ -0,0 +1,96 @@
+#include "ck/host/device_grouped_gemm_multiple_d/problem.hpp"
+#include "ck/host/device_grouped_gemm_multiple_d/operation.hpp"
+#include "ck/host/headers.hpp"
+#include <test.hpp>
+
+const std::string epilogue = R"(
+struct Epilogue
+{
+    template <typename E, typename D0, typename D1>
+    __host__ __device__ constexpr void
+    operator()(E& e, const E& c, const D0& d0, const D1& d1) const
+    {
+        e = c * d0 + d1;
+    }
+};
+using CDEElementOp = Epilogue;
+)";
+
+// the experts of a MoE layer: M differs between the groups
+ck::host::device_grouped_gemm_multiple_d::Problem make_problem()
+{
+    ck::host::device_grouped_gemm_multiple_d::Problem prob;
+    prob.N          = 4096;
+    prob.K          = 1024;
+    prob.TransB     = true;
+    prob.DsTrans    = {false, false};
+    prob.DsDataType = {ck::host::DataType::Half, ck::host::DataType::Half};
+    return prob;
+}
+
+TEST_CASE(test_grouped_template)
+{
+    auto prob      = make_problem();
+    auto solutions = prob.GetSolutions("gfx942", "", epilogue);
+    EXPECT(not solutions.empty());
+
+    for(const auto& solution : solutions)
+    {
+        const auto s = solution.ToTemplateString();
+        EXPECT(s.find("DeviceGroupedGemmMultipleDXdlCShuffleTileLoop<") ==
+               std::string("ck::tensor_operation::device::").size());
+        EXPECT(s.find("${") == std::string::npos);
+        EXPECT(s.find("ck::BlockGemmPipelineScheduler::Intrawave") != std::string::npos);
+        EXPECT(solution.GetTemplateParameter("CDEShuffleBlockTransferScalarPerVectors") ==
+               "ck::Sequence<8, 8, 8>");
+        EXPECT(solution.GetTemplateParameter("DsDataType") == "ck::Tuple<ck::half_t, ck::half_t>");
+        EXPECT(solution.GetTemplateParameter("CDEElementwiseOperation") == "CDEElementOp");
+        EXPECT(solution.GetTemplateParameter("Epilogue") == epilogue);
+    }
+}
+
+TEST_CASE(test_grouped_gemm_spec)
+{
+    auto prob = make_problem();
+    for(const auto& solution : prob.GetSolutions("gfx942", "", ""))
+    {
+        // M varies between the groups and is always padded, N and K divide the tiles
+        EXPECT(solution.GetTemplateParameter("GemmSpecialization") ==
+               "ck::tensor_operation::device::GemmSpecialization::MPadding");
+    }
+
+    prob.N = 0;
+    prob.K = 0;
+    for(const auto& solution : prob.GetSolutions("gfx942", "", ""))
+    {
+        EXPECT(solution.GetTemplateParameter("GemmSpecialization") ==
+               "ck::tensor_operation::device::GemmSpecialization::MNKPadding");
+    }
+}
+
+TEST_CASE(test_grouped_default_problems)
+{
+    using ck::host::device_grouped_gemm_multiple_d::Operation_Xdl_CShuffle_Tile_Loop;
+
+    auto configs = Operation_Xdl_CShuffle_Tile_Loop::CreateOperations("", "");
+    EXPECT(configs.size() == 4u);
+    for(const auto& ops : configs)
+    {
+        EXPECT(not ops.empty());
+        for(const auto& op : ops)
+        {
+            const auto solution = op.ToSolution();
+            EXPECT(solution.GetTemplateParameter("CDEShuffleBlockTransferScalarPerVectors") ==
+                   "ck::Sequence<8>");
+            EXPECT(solution.GetTemplateParameter("GemmSpecialization") ==
+                   "ck::tensor_operation::device::GemmSpecialization::MNKPadding");
+        }
+    }
+}
+
+TEST_CASE(test_grouped_header)
+{
+    EXPECT(ck::host::GetHeaders().count(make_problem().GetIncludeHeader()) == 1);
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
@@ -0,0 +1,61 @@
+#include "ck/host/device_gemm_multiple_d/problem.hpp"
+#include "ck/host/device_grouped_conv_fwd_multiple_d/conv_fwd_problem.hpp"
+#include "ck/host/headers.hpp"
+#include <test.hpp>
+
+TEST_CASE(test_closure_is_closed)
+{
+    const auto all = ck::host::GetHeaders();
+
+    ck::host::device_gemm_multiple_d::Problem gemm;
+    ck::host::conv::Problem_Conv_Fwd conv;
+    for(const auto& root : {gemm.GetIncludeHeader(), conv.GetIncludeHeader()})
+    {
+        const auto closure = ck::host::GetHeaders({root});
+
+        EXPECT(closure.count(root) == 1);
+        EXPECT(closure.count("ck/ck.hpp") == 1);
+        EXPECT(closure.count("ck/config.h") == 1);
+        EXPECT(closure.size() < all.size());
+
+        for(const auto& [header, content] : closure)
+        {
+            EXPECT(all.at(header) == content);
+            for(auto include : ck::host::GetIncludes(header))
+                EXPECT(closure.count(include) == 1);
+        }
+    }
+}
+
+TEST_CASE(test_closure_of_several_headers)
+{
+    ck::host::device_gemm_multiple_d::Problem gemm;
+    ck::host::conv::Problem_Conv_Fwd conv;
+
+    const auto gemm_closure = ck::host::GetHeaders({gemm.GetIncludeHeader()});
+    const auto conv_closure = ck::host::GetHeaders({conv.GetIncludeHeader()});
+    const auto both = ck::host::GetHeaders({gemm.GetIncludeHeader(), conv.GetIncludeHeader()});
+
+    for(const auto& closure : {gemm_closure, conv_closure})
+    {
+        for(const auto& header : closure)
+            EXPECT(both.count(header.first) == 1);
+    }
+    EXPECT(both.size() <= gemm_closure.size() + conv_closure.size());
+}
+
+TEST_CASE(test_unknown_header)
+{
+    bool thrown = false;
+    try
+    {
+        ck::host::GetHeaders({"ck/no_such_header.hpp"});
+    }
+    catch(const std::runtime_error&)
+    {
+        thrown = true;
+    }
+    EXPECT(thrown);
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
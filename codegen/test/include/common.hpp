@@ -9,10 +9,11 @@
 #include <rtc/hip.hpp>
 #include <fstream>
 
-std::vector<rtc::src_file> get_headers_for_test()
+// the headers a kernel including the device op header needs
+std::vector<rtc::src_file> get_headers_for_test(const std::string& include_header)
 {
     std::vector<rtc::src_file> result;
-    auto hs = ck::host::GetHeaders();
+    auto hs = ck::host::GetHeaders({include_header});
     std::transform(
         hs.begin(), hs.end(), std::back_inserter(result), [&](const auto& p) -> rtc::src_file {
             return {p.first, p.second};
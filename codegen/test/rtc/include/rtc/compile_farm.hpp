@@ -0,0 +1,74 @@
+#ifndef GUARD_HOST_TEST_RTC_INCLUDE_RTC_COMPILE_FARM
+#define GUARD_HOST_TEST_RTC_INCLUDE_RTC_COMPILE_FARM
+
+#include <rtc/compile_kernel.hpp>
+#include <chrono>
+#include <cstddef>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace rtc {
+
+struct compile_job
+{
+    // the contents are copied on submit, the sources need not outlive the job
+    std::vector<src_file> srcs;
+    compile_options options = compile_options{};
+    // the longest a compile may run once started, zero is no limit
+    std::chrono::milliseconds timeout{0};
+};
+
+struct compile_farm_options
+{
+    // zero is one worker per hardware thread
+    std::size_t workers = 0;
+    // code objects are read from and written to <cache_dir>/<key>.co, empty is the
+    // CK_RTC_CACHE_DIR environment variable, no cache when it is not set either
+    std::string cache_dir = "";
+};
+
+struct compile_handle
+{
+    // identical jobs, submitted while one of them is in flight, share a key and a result
+    std::string key;
+    std::shared_future<compile_result> result;
+    // tells a job from a later one with the same key
+    std::size_t job_id = 0;
+};
+
+// a bounded pool of workers running compile_code_object on submitted jobs
+struct compile_farm
+{
+    explicit compile_farm(compile_farm_options options = compile_farm_options{});
+
+    compile_farm(compile_farm const&) = delete;
+    compile_farm& operator=(compile_farm const&) = delete;
+
+    // cancels the jobs not completed yet and waits for the workers
+    ~compile_farm();
+
+    compile_handle submit(const compile_job& job);
+    std::vector<compile_handle> submit(const std::vector<compile_job>& jobs);
+
+    // withdraws one submission of the job; once every submission of it is withdrawn a queued job
+    // is dropped and a running compile is killed, its result is compile_status::cancelled
+    void cancel(const compile_handle& handle);
+
+    // the number of jobs queued or compiling
+    std::size_t in_flight() const;
+
+    std::size_t workers() const;
+
+    private:
+    struct impl;
+    std::unique_ptr<impl> pimpl;
+};
+
+// the key of a job: a hash of the compiler, flags, target and sources
+std::string compile_job_key(const compile_job& job);
+
+} // namespace rtc
+
+#endif
@@ -3,7 +3,9 @@
 
 #include <rtc/kernel.hpp>
 #include <rtc/filesystem.hpp>
+#include <functional>
 #include <string>
+#include <vector>
 
 namespace rtc {
 
@@ -17,8 +19,39 @@ struct compile_options
 {
     std::string flags       = "";
     std::string kernel_name = "main";
+    // headers compiled once into a precompiled header per set of header sources, flags and
+    // device, and reused by every compile with the same ones; only the .cpp sources are then
+    // written per compile
+    std::vector<std::string> prelude = {};
+    // the compiler command, the sources and flags are appended to it; empty is the hip device
+    // compiler of ROCm
+    std::string compiler = "";
+    // the --offload-arch, empty is the current device
+    std::string arch = "";
 };
 
+enum class compile_status
+{
+    success,
+    failed,
+    timeout,
+    cancelled
+};
+
+struct compile_result
+{
+    compile_status status = compile_status::failed;
+    std::vector<char> code_object;
+    // the output of the compiler
+    std::string log;
+};
+
+// compiles the sources to a code object without loading it, stop is polled while the compiler
+// runs and kills it when it returns true, the result is then compile_status::cancelled
+compile_result compile_code_object(const std::vector<src_file>& srcs,
+                                   compile_options options,
+                                   const std::function<bool()>& stop = nullptr);
+
 kernel compile_kernel(const std::vector<src_file>& src,
                       compile_options options = compile_options{});
 
@@ -1,11 +1,14 @@
 #ifndef GUARD_HOST_TEST_RTC_INCLUDE_RTC_TMP_DIR
 #define GUARD_HOST_TEST_RTC_INCLUDE_RTC_TMP_DIR
 
+#include <functional>
 #include <string>
 #include <rtc/filesystem.hpp>
 
 namespace rtc {
 
+std::string unique_string(const std::string& prefix);
+
 struct tmp_dir
 {
     fs::path path;
@@ -13,6 +16,10 @@ struct tmp_dir
 
     void execute(const std::string& cmd) const;
 
+    // runs cmd in its own process group, polling stop() while it runs and killing the group when
+    // stop() returns true; returns the exit status of cmd, or -1 if it was killed
+    int execute(const std::string& cmd, const std::function<bool()>& stop) const;
+
     tmp_dir(tmp_dir const&) = delete;
     tmp_dir& operator=(tmp_dir const&) = delete;
 
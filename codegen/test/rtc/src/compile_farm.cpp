@@ -0,0 +1,301 @@
+#include <rtc/compile_farm.hpp>
+#include <rtc/hip.hpp>
+#include <rtc/tmp_dir.hpp>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+namespace rtc {
+
+namespace {
+
+struct fnv1a
+{
+    std::uint64_t value = 14695981039346656037ull;
+
+    void add(std::string_view s)
+    {
+        for(auto c : s)
+        {
+            value ^= static_cast<unsigned char>(c);
+            value *= 1099511628211ull;
+        }
+        // a separator, so that consecutive fields cannot run into each other
+        value ^= 0xff;
+        value *= 1099511628211ull;
+    }
+};
+
+std::string get_arch(const compile_options& options)
+{
+    return options.arch.empty() ? get_device_name() : options.arch;
+}
+
+std::string get_cache_dir(const compile_farm_options& options)
+{
+    if(not options.cache_dir.empty())
+        return options.cache_dir;
+    const char* dir = std::getenv("CK_RTC_CACHE_DIR");
+    return dir == nullptr ? "" : dir;
+}
+
+compile_result read_cache(const std::string& cache_dir, const std::string& key)
+{
+    compile_result result;
+    if(cache_dir.empty())
+        return result;
+    std::ifstream is((fs::path{cache_dir} / (key + ".co")).string(), std::ios::binary);
+    if(not is)
+        return result;
+    result.code_object.assign(std::istreambuf_iterator<char>{is}, std::istreambuf_iterator<char>{});
+    if(not result.code_object.empty())
+        result.status = compile_status::success;
+    return result;
+}
+
+void write_cache(const std::string& cache_dir, const std::string& key, const std::vector<char>& obj)
+{
+    if(cache_dir.empty())
+        return;
+    // written next to the entry and renamed, a concurrent reader sees all of it or nothing
+    std::error_code ec;
+    fs::create_directories(cache_dir, ec);
+    const auto path = fs::path{cache_dir} / (key + ".co");
+    const auto tmp  = fs::path{cache_dir} / unique_string(key);
+    {
+        std::ofstream os(tmp.string(), std::ios::binary);
+        os.write(obj.data(), obj.size());
+        if(not os)
+            return;
+    }
+    fs::rename(tmp, path, ec);
+    if(ec)
+        fs::remove(tmp, ec);
+}
+
+} // namespace
+
+std::string compile_job_key(const compile_job& job)
+{
+    fnv1a h;
+    h.add(job.options.compiler);
+    h.add(job.options.flags);
+    h.add(get_arch(job.options));
+    for(const auto& header : job.options.prelude)
+        h.add(header);
+    for(const auto& src : job.srcs)
+    {
+        h.add(src.path.string());
+        h.add(src.content);
+    }
+
+    static const char* digits = "0123456789abcdef";
+    std::string key(16, '0');
+    for(std::size_t i = 0; i < key.size(); ++i)
+        key[key.size() - 1 - i] = digits[(h.value >> (4 * i)) & 0xf];
+    return key;
+}
+
+struct job_state
+{
+    std::string key;
+    std::size_t id = 0;
+    // the sources point into contents
+    std::vector<std::string> contents;
+    std::vector<src_file> srcs;
+    compile_options options;
+    std::chrono::milliseconds timeout{0};
+
+    std::promise<compile_result> promise;
+    std::shared_future<compile_result> result = promise.get_future().share();
+
+    std::size_t waiters = 1;
+    std::atomic<bool> cancelled{false};
+};
+
+struct compile_farm::impl
+{
+    std::string cache_dir;
+
+    mutable std::mutex mutex;
+    std::condition_variable cv;
+    std::deque<std::shared_ptr<job_state>> queue;
+    // the jobs queued or compiling, by key
+    std::unordered_map<std::string, std::shared_ptr<job_state>> jobs;
+    bool stopping       = false;
+    std::size_t next_id = 1;
+
+    std::vector<std::thread> workers;
+
+    void run()
+    {
+        for(;;)
+        {
+            std::shared_ptr<job_state> job;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                cv.wait(lock, [&] { return stopping or not queue.empty(); });
+                if(queue.empty())
+                    return;
+                job = queue.front();
+                queue.pop_front();
+            }
+
+            auto result = compile(*job);
+
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                auto it = jobs.find(job->key);
+                if(it != jobs.end() and it->second == job)
+                    jobs.erase(it);
+            }
+            job->promise.set_value(std::move(result));
+        }
+    }
+
+    compile_result compile(job_state& job) const
+    {
+        auto result = read_cache(cache_dir, job.key);
+        if(result.status == compile_status::success)
+            return result;
+
+        const auto deadline = std::chrono::steady_clock::now() + job.timeout;
+        auto timed_out      = [&] {
+            return job.timeout.count() > 0 and std::chrono::steady_clock::now() > deadline;
+        };
+
+        result = compile_code_object(
+            job.srcs, job.options, [&] { return job.cancelled.load() or timed_out(); });
+
+        if(result.status == compile_status::cancelled and not job.cancelled)
+            result.status = compile_status::timeout;
+        if(result.status == compile_status::success)
+            write_cache(cache_dir, job.key, result.code_object);
+        return result;
+    }
+};
+
+compile_farm::compile_farm(compile_farm_options options) : pimpl(std::make_unique<impl>())
+{
+    pimpl->cache_dir = get_cache_dir(options);
+
+    std::size_t n = options.workers;
+    if(n == 0)
+        n = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    for(std::size_t i = 0; i < n; ++i)
+        pimpl->workers.emplace_back([this] { pimpl->run(); });
+}
+
+compile_farm::~compile_farm()
+{
+    std::deque<std::shared_ptr<job_state>> dropped;
+    {
+        std::lock_guard<std::mutex> lock(pimpl->mutex);
+        pimpl->stopping = true;
+        dropped.swap(pimpl->queue);
+        for(auto& job : pimpl->jobs)
+            job.second->cancelled = true;
+        pimpl->jobs.clear();
+    }
+    pimpl->cv.notify_all();
+
+    compile_result cancelled;
+    cancelled.status = compile_status::cancelled;
+    for(auto& job : dropped)
+        job->promise.set_value(cancelled);
+
+    for(auto& worker : pimpl->workers)
+        worker.join();
+}
+
+compile_handle compile_farm::submit(const compile_job& job)
+{
+    auto key = compile_job_key(job);
+
+    std::lock_guard<std::mutex> lock(pimpl->mutex);
+    auto it = pimpl->jobs.find(key);
+    if(it != pimpl->jobs.end())
+    {
+        it->second->waiters++;
+        return {key, it->second->result, it->second->id};
+    }
+
+    auto state     = std::make_shared<job_state>();
+    state->key     = key;
+    state->id      = pimpl->next_id++;
+    state->options = job.options;
+    state->timeout = job.timeout;
+    // the device is looked up once here rather than by each worker
+    state->options.arch = get_arch(job.options);
+    state->contents.reserve(job.srcs.size());
+    for(const auto& src : job.srcs)
+    {
+        state->contents.emplace_back(src.content);
+        state->srcs.push_back({src.path, state->contents.back()});
+    }
+
+    pimpl->jobs.emplace(key, state);
+    pimpl->queue.push_back(state);
+    pimpl->cv.notify_one();
+    return {key, state->result, state->id};
+}
+
+std::vector<compile_handle> compile_farm::submit(const std::vector<compile_job>& jobs)
+{
+    std::vector<compile_handle> handles;
+    handles.reserve(jobs.size());
+    std::transform(jobs.begin(), jobs.end(), std::back_inserter(handles), [&](const auto& job) {
+        return submit(job);
+    });
+    return handles;
+}
+
+void compile_farm::cancel(const compile_handle& handle)
+{
+    std::shared_ptr<job_state> dropped;
+    {
+        std::lock_guard<std::mutex> lock(pimpl->mutex);
+        auto it = pimpl->jobs.find(handle.key);
+        // a completed job, or the handle of an earlier job with the same key
+        if(it == pimpl->jobs.end() or it->second->id != handle.job_id)
+            return;
+        auto job = it->second;
+        if(--job->waiters > 0)
+            return;
+
+        // a new submission of the same sources starts a fresh job
+        job->cancelled = true;
+        pimpl->jobs.erase(it);
+
+        auto queued = std::find(pimpl->queue.begin(), pimpl->queue.end(), job);
+        if(queued != pimpl->queue.end())
+        {
+            pimpl->queue.erase(queued);
+            dropped = job;
+        }
+    }
+    if(dropped != nullptr)
+    {
+        compile_result cancelled;
+        cancelled.status = compile_status::cancelled;
+        dropped->promise.set_value(cancelled);
+    }
+}
+
+std::size_t compile_farm::in_flight() const
+{
+    std::lock_guard<std::mutex> lock(pimpl->mutex);
+    return pimpl->jobs.size();
+}
+
+std::size_t compile_farm::workers() const { return pimpl->workers.size(); }
+
+} // namespace rtc
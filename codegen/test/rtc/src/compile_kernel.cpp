@@ -5,6 +5,10 @@
 #include <iostream>
 #include <fstream>
 #include <cassert>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
 
 namespace rtc {
 
@@ -59,21 +63,101 @@ std::string compiler() { return "/opt/rocm/llvm/bin/clang++ -x hip --cuda-device
 // TODO: undo after extracting the codeobj
 // std::string compiler() { return "/opt/rocm/llvm/bin/clang++ -x hip"; }
 
-kernel compile_kernel(const std::vector<src_file>& srcs, compile_options options)
+void write_src(const tmp_dir& td, const src_file& src)
+{
+    fs::path full_path   = td.path / src.path;
+    fs::path parent_path = full_path.parent_path();
+    fs::create_directories(parent_path);
+    write_string(full_path.string(), src.content);
+}
+
+std::string get_compiler(const compile_options& options)
+{
+    return options.compiler.empty() ? compiler() : options.compiler;
+}
+
+bool is_header(const src_file& src) { return src.path.extension().string() != ".cpp"; }
+
+// the headers and the precompiled prelude of one set of header sources, flags and device, kept
+// for the lifetime of the process
+struct prelude
+{
+    tmp_dir td{"prelude"};
+    bool valid = false;
+};
+
+std::string prelude_key(const std::vector<src_file>& srcs, const compile_options& options)
+{
+    std::stringstream ss;
+    ss << get_compiler(options) << ";" << options.flags;
+    for(const auto& header : options.prelude)
+        ss << ";" << header;
+    for(const auto& src : srcs)
+    {
+        if(is_header(src))
+            ss << ";" << src.path.string() << ":" << std::hash<std::string_view>{}(src.content);
+    }
+    return ss.str();
+}
+
+const prelude& get_prelude(const std::vector<src_file>& srcs, const compile_options& options)
+{
+    static std::mutex mutex;
+    static std::unordered_map<std::string, std::unique_ptr<prelude>> preludes;
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto& p = preludes[prelude_key(srcs, options)];
+    if(p == nullptr)
+    {
+        p = std::make_unique<prelude>();
+        for(const auto& src : srcs)
+        {
+            if(is_header(src))
+                write_src(p->td, src);
+        }
+
+        std::string content;
+        for(const auto& header : options.prelude)
+            content += "#include <" + header + ">\n";
+        write_string((p->td.path / "prelude.hpp").string(), content);
+
+        const auto cmd = get_compiler(options) + options.flags +
+                         " -Xclang -emit-pch -o prelude.pch prelude.hpp";
+        p->valid = p->td.execute(cmd, nullptr) == 0 and fs::exists(p->td.path / "prelude.pch");
+    }
+    return *p;
+}
+
+compile_result compile_code_object(const std::vector<src_file>& srcs,
+                                   compile_options options,
+                                   const std::function<bool()>& stop)
 {
     assert(not srcs.empty());
     tmp_dir td{"compile"};
     options.flags += " -I. -O3";
     options.flags += " -std=c++17";
-    options.flags += " --offload-arch=" + get_device_name();
+    options.flags += " --offload-arch=" + (options.arch.empty() ? get_device_name() : options.arch);
     std::string out;
 
+    // with a prelude the headers are read from its directory, a failed build falls back to
+    // writing and parsing them for this compile
+    bool write_headers = true;
+    if(not options.prelude.empty())
+    {
+        const auto& p = get_prelude(srcs, options);
+        if(p.valid)
+        {
+            const auto pch = (p.td.path / "prelude.pch").string();
+            options.flags += " -I" + p.td.path.string() + " -Xclang -include-pch -Xclang " + pch;
+            write_headers = false;
+        }
+    }
+
     for(const auto& src : srcs)
     {
-        fs::path full_path   = td.path / src.path;
-        fs::path parent_path = full_path.parent_path();
-        fs::create_directories(parent_path);
-        write_string(full_path.string(), src.content);
+        if(write_headers or not is_header(src))
+            write_src(td, src);
         if(src.path.extension().string() == ".cpp")
         {
             options.flags += " -c " + src.path.filename().string();
@@ -83,13 +167,35 @@ kernel compile_kernel(const std::vector<src_file>& srcs, compile_options options
     }
 
     options.flags += " -o " + out;
-    td.execute(compiler() + options.flags);
+
+    compile_result result;
+    const int status =
+        td.execute(get_compiler(options) + options.flags + " > compile.log 2>&1", stop);
+
+    const auto log_path = td.path / "compile.log";
+    if(fs::exists(log_path) and fs::file_size(log_path) > 0)
+        result.log = read_string(log_path.string());
 
     auto out_path = td.path / out;
-    if(not fs::exists(out_path))
-        throw std::runtime_error("Output file missing: " + out);
+    if(status == -1 and stop and stop())
+        result.status = compile_status::cancelled;
+    else if(status != 0 or not fs::exists(out_path) or fs::file_size(out_path) == 0)
+        result.status = compile_status::failed;
+    else
+    {
+        result.status      = compile_status::success;
+        result.code_object = read_buffer(out_path.string());
+    }
+    return result;
+}
+
+kernel compile_kernel(const std::vector<src_file>& srcs, compile_options options)
+{
+    auto result = compile_code_object(srcs, options);
+    if(result.status != compile_status::success)
+        throw std::runtime_error("Compilation failed: " + result.log);
 
-    auto obj = read_buffer(out_path.string());
+    const auto& obj = result.code_object;
 
     std::ofstream ofh("obj.o", std::ios::binary);
     for(auto i : obj)
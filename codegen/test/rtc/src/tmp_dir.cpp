@@ -3,6 +3,10 @@
 #include <random>
 #include <thread>
 #include <unistd.h>
+#include <chrono>
+#include <csignal>
+#include <stdexcept>
+#include <sys/wait.h>
 
 namespace rtc {
 std::string random_string(std::string::size_type length)
@@ -43,6 +47,36 @@ void tmp_dir::execute(const std::string& cmd) const
     std::system(s.c_str());
 }
 
+int tmp_dir::execute(const std::string& cmd, const std::function<bool()>& stop) const
+{
+    const std::string s = "cd " + path.string() + "; " + cmd;
+
+    const pid_t pid = fork();
+    if(pid < 0)
+        throw std::runtime_error("Failed to start: " + cmd);
+    if(pid == 0)
+    {
+        // a compiler driver starts more processes, put them all in one group to kill
+        setpgid(0, 0);
+        execl("/bin/sh", "sh", "-c", s.c_str(), static_cast<char*>(nullptr));
+        _exit(127);
+    }
+    setpgid(pid, pid);
+
+    int status = 0;
+    while(waitpid(pid, &status, WNOHANG) == 0)
+    {
+        if(stop and stop())
+        {
+            kill(-pid, SIGKILL);
+            waitpid(pid, &status, 0);
+            return -1;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+}
+
 tmp_dir::~tmp_dir() { fs::remove_all(this->path); }
 
 } // namespace rtc
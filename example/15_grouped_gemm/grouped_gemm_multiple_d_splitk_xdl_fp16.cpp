@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2018-2024, Advanced Micro Devices, Inc. All rights reserved.
+// Copyright (c) 2018-2025, Advanced Micro Devices, Inc. All rights reserved.
 
 #include <iostream>
 #include <numeric>
@@ -12,6 +12,7 @@
 #include "ck/tensor_operation/gpu/device/impl/device_grouped_gemm_multiple_d_splitk_xdl_cshuffle_two_stage.hpp"
 #include "ck/tensor_operation/gpu/device/device_grouped_gemm.hpp"
 #include "ck/tensor_operation/gpu/element/element_wise_operation.hpp"
+#include "ck/host_utility/workspace_arena.hpp"
 
 #include <ck/utility/data_type.hpp>
 #include <ck/utility/tuple.hpp>
@@ -253,11 +254,10 @@ bool run_grouped_gemm(const ProblemSize& problem_size, const ExecutionConfig& co
             "wrong! device_gemm with the specified compilation parameters does "
             "not support this GEMM problem");
     }
-    DeviceMem gemm_workspace_dev(gemm.GetWorkSpaceSize(&argument));
-    gemm.SetWorkSpacePointer(&argument, gemm_workspace_dev.GetDeviceBuffer());
-
-    DeviceMem gemm_arg_dev_mem(gemm.GetDeviceKernelArgSize(&argument));
-    gemm.SetDeviceKernelArgs(&argument, gemm_arg_dev_mem.GetDeviceBuffer());
+    // the split-K workspace and the kernel arguments, sub-allocated from one arena
+    ck::WorkspaceArena workspace_arena;
+    void* p_workspace   = workspace_arena.Bind(gemm, &argument);
+    void* p_kernel_args = workspace_arena.BindDeviceKernelArgs(gemm, &argument);
 
     invoker.Run(argument, StreamConfig{nullptr, false, 1});
 
@@ -271,6 +271,10 @@ bool run_grouped_gemm(const ProblemSize& problem_size, const ExecutionConfig& co
                   << " GB/s, " << gemm.GetTypeString() << std::endl;
     }
 
+    // the last run is launched, later ops of the stream may reuse the slices
+    workspace_arena.Release(p_workspace);
+    workspace_arena.Release(p_kernel_args);
+
     bool pass = true;
     if(config.do_verification)
     {
@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2018-2023, Advanced Micro Devices, Inc. All rights reserved.
+// Copyright (c) 2018-2025, Advanced Micro Devices, Inc. All rights reserved.
 
 #pragma once
 
@@ -211,8 +211,15 @@ bool maxpool_bwd_test(bool do_verification,
 
         auto ref_pooling_bwd          = ReferencePoolingBwdInstance{};
         auto ref_pooling_bwd_invoker  = ref_pooling_bwd.MakeInvoker();
-        auto ref_pooling_bwd_argument = ref_pooling_bwd.MakeArgument(
-            dout_n_c_ho_wo, indices_n_c_ho_wo_host, din_n_c_hi_wi_host, PassThrough{});
+        auto ref_pooling_bwd_argument = ref_pooling_bwd.MakeArgument(dout_n_c_ho_wo,
+                                                                     indices_n_c_ho_wo_host,
+                                                                     din_n_c_hi_wi_host,
+                                                                     window_spatial_lengths,
+                                                                     window_strides,
+                                                                     window_dilations,
+                                                                     input_left_pads,
+                                                                     input_right_pads,
+                                                                     PassThrough{});
 
         ref_pooling_bwd_invoker.Run(ref_pooling_bwd_argument);
 
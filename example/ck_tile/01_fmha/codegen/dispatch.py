@@ -0,0 +1,128 @@
+# SPDX-License-Identifier: MIT
+# Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+# helpers to emit the trait dispatch of the generated APIs
+
+from dataclasses import dataclass
+from typing import Dict, List
+
+from codegen.cpp_symbol_map import *
+
+
+def fnv1a64(s : str) -> int:
+    h = 0xcbf29ce484222325
+    for c in s.encode():
+        h ^= c
+        h = (h * 0x100000001b3) & 0xffffffffffffffff
+    return h
+
+DISPATCH_DTYPE_INDEX_FUNC="""
+// index of the data type in the dispatch key, -1 for an unknown one: a switch over a perfect hash
+// of the type names, checked by a single string compare
+int {F_name}(const std::string& dtype)
+{{
+    std::uint64_t h = 0xcbf29ce484222325ull;
+    for(unsigned char c : dtype)
+        h = (h ^ c) * 0x100000001b3ull;
+    switch(h)
+    {{
+{F_cases}
+    default: return -1;
+    }}
+}}
+"""
+
+def get_dtype_index_func(name : str, dtypes : List[str]) -> str:
+    hashes = [fnv1a64(d) for d in dtypes]
+    assert len(set(hashes)) == len(hashes), 'data type names collide in the dispatch hash'
+    cases = '\n'.join(
+        f'    case 0x{h:016x}ull: return dtype == "{d}" ? {i} : -1;' for i, (d, h) in enumerate(zip(dtypes, hashes)))
+    return DISPATCH_DTYPE_INDEX_FUNC.format(F_name=name, F_cases=cases)
+
+# index of the mask class in the dispatch key, the generated masks of an implementation each take
+# a set of mask_enum values (see get_mask_check_map())
+_MASK_INDEX_MAP = {
+    "no" : 0,
+    "causal" : 1,
+    "generic" : 2,
+}
+
+_MASK_SIMPLIFIED_INDEX_MAP = {
+    "s_no" : 0,
+    "s_mask" : 1,
+}
+
+_MASK_INDEX_FUNC="""
+int {F_name}(mask_enum m)
+{
+    switch(m)
+    {
+    case mask_enum::no_mask: return 0;
+    case mask_enum::mask_top_left:
+    case mask_enum::mask_bottom_right: return 1;
+    case mask_enum::window_generic: return 2;
+    }
+    return -1;
+}
+"""
+
+_MASK_SIMPLIFIED_INDEX_FUNC="""
+int {F_name}(mask_enum m) { return m == mask_enum::no_mask ? 0 : 1; }
+"""
+
+def get_mask_index_map(mask : str) -> Dict[str, int]:
+    if mask == "generic":
+        return _MASK_INDEX_MAP
+    elif mask == "simplified":
+        return _MASK_SIMPLIFIED_INDEX_MAP
+    else:
+        assert False
+        return None
+
+def get_mask_index_func(name : str, mask : str) -> str:
+    if mask == "generic":
+        return _MASK_INDEX_FUNC.replace('{F_name}', name)
+    elif mask == "simplified":
+        return _MASK_SIMPLIFIED_INDEX_FUNC.replace('{F_name}', name)
+    else:
+        assert False
+        return None
+
+@dataclass
+class DispatchKeyField:
+    name : str
+    expr : str  # C++ expression of the field value, an integer in [0, 2^bits)
+    bits : int
+
+class DispatchKey:
+    """
+    packs the exactly matched traits of an API into an unsigned integer, the generated API switches
+    over it so a call only checks the handful of kernels built for its traits
+    """
+    def __init__(self, fields : List[DispatchKeyField]):
+        self.fields = fields
+        assert sum(f.bits for f in fields) <= 32
+
+    def pack(self, **values) -> int:
+        key = 0
+        shift = 0
+        for f in self.fields:
+            v = values[f.name]
+            assert 0 <= v < (1 << f.bits), f'{f.name}={v} does not fit the dispatch key'
+            key |= v << shift
+            shift += f.bits
+        return key
+
+    @property
+    def cpp_expr(self) -> str:
+        terms = []
+        shift = 0
+        for f in self.fields:
+            terms.append(f'(static_cast<unsigned>({f.expr}) << {shift})')
+            shift += f.bits
+        return ' |\n                         '.join(terms)
+
+def get_bias_index(bias : str) -> int:
+    return list(BIAS_CHECK_MAP.keys()).index(bias)
+
+def get_bool_index(b : str) -> int:
+    return 1 if b == 't' else 0
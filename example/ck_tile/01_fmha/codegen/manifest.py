@@ -0,0 +1,191 @@
+# SPDX-License-Identifier: MIT
+# Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+# prune the generated instances to the attention configurations of a deployment manifest
+
+import json
+import re
+from collections import Counter
+from math import gcd
+from pathlib import Path
+from types import SimpleNamespace
+from typing import Dict, List, Optional, Tuple
+
+# the manifest is a json object with a list of served configurations per API, e.g.
+# {
+#   "fwd": [{"dtype": ["fp16", "bf16"], "mode": ["batch"], "hdim": [64, [128, 96]],
+#            "mask": ["no", "causal"], "bias": ["no"], "lse": [false], "dropout": [false],
+#            "vlayout": ["row"], "seqlen_q": [1, 8192], "seqlen_k": [128, 8192],
+#            "seqlen_multiple_of": 128, "fallback": false}],
+#   "bwd": [{"dtype": ["bf16"], "hdim": [128], "mask": ["causal"]}]
+# }
+# a field left out serves every value. "hdim" lists head dims, or [hdim_q, hdim_v] pairs, a kernel
+# is kept for the smallest hdim case that holds them. "mask" takes no/causal/window.
+# "seqlen_q" and "seqlen_k" are [min, max] ranges of the served seqlens, each a multiple of
+# "seqlen_multiple_of" (default 1). with "fallback": false only the padding variants the dispatch
+# picks for a served shape are kept, by default all of them are, so that a shape outside the served
+# ranges still finds a (padded) kernel in its hdim case or the next larger one.
+
+# the mask_enum values each generated mask takes
+_MASK_KINDS = {
+    "no" : {"no"},
+    "causal" : {"causal"},
+    "generic" : {"window"},
+    "s_no" : {"no"},
+    "s_mask" : {"causal", "window"},
+}
+
+# the kernel properties checked, in the order a drop reason is looked for
+_FIELDS = ["dtype", "mode", "hdim", "mask", "bias", "dbias", "lse", "dropout", "store_randval",
+           "deterministic", "squant", "vlayout", "paged_kv", "rope"]
+
+def _hdim_bucket(h, hdim_buckets : List[int]) -> Optional[int]:
+    # the dispatch takes the first hdim case holding max(hdim_q, hdim_v)
+    h = max(h) if isinstance(h, list) else h
+    return min((b for b in hdim_buckets if h <= b), default=None)
+
+def _predicate(expr : str):
+    # the C++ shape checks of the generated API, evaluated on the served shapes
+    expr = re.sub(r'/\*.*?\*/', '', expr)
+    expr = expr.replace('&&', ' and ').replace('||', ' or ')
+    expr = re.sub(r'\btrue\b', 'True', re.sub(r'\bfalse\b', 'False', expr))
+    return compile(expr, '<predicate>', 'eval')
+
+class Manifest:
+    def __init__(self, path : str):
+        with open(path) as f:
+            self.entries : Dict[str, List[dict]] = json.load(f)
+        self.kept : Dict[str, int] = Counter()
+        self.dropped : Dict[str, List[Tuple[str, str]]] = dict()
+
+    def _mismatch(self, entry : dict, props : dict) -> Optional[Tuple[int, str]]:
+        # the first property of the kernel the entry does not serve, with its index in _FIELDS
+        for i, field in enumerate(_FIELDS):
+            if field not in props or field not in entry:
+                continue
+            value = props[field]
+            if field == "hdim":
+                if not any(_hdim_bucket(h, props["hdim_buckets"]) == value for h in entry[field]):
+                    return (i, f"hdim {value} not served")
+            elif field == "mask":
+                if not (_MASK_KINDS[value] & set(entry[field])):
+                    return (i, f"mask {value} not served")
+            else:
+                v = (value == 't') if value in ['t', 'f'] else value
+                if v not in entry[field]:
+                    return (i, f"{field} {value} not served")
+        return None
+
+    def note(self, api : str, name : str, reason : Optional[str] = None) -> None:
+        """record a kernel kept, or dropped for the reason"""
+        if reason is None:
+            self.kept[api] += 1
+        else:
+            self.dropped.setdefault(api, list()).append((name, reason))
+
+    def match(self, api : str, name : str, **props) -> List[dict]:
+        """
+        the configurations of the manifest a kernel of the API serves, named as in _FIELDS plus the
+        "hdim_buckets" of the dtype. a kernel serving none is recorded with the reason for the report
+        """
+        entries = self.entries.get(api, [])
+        reasons = [self._mismatch(e, props) for e in entries]
+        served = [e for e, r in zip(entries, reasons) if r is None]
+        if not entries:
+            self.note(api, name, f"no {api} configuration served")
+        elif not served:
+            # the reason of the configuration the kernel came closest to
+            self.note(api, name, max(reasons)[1])
+        return served
+
+    def keep(self, api : str, name : str, **props) -> bool:
+        served = len(self.match(api, name, **props)) > 0
+        if served:
+            self.note(api, name)
+        return served
+
+    @staticmethod
+    def _seqlens(entry : dict, seqlen : str, moduli : List[int]) -> List[int]:
+        # one served seqlen per outcome of the shape checks, which only take it modulo the tiles
+        lo, hi = entry.get(seqlen, [1, 1 << 31])
+        m = entry.get("seqlen_multiple_of", 1)
+        period = m
+        for t in moduli:
+            period = period * t // gcd(period, t)
+        seen = dict()
+        v = (lo + m - 1) // m * m
+        while v <= hi and v < lo + period + m:
+            seen.setdefault((v == 0, tuple(v % t == 0 for t in moduli)), v)
+            v += m
+        return list(seen.values())
+
+    @staticmethod
+    def _hdims(entry : dict, hdim : int, hdim_buckets : List[int]) -> List[Tuple[int, int]]:
+        if "hdim" in entry:
+            pairs = [h if isinstance(h, list) else [h, h] for h in entry["hdim"]]
+        else:
+            pairs = [[h, h] for h in range(1, hdim + 1)]
+        return [tuple(p) for p in pairs if _hdim_bucket(p, hdim_buckets) == hdim]
+
+    def prune_shapes(self, api : str, hdim : int, hdim_buckets : List[int],
+                     candidates : List[Tuple[str, str, List[dict]]]) -> List[str]:
+        """
+        the kernels of one dispatch case the API picks for a served shape. candidates are the
+        (kernel name, shape check, served configurations) in dispatch order, the first one whose
+        check passes is picked; a kernel may be several candidates
+        """
+        names = list(dict.fromkeys(name for name, _, _ in candidates))
+        if all(e.get("fallback", True) for _, _, entries in candidates for e in entries):
+            for name in names:
+                self.note(api, name)
+            return names
+
+        checks = [(name, _predicate(check), entries) for name, check, entries in candidates]
+        moduli = sorted(set(int(t) for _, check, _ in candidates for t in re.findall(r'%\s*(\d+)', check)))
+        picked = set()
+        for entry in {id(e) : e for _, _, entries in candidates for e in entries}.values():
+            if entry.get("fallback", True):
+                picked |= set(name for name, _, entries in candidates if entry in entries)
+                continue
+            for sq in self._seqlens(entry, "seqlen_q", moduli):
+                for sk in self._seqlens(entry, "seqlen_k", moduli):
+                    for hq, hv in self._hdims(entry, hdim, hdim_buckets):
+                        a = SimpleNamespace(seqlen_q=sq, seqlen_k=sk, hdim_q=hq, hdim_v=hv)
+                        for name, check, entries in checks:
+                            if entry in entries and eval(check, {}, {'a' : a}):
+                                picked.add(name)
+                                break
+        for name in names:
+            self.note(api, name, None if name in picked else "padding variant not picked for a served shape")
+        return [name for name in names if name in picked]
+
+    def select(self, api : str, matched : List[tuple]) -> List:
+        """
+        the matched kernels the API picks for a served shape. matched holds (dispatch case, hdim,
+        hdim buckets, kernel, served configurations, shape checks) in dispatch order, a kernel is
+        a candidate for each of its shape checks
+        """
+        cases = dict()
+        for case, hdim, hdim_buckets, kernel, served, checks in matched:
+            candidates = cases.setdefault(case, (hdim, hdim_buckets, list()))[2]
+            candidates.extend((kernel.name, check, served) for check in checks)
+        kept = set()
+        for hdim, hdim_buckets, candidates in cases.values():
+            kept.update(self.prune_shapes(api, hdim, hdim_buckets, candidates))
+        return [m[3] for m in matched if m[3].name in kept]
+
+    def report(self) -> str:
+        lines = []
+        for api in sorted(set(self.kept.keys()) | set(self.dropped.keys())):
+            dropped = self.dropped.get(api, [])
+            lines.append(f"{api}: kept {self.kept[api]}, dropped {len(dropped)}")
+            for reason, n in Counter(r for _, r in dropped).most_common():
+                lines.append(f"  {n:6d} {reason}")
+        for api, dropped in self.dropped.items():
+            lines.append("")
+            for name, reason in dropped:
+                lines.append(f"{api} {name}: {reason}")
+        return "\n".join(lines) + "\n"
+
+    def write_report(self, path : Optional[str]) -> None:
+        if path is not None:
+            Path(path).write_text(self.report())
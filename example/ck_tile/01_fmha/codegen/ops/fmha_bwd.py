@@ -11,6 +11,8 @@ from typing import List, Optional, Tuple
 
 from codegen.cmake_config import *
 from codegen.cpp_symbol_map import *
+from codegen.dispatch import *
+from codegen.manifest import Manifest
 
 
 BWD_DQDKDV_PIPELINE_MAP = {
@@ -162,7 +164,9 @@ std::string fmha_bwd_dq_dk_dv_get_name_<dq_dk_dv_trait_{F_idx}>()
 
 FMHA_BWD_API_FILENAME="fmha_bwd_api.cpp"
 FMHA_BWD_API="""
+#include <cstdint>
 #include <iostream>
+#include <string>
 
 template <typename dot_do_o_trait_, typename dq_dk_dv_trait_, typename convert_dq_trait_>
 float fmha_bwd_(const ck_tile::stream_config& s, fmha_bwd_args a)
@@ -176,30 +180,84 @@ float fmha_bwd_(const ck_tile::stream_config& s, fmha_bwd_args a)
     );
 }}
 
-float fmha_bwd(fmha_bwd_traits t, fmha_bwd_args a, const ck_tile::stream_config& s){{
-    float r = -1;
+namespace {{
+{F_dtype_index}{F_mask_index}
+// the kernels generated for the traits and shapes, nullptr if there are none. the exactly matched
+// traits are packed into a key, so only the kernels built for them check the shapes
+fmha_bwd_memo::kernel_type fmha_bwd_select(const fmha_bwd_traits& t, const fmha_bwd_args& a)
+{{
+    const int dtype   = fmha_bwd_dtype_index(t.data_type);
+    const int mask    = fmha_bwd_mask_index(t.mask_type);
+    const int dropout = t.has_dropout ? (t.is_store_randval ? 2 : 1) : 0;
+    if(dtype < 0 || mask < 0)
+        return nullptr;
+    const unsigned key = {F_key};
+    switch(key)
+    {{
 {F_dispatch}
-    return r;
+    default: break;
+    }}
+    (void)a;
+    return nullptr;
+}}
+
+bool fmha_bwd_memo_hit(const fmha_bwd_memo& m, const fmha_bwd_traits& t, const fmha_bwd_args& a)
+{{
+    return m.kernel != nullptr && m.seqlen_q == a.seqlen_q && m.seqlen_k == a.seqlen_k &&
+           m.hdim_q == a.hdim_q && m.hdim_v == a.hdim_v && m.traits.hdim_q == t.hdim_q &&
+           m.traits.hdim_v == t.hdim_v && m.traits.is_group_mode == t.is_group_mode &&
+           m.traits.mask_type == t.mask_type && m.traits.bias_type == t.bias_type &&
+           m.traits.has_dbias == t.has_dbias && m.traits.has_dropout == t.has_dropout &&
+           m.traits.is_store_randval == t.is_store_randval &&
+           m.traits.is_deterministic == t.is_deterministic && m.traits.data_type == t.data_type;
+}}
+}} // namespace
+
+float fmha_bwd(fmha_bwd_traits t, fmha_bwd_args a, const ck_tile::stream_config& s){{
+    const auto kernel = fmha_bwd_select(t, a);
+    return kernel == nullptr ? -1 : kernel(s, a);
+}}
+
+float fmha_bwd(fmha_bwd_traits t, fmha_bwd_args a, const ck_tile::stream_config& s, fmha_bwd_memo& m){{
+    if(!fmha_bwd_memo_hit(m, t, a))
+        m = fmha_bwd_memo{{t, a.seqlen_q, a.seqlen_k, a.hdim_q, a.hdim_v, fmha_bwd_select(t, a)}};
+    return m.kernel == nullptr ? -1 : m.kernel(s, a);
 }}
 """
 
-FMHA_BWD_API_PER_DTYPE="""    {F_if}(t.data_type.compare(\"{F_dtype}\") == 0){{
-{F_hdim_case}
-    }}
+FMHA_BWD_API_PER_KEY="""    case 0x{F_key:x}: // {F_comment}
+{F_hdim_case}        break;
 """
-FMHA_BWD_API_PER_HDIM_CASE="""        {F_if} (t.hdim_q <= {F_hdim} && t.hdim_v <= {F_hdim}) {{
-{F_inner_dispatch}
+
+FMHA_BWD_API_PER_HDIM_CASE="""        if(t.hdim_q <= {F_hdim} && t.hdim_v <= {F_hdim}) {{
+{F_inner_dispatch}            return nullptr;
         }}
 """
 
-FMHA_BWD_API_INNER_DISPATCH="""            {F_if}((t.is_group_mode == {F_mode}) && ({F_mask_check}) && (t.bias_type == {F_bias_check}) && (t.has_dbias == {F_dbias}) && ({F_dropout_check}) &&
-                        ({F_scheck}) && ({F_skcheck}) && ({F_dcheck}) && ({F_dvcheck}) && (t.is_deterministic == {F_deterministic})) {{
-                using dot_do_o_trait_ = fmha_bwd_dot_do_o_traits_<{F_hdim}, {F_dtype}, {F_mode}, {F_spad1}, {F_dvpad}>;
-                using dq_dk_dv_trait_ = fmha_bwd_dq_dk_dv_traits_<{F_hdim}, {F_dtype}, {F_mode}, {F_pipeline_enum}, {F_mask}, {F_dropout}, {F_bias}, {F_dbias}, {F_spad0}, {F_skpad}, {F_dpad}, {F_dvpad}, {F_deterministic}>;
-                using convert_dq_trait_ = fmha_bwd_convert_dq_traits_<{F_hdim}, {F_dtype}, {F_mode}, {F_spad1}, {F_dpad}, {F_deterministic}>;
-                r = fmha_bwd_<dot_do_o_trait_, dq_dk_dv_trait_, convert_dq_trait_>(s, a);
-                return r;
-            }}
+FMHA_BWD_API_EMPTY_HDIM_CASE="""        if(t.hdim_q <= {F_hdim} && t.hdim_v <= {F_hdim})
+            return nullptr;
+"""
+
+FMHA_BWD_API_INNER_DISPATCH="""            if(({F_scheck}) && ({F_skcheck}) && ({F_dcheck}) && ({F_dvcheck}))
+                return &fmha_bwd_<{F_dot_do_o_trait}, {F_dq_dk_dv_trait}, {F_convert_dq_trait}>;
+"""
+
+FMHA_BWD_API_DOT_DO_O_TRAIT="""fmha_bwd_dot_do_o_traits_<{F_hdim}, {F_dtype}, {F_mode}, {F_spad1}, {F_dvpad}>"""
+FMHA_BWD_API_DQ_DK_DV_TRAIT="""fmha_bwd_dq_dk_dv_traits_<{F_hdim}, {F_dtype}, {F_mode}, {F_pipeline_enum}, {F_mask}, {F_dropout}, {F_bias}, {F_dbias}, {F_spad0}, {F_skpad}, {F_dpad}, {F_dvpad}, {F_deterministic}>"""
+FMHA_BWD_API_CONVERT_DQ_TRAIT="""fmha_bwd_convert_dq_traits_<{F_hdim}, {F_dtype}, {F_mode}, {F_spad1}, {F_dpad}, {F_deterministic}>"""
+
+FMHA_BWD_STUB_FILENAME="fmha_bwd_stub_kernels.cpp"
+FMHA_BWD_STUB_KERNEL="""
+template<>
+void fmha_bwd_{F_kind}_oneshot_<{F_trait}>(const ck_tile::stream_config&, fmha_bwd_args)
+{{
+}}
+
+template<>
+std::string fmha_bwd_{F_kind}_get_name_<{F_trait}>()
+{{
+    return "stub";
+}}
 """
 
 @dataclass
@@ -266,35 +324,92 @@ class FmhaBwdApiPool:
 
         self.dq_dk_dv_pool[trait.dtype][trait.hdim].append(copy.copy(trait))
 
+    def dispatch_key(self) -> DispatchKey:
+        return DispatchKey([
+            DispatchKeyField('dtype', 'dtype', 4),
+            DispatchKeyField('mode', 't.is_group_mode', 1),
+            DispatchKeyField('mask', 'mask', 2),
+            DispatchKeyField('bias', 't.bias_type', 2),
+            DispatchKeyField('dbias', 't.has_dbias', 1),
+            DispatchKeyField('dropout', 'dropout', 2),
+            DispatchKeyField('deterministic', 't.is_deterministic', 1),
+        ])
+
+    # the traits of the three kernels a dq_dk_dv kernel is launched with
+    def trait_types(self, trait : FmhaBwdDQDKDVApiTrait, spad1 : str) -> Tuple[str, str, str]:
+        fields = dict(F_mode=MODE_MAP[trait.mode], F_pipeline_enum=BWD_DQDKDV_PIPELINE_ENUM_MAP[trait.pipeline],
+                    F_mask=get_mask_map(self.mask_impl)[trait.mask], F_bias=BIAS_MAP[trait.bias], F_dbias=BOOL_MAP[trait.dbias],
+                    F_dropout=DROPOUT_MAP[trait.dropout], F_hdim=trait.hdim, F_dtype=BWD_DTYPE_MAP[trait.dtype],
+                    F_spad0=BOOL_MAP[trait.spad], F_spad1=BOOL_MAP[spad1], F_skpad=BOOL_MAP[trait.skpad], F_dpad=BOOL_MAP[trait.dpad],
+                    F_dvpad=BOOL_MAP[trait.dvpad], F_deterministic=BOOL_MAP[trait.deterministic])
+        return (FMHA_BWD_API_DOT_DO_O_TRAIT.format(**fields), FMHA_BWD_API_DQ_DK_DV_TRAIT.format(**fields),
+                FMHA_BWD_API_CONVERT_DQ_TRAIT.format(**fields))
+
+    # the padding of the dot_do_o and convert_dq kernels each dq_dk_dv kernel is dispatched with
+    def spad1s(self, trait : FmhaBwdDQDKDVApiTrait) -> List[str]:
+        return [spad1 for spad1 in ["t", "f"] if not (spad1 == "f" and (trait.spad == "t" or trait.mode == "group"))]
+
     @property
     def api(self) -> str:
-        per_dtypes=str()
-        for i, dtype in enumerate(self.dq_dk_dv_pool.keys()):
+        dtypes = list(self.dq_dk_dv_pool.keys())
+        key = self.dispatch_key()
+        # group the kernels by key, keeping the order of the hdim cases and of the kernels in them
+        per_key = dict()
+        for i, dtype in enumerate(dtypes):
+            for hdim, traits in self.dq_dk_dv_pool[dtype].items():
+                for trait in traits:
+                    dropout = 0 if trait.dropout == 'no' else (2 if trait.dropout.endswith('storerandval') else 1)
+                    k = key.pack(dtype=i, mode=int(trait.mode == 'group'), mask=get_mask_index_map(self.mask_impl)[trait.mask],
+                                 bias=get_bias_index(trait.bias), dbias=get_bool_index(trait.dbias), dropout=dropout,
+                                 deterministic=get_bool_index(trait.deterministic))
+                    per_key.setdefault(k, (dtype, trait, dict()))[2].setdefault(hdim, list()).append(trait)
+
+        per_keys=str()
+        for k, (dtype, first, hdims) in sorted(per_key.items()):
             per_hdim_case=str()
-            for j, hdim in enumerate(self.dq_dk_dv_pool[dtype].keys()):
-                traits=self.dq_dk_dv_pool[dtype][hdim]
-                hdim_int = int(hdim)
+            empty_cases=str()
+            for hdim in self.dq_dk_dv_pool[dtype].keys():
+                if hdim not in hdims:
+                    # an hdim case without kernels for the key still ends the search
+                    empty_cases = empty_cases + FMHA_BWD_API_EMPTY_HDIM_CASE.format(F_hdim=hdim)
+                    continue
                 inners=str()
-                for k, trait in enumerate(traits):
-                    if_k = 'if' if k == 0 else 'else if'
-                    for spad1 in ["t", "f"]:
-                        if (spad1 == "f" and (trait.spad == "t" or trait.mode == "group")):
-                            continue
-                        inners = inners + FMHA_BWD_API_INNER_DISPATCH.format(F_if=if_k, F_mode=MODE_MAP[trait.mode], F_pipeline_enum=BWD_DQDKDV_PIPELINE_ENUM_MAP[trait.pipeline],
-                                    F_mask_check=get_mask_check_map(self.mask_impl)[trait.mask], F_mask=get_mask_map(self.mask_impl)[trait.mask], F_bias_check=BIAS_CHECK_MAP[trait.bias],
-                                    F_bias=BIAS_MAP[trait.bias], F_dbias=BOOL_MAP[trait.dbias], F_dropout_check=DROPOUT_CHECK_MAP[trait.dropout], F_dropout=DROPOUT_MAP[trait.dropout],
-                                    F_scheck=trait.scheck(spad1=spad1), F_skcheck=trait.skcheck, F_dcheck=trait.dcheck, F_dvcheck=trait.dvcheck, F_hdim=hdim, F_dtype=BWD_DTYPE_MAP[dtype],
-                                    F_spad0=BOOL_MAP[trait.spad], F_spad1=BOOL_MAP[spad1], F_skpad=BOOL_MAP[trait.skpad], F_dpad=BOOL_MAP[trait.dpad], F_dvpad=BOOL_MAP[trait.dvpad],
-                                    F_deterministic=BOOL_MAP[trait.deterministic])
-
-                if_j = 'if' if j == 0 else 'else if'
-                per_hdim_case = per_hdim_case + FMHA_BWD_API_PER_HDIM_CASE.format(F_if=if_j, F_hdim=hdim, F_inner_dispatch=inners)
-            if_i = 'if' if i == 0 else 'else if'
-            per_dtypes = per_dtypes + FMHA_BWD_API_PER_DTYPE.format(F_if=if_i, F_dtype=dtype, F_hdim_case=per_hdim_case)
-        if not per_dtypes:
-            # empty string we add some ignore to suppress warning in api
-            per_dtypes += '    (void)t ; (void)s ; (void)a;'
-        return FMHA_BWD_KERNEL_HEADER + FMHA_BWD_API.format(F_dispatch = per_dtypes)
+                for trait in hdims[hdim]:
+                    for spad1 in self.spad1s(trait):
+                        dot_do_o, dq_dk_dv, convert_dq = self.trait_types(trait, spad1)
+                        inners = inners + FMHA_BWD_API_INNER_DISPATCH.format(F_scheck=trait.scheck(spad1=spad1),
+                                    F_skcheck=trait.skcheck, F_dcheck=trait.dcheck, F_dvcheck=trait.dvcheck,
+                                    F_dot_do_o_trait=dot_do_o, F_dq_dk_dv_trait=dq_dk_dv, F_convert_dq_trait=convert_dq)
+                per_hdim_case = per_hdim_case + empty_cases + FMHA_BWD_API_PER_HDIM_CASE.format(F_hdim=hdim, F_inner_dispatch=inners)
+                empty_cases=str()
+            comment = f'{dtype}, {first.mode}, mask {first.mask}, bias {first.bias}, dbias {first.dbias}, ' + \
+                      f'dropout {first.dropout}, deterministic {first.deterministic}'
+            per_keys = per_keys + FMHA_BWD_API_PER_KEY.format(F_key=k, F_comment=comment, F_hdim_case=per_hdim_case)
+        return FMHA_BWD_KERNEL_HEADER + FMHA_BWD_API.format(F_dtype_index=get_dtype_index_func('fmha_bwd_dtype_index', dtypes),
+                    F_mask_index=get_mask_index_func('fmha_bwd_mask_index', self.mask_impl), F_key=key.cpp_expr,
+                    F_dispatch=per_keys)
+
+    # the traits of every kernel the API launches
+    @property
+    def launched_traits(self) -> set:
+        launched=set()
+        for dtype in self.dq_dk_dv_pool.keys():
+            for traits in self.dq_dk_dv_pool[dtype].values():
+                for trait in traits:
+                    for spad1 in self.spad1s(trait):
+                        launched.update(self.trait_types(trait, spad1))
+        return launched
+
+    @property
+    def stub_kernels(self) -> str:
+        stubs=dict()
+        for dtype in self.dq_dk_dv_pool.keys():
+            for traits in self.dq_dk_dv_pool[dtype].values():
+                for trait in traits:
+                    for spad1 in self.spad1s(trait):
+                        for kind, t in zip(['dot_do_o', 'dq_dk_dv', 'convert_dq'], self.trait_types(trait, spad1)):
+                            stubs.setdefault(t, FMHA_BWD_STUB_KERNEL.format(F_kind=kind, F_trait=t))
+        return FMHA_BWD_KERNEL_HEADER + ''.join(stubs.values())
 
 # GEMM0: Q@K=S^T
 # GEMM1: P^T@dO^T=dV(This was chosen as G1 to match fwd, but N1 must be equal to headdim_v)
@@ -463,11 +578,12 @@ def get_fmha_bwd_dq_dk_dv_tile_ppl_dict_from_dtype(dtype : str) -> Optional[dict
     else:
         return None
 
-def get_bwd_dq_dk_dv_blobs(kernel_filter : Optional[str], receipt, mask_impl) -> Tuple[FmhaBwdApiPool, List[FmhaBwdDQDKDVKernel]]:
+def get_bwd_dq_dk_dv_blobs(kernel_filter : Optional[str], receipt, mask_impl, manifest : Optional[Manifest] = None) -> Tuple[FmhaBwdApiPool, List[FmhaBwdDQDKDVKernel]]:
     # TODO: we don't support tuning yet, so pick up one value for pad
     #       support this in future
     gen = list()
     api_pool = FmhaBwdApiPool(mask_impl)
+    matched = list()
 
     for dtype in BWD_DTYPE_MAP.keys():
         d = get_fmha_bwd_dq_dk_dv_tile_ppl_dict_from_dtype(dtype)
@@ -506,6 +622,22 @@ def get_bwd_dq_dk_dv_blobs(kernel_filter : Optional[str], receipt, mask_impl) ->
                     cond &= deterministic == "f"
                     if not cond:
                         continue
+            if manifest != None:
+                served = manifest.match('bwd', k.name, dtype=dtype, mode=mode, hdim=hdim, hdim_buckets=[int(h) for h in d.keys()],
+                                        mask=mask, bias=bias, dbias=dbias, dropout='t' if dropout != 'no' else 'f',
+                                        store_randval='t' if dropout.endswith('storerandval') else 'f', deterministic=deterministic)
+                if served:
+                    t = k.api_trait()
+                    dropout_class = 0 if dropout == 'no' else (2 if dropout.endswith('storerandval') else 1)
+                    matched.append(((dtype, hdim, mode, mask, bias, dbias, dropout_class, deterministic), hdim, [int(h) for h in d.keys()], k, served,
+                                    [f'({t.scheck(spad1)}) && ({t.skcheck}) && ({t.dcheck}) && ({t.dvcheck})' for spad1 in api_pool.spad1s(t)]))
+                continue
+            api_pool.register_dq_dk_dv_traits(k.api_trait())
+            gen.append(k)
+
+    if manifest != None:
+        # only the padding variants picked for a served shape
+        for k in manifest.select('bwd', matched):
             api_pool.register_dq_dk_dv_traits(k.api_trait())
             gen.append(k)
 
@@ -608,13 +740,15 @@ class FmhaBwdOGradDotOKernel:
     def filename(self) -> str:
         return self.name + ".cpp"
 
-def get_bwd_dot_do_o_blobs() -> List[FmhaBwdOGradDotOKernel]:
+# with a manifest, only the kernels the API launches
+def get_bwd_dot_do_o_blobs(api_pool : Optional[FmhaBwdApiPool] = None, manifest : Optional[Manifest] = None) -> List[FmhaBwdOGradDotOKernel]:
     # TODO: we don't support tuning yet, so pick up one value for pad/occupancy
     #       support this in future
     def get_occupancy(dtype, hdim):
         return 2
 
     gen = list()
+    launched = api_pool.launched_traits if manifest != None else None
 
     for dtype in BWD_DTYPE_MAP.keys():
         d = get_fmha_bwd_dq_dk_dv_tile_ppl_dict_from_dtype(dtype)
@@ -627,6 +761,13 @@ def get_bwd_dot_do_o_blobs() -> List[FmhaBwdOGradDotOKernel]:
             k = FmhaBwdOGradDotOKernel(F_idx=0, F_hdim=hdim, F_dtype=dtype,
                                 F_spad=spad, F_dvpad=dvpad, F_mode=mode,
                                 F_occupancy=get_occupancy(dtype, hdim))
+            if manifest != None:
+                t = FMHA_BWD_API_DOT_DO_O_TRAIT.format(F_hdim=hdim, F_dtype=BWD_DTYPE_MAP[dtype], F_mode=MODE_MAP[mode],
+                                F_spad1=BOOL_MAP[spad], F_dvpad=BOOL_MAP[dvpad])
+                if t not in launched:
+                    manifest.note('bwd', k.name, "not launched by a kept dq_dk_dv kernel")
+                    continue
+                manifest.note('bwd', k.name)
             gen.append(k)
 
     return gen
@@ -743,13 +884,15 @@ class FmhaBwdConvertQGradKernel:
     def filename(self) -> str:
         return self.name + ".cpp"
 
-def get_bwd_convert_dq_blobs() -> List[FmhaBwdConvertQGradKernel]:
+# with a manifest, only the kernels the API launches
+def get_bwd_convert_dq_blobs(api_pool : Optional[FmhaBwdApiPool] = None, manifest : Optional[Manifest] = None) -> List[FmhaBwdConvertQGradKernel]:
     # TODO: we don't support tuning yet, so pick up one value for pad/occupancy
     #       support this in future
     def get_occupancy(dtype, hdim):
         return 2
 
     gen = list()
+    launched = api_pool.launched_traits if manifest != None else None
 
     for dtype in BWD_DTYPE_MAP.keys():
         d = get_fmha_bwd_dq_dk_dv_tile_ppl_dict_from_dtype(dtype)
@@ -762,6 +905,13 @@ def get_bwd_convert_dq_blobs() -> List[FmhaBwdConvertQGradKernel]:
                 continue
             k = FmhaBwdConvertQGradKernel(F_idx=0, F_hdim=hdim, F_dtype=dtype, F_bm0=64, F_bn0=tile.F_bn0,
                                 F_spad=spad, F_dpad=dpad, F_mode=mode, F_occupancy=get_occupancy(dtype, hdim), F_deterministic=deterministic)
+            if manifest != None:
+                t = FMHA_BWD_API_CONVERT_DQ_TRAIT.format(F_hdim=hdim, F_dtype=BWD_DTYPE_MAP[dtype], F_mode=MODE_MAP[mode],
+                                F_spad1=BOOL_MAP[spad], F_dpad=BOOL_MAP[dpad], F_deterministic=BOOL_MAP[deterministic])
+                if t not in launched:
+                    manifest.note('bwd', k.name, "not launched by a kept dq_dk_dv kernel")
+                    continue
+                manifest.note('bwd', k.name)
             gen.append(k)
 
     return gen
@@ -778,27 +928,33 @@ def write_single_bwd_convert_dq_kernel(kernel: FmhaBwdConvertQGradKernel, autoge
 def write_bwd_api(api_pool : FmhaBwdApiPool, autogen_dir: Path) -> None:
     (autogen_dir / FMHA_BWD_API_FILENAME).write_text(api_pool.api)
 
-def write_blobs(output_dir : Path, kernel_filter : Optional[str], receipt, mask_impl) -> None:
-    kernels = get_bwd_dot_do_o_blobs()
+def write_blobs(output_dir : Path, kernel_filter : Optional[str], receipt, mask_impl, manifest : Optional[Manifest] = None) -> None:
+    api_pool, dq_dk_dv_kernels = get_bwd_dq_dk_dv_blobs(kernel_filter, receipt, mask_impl, manifest)
+    kernels = get_bwd_dot_do_o_blobs(api_pool, manifest)
     for kernel in kernels:
         write_single_bwd_dot_do_o_kernel(kernel, output_dir)
-    kernels = get_bwd_convert_dq_blobs()
+    kernels = get_bwd_convert_dq_blobs(api_pool, manifest)
     for kernel in kernels:
         write_single_bwd_convert_dq_kernel(kernel, output_dir)
-    api_pool, kernels = get_bwd_dq_dk_dv_blobs(kernel_filter, receipt, mask_impl)
-    for kernel in kernels:
+    for kernel in dq_dk_dv_kernels:
         write_single_bwd_dq_dk_dv_kernel(kernel, output_dir)
     write_bwd_api(api_pool, output_dir)
 
-def list_blobs(file_path : Path, kernel_filter : Optional[str], receipt, mask_impl) -> None:
+# the API with a no-op instead of every kernel, to time the host side dispatch
+def write_stub_blobs(output_dir : Path, kernel_filter : Optional[str], receipt, mask_impl, manifest : Optional[Manifest] = None) -> None:
+    api_pool, _ = get_bwd_dq_dk_dv_blobs(kernel_filter, receipt, mask_impl, manifest)
+    write_bwd_api(api_pool, output_dir)
+    (output_dir / FMHA_BWD_STUB_FILENAME).write_text(api_pool.stub_kernels)
+
+def list_blobs(file_path : Path, kernel_filter : Optional[str], receipt, mask_impl, manifest : Optional[Manifest] = None) -> None:
     with file_path.open('a') as f:
-        kernels = get_bwd_dot_do_o_blobs()
+        api_pool, dq_dk_dv_kernels = get_bwd_dq_dk_dv_blobs(kernel_filter, receipt, mask_impl, manifest)
+        kernels = get_bwd_dot_do_o_blobs(api_pool, manifest)
         for kernel in kernels:
             f.write(str(file_path.parent / GEN_DIR / kernel.filename) + "\n")
-        kernels = get_bwd_convert_dq_blobs()
+        kernels = get_bwd_convert_dq_blobs(api_pool, manifest)
         for kernel in kernels:
             f.write(str(file_path.parent / GEN_DIR / kernel.filename) + "\n")
-        _, kernels = get_bwd_dq_dk_dv_blobs(kernel_filter, receipt, mask_impl)
-        for kernel in kernels:
+        for kernel in dq_dk_dv_kernels:
             f.write(str(file_path.parent / GEN_DIR / kernel.filename) + "\n")
-        f.write(str(file_path.parent / GEN_DIR / FMHA_BWD_API_FILENAME) + "\n")
\ No newline at end of file
+        f.write(str(file_path.parent / GEN_DIR / FMHA_BWD_API_FILENAME) + "\n")
@@ -11,6 +11,8 @@ from typing import List, Optional, Tuple
 
 from codegen.cmake_config import *
 from codegen.cpp_symbol_map import *
+from codegen.dispatch import *
+from codegen.manifest import Manifest
 
 
 DTYPE_BITS = {
@@ -107,13 +109,59 @@ float fmha_fwd_<trait_{F_idx}>(const ck_tile::stream_config& s, fmha_fwd_args a)
 
 FMHA_FWD_API_FILENAME="fmha_fwd_api.cpp"
 FMHA_FWD_API="""
-float fmha_fwd(fmha_fwd_traits t, fmha_fwd_args a, const ck_tile::stream_config& s){{
-    float r = -1;
+#include <cstdint>
+#include <string>
+
+namespace {{
+{F_dtype_index}{F_mask_index}
+// the kernel generated for the traits and shapes, nullptr if there is none. the exactly matched traits
+// are packed into a key, so only the kernels built for them check the shapes
+fmha_fwd_memo::kernel_type fmha_fwd_select(const fmha_fwd_traits& t, const fmha_fwd_args& a)
+{{
+    const int dtype = fmha_fwd_dtype_index(t.data_type);
+    const int mask  = fmha_fwd_mask_index(t.mask_type);
+    if(dtype < 0 || mask < 0)
+        return nullptr;
+    const unsigned key = {F_key};
+    switch(key)
+    {{
 {F_dispatch}
-    return r;
+    default: break;
+    }}
+    (void)a;
+    return nullptr;
+}}
+
+bool fmha_fwd_memo_hit(const fmha_fwd_memo& m, const fmha_fwd_traits& t, const fmha_fwd_args& a)
+{{
+    return m.kernel != nullptr && m.seqlen_q == a.seqlen_q && m.seqlen_k == a.seqlen_k &&
+           m.hdim_q == a.hdim_q && m.hdim_v == a.hdim_v && m.traits.hdim_q == t.hdim_q &&
+           m.traits.hdim_v == t.hdim_v && m.traits.is_group_mode == t.is_group_mode &&
+           m.traits.is_v_rowmajor == t.is_v_rowmajor && m.traits.mask_type == t.mask_type &&
+           m.traits.bias_type == t.bias_type && m.traits.has_lse == t.has_lse &&
+           m.traits.has_dropout == t.has_dropout &&
+           m.traits.do_fp8_static_quant == t.do_fp8_static_quant &&
+           m.traits.data_type == t.data_type;
+}}
+}} // namespace
+
+float fmha_fwd(fmha_fwd_traits t, fmha_fwd_args a, const ck_tile::stream_config& s){{
+    const auto kernel = fmha_fwd_select(t, a);
+    return kernel == nullptr ? -1 : kernel(s, a);
+}}
+
+float fmha_fwd(fmha_fwd_traits t, fmha_fwd_args a, const ck_tile::stream_config& s, fmha_fwd_memo& m){{
+    if(!fmha_fwd_memo_hit(m, t, a))
+        m = fmha_fwd_memo{{t, a.seqlen_q, a.seqlen_k, a.hdim_q, a.hdim_v, fmha_fwd_select(t, a)}};
+    return m.kernel == nullptr ? -1 : m.kernel(s, a);
 }}
 """
 
+FMHA_FWD_API_PER_KEY="""    case 0x{F_key:x}: // {F_comment}
+{F_hdim_case}        break;
+"""
+
+# the if chains of the splitkv and appendkv APIs
 FMHA_FWD_API_PER_DTYPE="""    {F_if}(t.data_type.compare(\"{F_dtype}\") == 0){{
 {F_hdim_case}
     }}
@@ -123,11 +171,28 @@ FMHA_FWD_API_PER_HDIM_CASE="""        {F_if} (t.hdim_q <= {F_hdim} && t.hdim_v <
         }}
 """
 
-FMHA_FWD_API_INNER_DISPATCH="""            {F_if}((t.is_group_mode == {F_mode}) && (t.is_v_rowmajor == {F_vlayout}) && ({F_mask_check}) && (t.bias_type == {F_bias_check}) && (t.has_lse == {F_lse})  && (t.has_dropout == {F_dropout}) && (t.do_fp8_static_quant == {F_squant}) &&
-                        ({F_scheck}) && ({F_skcheck}) && ({F_dcheck}) && ({F_dvcheck})) {{
-                using trait_ = fmha_fwd_traits_<{F_hdim}, {F_dtype}, {F_mode}, {F_bm0}, {F_bn0}, {F_bk0}, {F_bn1}, {F_bk1}, {F_bk0max}, {F_vlayout}, {F_pipeline_enum}, {F_mask}, {F_bias}, {F_lse}, {F_dropout}, {F_squant}, {F_spad}, {F_skpad}, {F_dpad}, {F_dvpad}>;
-                return fmha_fwd_<trait_>(s, a);
-            }}
+FMHA_FWD_API_KEY_HDIM_CASE="""        if(t.hdim_q <= {F_hdim} && t.hdim_v <= {F_hdim}) {{
+{F_inner_dispatch}            return nullptr;
+        }}
+"""
+
+FMHA_FWD_API_KEY_EMPTY_HDIM_CASE="""        if(t.hdim_q <= {F_hdim} && t.hdim_v <= {F_hdim})
+            return nullptr;
+"""
+
+FMHA_FWD_API_INNER_DISPATCH="""            if(({F_scheck}) && ({F_skcheck}) && ({F_dcheck}) && ({F_dvcheck}))
+                return &fmha_fwd_<{F_trait}>;
+"""
+
+FMHA_FWD_API_TRAIT="""fmha_fwd_traits_<{F_hdim}, {F_dtype}, {F_mode}, {F_bm0}, {F_bn0}, {F_bk0}, {F_bn1}, {F_bk1}, {F_bk0max}, {F_vlayout}, {F_pipeline_enum}, {F_mask}, {F_bias}, {F_lse}, {F_dropout}, {F_squant}, {F_spad}, {F_skpad}, {F_dpad}, {F_dvpad}>"""
+
+FMHA_FWD_STUB_FILENAME="fmha_fwd_stub_kernels.cpp"
+FMHA_FWD_STUB_KERNEL="""
+template<>
+float fmha_fwd_<{F_trait}>(const ck_tile::stream_config&, fmha_fwd_args)
+{{
+    return 0;
+}}
 """
 
 @dataclass
@@ -257,32 +322,73 @@ class FmhaFwdApiPool:
 
         self.pool[trait.dtype][trait.hdim].append(copy.copy(trait))
 
+    def dispatch_key(self) -> DispatchKey:
+        return DispatchKey([
+            DispatchKeyField('dtype', 'dtype', 4),
+            DispatchKeyField('mode', 't.is_group_mode', 1),
+            DispatchKeyField('vlayout', 't.is_v_rowmajor', 1),
+            DispatchKeyField('mask', 'mask', 2),
+            DispatchKeyField('bias', 't.bias_type', 2),
+            DispatchKeyField('lse', 't.has_lse', 1),
+            DispatchKeyField('dropout', 't.has_dropout', 1),
+            DispatchKeyField('squant', 't.do_fp8_static_quant', 1),
+        ])
+
+    def trait_type(self, trait : FmhaFwdApiTrait) -> str:
+        return FMHA_FWD_API_TRAIT.format(F_mode=MODE_MAP[trait.mode], F_vlayout=LAYOUT_MAP[trait.vlayout],
+                    F_pipeline_enum=PIPELINE_ENUM_MAP[trait.pipeline_tag], F_mask=get_mask_map(self.mask_impl)[trait.mask],
+                    F_bias=BIAS_MAP[trait.bias], F_lse=BOOL_MAP[trait.lse], F_dropout=BOOL_MAP[trait.dropout],
+                    F_squant=BOOL_MAP[trait.squant], F_spad=BOOL_MAP[trait.spad], F_skpad=BOOL_MAP[trait.skpad],
+                    F_dpad=BOOL_MAP[trait.dpad], F_dvpad=BOOL_MAP[trait.dvpad],
+                    F_bm0=trait.bm0, F_bn0=trait.bn0, F_bk0=trait.bk0, F_bn1=trait.bn1, F_bk1=trait.bk1, F_bk0max=trait.bk0max,
+                    F_hdim=trait.hdim, F_dtype=FWD_DTYPE_MAP[trait.dtype])
+
     @property
     def api(self) -> str:
-        per_dtypes=str()
-        for i, dtype in enumerate(self.pool.keys()):
+        dtypes = list(self.pool.keys())
+        key = self.dispatch_key()
+        # group the kernels by key, keeping the order of the hdim cases and of the kernels in them
+        per_key = dict()
+        for i, dtype in enumerate(dtypes):
+            for hdim, traits in self.pool[dtype].items():
+                for trait in traits:
+                    k = key.pack(dtype=i, mode=int(trait.mode == 'group'), vlayout=int(trait.vlayout == 'row'),
+                                 mask=get_mask_index_map(self.mask_impl)[trait.mask], bias=get_bias_index(trait.bias),
+                                 lse=get_bool_index(trait.lse), dropout=get_bool_index(trait.dropout),
+                                 squant=get_bool_index(trait.squant))
+                    per_key.setdefault(k, (dtype, trait, dict()))[2].setdefault(hdim, list()).append(trait)
+
+        per_keys=str()
+        for k, (dtype, first, hdims) in sorted(per_key.items()):
             per_hdim_case=str()
-            for j, hdim in enumerate(self.pool[dtype].keys()):
-                traits=self.pool[dtype][hdim]
+            empty_cases=str()
+            for hdim in self.pool[dtype].keys():
+                if hdim not in hdims:
+                    # an hdim case without kernels for the key still ends the search
+                    empty_cases = empty_cases + FMHA_FWD_API_KEY_EMPTY_HDIM_CASE.format(F_hdim=hdim)
+                    continue
                 inners=str()
-                for k, trait in enumerate(traits):
-                    if_k = 'if' if k == 0 else 'else if'
-                    inners = inners + FMHA_FWD_API_INNER_DISPATCH.format(F_if=if_k, F_mode=MODE_MAP[trait.mode], F_vlayout=LAYOUT_MAP[trait.vlayout],
-                                   F_pipeline_enum=PIPELINE_ENUM_MAP[trait.pipeline_tag], F_mask=get_mask_map(self.mask_impl)[trait.mask],
-                                   F_mask_check=get_mask_check_map(self.mask_impl)[trait.mask], F_bias_check=BIAS_CHECK_MAP[trait.bias], F_bias=BIAS_MAP[trait.bias],
-                                   F_lse=BOOL_MAP[trait.lse], F_dropout=BOOL_MAP[trait.dropout] ,
-                                   F_squant=BOOL_MAP[trait.squant], F_scheck=trait.scheck, F_skcheck=trait.skcheck, F_dcheck=trait.dcheck, F_dvcheck=trait.dvcheck,
-                                   F_spad=BOOL_MAP[trait.spad], F_skpad=BOOL_MAP[trait.skpad], F_dpad=BOOL_MAP[trait.dpad], F_dvpad=BOOL_MAP[trait.dvpad],
-                                   F_bm0=trait.bm0, F_bn0=trait.bn0, F_bk0=trait.bk0, F_bn1=trait.bn1, F_bk1=trait.bk1, F_bk0max=trait.bk0max,
-                                   F_hdim=hdim, F_dtype=FWD_DTYPE_MAP[dtype])
-                if_j = 'if' if j == 0 else 'else if'
-                per_hdim_case = per_hdim_case + FMHA_FWD_API_PER_HDIM_CASE.format(F_if=if_j, F_hdim=hdim, F_inner_dispatch=inners)
-            if_i = 'if' if i == 0 else 'else if'
-            per_dtypes = per_dtypes + FMHA_FWD_API_PER_DTYPE.format(F_if=if_i, F_dtype=dtype, F_hdim_case=per_hdim_case)
-        if not per_dtypes:
-            # empty string we add some ignore to suppress warning in api
-            per_dtypes += '    (void)t ; (void)s ; (void)a;'
-        return FMHA_FWD_KERNEL_HEADER + FMHA_FWD_API.format(F_dispatch = per_dtypes)
+                for trait in hdims[hdim]:
+                    inners = inners + FMHA_FWD_API_INNER_DISPATCH.format(F_scheck=trait.scheck, F_skcheck=trait.skcheck,
+                                   F_dcheck=trait.dcheck, F_dvcheck=trait.dvcheck, F_trait=self.trait_type(trait))
+                per_hdim_case = per_hdim_case + empty_cases + FMHA_FWD_API_KEY_HDIM_CASE.format(F_hdim=hdim, F_inner_dispatch=inners)
+                empty_cases=str()
+            comment = f'{dtype}, {first.mode}, v{first.vlayout}, mask {first.mask}, bias {first.bias}, ' + \
+                      f'lse {first.lse}, dropout {first.dropout}, squant {first.squant}'
+            per_keys = per_keys + FMHA_FWD_API_PER_KEY.format(F_key=k, F_comment=comment, F_hdim_case=per_hdim_case)
+        return FMHA_FWD_KERNEL_HEADER + FMHA_FWD_API.format(F_dtype_index=get_dtype_index_func('fmha_fwd_dtype_index', dtypes),
+                    F_mask_index=get_mask_index_func('fmha_fwd_mask_index', self.mask_impl), F_key=key.cpp_expr,
+                    F_dispatch=per_keys)
+
+    @property
+    def stub_kernels(self) -> str:
+        stubs=dict()
+        for dtype in self.pool.keys():
+            for traits in self.pool[dtype].values():
+                for trait in traits:
+                    t = self.trait_type(trait)
+                    stubs.setdefault(t, FMHA_FWD_STUB_KERNEL.format(F_trait=t))
+        return FMHA_FWD_KERNEL_HEADER + ''.join(stubs.values())
 
 @dataclass
 class FmhaFwdTileSize:
@@ -416,7 +522,7 @@ def get_fmha_fwd_tile_dict_from_dtype(dtype : str) -> Optional[dict]:
     else:
         return None
 
-def get_fwd_blobs(kernel_filter : Optional[str], receipt, mask_impl) -> Tuple[FmhaFwdApiPool, List[FmhaFwdKernel]]:
+def get_fwd_blobs(kernel_filter : Optional[str], receipt, mask_impl, manifest : Optional[Manifest] = None) -> Tuple[FmhaFwdApiPool, List[FmhaFwdKernel]]:
     # TODO: we don't support tuning yet, so pick up one value for vlayout/pipeline/pad
     #       support this in future
     def get_pipelines(dtype, hdim) -> List[FmhaFwdPipeline]:
@@ -463,6 +569,7 @@ def get_fwd_blobs(kernel_filter : Optional[str], receipt, mask_impl) -> Tuple[Fm
 
     gen = list()
     api_pool = FmhaFwdApiPool(mask_impl)
+    matched = list()
 
     for dtype in FWD_DTYPE_MAP.keys():
         d = get_fmha_fwd_tile_dict_from_dtype(dtype)
@@ -494,9 +601,24 @@ def get_fwd_blobs(kernel_filter : Optional[str], receipt, mask_impl) -> Tuple[Fm
                     cond &= pipeline.F_squant == 'f'
                     if not cond:
                         continue
+                if manifest != None:
+                    p = pipeline
+                    served = manifest.match('fwd', k.name, dtype=dtype, mode=mode, hdim=hdim, hdim_buckets=[int(h) for h in d.keys()],
+                                            mask=p.F_mask, bias=p.F_bias, lse=p.F_lse, dropout=p.F_dropout, squant=p.F_squant, vlayout=p.F_vlayout)
+                    if served:
+                        t = k.api_trait()
+                        matched.append(((dtype, hdim, mode, p.F_vlayout, p.F_mask, p.F_bias, p.F_lse, p.F_dropout, p.F_squant),
+                                        hdim, [int(h) for h in d.keys()], k, served, [f'({t.scheck}) && ({t.skcheck}) && ({t.dcheck}) && ({t.dvcheck})']))
+                    continue
                 api_pool.register_traits(k.api_trait())
                 gen.append(k)
 
+    if manifest != None:
+        # only the padding variants picked for a served shape
+        for k in manifest.select('fwd', matched):
+            api_pool.register_traits(k.api_trait())
+            gen.append(k)
+
     return (api_pool, gen)
 
 def write_single_fwd_kernel(kernel: FmhaFwdKernel, autogen_dir: Path) -> None:
@@ -505,15 +627,21 @@ def write_single_fwd_kernel(kernel: FmhaFwdKernel, autogen_dir: Path) -> None:
 def write_fwd_api(api_pool : FmhaFwdApiPool, autogen_dir: Path) -> None:
     (autogen_dir / FMHA_FWD_API_FILENAME).write_text(api_pool.api)
 
-def write_blobs(output_dir : Path, kernel_filter : Optional[str], receipt, mask_impl) -> None:
-    api_pool, kernels = get_fwd_blobs(kernel_filter, receipt, mask_impl)
+def write_blobs(output_dir : Path, kernel_filter : Optional[str], receipt, mask_impl, manifest : Optional[Manifest] = None) -> None:
+    api_pool, kernels = get_fwd_blobs(kernel_filter, receipt, mask_impl, manifest)
     for kernel in kernels:
         write_single_fwd_kernel(kernel, output_dir)
     write_fwd_api(api_pool, output_dir)
 
-def list_blobs(file_path : Path, kernel_filter : Optional[str], receipt, mask_impl) -> None:
+# the API with a no-op instead of every kernel, to time the host side dispatch
+def write_stub_blobs(output_dir : Path, kernel_filter : Optional[str], receipt, mask_impl, manifest : Optional[Manifest] = None) -> None:
+    api_pool, _ = get_fwd_blobs(kernel_filter, receipt, mask_impl, manifest)
+    write_fwd_api(api_pool, output_dir)
+    (output_dir / FMHA_FWD_STUB_FILENAME).write_text(api_pool.stub_kernels)
+
+def list_blobs(file_path : Path, kernel_filter : Optional[str], receipt, mask_impl, manifest : Optional[Manifest] = None) -> None:
     with file_path.open('a') as f:
-        _, kernels = get_fwd_blobs(kernel_filter, receipt, mask_impl)
+        _, kernels = get_fwd_blobs(kernel_filter, receipt, mask_impl, manifest)
         for kernel in kernels:
             f.write(str(file_path.parent / GEN_DIR / kernel.filename) + "\n")
         f.write(str(file_path.parent / GEN_DIR / FMHA_FWD_API_FILENAME) + "\n")
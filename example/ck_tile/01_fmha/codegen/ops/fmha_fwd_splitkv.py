@@ -11,6 +11,7 @@ from typing import List, Optional, Tuple, Union
 
 from codegen.cmake_config import *
 from codegen.cpp_symbol_map import *
+from codegen.manifest import Manifest
 
 from codegen.ops.fmha_fwd import (
     FmhaFwdTileSize,
@@ -638,7 +639,7 @@ def get_fmha_fwd_splitkv_combine_tile_dict_from_dtype(dtype : str) -> Optional[d
     else:
         return None
 
-def get_fwd_splitkv_blobs(kernel_filter : Optional[str], receipt, mask_impl) -> Tuple[FmhaFwdSplitKVApiPool, List[FmhaFwdSplitKVKernel]]:
+def get_fwd_splitkv_blobs(kernel_filter : Optional[str], receipt, mask_impl, manifest : Optional[Manifest] = None) -> Tuple[FmhaFwdSplitKVApiPool, List[FmhaFwdSplitKVKernel]]:
     Pipeline = FmhaFwdSplitKVPipeline
     Kernel = FmhaFwdSplitKVKernel
 
@@ -712,12 +713,19 @@ def get_fwd_splitkv_blobs(kernel_filter : Optional[str], receipt, mask_impl) ->
                     cond &= pipeline.F_squant == 'f'
                     if not cond:
                         continue
+                if manifest != None:
+                    if not manifest.keep('fwd_splitkv', k.name, dtype=dtype, mode=mode, hdim=hdim, hdim_buckets=[int(h) for h in d.keys()],
+                                         mask=pipeline.F_mask, bias=pipeline.F_bias, squant=pipeline.F_squant,
+                                         vlayout=pipeline.F_vlayout, paged_kv=pipeline.F_pagedkv):
+                        continue
                 api_pool.register_traits(k.api_trait())
                 gen.append(k)
 
     return (api_pool, gen)
 
-def get_fwd_splitkv_combine_blobs(kernel_filter : Optional[str], receipt) -> List[FmhaFwdSplitKVCombineKernel]:
+# with a manifest, only the kernels combining the splits of the kept splitkv kernels are generated
+def get_fwd_splitkv_combine_blobs(kernel_filter : Optional[str], receipt, splitkv_kernels : Optional[List[FmhaFwdSplitKVKernel]] = None,
+                                  manifest : Optional[Manifest] = None) -> List[FmhaFwdSplitKVCombineKernel]:
     Pipeline = FmhaFwdSplitKVCombinePipeline
     Kernel = FmhaFwdSplitKVCombineKernel
 
@@ -741,6 +749,8 @@ def get_fwd_splitkv_combine_blobs(kernel_filter : Optional[str], receipt) -> Lis
         return pipelines
 
     gen = list()
+    if manifest != None:
+        combined = set((k.F_dtype, k.F_hdim, k.F_mode, k.F_pipeline.F_squant, k.F_pipeline.F_spad, k.F_pipeline.F_dvpad) for k in splitkv_kernels)
 
     for dtype in FWD_DTYPE_MAP.keys():
         d = get_fmha_fwd_splitkv_combine_tile_dict_from_dtype(dtype)
@@ -764,6 +774,13 @@ def get_fwd_splitkv_combine_blobs(kernel_filter : Optional[str], receipt) -> Lis
                 if kernel_filter != None:
                     if not fnmatch.fnmatch(k.name, kernel_filter):
                         continue
+                if manifest != None:
+                    # the API instantiates the lse and the no-lse combine kernel for each splitkv kernel
+                    p = pipeline
+                    if (dtype, hdim, mode, p.F_squant, p.F_spad, p.F_dvpad) not in combined:
+                        manifest.note('fwd_splitkv', k.name, "no kept splitkv kernel to combine")
+                        continue
+                    manifest.note('fwd_splitkv', k.name)
                 gen.append(k)
 
     return gen
@@ -775,21 +792,21 @@ def write_fwd_splitkv_api(api_pool : FmhaFwdSplitKVApiPool, autogen_dir: Path) -
     file_path = autogen_dir / FMHA_FWD_SPLITKV_API_FILENAME
     file_path.write_text(api_pool.api)
 
-def write_blobs(output_dir : Path, kernel_filter : Optional[str], receipt, mask_impl) -> None:
-    kernels = get_fwd_splitkv_combine_blobs(kernel_filter, receipt)
+def write_blobs(output_dir : Path, kernel_filter : Optional[str], receipt, mask_impl, manifest : Optional[Manifest] = None) -> None:
+    api_pool, splitkv_kernels = get_fwd_splitkv_blobs(kernel_filter, receipt, mask_impl, manifest)
+    kernels = get_fwd_splitkv_combine_blobs(kernel_filter, receipt, splitkv_kernels, manifest)
     for kernel in kernels:
         write_single_kernel(kernel, output_dir)
-    api_pool, kernels = get_fwd_splitkv_blobs(kernel_filter, receipt, mask_impl)
-    for kernel in kernels:
+    for kernel in splitkv_kernels:
         write_single_kernel(kernel, output_dir)
     write_fwd_splitkv_api(api_pool, output_dir)
 
-def list_blobs(file_path : Path, kernel_filter : Optional[str], receipt, mask_impl) -> None:
+def list_blobs(file_path : Path, kernel_filter : Optional[str], receipt, mask_impl, manifest : Optional[Manifest] = None) -> None:
     with file_path.open('a') as f:
-        kernels = get_fwd_splitkv_combine_blobs(kernel_filter, receipt)
+        _, splitkv_kernels = get_fwd_splitkv_blobs(kernel_filter, receipt, mask_impl, manifest)
+        kernels = get_fwd_splitkv_combine_blobs(kernel_filter, receipt, splitkv_kernels, manifest)
         for kernel in kernels:
             f.write(str(file_path.parent / GEN_DIR / kernel.filename) + "\n")
-        _, kernels = get_fwd_splitkv_blobs(kernel_filter, receipt, mask_impl)
-        for kernel in kernels:
+        for kernel in splitkv_kernels:
             f.write(str(file_path.parent / GEN_DIR / kernel.filename) + "\n")
         f.write(str(file_path.parent / GEN_DIR / FMHA_FWD_SPLITKV_API_FILENAME) + "\n")
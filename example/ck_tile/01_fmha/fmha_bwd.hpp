@@ -453,3 +453,18 @@ struct fmha_bwd_traits
     // TODO: padding check is inside this api
 };
 float fmha_bwd(fmha_bwd_traits, fmha_bwd_args, const ck_tile::stream_config&);
+
+// the kernels fmha_bwd() last resolved at a call site, a later call with the same traits and shapes
+// launches them without dispatching again
+struct fmha_bwd_memo
+{
+    using kernel_type = float (*)(const ck_tile::stream_config&, fmha_bwd_args);
+
+    fmha_bwd_traits traits{};
+    ck_tile::index_t seqlen_q = 0;
+    ck_tile::index_t seqlen_k = 0;
+    ck_tile::index_t hdim_q   = 0;
+    ck_tile::index_t hdim_v   = 0;
+    kernel_type kernel        = nullptr; // nullptr: nothing memoized yet
+};
+float fmha_bwd(fmha_bwd_traits, fmha_bwd_args, const ck_tile::stream_config&, fmha_bwd_memo&);
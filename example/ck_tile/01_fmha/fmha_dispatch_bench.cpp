@@ -0,0 +1,129 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+
+// times the host side of fmha_fwd()/fmha_bwd(), linked with the no-op kernels that
+// generate.py --stub_kernels writes, so a call costs only the trait dispatch
+
+#if CK_TILE_FMHA_DISPATCH_BENCH_BWD
+#include "fmha_bwd.hpp"
+#else
+#include "fmha_fwd.hpp"
+#endif
+#include "ck_tile/host.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#if CK_TILE_FMHA_DISPATCH_BENCH_BWD
+using fmha_traits = fmha_bwd_traits;
+using fmha_args   = fmha_bwd_args;
+using fmha_memo   = fmha_bwd_memo;
+
+float fmha_call(fmha_traits t, fmha_args a, const ck_tile::stream_config& s)
+{
+    return fmha_bwd(t, a, s);
+}
+float fmha_call(fmha_traits t, fmha_args a, const ck_tile::stream_config& s, fmha_memo& m)
+{
+    return fmha_bwd(t, a, s, m);
+}
+
+fmha_traits make_traits(const std::string& prec, bool group, mask_enum mask, int hdim)
+{
+    return fmha_traits{
+        hdim, hdim, prec, group, mask, bias_enum::no_bias, false, false, false, false};
+}
+#else
+using fmha_traits = fmha_fwd_traits;
+using fmha_args   = fmha_fwd_args;
+using fmha_memo   = fmha_fwd_memo;
+
+float fmha_call(fmha_traits t, fmha_args a, const ck_tile::stream_config& s)
+{
+    return fmha_fwd(t, a, s);
+}
+float fmha_call(fmha_traits t, fmha_args a, const ck_tile::stream_config& s, fmha_memo& m)
+{
+    return fmha_fwd(t, a, s, m);
+}
+
+fmha_traits make_traits(const std::string& prec, bool group, mask_enum mask, int hdim)
+{
+    return fmha_traits{
+        hdim, hdim, prec, group, true, mask, bias_enum::no_bias, false, false, false};
+}
+#endif
+
+auto create_args(int argc, char* argv[])
+{
+    ck_tile::ArgParser arg_parser;
+    arg_parser.insert("n", "1000000", "calls timed per problem")
+        .insert("prec", "fp16,bf16", "data types, separated by comma");
+
+    bool result = arg_parser.parse(argc, argv);
+    return std::make_tuple(result, arg_parser);
+}
+
+template <typename F>
+double ns_per_call(int n, F f)
+{
+    const auto start = std::chrono::steady_clock::now();
+    for(int i = 0; i < n; ++i)
+        f();
+    const std::chrono::duration<double, std::nano> d = std::chrono::steady_clock::now() - start;
+    return d.count() / n;
+}
+
+int main(int argc, char* argv[])
+{
+    auto [result, arg_parser] = create_args(argc, argv);
+    if(!result)
+        return -1;
+
+    const int n = arg_parser.get_int("n");
+    std::vector<std::string> precs;
+    for(std::string p = arg_parser.get_str("prec") + ","; !p.empty(); p.erase(0, p.find(',') + 1))
+        precs.push_back(p.substr(0, p.find(',')));
+
+    const ck_tile::stream_config s{nullptr, false, 0};
+    for(const auto& prec : precs)
+        for(bool group : {false, true})
+            for(auto mask : {mask_enum::no_mask, mask_enum::mask_top_left})
+                for(int hdim : {64, 128})
+                    for(int seqlen : {1024, 1000})
+                    {
+                        const auto t = make_traits(prec, group, mask, hdim);
+                        fmha_args a{};
+                        a.seqlen_q = seqlen;
+                        a.seqlen_k = seqlen;
+                        a.hdim_q   = hdim;
+                        a.hdim_v   = hdim;
+
+                        if(fmha_call(t, a, s) < 0)
+                        {
+                            std::printf("[%s|%s|mask:%d|d:%d|s:%d] no kernel\n",
+                                        prec.c_str(),
+                                        group ? "group" : "batch",
+                                        static_cast<int>(mask),
+                                        hdim,
+                                        seqlen);
+                            continue;
+                        }
+
+                        const double dispatch = ns_per_call(n, [&] { fmha_call(t, a, s); });
+                        fmha_memo memo;
+                        const double memoized = ns_per_call(n, [&] { fmha_call(t, a, s, memo); });
+                        std::printf("[%s|%s|mask:%d|d:%d|s:%d] dispatch %.1f ns, memoized %.1f ns\n",
+                                    prec.c_str(),
+                                    group ? "group" : "batch",
+                                    static_cast<int>(mask),
+                                    hdim,
+                                    seqlen,
+                                    dispatch,
+                                    memoized);
+                    }
+    return 0;
+}
@@ -126,6 +126,10 @@ auto create_args(int argc, char* argv[])
         .insert("drop_prefs",
                 "0",
                 "seed and offset values are present on GPU; 0 - host, 1 - device/GPU")
+        .insert("s_randval",
+                "0",
+                "validate dropout with the random values stored by the kernel; 0 - regenerate "
+                "them on the host, 1 - store and copy back the [b, h, s, s_k] random values")
         .insert("timer", "gpu", "gpu:gpu timer, cpu:cpu timer")
         .insert(
             "rotary_dim", "0", "RoPE rotary dimension. rotary_dim <= 0 means not apply RoPE at all")
@@ -450,7 +454,7 @@ bool run(const ck_tile::ArgParser& arg_parser)
     bool s_randval = false;
     if(p_drop > 0.0f && do_validation != 0)
     {
-        s_randval = true;
+        s_randval = arg_parser.get_bool("s_randval");
     }
 
     std::string init_method = arg_parser.get_str("init");
@@ -654,8 +658,8 @@ bool run(const ck_tile::ArgParser& arg_parser)
         get_lengths(o_perm, shape_batch, nhead, shape_seqlen_q, hdim_v));
 
     ck_tile::HostTensor<RandValOutputDataType> randval_host(
-        p_drop > 0 ? get_lengths(true, shape_batch, nhead, shape_seqlen_q, max_seqlen_k)
-                   : std::array<ck_tile::index_t, 4>{1, 1, 1, 1});
+        s_randval ? get_lengths(true, shape_batch, nhead, shape_seqlen_q, max_seqlen_k)
+                  : std::array<ck_tile::index_t, 4>{1, 1, 1, 1});
 
     ck_tile::HostTensor<int32_t> block_table_host(
         0 < page_block_size ? std::array<ck_tile::index_t, 2>{batch, max_num_page_blocks / batch}
@@ -1487,7 +1491,7 @@ bool run(const ck_tile::ArgParser& arg_parser)
                 s_host_ref, p_host_ref, p_compute_element_func);
         }
 
-        if(p_drop > 0)
+        if(p_drop > 0 && s_randval)
         {
             ck_tile::HostTensor<RandValOutputDataType> randval_host_ref(
                 {nhead, real_seqlen_q, real_seqlen_k});
@@ -1497,6 +1501,11 @@ bool run(const ck_tile::ArgParser& arg_parser)
             ck_tile::reference_batched_dropout(
                 p_host_ref, randval_host_ref, p_undrop_in_uint8_t, rp_undrop);
         }
+        else if(p_drop > 0)
+        {
+            ck_tile::reference_batched_dropout(
+                p_host_ref, wb, nhead, drop_seed, drop_offset, p_undrop_in_uint8_t, rp_undrop);
+        }
 
         ck_tile::reference_batched_gemm<PDataType, VDataType, OaccDataType, ODataType>(
             p_host_ref,
@@ -793,6 +793,21 @@ struct fmha_fwd_traits
 };
 float fmha_fwd(fmha_fwd_traits, fmha_fwd_args, const ck_tile::stream_config&);
 
+// the kernel fmha_fwd() last resolved at a call site, a later call with the same traits and shapes
+// launches it without dispatching again
+struct fmha_fwd_memo
+{
+    using kernel_type = float (*)(const ck_tile::stream_config&, fmha_fwd_args);
+
+    fmha_fwd_traits traits{};
+    ck_tile::index_t seqlen_q = 0;
+    ck_tile::index_t seqlen_k = 0;
+    ck_tile::index_t hdim_q   = 0;
+    ck_tile::index_t hdim_v   = 0;
+    kernel_type kernel        = nullptr; // nullptr: nothing memoized yet
+};
+float fmha_fwd(fmha_fwd_traits, fmha_fwd_args, const ck_tile::stream_config&, fmha_fwd_memo&);
+
 struct fmha_fwd_splitkv_traits
 {
     int hdim_q;
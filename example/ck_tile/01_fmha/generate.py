@@ -11,11 +11,13 @@ from typing import List, Optional
 
 import codegen.ops
 from codegen.cmake_config import *
+from codegen.manifest import Manifest
 
 
 class HandlerId(IntEnum):
     LIST_BLOBS = 0
     WRITE_BLOBS = 1
+    WRITE_STUB_BLOBS = 2
 
 # inspect all modules under 'codegen.ops' and register API handlers 
 ops = []
@@ -26,11 +28,11 @@ for importer, module_name, _ in pkgutil.iter_modules(codegen.ops.__path__):
 unwanted_prefix = 'fmha_'
 handlers = dict(
     [(op.__name__[len(unwanted_prefix):] if op.__name__.startswith(unwanted_prefix) else op.__name__,
-        (op.list_blobs, op.write_blobs)) for op in ops]
+        (op.list_blobs, op.write_blobs, getattr(op, 'write_stub_blobs', None))) for op in ops]
 )
 assert 0 < len(handlers)
 
-def write_blobs(output_dir: Optional[str], api_list : List[str], kernel_filter : Optional[str], receipt, mask_impl) -> None:
+def write_blobs(output_dir: Optional[str], api_list : List[str], kernel_filter : Optional[str], receipt, mask_impl, stub_kernels = False, manifest : Optional[Manifest] = None) -> None:
     if output_dir is None:
         output_dir = Path(__file__).parent
     else:
@@ -39,11 +41,12 @@ def write_blobs(output_dir: Optional[str], api_list : List[str], kernel_filter :
     output_dir.mkdir(parents=True, exist_ok=True)
 
     for api in api_list:
-        handler = handlers[api][HandlerId.WRITE_BLOBS]
-        handler(output_dir, kernel_filter, receipt, mask_impl)
+        handler = handlers[api][HandlerId.WRITE_STUB_BLOBS if stub_kernels else HandlerId.WRITE_BLOBS]
+        assert handler is not None, f'{api} has no stub kernels'
+        handler(output_dir, kernel_filter, receipt, mask_impl, manifest)
 
 # list all the files that will be generated
-def list_blobs(output_file : Optional[str], api_list : List[str], kernel_filter : Optional[str], receipt, mask_impl) -> None:
+def list_blobs(output_file : Optional[str], api_list : List[str], kernel_filter : Optional[str], receipt, mask_impl, manifest : Optional[Manifest] = None) -> None:
     assert output_file is not None
     file_path = Path(output_file)
 
@@ -52,7 +55,7 @@ def list_blobs(output_file : Optional[str], api_list : List[str], kernel_filter
 
     for api in api_list:
         handler = handlers[api][HandlerId.LIST_BLOBS]
-        handler(file_path, kernel_filter, receipt, mask_impl)
+        handler(file_path, kernel_filter, receipt, mask_impl, manifest)
 
 if __name__ == "__main__":
     parser = argparse.ArgumentParser(
@@ -106,9 +109,31 @@ if __name__ == "__main__":
              "  2: Only generate instance for Flash attention integration"
     )
 
+    parser.add_argument(
+        "--stub_kernels",
+        action='store_true',
+        help="write the API(s) with a no-op for every kernel, to time the host side dispatch"
+    )
+
+    parser.add_argument(
+        "--manifest",
+        required=False,
+        help="json file of the attention configurations served, only the kernels for them are generated\n" + \
+             "  (see codegen/manifest.py)"
+    )
+
+    parser.add_argument(
+        "--manifest_report",
+        required=False,
+        help="write the kernels the manifest dropped, and why, to a file"
+    )
+
     args = parser.parse_args()
     api_list = args.direction.split(',')
+    manifest = Manifest(args.manifest) if args.manifest is not None else None
     if args.list_blobs is not None:
-        list_blobs(args.list_blobs, api_list, args.filter, int(args.receipt), mask_impl=args.mask)
+        list_blobs(args.list_blobs, api_list, args.filter, int(args.receipt), mask_impl=args.mask, manifest=manifest)
     else:
-        write_blobs(args.output_dir, api_list, args.filter, int(args.receipt), mask_impl=args.mask)
+        write_blobs(args.output_dir, api_list, args.filter, int(args.receipt), mask_impl=args.mask, stub_kernels=args.stub_kernels, manifest=manifest)
+    if manifest is not None:
+        manifest.write_report(args.manifest_report)
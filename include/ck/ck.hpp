@@ -6,7 +6,9 @@
 #include "ck/config.h"
 #include "ck/utility/env.hpp"
 
-#ifndef CK_DONT_USE_HIP_RUNTIME_HEADERS
+#if defined(CK_USE_MOCK_HIP_RUNTIME)
+#include "ck/host_utility/mock_hip_runtime.hpp"
+#elif !defined(CK_DONT_USE_HIP_RUNTIME_HEADERS)
 #include "hip/hip_runtime.h"
 #include "hip/hip_fp16.h"
 #endif
@@ -1,16 +1,42 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2018-2023, Advanced Micro Devices, Inc. All rights reserved.
+// Copyright (c) 2018-2025, Advanced Micro Devices, Inc. All rights reserved.
 
 #pragma once
 
 #include <string>
 #include <map>
-#include <hip/hip_runtime.h>
+#include "ck/host_utility/hip_runtime.hpp"
 
 namespace ck {
 
+namespace detail {
+
+inline std::string& get_device_name_override()
+{
+    static std::string device_name;
+    return device_name;
+}
+
+} // namespace detail
+
+// Make get_device_name() report device_name instead of querying the GPU, an empty name restores
+// the query. This is for host-only tools such as ckHostOverheadBenchmark, which run the argument
+// checks of a device that is not present. It affects the whole process and is not thread-safe, so
+// set it once at startup.
+inline void set_device_name_override(const std::string& device_name)
+{
+    detail::get_device_name_override() = device_name;
+}
+
+inline bool has_device_name_override() { return !detail::get_device_name_override().empty(); }
+
 inline std::string get_device_name()
 {
+    if(has_device_name_override())
+    {
+        return detail::get_device_name_override();
+    }
+
     hipDeviceProp_t props{};
     int device;
     auto status = hipGetDevice(&device);
@@ -10,6 +10,7 @@
 #include "ck/ck.hpp"
 #include "ck/stream_config.hpp"
 #include "ck/host_utility/hip_check_error.hpp"
+#include "ck/host_utility/kernel_launch.hpp"
 #include "ck/utility/flush_icache.hpp"
 namespace ck {
 namespace utility {
@@ -265,6 +266,26 @@ float launch_and_time_kernel_with_preprocess(const StreamConfig& stream_config,
         {
             return 0.0;
         }
+        if(stream_config.timing_stats_ != nullptr)
+        {
+            auto run_kernel = [&] {
+                kernel<<<grid_dim, block_dim, lds_byte, stream_config.stream_id_>>>(gemm_args,
+                                                                                     args...);
+                hip_check_error(hipGetLastError());
+            };
+
+            if constexpr(TimePreprocess)
+            {
+                return ck::timing::MeasureKernel(stream_config, [] {}, [&] {
+                    preprocess();
+                    run_kernel();
+                });
+            }
+            else
+            {
+                return ck::timing::MeasureKernel(stream_config, preprocess, run_kernel);
+            }
+        }
         if(ck::EnvIsEnabled(CK_ENV(CK_LOGGING)))
         {
             printf("Start running %d times...\n", nrepeat);
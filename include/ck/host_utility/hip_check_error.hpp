@@ -4,7 +4,8 @@
 #pragma once
 
 #include <sstream>
-#include <hip/hip_runtime.h>
+
+#include "ck/host_utility/hip_runtime.hpp"
 
 // To be removed, which really does not tell the location of failed HIP functional call
 inline void hip_check_error(hipError_t x)
@@ -0,0 +1,15 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+// The host utilities get the HIP runtime from here, so host-only builds can swap in the
+// stand-in of mock_hip_runtime.hpp with -DCK_USE_MOCK_HIP_RUNTIME, and have the launched kernels
+// run by simt_emulator.hpp with -DCK_USE_SIMT_EMULATOR in addition
+#if defined(CK_USE_MOCK_HIP_RUNTIME) && defined(CK_USE_SIMT_EMULATOR)
+#include "ck/host_utility/simt_emulator.hpp"
+#elif defined(CK_USE_MOCK_HIP_RUNTIME)
+#include "ck/host_utility/mock_hip_runtime.hpp"
+#else
+#include <hip/hip_runtime.h>
+#endif
@@ -0,0 +1,183 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+#include "ck/host_utility/hip_check_error.hpp"
+
+namespace ck {
+
+// Memoizes a host side validity check by shape signature (lengths, strides, ...). A device
+// instance keeps one static cache so that arguments with shapes it has already seen, e.g.
+// the groups of a grouped GEMM rebuilt every step, skip the check.
+class ValidityCache
+{
+    public:
+    using Key = std::vector<std::int64_t>;
+
+    explicit ValidityCache(std::size_t max_entries = 4096) : max_entries_(max_entries) {}
+
+    template <typename Check>
+    bool Get(const Key& key, Check&& check)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+
+            const auto it = results_.find(key);
+            if(it != results_.end())
+            {
+                ++num_hits_;
+                return it->second;
+            }
+        }
+
+        // run the check unlocked, a racing thread computes the same result at worst
+        const bool valid = check();
+
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        if(results_.size() >= max_entries_)
+            results_.clear();
+
+        results_.emplace(key, valid);
+        ++num_misses_;
+
+        return valid;
+    }
+
+    void Clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        results_.clear();
+        num_hits_   = 0;
+        num_misses_ = 0;
+    }
+
+    std::size_t GetNumEntries() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return results_.size();
+    }
+
+    std::size_t GetNumHits() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return num_hits_;
+    }
+
+    std::size_t GetNumMisses() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return num_misses_;
+    }
+
+    private:
+    mutable std::mutex mutex_;
+    std::map<Key, bool> results_;
+    std::size_t max_entries_;
+    std::size_t num_hits_   = 0;
+    std::size_t num_misses_ = 0;
+};
+
+// Keeps a host copy of what was last uploaded to a device argument buffer, so that uploading
+// a mostly unchanged array again (new data pointers, a few new M) only copies the elements
+// that differ. Runs of changed elements closer than merge_gap_byte are copied with a single
+// hipMemcpyAsync, as a few extra bytes are cheaper than an extra API call.
+//
+// The uploader assumes that it is the only writer of the buffer; call Invalidate() if
+// something else writes to it.
+class KernelArgUploader
+{
+    public:
+    explicit KernelArgUploader(std::size_t merge_gap_byte = 1024) : merge_gap_byte_(merge_gap_byte)
+    {
+    }
+
+    // Copy count elements from p_host to p_dev, returns the number of bytes copied
+    template <typename T>
+    std::size_t Upload(void* p_dev, const T* p_host, std::size_t count, hipStream_t stream)
+    {
+        static_assert(std::is_trivially_copyable<T>::value,
+                      "kernel arguments must be trivially copyable");
+
+        const std::size_t size_byte = count * sizeof(T);
+        const auto* p_src           = reinterpret_cast<const unsigned char*>(p_host);
+        auto* p_dst                 = static_cast<unsigned char*>(p_dev);
+
+        if(size_byte == 0)
+            return 0;
+
+        // new buffer or new size, nothing is known about the device content
+        if(p_dev != p_dev_ || shadow_.size() != size_byte)
+        {
+            hip_check_error(
+                hipMemcpyAsync(p_dst, p_src, size_byte, hipMemcpyHostToDevice, stream));
+
+            shadow_.assign(p_src, p_src + size_byte);
+            p_dev_ = p_dev;
+
+            return size_byte;
+        }
+
+        const auto is_changed = [&](std::size_t i) {
+            return std::memcmp(&shadow_[i * sizeof(T)], p_src + i * sizeof(T), sizeof(T)) != 0;
+        };
+
+        const std::size_t merge_gap = merge_gap_byte_ / sizeof(T);
+
+        std::size_t copied_byte = 0;
+
+        for(std::size_t i = 0; i < count;)
+        {
+            if(!is_changed(i))
+            {
+                ++i;
+                continue;
+            }
+
+            // [i, end) is the run to copy, extended over short unchanged gaps
+            std::size_t end = i + 1;
+            for(std::size_t j = end; j < count && j <= end + merge_gap; ++j)
+            {
+                if(is_changed(j))
+                    end = j + 1;
+            }
+
+            const std::size_t offset = i * sizeof(T);
+            const std::size_t length = (end - i) * sizeof(T);
+
+            hip_check_error(hipMemcpyAsync(
+                p_dst + offset, p_src + offset, length, hipMemcpyHostToDevice, stream));
+
+            std::memcpy(&shadow_[offset], p_src + offset, length);
+            copied_byte += length;
+
+            i = end;
+        }
+
+        return copied_byte;
+    }
+
+    void Invalidate()
+    {
+        p_dev_ = nullptr;
+        shadow_.clear();
+    }
+
+    const void* GetDeviceBuffer() const { return p_dev_; }
+
+    private:
+    const void* p_dev_ = nullptr;
+    std::vector<unsigned char> shadow_;
+    std::size_t merge_gap_byte_;
+};
+
+} // namespace ck
@@ -3,11 +3,130 @@
 
 #pragma once
 
-#include <hip/hip_runtime.h>
+#include "ck/host_utility/hip_runtime.hpp"
 
 #include "ck/ck.hpp"
 #include "ck/stream_config.hpp"
 #include "ck/host_utility/hip_check_error.hpp"
+#include "ck/host_utility/timing_statistics.hpp"
+
+namespace ck {
+
+// kernel<<<grid_dim, block_dim, lds_byte, stream>>>(args...); with the mock runtime the launch is
+// only recorded, unless the SIMT emulator runs it
+template <typename F, typename... Args>
+inline void enqueue_kernel(F kernel,
+                           dim3 grid_dim,
+                           dim3 block_dim,
+                           std::size_t lds_byte,
+                           hipStream_t stream,
+                           Args... args)
+{
+#ifdef CK_USE_MOCK_HIP_RUNTIME
+    ck::mock::Runtime::Get().Launch(kernel, grid_dim, block_dim, lds_byte, stream);
+#ifdef CK_USE_SIMT_EMULATOR
+    ck::simt::Launch(grid_dim, block_dim, lds_byte, kernel, args...);
+#else
+    ((void)args, ...);
+#endif
+#else
+    kernel<<<grid_dim, block_dim, lds_byte, stream>>>(args...);
+#endif
+}
+
+namespace timing {
+
+// Timer for MeasureIterations(): one event pair per sample, read back once per batch
+struct HipEventTimer
+{
+    explicit HipEventTimer(hipStream_t stream) : stream_(stream) {}
+
+    HipEventTimer(const HipEventTimer&) = delete;
+    HipEventTimer& operator=(const HipEventTimer&) = delete;
+
+    ~HipEventTimer()
+    {
+        for(auto event : events_)
+            (void)hipEventDestroy(event);
+    }
+
+    void Start() { Record(); }
+
+    void Stop() { Record(); }
+
+    std::vector<float> Collect()
+    {
+        std::vector<float> samples;
+
+        if(num_recorded_ == 0)
+            return samples;
+
+        hip_check_error(hipEventSynchronize(events_[num_recorded_ - 1]));
+
+        for(std::size_t i = 0; i + 1 < num_recorded_; i += 2)
+        {
+            float ms = 0;
+            hip_check_error(hipEventElapsedTime(&ms, events_[i], events_[i + 1]));
+            samples.push_back(ms);
+        }
+
+        num_recorded_ = 0;
+
+        return samples;
+    }
+
+    private:
+    void Record()
+    {
+        if(num_recorded_ == events_.size())
+        {
+            hipEvent_t event;
+            hip_check_error(hipEventCreate(&event));
+            events_.push_back(event);
+        }
+        hip_check_error(hipEventRecord(events_[num_recorded_++], stream_));
+    }
+
+    hipStream_t stream_;
+    std::vector<hipEvent_t> events_;
+    std::size_t num_recorded_ = 0;
+};
+
+inline TimingConfig MakeTimingConfig(const StreamConfig& stream_config)
+{
+    return TimingConfig{
+        stream_config.nrepeat_, stream_config.max_nrepeat_, stream_config.target_rel_ci_};
+}
+
+// per-launch timing of `untimed(); timed();` reporting into stream_config.timing_stats_
+template <typename Untimed, typename Timed>
+float MeasureKernel(const StreamConfig& stream_config, Untimed&& untimed, Timed&& timed)
+{
+    HipEventTimer timer{stream_config.stream_id_};
+
+    hip_check_error(hipDeviceSynchronize());
+
+    *stream_config.timing_stats_ =
+        MeasureIterations(timer, untimed, timed, MakeTimingConfig(stream_config));
+
+    const auto& stats = *stream_config.timing_stats_;
+
+    if(ck::EnvIsEnabled(CK_ENV(CK_LOGGING)))
+    {
+        printf("Timed %zu launches: median %f ms, p10 %f ms, p90 %f ms, cv %f, %d outliers\n",
+               stats.samples_.size(),
+               stats.median_,
+               stats.p10_,
+               stats.p90_,
+               stats.cv_,
+               stats.num_outliers_);
+    }
+
+    return stats.median_;
+}
+
+} // namespace timing
+} // namespace ck
 
 template <typename... Args, typename F>
 float launch_and_time_kernel(const StreamConfig& stream_config,
@@ -36,10 +155,20 @@ float launch_and_time_kernel(const StreamConfig& stream_config,
         // warm up
         for(int i = 0; i < stream_config.cold_niters_; ++i)
         {
-            kernel<<<grid_dim, block_dim, lds_byte, stream_config.stream_id_>>>(args...);
+            ck::enqueue_kernel(
+                kernel, grid_dim, block_dim, lds_byte, stream_config.stream_id_, args...);
             hip_check_error(hipGetLastError());
         }
 
+        if(stream_config.timing_stats_ != nullptr)
+        {
+            return ck::timing::MeasureKernel(stream_config, [] {}, [&] {
+                ck::enqueue_kernel(
+                    kernel, grid_dim, block_dim, lds_byte, stream_config.stream_id_, args...);
+                hip_check_error(hipGetLastError());
+            });
+        }
+
         const int nrepeat = stream_config.nrepeat_;
         if(ck::EnvIsEnabled(CK_ENV(CK_LOGGING)))
         {
@@ -55,7 +184,8 @@ float launch_and_time_kernel(const StreamConfig& stream_config,
 
         for(int i = 0; i < nrepeat; ++i)
         {
-            kernel<<<grid_dim, block_dim, lds_byte, stream_config.stream_id_>>>(args...);
+            ck::enqueue_kernel(
+                kernel, grid_dim, block_dim, lds_byte, stream_config.stream_id_, args...);
             hip_check_error(hipGetLastError());
         }
 
@@ -73,13 +203,14 @@ float launch_and_time_kernel(const StreamConfig& stream_config,
     }
     else
     {
-        kernel<<<grid_dim, block_dim, lds_byte, stream_config.stream_id_>>>(args...);
+        ck::enqueue_kernel(
+            kernel, grid_dim, block_dim, lds_byte, stream_config.stream_id_, args...);
         hip_check_error(hipGetLastError());
 
         return 0;
     }
 #else
-    kernel<<<grid_dim, block_dim, lds_byte, stream_config.stream_id_>>>(args...);
+    ck::enqueue_kernel(kernel, grid_dim, block_dim, lds_byte, stream_config.stream_id_, args...);
     hip_check_error(hipGetLastError());
 
     return 0;
@@ -115,10 +246,21 @@ float launch_and_time_kernel_with_preprocess(const StreamConfig& stream_config,
         preprocess();
         for(int i = 0; i < stream_config.cold_niters_; ++i)
         {
-            kernel<<<grid_dim, block_dim, lds_byte, stream_config.stream_id_>>>(args...);
+            ck::enqueue_kernel(
+                kernel, grid_dim, block_dim, lds_byte, stream_config.stream_id_, args...);
             hip_check_error(hipGetLastError());
         }
 
+        if(stream_config.timing_stats_ != nullptr)
+        {
+            return ck::timing::MeasureKernel(stream_config, [] {}, [&] {
+                preprocess();
+                ck::enqueue_kernel(
+                    kernel, grid_dim, block_dim, lds_byte, stream_config.stream_id_, args...);
+                hip_check_error(hipGetLastError());
+            });
+        }
+
         const int nrepeat = stream_config.nrepeat_;
         if(ck::EnvIsEnabled(CK_ENV(CK_LOGGING)))
         {
@@ -135,7 +277,8 @@ float launch_and_time_kernel_with_preprocess(const StreamConfig& stream_config,
         for(int i = 0; i < nrepeat; ++i)
         {
             preprocess();
-            kernel<<<grid_dim, block_dim, lds_byte, stream_config.stream_id_>>>(args...);
+            ck::enqueue_kernel(
+                kernel, grid_dim, block_dim, lds_byte, stream_config.stream_id_, args...);
             hip_check_error(hipGetLastError());
         }
 
@@ -154,13 +297,14 @@ float launch_and_time_kernel_with_preprocess(const StreamConfig& stream_config,
     else
     {
         preprocess();
-        kernel<<<grid_dim, block_dim, lds_byte, stream_config.stream_id_>>>(args...);
+        ck::enqueue_kernel(
+            kernel, grid_dim, block_dim, lds_byte, stream_config.stream_id_, args...);
         hip_check_error(hipGetLastError());
 
         return 0;
     }
 #else
-    kernel<<<grid_dim, block_dim, lds_byte, stream_config.stream_id_>>>(args...);
+    ck::enqueue_kernel(kernel, grid_dim, block_dim, lds_byte, stream_config.stream_id_, args...);
     hip_check_error(hipGetLastError());
 
     return 0;
@@ -0,0 +1,523 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+// Host-only stand-in for the part of the HIP runtime used by the CK host utilities
+// (StreamConfig, launch_and_time_kernel, DeviceMem, device properties). It is selected with
+// -DCK_USE_MOCK_HIP_RUNTIME and lets the host side logic be built with a plain C++ compiler,
+// unit-tested and benchmarked on machines without a GPU:
+//  - device memory is malloc-backed and can be read directly on the host
+//  - kernels are not executed, every launch is recorded with its grid/block/LDS metadata
+//  - streams carry a virtual clock that launches advance by a configurable cost model, events
+//    read that clock, so kernel timing reports deterministic times
+//  - the device properties are configurable and default to a gfx942 with 304 CUs
+// Everything is synchronous.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
+
+#ifndef __host__
+#define __host__
+#endif
+#ifndef __device__
+#define __device__
+#endif
+#ifndef __global__
+#define __global__
+#endif
+#ifndef __launch_bounds__
+#define __launch_bounds__(...)
+#endif
+
+enum hipError_t
+{
+    hipSuccess                    = 0,
+    hipErrorInvalidValue          = 1,
+    hipErrorOutOfMemory           = 2,
+    hipErrorInvalidDevice         = 101,
+    hipErrorInvalidResourceHandle = 400,
+    hipErrorNotSupported          = 801,
+};
+
+enum hipMemcpyKind
+{
+    hipMemcpyHostToHost     = 0,
+    hipMemcpyHostToDevice   = 1,
+    hipMemcpyDeviceToHost   = 2,
+    hipMemcpyDeviceToDevice = 3,
+    hipMemcpyDefault        = 4,
+};
+
+struct dim3
+{
+    uint32_t x;
+    uint32_t y;
+    uint32_t z;
+
+    constexpr dim3(uint32_t x_ = 1, uint32_t y_ = 1, uint32_t z_ = 1) : x(x_), y(y_), z(z_) {}
+};
+
+struct hipDeviceProp_t
+{
+    char name[256];
+    char gcnArchName[256];
+    std::size_t totalGlobalMem;
+    std::size_t sharedMemPerBlock;
+    int warpSize;
+    int maxThreadsPerBlock;
+    int clockRate; // kHz
+    int multiProcessorCount;
+    int l2CacheSize;
+    int maxSharedMemoryPerMultiProcessor;
+    int major;
+    int minor;
+};
+
+struct ihipStream_t
+{
+    float clock_ms_ = 0.f;
+};
+using hipStream_t = ihipStream_t*;
+
+struct ihipEvent_t
+{
+    float time_ms_ = 0.f;
+    bool recorded_ = false;
+};
+using hipEvent_t = ihipEvent_t*;
+
+namespace ck {
+namespace mock {
+
+struct LaunchRecord
+{
+    // address and signature of the launched function
+    const void* kernel_;
+    std::string signature_;
+
+    dim3 grid_dim_;
+    dim3 block_dim_;
+    std::size_t lds_byte_;
+    hipStream_t stream_;
+
+    // virtual time of the launch on its stream
+    float start_ms_;
+    float duration_ms_;
+
+    std::size_t GetNumBlocks() const
+    {
+        return std::size_t{grid_dim_.x} * grid_dim_.y * grid_dim_.z;
+    }
+    std::size_t GetBlockSize() const
+    {
+        return std::size_t{block_dim_.x} * block_dim_.y * block_dim_.z;
+    }
+};
+
+// Duration in ms charged to the virtual clock for a launch
+using LaunchCostModel = std::function<float(const LaunchRecord&)>;
+
+class Runtime
+{
+    public:
+    static Runtime& Get()
+    {
+        static Runtime runtime;
+        return runtime;
+    }
+
+    Runtime(const Runtime&) = delete;
+    Runtime& operator=(const Runtime&) = delete;
+
+    // forget launches, clocks and configuration; live allocations are kept
+    void Reset()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        launches_.clear();
+        default_stream_ = ihipStream_t{};
+        props_          = MakeDefaultProperties();
+        cost_model_     = DefaultCostModel;
+        peak_allocated_ = allocated_;
+    }
+
+    void SetDeviceProperties(const hipDeviceProp_t& props)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        props_ = props;
+    }
+
+    hipDeviceProp_t GetDeviceProperties() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return props_;
+    }
+
+    void SetArchName(const std::string& arch, int num_cu)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::snprintf(props_.gcnArchName, sizeof(props_.gcnArchName), "%s", arch.c_str());
+        props_.multiProcessorCount = num_cu;
+    }
+
+    void SetLaunchCostModel(LaunchCostModel cost_model)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        cost_model_ = cost_model ? std::move(cost_model) : LaunchCostModel(DefaultCostModel);
+    }
+
+    std::vector<LaunchRecord> GetLaunches() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return launches_;
+    }
+
+    std::size_t GetNumLaunches() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return launches_.size();
+    }
+
+    void ClearLaunches()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        launches_.clear();
+    }
+
+    std::size_t GetAllocatedBytes() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return allocated_;
+    }
+
+    std::size_t GetPeakAllocatedBytes() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return peak_allocated_;
+    }
+
+    std::size_t GetNumAllocations() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return allocations_.size();
+    }
+
+    float GetClock(hipStream_t stream = nullptr)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return Stream(stream).clock_ms_;
+    }
+
+    // implementation of the runtime API below
+
+    hipError_t Malloc(void** ptr, std::size_t size)
+    {
+        if(ptr == nullptr)
+            return hipErrorInvalidValue;
+
+        *ptr = nullptr;
+        if(size == 0)
+            return hipSuccess;
+
+        // same alignment as hipMalloc
+        constexpr std::size_t alignment = 256;
+        void* p = std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+        if(p == nullptr)
+            return hipErrorOutOfMemory;
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        allocations_.emplace(p, size);
+        allocated_ += size;
+        peak_allocated_ = std::max(peak_allocated_, allocated_);
+
+        *ptr = p;
+        return hipSuccess;
+    }
+
+    hipError_t Free(void* ptr)
+    {
+        if(ptr == nullptr)
+            return hipSuccess;
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = allocations_.find(ptr);
+            if(it == allocations_.end())
+                return hipErrorInvalidValue;
+            allocated_ -= it->second;
+            allocations_.erase(it);
+        }
+        std::free(ptr);
+        return hipSuccess;
+    }
+
+    template <typename F>
+    void Launch(F kernel, dim3 grid_dim, dim3 block_dim, std::size_t lds_byte, hipStream_t stream)
+    {
+        const void* address = nullptr;
+        if constexpr(std::is_pointer_v<F>)
+            address = reinterpret_cast<const void*>(kernel);
+
+        LaunchRecord record{address,
+                            typeid(F).name(),
+                            grid_dim,
+                            block_dim,
+                            lds_byte,
+                            stream,
+                            0.f,
+                            0.f};
+
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        auto& s             = Stream(stream);
+        record.start_ms_    = s.clock_ms_;
+        record.duration_ms_ = cost_model_(record);
+        s.clock_ms_ += record.duration_ms_;
+
+        launches_.push_back(std::move(record));
+    }
+
+    void Record(hipEvent_t event, hipStream_t stream)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        event->time_ms_  = Stream(stream).clock_ms_;
+        event->recorded_ = true;
+    }
+
+    private:
+    Runtime() : props_(MakeDefaultProperties()), cost_model_(DefaultCostModel) {}
+
+    static hipDeviceProp_t MakeDefaultProperties()
+    {
+        hipDeviceProp_t props{};
+        std::snprintf(props.name, sizeof(props.name), "%s", "CK mock device");
+        std::snprintf(props.gcnArchName, sizeof(props.gcnArchName), "%s", "gfx942:sramecc+:xnack-");
+        props.totalGlobalMem                   = std::size_t{192} << 30;
+        props.sharedMemPerBlock                = 64 * 1024;
+        props.warpSize                         = 64;
+        props.maxThreadsPerBlock               = 1024;
+        props.clockRate                        = 2100000;
+        props.multiProcessorCount              = 304;
+        props.l2CacheSize                      = 4 * 1024 * 1024;
+        props.maxSharedMemoryPerMultiProcessor = 64 * 1024;
+        props.major                            = 9;
+        props.minor                            = 4;
+        return props;
+    }
+
+    // a fixed launch latency
+    static float DefaultCostModel(const LaunchRecord&) { return 0.005f; }
+
+    ihipStream_t& Stream(hipStream_t stream) { return stream ? *stream : default_stream_; }
+
+    mutable std::mutex mutex_;
+
+    hipDeviceProp_t props_;
+    LaunchCostModel cost_model_;
+
+    ihipStream_t default_stream_;
+    std::vector<LaunchRecord> launches_;
+
+    std::unordered_map<void*, std::size_t> allocations_;
+    std::size_t allocated_      = 0;
+    std::size_t peak_allocated_ = 0;
+};
+
+inline hipError_t& LastError()
+{
+    static thread_local hipError_t error = hipSuccess;
+    return error;
+}
+
+inline hipError_t SetLastError(hipError_t error)
+{
+    if(error != hipSuccess)
+        LastError() = error;
+    return error;
+}
+
+} // namespace mock
+} // namespace ck
+
+inline const char* hipGetErrorString(hipError_t error)
+{
+    switch(error)
+    {
+    case hipSuccess: return "hipSuccess";
+    case hipErrorInvalidValue: return "hipErrorInvalidValue";
+    case hipErrorOutOfMemory: return "hipErrorOutOfMemory";
+    case hipErrorInvalidDevice: return "hipErrorInvalidDevice";
+    case hipErrorInvalidResourceHandle: return "hipErrorInvalidResourceHandle";
+    case hipErrorNotSupported: return "hipErrorNotSupported";
+    }
+    return "unknown mock HIP error";
+}
+
+inline hipError_t hipGetLastError()
+{
+    const hipError_t error = ck::mock::LastError();
+    ck::mock::LastError()  = hipSuccess;
+    return error;
+}
+
+inline hipError_t hipPeekAtLastError() { return ck::mock::LastError(); }
+
+inline hipError_t hipGetDeviceCount(int* count)
+{
+    if(count == nullptr)
+        return ck::mock::SetLastError(hipErrorInvalidValue);
+    *count = 1;
+    return hipSuccess;
+}
+
+inline hipError_t hipGetDevice(int* device)
+{
+    if(device == nullptr)
+        return ck::mock::SetLastError(hipErrorInvalidValue);
+    *device = 0;
+    return hipSuccess;
+}
+
+inline hipError_t hipSetDevice(int device)
+{
+    return device == 0 ? hipSuccess : ck::mock::SetLastError(hipErrorInvalidDevice);
+}
+
+inline hipError_t hipGetDeviceProperties(hipDeviceProp_t* props, int device)
+{
+    if(props == nullptr)
+        return ck::mock::SetLastError(hipErrorInvalidValue);
+    if(device != 0)
+        return ck::mock::SetLastError(hipErrorInvalidDevice);
+    *props = ck::mock::Runtime::Get().GetDeviceProperties();
+    return hipSuccess;
+}
+
+inline hipError_t hipDeviceSynchronize() { return hipSuccess; }
+
+inline hipError_t hipMalloc(void** ptr, std::size_t size)
+{
+    return ck::mock::SetLastError(ck::mock::Runtime::Get().Malloc(ptr, size));
+}
+
+template <typename T>
+hipError_t hipMalloc(T** ptr, std::size_t size)
+{
+    return hipMalloc(reinterpret_cast<void**>(ptr), size);
+}
+
+inline hipError_t hipFree(void* ptr)
+{
+    return ck::mock::SetLastError(ck::mock::Runtime::Get().Free(ptr));
+}
+
+inline hipError_t hipMemcpy(void* dst, const void* src, std::size_t size, hipMemcpyKind)
+{
+    if(size == 0)
+        return hipSuccess;
+    if(dst == nullptr || src == nullptr)
+        return ck::mock::SetLastError(hipErrorInvalidValue);
+    std::memmove(dst, src, size);
+    return hipSuccess;
+}
+
+inline hipError_t
+hipMemcpyAsync(void* dst, const void* src, std::size_t size, hipMemcpyKind kind, hipStream_t)
+{
+    return hipMemcpy(dst, src, size, kind);
+}
+
+inline hipError_t hipMemset(void* dst, int value, std::size_t size)
+{
+    if(size == 0)
+        return hipSuccess;
+    if(dst == nullptr)
+        return ck::mock::SetLastError(hipErrorInvalidValue);
+    std::memset(dst, value, size);
+    return hipSuccess;
+}
+
+inline hipError_t hipMemsetAsync(void* dst, int value, std::size_t size, hipStream_t)
+{
+    return hipMemset(dst, value, size);
+}
+
+inline hipError_t hipStreamCreate(hipStream_t* stream)
+{
+    if(stream == nullptr)
+        return ck::mock::SetLastError(hipErrorInvalidValue);
+    *stream = new ihipStream_t{};
+    return hipSuccess;
+}
+
+inline hipError_t hipStreamDestroy(hipStream_t stream)
+{
+    delete stream;
+    return hipSuccess;
+}
+
+inline hipError_t hipStreamSynchronize(hipStream_t) { return hipSuccess; }
+
+// every CU of the device is available to every stream
+inline hipError_t hipExtStreamGetCUMask(hipStream_t, uint32_t cu_mask_size, uint32_t* cu_mask)
+{
+    if(cu_mask == nullptr)
+        return ck::mock::SetLastError(hipErrorInvalidValue);
+
+    const int num_cu = ck::mock::Runtime::Get().GetDeviceProperties().multiProcessorCount;
+    for(uint32_t i = 0; i < cu_mask_size; ++i)
+    {
+        const int bits = std::clamp(num_cu - static_cast<int>(i) * 32, 0, 32);
+        cu_mask[i]     = bits == 32 ? 0xffffffffu : (1u << bits) - 1u;
+    }
+    return hipSuccess;
+}
+
+inline hipError_t hipEventCreate(hipEvent_t* event)
+{
+    if(event == nullptr)
+        return ck::mock::SetLastError(hipErrorInvalidValue);
+    *event = new ihipEvent_t{};
+    return hipSuccess;
+}
+
+inline hipError_t hipEventDestroy(hipEvent_t event)
+{
+    delete event;
+    return hipSuccess;
+}
+
+inline hipError_t hipEventRecord(hipEvent_t event, hipStream_t stream = nullptr)
+{
+    if(event == nullptr)
+        return ck::mock::SetLastError(hipErrorInvalidResourceHandle);
+    ck::mock::Runtime::Get().Record(event, stream);
+    return hipSuccess;
+}
+
+inline hipError_t hipEventSynchronize(hipEvent_t event)
+{
+    return event == nullptr ? ck::mock::SetLastError(hipErrorInvalidResourceHandle) : hipSuccess;
+}
+
+inline hipError_t hipEventElapsedTime(float* ms, hipEvent_t start, hipEvent_t stop)
+{
+    if(ms == nullptr)
+        return ck::mock::SetLastError(hipErrorInvalidValue);
+    if(start == nullptr || stop == nullptr || !start->recorded_ || !stop->recorded_)
+        return ck::mock::SetLastError(hipErrorInvalidResourceHandle);
+    *ms = stop->time_ms_ - start->time_ms_;
+    return hipSuccess;
+}
@@ -0,0 +1,591 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+// Host SIMT emulator, the device side counterpart of mock_hip_runtime.hpp. It is selected with
+// -DCK_USE_SIMT_EMULATOR (on top of -DCK_USE_MOCK_HIP_RUNTIME) and runs the body of a kernel on
+// the host for every block and lane, so that block-level code (LDS layouts, tile windows, sweeps,
+// warp level exchanges) can be functionally tested on machines without a GPU:
+//  - every lane is a fiber with its own stack; the lanes of a block run in lock-step up to the
+//    next barrier, blocks run one after another, each on a host thread of its own
+//  - threadIdx/blockIdx/blockDim/gridDim/warpSize, __syncthreads, __lane_id and __shfl are
+//    provided on top of the lane being run, __shared__ variables are shared by the lanes of a
+//    block and start zeroed in every block, dynamic LDS is a per-block arena
+//  - buffer loads/stores, warp shuffles/ballots and MFMA have scalar/reference fallbacks
+//  - the accessors below count the global and LDS traffic, barriers and MFMA of every block
+// Device code reads host memory directly, allocations of the mock runtime included.
+//
+// Only code written against the HIP built-ins above and the emulator API runs. ck_tile and the
+// wrapper reach memory and the matrix cores through LLVM buffer/MFMA intrinsics and inline asm,
+// which have no host fallback: their kernels cannot run under the emulator.
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <ucontext.h>
+
+#include "ck/host_utility/mock_hip_runtime.hpp"
+
+#ifndef __shared__
+// the lanes of a block share the host thread running it, and every block gets a fresh one
+#define __shared__ static thread_local
+#endif
+
+namespace ck {
+namespace simt {
+
+inline constexpr int kWarpSize = 64;
+
+// bytes a lane can exchange with its warp in one shuffle/MFMA
+inline constexpr std::size_t kMaxExchangeByte = 64;
+
+struct Counters
+{
+    std::size_t global_read_byte_  = 0;
+    std::size_t global_write_byte_ = 0;
+    std::size_t lds_read_byte_     = 0;
+    std::size_t lds_write_byte_    = 0;
+    std::size_t num_barriers_      = 0; // block-wide
+    std::size_t num_shuffles_      = 0; // per warp
+    std::size_t num_mfmas_         = 0; // per warp
+
+    Counters& operator+=(const Counters& other)
+    {
+        global_read_byte_ += other.global_read_byte_;
+        global_write_byte_ += other.global_write_byte_;
+        lds_read_byte_ += other.lds_read_byte_;
+        lds_write_byte_ += other.lds_write_byte_;
+        num_barriers_ += other.num_barriers_;
+        num_shuffles_ += other.num_shuffles_;
+        num_mfmas_ += other.num_mfmas_;
+        return *this;
+    }
+};
+
+struct LaunchStats
+{
+    dim3 grid_dim_;
+    dim3 block_dim_;
+    std::size_t lds_byte_;
+
+    // in the order of the linear block id
+    std::vector<Counters> blocks_;
+
+    Counters GetTotal() const
+    {
+        Counters total;
+        for(const auto& block : blocks_)
+            total += block;
+        return total;
+    }
+};
+
+struct Options
+{
+    // of every lane, all lanes of a block are allocated at once
+    std::size_t stack_byte_ = 64 * 1024;
+    // dynamic LDS starts with this pattern, as on hardware it starts with garbage
+    std::uint8_t lds_fill_ = 0xcd;
+};
+
+inline constexpr std::size_t kMinStackByte = 16 * 1024;
+
+namespace detail {
+
+inline Options& DefaultOptions()
+{
+    static Options options;
+    return options;
+}
+
+} // namespace detail
+
+// the options of the launches not given any, those of ck::enqueue_kernel included
+inline const Options& GetDefaultOptions() { return detail::DefaultOptions(); }
+
+inline void SetDefaultOptions(const Options& options)
+{
+    if(options.stack_byte_ < kMinStackByte)
+        throw std::invalid_argument("simt emulator: lane stack too small");
+    detail::DefaultOptions() = options;
+}
+
+namespace detail {
+
+enum struct LaneState
+{
+    Ready,
+    AtWarpBarrier,
+    AtBlockBarrier,
+    Done,
+};
+
+struct Lane
+{
+    dim3 thread_idx_;
+    int thread_id_; // linear in the block
+    LaneState state_ = LaneState::Ready;
+    ucontext_t context_;
+};
+
+struct Block
+{
+    dim3 grid_dim_;
+    dim3 block_dim_;
+    dim3 block_idx_;
+
+    std::function<void()> body_;
+    std::vector<Lane> lanes_;
+    std::unique_ptr<char[]> stacks_;
+    Lane* current_ = nullptr;
+    ucontext_t scheduler_;
+
+    std::vector<unsigned char> lds_;
+    std::vector<std::array<unsigned char, kMaxExchangeByte>> exchange_;
+    Counters counters_;
+
+    std::exception_ptr error_;
+};
+
+inline thread_local Block* current_block = nullptr;
+
+inline Block& CurrentBlock()
+{
+    if(current_block == nullptr || current_block->current_ == nullptr)
+        throw std::logic_error("simt emulator: device function called outside of a launch");
+    return *current_block;
+}
+
+inline Lane& CurrentLane() { return *CurrentBlock().current_; }
+
+inline void Yield(LaneState state)
+{
+    auto& block  = CurrentBlock();
+    auto& lane   = *block.current_;
+    lane.state_  = state;
+    swapcontext(&lane.context_, &block.scheduler_);
+}
+
+inline void LaneEntry()
+{
+    auto& block = *current_block;
+    try
+    {
+        block.body_();
+    }
+    catch(...)
+    {
+        if(!block.error_)
+            block.error_ = std::current_exception();
+    }
+    // back to the scheduler through uc_link
+    block.current_->state_ = LaneState::Done;
+}
+
+inline bool IsLive(const Lane& lane) { return lane.state_ != LaneState::Done; }
+
+// releases the barriers all live lanes of their scope have reached, returns whether any was
+inline bool ReleaseBarriers(Block& block)
+{
+    bool released   = false;
+    const int lanes = static_cast<int>(block.lanes_.size());
+
+    for(int first = 0; first < lanes; first += kWarpSize)
+    {
+        const int last = std::min(first + kWarpSize, lanes);
+        bool any = false, all = true;
+        for(int i = first; i < last; ++i)
+        {
+            const auto& lane = block.lanes_[i];
+            any |= lane.state_ == LaneState::AtWarpBarrier;
+            all &= !IsLive(lane) || lane.state_ == LaneState::AtWarpBarrier;
+        }
+        if(any && all)
+        {
+            for(int i = first; i < last; ++i)
+                if(IsLive(block.lanes_[i]))
+                    block.lanes_[i].state_ = LaneState::Ready;
+            released = true;
+        }
+    }
+
+    bool any = false, all = true;
+    for(const auto& lane : block.lanes_)
+    {
+        any |= lane.state_ == LaneState::AtBlockBarrier;
+        all &= !IsLive(lane) || lane.state_ == LaneState::AtBlockBarrier;
+    }
+    if(any && all)
+    {
+        for(auto& lane : block.lanes_)
+            if(IsLive(lane))
+                lane.state_ = LaneState::Ready;
+        ++block.counters_.num_barriers_;
+        released = true;
+    }
+
+    return released;
+}
+
+// runs the lanes of the block on the calling thread
+inline void RunLanes(Block& block, const Options& options)
+{
+    const int num_lanes =
+        static_cast<int>(block.block_dim_.x * block.block_dim_.y * block.block_dim_.z);
+
+    block.lanes_  = std::vector<Lane>(num_lanes);
+    block.stacks_ = std::make_unique<char[]>(options.stack_byte_ * num_lanes);
+    block.exchange_.resize(num_lanes);
+
+    for(int i = 0; i < num_lanes; ++i)
+    {
+        auto& lane      = block.lanes_[i];
+        lane.thread_id_ = i;
+        lane.thread_idx_ =
+            dim3(i % block.block_dim_.x,
+                 i / block.block_dim_.x % block.block_dim_.y,
+                 i / (block.block_dim_.x * block.block_dim_.y));
+
+        getcontext(&lane.context_);
+        lane.context_.uc_stack.ss_sp   = block.stacks_.get() + options.stack_byte_ * i;
+        lane.context_.uc_stack.ss_size = options.stack_byte_;
+        lane.context_.uc_link          = &block.scheduler_;
+        makecontext(&lane.context_, LaneEntry, 0);
+    }
+
+    Block* const outer_block = current_block;
+    current_block            = &block;
+
+    while(!block.error_)
+    {
+        bool ran = false;
+        for(auto& lane : block.lanes_)
+        {
+            if(lane.state_ != LaneState::Ready)
+                continue;
+            block.current_ = &lane;
+            swapcontext(&block.scheduler_, &lane.context_);
+            ran = true;
+            if(block.error_)
+                break;
+        }
+        block.current_ = nullptr;
+
+        if(block.error_ || std::none_of(block.lanes_.begin(), block.lanes_.end(), IsLive))
+            break;
+
+        if(!ReleaseBarriers(block) && !ran)
+        {
+            block.error_ = std::make_exception_ptr(std::runtime_error(
+                "simt emulator: deadlock, lanes of a block wait on different barriers"));
+        }
+    }
+
+    current_block = outer_block;
+
+    // lanes left at a barrier are dropped with their stacks
+    block.lanes_.clear();
+    block.stacks_.reset();
+}
+
+// __shared__ variables are thread_local: a host thread of its own gives the block zeroed ones,
+// which do not outlive it
+inline void RunBlock(Block& block, const Options& options)
+{
+    if(options.stack_byte_ < kMinStackByte)
+        throw std::invalid_argument("simt emulator: lane stack too small");
+
+    std::thread thread([&]() {
+        try
+        {
+            RunLanes(block, options);
+        }
+        catch(...)
+        {
+            block.error_ = std::current_exception();
+        }
+    });
+    thread.join();
+
+    if(block.error_)
+        std::rethrow_exception(block.error_);
+}
+
+template <typename T>
+void Exchange(const T& value)
+{
+    static_assert(sizeof(T) <= kMaxExchangeByte && std::is_trivially_copyable_v<T>);
+    std::memcpy(CurrentBlock().exchange_[CurrentLane().thread_id_].data(), &value, sizeof(T));
+}
+
+template <typename T>
+T Exchanged(int thread_id)
+{
+    T value;
+    std::memcpy(&value, CurrentBlock().exchange_[thread_id].data(), sizeof(T));
+    return value;
+}
+
+} // namespace detail
+
+// the index functions of the lane being run
+
+inline dim3 ThreadIdx() { return detail::CurrentLane().thread_idx_; }
+inline dim3 BlockIdx() { return detail::CurrentBlock().block_idx_; }
+inline dim3 BlockDim() { return detail::CurrentBlock().block_dim_; }
+inline dim3 GridDim() { return detail::CurrentBlock().grid_dim_; }
+inline int ThreadId() { return detail::CurrentLane().thread_id_; }
+inline int LaneId() { return ThreadId() % kWarpSize; }
+inline int WarpId() { return ThreadId() / kWarpSize; }
+
+inline Counters& GetCounters() { return detail::CurrentBlock().counters_; }
+
+// __syncthreads()
+inline void BlockSync() { detail::Yield(detail::LaneState::AtBlockBarrier); }
+
+// the lanes of a warp run in lock-step on hardware; here they meet at warp level exchanges
+inline void WarpSync() { detail::Yield(detail::LaneState::AtWarpBarrier); }
+
+// the dynamic LDS of the block (extern __shared__)
+template <typename T = void>
+T* GetLds(std::size_t byte_offset = 0)
+{
+    return reinterpret_cast<T*>(detail::CurrentBlock().lds_.data() + byte_offset);
+}
+
+template <typename T>
+T GlobalLoad(const T* p)
+{
+    GetCounters().global_read_byte_ += sizeof(T);
+    return *p;
+}
+
+template <typename T>
+void GlobalStore(T* p, const T& value)
+{
+    GetCounters().global_write_byte_ += sizeof(T);
+    *p = value;
+}
+
+template <typename T>
+T LdsLoad(const T* p)
+{
+    GetCounters().lds_read_byte_ += sizeof(T);
+    return *p;
+}
+
+template <typename T>
+void LdsStore(T* p, const T& value)
+{
+    GetCounters().lds_write_byte_ += sizeof(T);
+    *p = value;
+}
+
+// buffer_load: an offset outside of the num_elements of the buffer reads 0
+template <typename T>
+T BufferLoad(const T* base, std::int64_t offset, std::int64_t num_elements)
+{
+    if(offset < 0 || offset >= num_elements)
+        return T{};
+    return GlobalLoad(base + offset);
+}
+
+// buffer_store: an offset outside of the num_elements of the buffer is dropped
+template <typename T>
+void BufferStore(T* base, std::int64_t offset, std::int64_t num_elements, const T& value)
+{
+    if(offset >= 0 && offset < num_elements)
+        GlobalStore(base + offset, value);
+}
+
+// the value of src_lane of the segment of width lanes the calling lane is in
+template <typename T>
+T Shuffle(const T& value, int src_lane, int width = kWarpSize)
+{
+    const int lane_id = LaneId();
+    const int src     = lane_id / width * width + (src_lane % width + width) % width;
+
+    detail::Exchange(value);
+    if(lane_id == 0)
+        ++GetCounters().num_shuffles_;
+    WarpSync();
+    const T result = detail::Exchanged<T>(WarpId() * kWarpSize + src);
+    WarpSync();
+    return result;
+}
+
+// the value of the first live lane of the warp
+template <typename T>
+T ReadFirstLane(const T& value)
+{
+    auto& block     = detail::CurrentBlock();
+    const int first = WarpId() * kWarpSize;
+    const int last  = std::min(first + kWarpSize, static_cast<int>(block.lanes_.size()));
+
+    detail::Exchange(value);
+    WarpSync();
+    int src = first;
+    while(src < last && !detail::IsLive(block.lanes_[src]))
+        ++src;
+    const T result = detail::Exchanged<T>(src);
+    WarpSync();
+    return result;
+}
+
+// bit i is set if lane i of the warp is live and passes a true predicate
+inline std::uint64_t Ballot(bool predicate)
+{
+    auto& block     = detail::CurrentBlock();
+    const int first = WarpId() * kWarpSize;
+    const int last  = std::min(first + kWarpSize, static_cast<int>(block.lanes_.size()));
+
+    detail::Exchange(predicate);
+    WarpSync();
+    std::uint64_t mask = 0;
+    for(int i = first; i < last; ++i)
+    {
+        if(detail::IsLive(block.lanes_[i]) && detail::Exchanged<bool>(i))
+            mask |= std::uint64_t{1} << (i - first);
+    }
+    WarpSync();
+    return mask;
+}
+
+namespace detail {
+
+template <typename T>
+struct MfmaOperands
+{
+    std::array<T, 4> a_;
+    std::array<T, 4> b_;
+};
+
+// c += a * b of one MxNxK MFMA, in the register layout of the hardware: lane l holds
+// a[m = l % M][k = l / M * 4 + i] and b[k = l / N * 4 + i][n = l % N], and the accumulators
+// c[i] of m = (i / 4 * (64 / N) + l / N) * 4 + i % 4, n = l % N
+template <int M, int N, int K, typename T, std::size_t CPerLane>
+void Mfma(const std::array<T, 4>& a, const std::array<T, 4>& b, std::array<float, CPerLane>& c)
+{
+    static_assert(M * K == 4 * kWarpSize && N * K == 4 * kWarpSize &&
+                  M * N == CPerLane * kWarpSize);
+    constexpr int kLaneGroups = kWarpSize / N; // lanes holding one column of c
+
+    Exchange(MfmaOperands<T>{a, b});
+    if(LaneId() == 0)
+        ++GetCounters().num_mfmas_;
+    WarpSync();
+
+    const int first = WarpId() * kWarpSize;
+    const int lane  = LaneId();
+    const int n     = lane % N;
+    for(std::size_t i = 0; i < CPerLane; ++i)
+    {
+        const int m = (static_cast<int>(i) / 4 * kLaneGroups + lane / N) * 4 + i % 4;
+
+        float acc = 0;
+        for(int k = 0; k < K; ++k)
+        {
+            const auto a_mk = Exchanged<MfmaOperands<T>>(first + k / 4 * M + m).a_[k % 4];
+            const auto b_kn = Exchanged<MfmaOperands<T>>(first + k / 4 * N + n).b_[k % 4];
+            acc += static_cast<float>(a_mk) * static_cast<float>(b_kn);
+        }
+        c[i] += acc;
+    }
+    WarpSync();
+}
+
+} // namespace detail
+
+// v_mfma_f32_32x32x8{f16,bf16}: 4 a and b values and 16 accumulators per lane, the operands are
+// of any type converting to float
+template <typename T>
+void Mfma32x32x8(const std::array<T, 4>& a, const std::array<T, 4>& b, std::array<float, 16>& c)
+{
+    detail::Mfma<32, 32, 8>(a, b, c);
+}
+
+// v_mfma_f32_16x16x16{f16,bf16}: 4 a and b values and 4 accumulators per lane
+template <typename T>
+void Mfma16x16x16(const std::array<T, 4>& a, const std::array<T, 4>& b, std::array<float, 4>& c)
+{
+    detail::Mfma<16, 16, 16>(a, b, c);
+}
+
+// runs kernel(args...) for every lane of every block of grid_dim x block_dim
+template <typename Kernel, typename... Args>
+LaunchStats Launch(const Options& options,
+                   dim3 grid_dim,
+                   dim3 block_dim,
+                   std::size_t lds_byte,
+                   Kernel&& kernel,
+                   Args&&... args)
+{
+    LaunchStats stats{grid_dim, block_dim, lds_byte, {}};
+
+    for(uint32_t z = 0; z < grid_dim.z; ++z)
+    {
+        for(uint32_t y = 0; y < grid_dim.y; ++y)
+        {
+            for(uint32_t x = 0; x < grid_dim.x; ++x)
+            {
+                detail::Block block;
+                block.grid_dim_  = grid_dim;
+                block.block_dim_ = block_dim;
+                block.block_idx_ = dim3(x, y, z);
+                block.body_      = [&]() { kernel(args...); };
+                block.lds_.assign(lds_byte, options.lds_fill_);
+
+                detail::RunBlock(block, options);
+                stats.blocks_.push_back(block.counters_);
+            }
+        }
+    }
+    return stats;
+}
+
+template <typename Kernel, typename... Args>
+LaunchStats
+Launch(dim3 grid_dim, dim3 block_dim, std::size_t lds_byte, Kernel&& kernel, Args&&... args)
+{
+    return Launch(GetDefaultOptions(),
+                  grid_dim,
+                  block_dim,
+                  lds_byte,
+                  std::forward<Kernel>(kernel),
+                  std::forward<Args>(args)...);
+}
+
+} // namespace simt
+} // namespace ck
+
+// the HIP device built-ins, on top of the lane being run
+#define threadIdx (::ck::simt::ThreadIdx())
+#define blockIdx (::ck::simt::BlockIdx())
+#define blockDim (::ck::simt::BlockDim())
+#define gridDim (::ck::simt::GridDim())
+
+inline constexpr int warpSize = ::ck::simt::kWarpSize;
+
+inline void __syncthreads() { ::ck::simt::BlockSync(); }
+
+inline unsigned int __lane_id() { return ::ck::simt::LaneId(); }
+
+template <typename T>
+T __shfl(T var, int src_lane, int width = warpSize)
+{
+    return ::ck::simt::Shuffle(var, src_lane, width);
+}
+
+inline std::uint64_t __ballot(int predicate) { return ::ck::simt::Ballot(predicate != 0); }
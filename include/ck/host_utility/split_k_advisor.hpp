@@ -0,0 +1,261 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+#include "ck/ck.hpp"
+#include "ck/host_utility/hip_runtime.hpp"
+
+namespace ck {
+
+//
+// Host side advisor of the K-batch of split-K GEMMs. Splitting K multiplies the workgroups of a
+// GEMM with few output tiles (small M decode GEMMs, tall-skinny ones) so that it fills the
+// device, at the cost of reducing the K-batch partial results. The advisor estimates, for every
+// K-batch, the time of the GEMM from its waves of workgroups, its memory traffic and the cost of
+// the reduction, and returns the fastest.
+//
+
+enum struct SplitKReduction
+{
+    // partial results atomically added into C, zeroed beforehand
+    Atomic,
+    // partial results written to a fp32 workspace, reduced into C by a second kernel
+    Workspace,
+};
+
+inline const char* get_split_k_reduction_name(SplitKReduction reduction)
+{
+    switch(reduction)
+    {
+    case SplitKReduction::Atomic: return "Atomic";
+    case SplitKReduction::Workspace: return "Workspace";
+    }
+    return "Unknown";
+}
+
+// one GEMM, or one group of a grouped GEMM
+struct SplitKGemmShape
+{
+    index_t M_;
+    index_t N_;
+    index_t K_;
+};
+
+// the block tile of the instance and the sizes of its data types
+struct SplitKInstance
+{
+    index_t m_per_block_;
+    index_t n_per_block_;
+    index_t k_per_block_;
+
+    // the granularity of the K batches of the universal GEMMs, lcm(AK1, BK1) (their KRead); 0 for
+    // the ops cutting K at KPerBlock multiples
+    index_t k_read_vec_ = 0;
+
+    std::size_t a_size_ = 2;
+    std::size_t b_size_ = 2;
+    std::size_t c_size_ = 2;
+
+    // the reductions the instance implements
+    bool atomic_    = true;
+    bool workspace_ = false;
+};
+
+struct SplitKDeviceModel
+{
+    index_t num_cu_        = 304;
+    index_t blocks_per_cu_ = 2;
+
+    // dense fp16 xdl throughput and HBM bandwidth of a MI300X
+    double flop_per_ns_per_cu_ = 4300;
+    double byte_per_ns_        = 5300;
+
+    // atomic add traffic relative to plain stores, fp32 and 16 bit types
+    double atomic_efficiency_        = 0.25;
+    double packed_atomic_efficiency_ = 0.05;
+
+    // cost of an extra kernel launch (C zeroing, workspace reduction)
+    double launch_ns_ = 4000;
+
+    index_t max_k_batch_ = 128;
+};
+
+// the model of a device: its CU count, the throughputs of the default model
+inline SplitKDeviceModel make_device_split_k_model(int device)
+{
+    SplitKDeviceModel model;
+
+    hipDeviceProp_t props{};
+    if(hipGetDeviceProperties(&props, device) == hipSuccess && props.multiProcessorCount > 0)
+    {
+        model.num_cu_ = props.multiProcessorCount;
+    }
+    return model;
+}
+
+// the model of the current device, queried once per device
+inline SplitKDeviceModel get_device_split_k_model()
+{
+    int device;
+    if(hipGetDevice(&device) != hipSuccess)
+        return SplitKDeviceModel{};
+
+    static std::mutex mutex;
+    static std::map<int, SplitKDeviceModel> models;
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto it = models.find(device);
+    if(it == models.end())
+        it = models.emplace(device, make_device_split_k_model(device)).first;
+    return it->second;
+}
+
+struct SplitKDecision
+{
+    index_t k_batch_;
+    SplitKReduction reduction_;
+
+    double predicted_ns_;
+};
+
+namespace detail {
+
+inline index_t split_k_integer_divide_ceil(index_t x, index_t y) { return (x + y - 1) / y; }
+
+// the K of a batch, as the device ops cut it: a multiple of KPerBlock, or of the K read vector of
+// the universal GEMMs. The last batch takes the rest
+inline index_t get_split_k_batch_length(index_t K, const SplitKInstance& instance, index_t k_batch)
+{
+    const index_t k_grain = instance.k_read_vec_ > 0 ? instance.k_read_vec_ : instance.k_per_block_;
+    return split_k_integer_divide_ceil(K, k_grain * k_batch) * k_grain;
+}
+
+inline double get_split_k_predicted_ns(const std::vector<SplitKGemmShape>& gemms,
+                                       const SplitKInstance& instance,
+                                       const SplitKDeviceModel& model,
+                                       index_t k_batch,
+                                       SplitKReduction reduction)
+{
+    std::size_t num_tiles = 0;
+    double tile_flop      = 0; // of the longest K range
+    double byte           = 0;
+    double atomic_byte    = 0;
+
+    for(const auto& gemm : gemms)
+    {
+        num_tiles += static_cast<std::size_t>(
+                         split_k_integer_divide_ceil(gemm.M_, instance.m_per_block_)) *
+                     split_k_integer_divide_ceil(gemm.N_, instance.n_per_block_) * k_batch;
+
+        // padded K tiles cost as much as full ones
+        const index_t k_length = get_split_k_batch_length(gemm.K_, instance, k_batch);
+        const index_t k_tiles  = split_k_integer_divide_ceil(k_length, instance.k_per_block_);
+
+        tile_flop = std::max(tile_flop,
+                             2. * instance.m_per_block_ * instance.n_per_block_ * k_tiles *
+                                 instance.k_per_block_);
+
+        const double M = gemm.M_, N = gemm.N_, K = gemm.K_;
+        byte += M * K * instance.a_size_ + N * K * instance.b_size_;
+
+        if(k_batch == 1)
+        {
+            byte += M * N * instance.c_size_;
+        }
+        else if(reduction == SplitKReduction::Atomic)
+        {
+            // zeroing C, then every K-batch adds its partial result
+            byte += M * N * instance.c_size_;
+            atomic_byte += k_batch * M * N * instance.c_size_;
+        }
+        else
+        {
+            // fp32 partial results written and read back, then C written
+            byte += M * N * (2. * k_batch * sizeof(float) + instance.c_size_);
+        }
+    }
+
+    const std::size_t num_blocks = static_cast<std::size_t>(model.num_cu_) * model.blocks_per_cu_;
+    const std::size_t num_waves  = (num_tiles + num_blocks - 1) / num_blocks;
+
+    const double compute_ns =
+        num_waves * model.blocks_per_cu_ * tile_flop / model.flop_per_ns_per_cu_;
+
+    const double efficiency = instance.c_size_ >= sizeof(float) ? model.atomic_efficiency_
+                                                                : model.packed_atomic_efficiency_;
+    const double memory_ns =
+        byte / model.byte_per_ns_ + atomic_byte / (model.byte_per_ns_ * efficiency);
+
+    // the C zeroing or the workspace reduction kernel
+    const double launch_ns = k_batch > 1 ? model.launch_ns_ : 0.;
+
+    return std::max(compute_ns, memory_ns) + launch_ns;
+}
+
+} // namespace detail
+
+// all K-batches and reductions of the instance for the GEMMs (the groups of a grouped GEMM share
+// one K-batch), fastest first. K-batches leaving a batch without K are skipped.
+inline std::vector<SplitKDecision> rank_split_k(const std::vector<SplitKGemmShape>& gemms,
+                                                const SplitKInstance& instance,
+                                                const SplitKDeviceModel& model = {})
+{
+    if(gemms.empty() || instance.m_per_block_ <= 0 || instance.n_per_block_ <= 0 ||
+       instance.k_per_block_ <= 0 || instance.k_read_vec_ < 0)
+        throw std::runtime_error("wrong! invalid split-K problem");
+
+    std::vector<SplitKReduction> reductions;
+    if(instance.atomic_)
+        reductions.push_back(SplitKReduction::Atomic);
+    if(instance.workspace_)
+        reductions.push_back(SplitKReduction::Workspace);
+
+    std::vector<SplitKDecision> decisions{
+        {1,
+         reductions.empty() ? SplitKReduction::Atomic : reductions.front(),
+         detail::get_split_k_predicted_ns(gemms, instance, model, 1, SplitKReduction::Atomic)}};
+
+    for(index_t k_batch = 2; k_batch <= model.max_k_batch_; ++k_batch)
+    {
+        bool all_batches_used = true;
+        for(const auto& gemm : gemms)
+        {
+            const index_t k_length = detail::get_split_k_batch_length(gemm.K_, instance, k_batch);
+            all_batches_used = all_batches_used && (k_batch - 1) * k_length < gemm.K_;
+        }
+        if(!all_batches_used)
+            continue;
+
+        for(const auto reduction : reductions)
+        {
+            decisions.push_back(
+                {k_batch,
+                 reduction,
+                 detail::get_split_k_predicted_ns(gemms, instance, model, k_batch, reduction)});
+        }
+    }
+
+    // on ties, the smaller K-batch
+    std::stable_sort(decisions.begin(), decisions.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.predicted_ns_ < rhs.predicted_ns_;
+    });
+    return decisions;
+}
+
+inline SplitKDecision advise_split_k(const std::vector<SplitKGemmShape>& gemms,
+                                     const SplitKInstance& instance,
+                                     const SplitKDeviceModel& model = {})
+{
+    return rank_split_k(gemms, instance, model).front();
+}
+
+} // namespace ck
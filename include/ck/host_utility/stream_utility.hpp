@@ -3,7 +3,7 @@
 
 #pragma once
 
-#include <hip/hip_runtime.h>
+#include "ck/host_utility/hip_runtime.hpp"
 
 #include "ck/stream_config.hpp"
 #include "ck/host_utility/hip_check_error.hpp"
@@ -0,0 +1,176 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <vector>
+
+namespace ck {
+
+// Summary of per-launch kernel times, all times in ms
+struct TimingStatistics
+{
+    std::vector<float> samples_;
+
+    float mean_   = 0;
+    float median_ = 0;
+    float p10_    = 0;
+    float p90_    = 0;
+    float min_    = 0;
+    float max_    = 0;
+    float stddev_ = 0;
+    // coefficient of variation, stddev / mean
+    float cv_ = 0;
+    // number of samples outside the Tukey fences [q1 - 1.5 * iqr, q3 + 1.5 * iqr]
+    int num_outliers_ = 0;
+    // relative half width of the ~95% confidence interval of the median
+    float median_rel_ci_ = 0;
+    // adaptive repetition reached its precision target before running out of iterations
+    bool converged_ = false;
+};
+
+namespace timing {
+
+// How many launches to time; with target_rel_ci_ > 0 the launches are repeated in growing
+// batches until the median is known to that relative precision or max_nrepeat_ is reached
+struct TimingConfig
+{
+    int nrepeat_         = 50;
+    int max_nrepeat_     = 1000;
+    float target_rel_ci_ = 0.f;
+};
+
+// linear interpolation between the closest ranks, same as numpy.percentile
+inline float Percentile(const std::vector<float>& sorted, float p)
+{
+    if(sorted.empty())
+        return 0;
+
+    const float pos  = p / 100.f * static_cast<float>(sorted.size() - 1);
+    const auto lower = static_cast<std::size_t>(std::floor(pos));
+    const auto upper = std::min(lower + 1, sorted.size() - 1);
+
+    return sorted[lower] + (pos - static_cast<float>(lower)) * (sorted[upper] - sorted[lower]);
+}
+
+// Distribution free confidence interval of the median: the order statistics at ranks
+// n/2 -+ 1.96 * sqrt(n) / 2 bracket the true median with ~95% probability
+inline float MedianRelativeConfidence(const std::vector<float>& sorted, float median)
+{
+    const int n = static_cast<int>(sorted.size());
+    if(n < 2 || median <= 0)
+        return INFINITY;
+
+    const float half_width = 0.98f * std::sqrt(static_cast<float>(n));
+    const int lower = std::max(0, static_cast<int>(std::floor(n / 2.f - half_width)));
+    const int upper = std::min(n - 1, static_cast<int>(std::ceil(n / 2.f + half_width)));
+
+    return (sorted[upper] - sorted[lower]) / (2.f * median);
+}
+
+inline TimingStatistics ComputeStatistics(std::vector<float> samples)
+{
+    TimingStatistics stats;
+
+    if(samples.empty())
+        return stats;
+
+    std::vector<float> sorted = samples;
+    std::sort(sorted.begin(), sorted.end());
+
+    const auto n = static_cast<float>(sorted.size());
+
+    stats.mean_   = std::accumulate(sorted.begin(), sorted.end(), 0.f) / n;
+    stats.median_ = Percentile(sorted, 50.f);
+    stats.p10_    = Percentile(sorted, 10.f);
+    stats.p90_    = Percentile(sorted, 90.f);
+    stats.min_    = sorted.front();
+    stats.max_    = sorted.back();
+
+    float sq_sum = 0;
+    for(float t : sorted)
+        sq_sum += (t - stats.mean_) * (t - stats.mean_);
+
+    stats.stddev_ = sorted.size() > 1 ? std::sqrt(sq_sum / (n - 1)) : 0.f;
+    stats.cv_     = stats.mean_ > 0 ? stats.stddev_ / stats.mean_ : 0.f;
+
+    const float q1  = Percentile(sorted, 25.f);
+    const float q3  = Percentile(sorted, 75.f);
+    const float iqr = q3 - q1;
+
+    stats.num_outliers_ = static_cast<int>(std::count_if(sorted.begin(), sorted.end(), [&](float t) {
+        return t < q1 - 1.5f * iqr || t > q3 + 1.5f * iqr;
+    }));
+
+    stats.median_rel_ci_ = MedianRelativeConfidence(sorted, stats.median_);
+    stats.samples_       = std::move(samples);
+
+    return stats;
+}
+
+// Time every launch separately.
+//
+// Timer is anything with
+//   void Start();                  // mark the beginning of one sample
+//   void Stop();                   // mark its end
+//   std::vector<float> Collect();  // wait for and return the ms of the samples since the last
+//                                  // Collect(), in order
+// so that on the device the whole batch is enqueued without host synchronization, and a
+// virtual clock can be plugged in on the host. `untimed` runs before every sample outside of
+// the timed region (e.g. cache flush), `timed` is the work being measured.
+template <typename Timer, typename Untimed, typename Timed>
+TimingStatistics
+MeasureIterations(Timer& timer, Untimed&& untimed, Timed&& timed, const TimingConfig& config)
+{
+    std::vector<float> samples;
+
+    const int max_nrepeat = std::max(config.nrepeat_, config.max_nrepeat_);
+
+    int batch = config.nrepeat_;
+    TimingStatistics stats;
+
+    while(batch > 0)
+    {
+        for(int i = 0; i < batch; ++i)
+        {
+            untimed();
+            timer.Start();
+            timed();
+            timer.Stop();
+        }
+
+        const std::vector<float> batch_samples = timer.Collect();
+        samples.insert(samples.end(), batch_samples.begin(), batch_samples.end());
+
+        stats = ComputeStatistics(samples);
+
+        if(config.target_rel_ci_ <= 0.f)
+        {
+            stats.converged_ = true;
+            break;
+        }
+        if(stats.median_rel_ci_ <= config.target_rel_ci_)
+        {
+            stats.converged_ = true;
+            break;
+        }
+
+        // double the sample count every round
+        const int total = static_cast<int>(samples.size());
+        batch           = std::min(total, max_nrepeat - total);
+    }
+
+    return stats;
+}
+
+template <typename Timer, typename Timed>
+TimingStatistics MeasureIterations(Timer& timer, Timed&& timed, const TimingConfig& config)
+{
+    return MeasureIterations(timer, [] {}, timed, config);
+}
+
+} // namespace timing
+} // namespace ck
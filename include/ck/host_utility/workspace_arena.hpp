@@ -0,0 +1,456 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "ck/stream_config.hpp"
+#include "ck/utility/is_detected.hpp"
+#include "ck/host_utility/hip_check_error.hpp"
+
+namespace ck {
+
+// Device memory the workspace arena sub-allocates from
+struct WorkspaceBackingStore
+{
+    virtual void* Allocate(std::size_t size_byte) = 0;
+    virtual void Free(void* p) = 0;
+
+    virtual ~WorkspaceBackingStore() {}
+};
+
+struct HipWorkspaceBackingStore : public WorkspaceBackingStore
+{
+    void* Allocate(std::size_t size_byte) override
+    {
+        void* p = nullptr;
+        hip_check_error(hipMalloc(&p, size_byte));
+        return p;
+    }
+
+    void Free(void* p) override { hip_check_error(hipFree(p)); }
+};
+
+// Shared scratch memory of the device ops (the workspace of GetWorkSpaceSize and
+// SetWorkSpacePointer, the device kernel arguments of the grouped GEMMs), instead of a DeviceMem
+// per op and call. Every op gets an aligned slice on the stream it runs on, which the caller
+// releases with Release once it launched the last run of the op on the slice:
+//
+// - a released slice is reused right away by later ops of the same stream, which run after the
+//   releasing op in stream order;
+// - other streams reuse it only after Synchronize(), which waits for the releasing streams.
+//
+// The arena grows by a new chunk when no free slice fits. Reserve(GetHighWaterMark()) after a
+// first iteration, or Reserve(plan_workspace(...)) before it, makes every later iteration run
+// within one chunk without allocating.
+class WorkspaceArena
+{
+    public:
+    static constexpr std::size_t DefaultAlignment = 256;
+
+    explicit WorkspaceArena(
+        std::unique_ptr<WorkspaceBackingStore> store = std::make_unique<HipWorkspaceBackingStore>(),
+        std::size_t alignment                        = DefaultAlignment)
+        : store_(std::move(store)), alignment_(alignment)
+    {
+        if(!store_ || alignment_ == 0 || (alignment_ & (alignment_ - 1)) != 0)
+            throw std::runtime_error("wrong! invalid workspace arena");
+    }
+
+    WorkspaceArena(const WorkspaceArena&) = delete;
+    WorkspaceArena& operator=(const WorkspaceArena&) = delete;
+
+    ~WorkspaceArena()
+    {
+        for(const auto& chunk : chunks_)
+            store_->Free(chunk.p_base_);
+    }
+
+    // nullptr for an empty slice
+    void* Acquire(std::size_t size_byte, hipStream_t stream = nullptr)
+    {
+        if(size_byte == 0)
+            return nullptr;
+
+        const std::size_t size = (size_byte + alignment_ - 1) / alignment_ * alignment_;
+
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        for(auto& chunk : chunks_)
+        {
+            for(auto first = chunk.blocks_.begin(); first != chunk.blocks_.end(); ++first)
+            {
+                // the run of free blocks from first the stream can use
+                std::size_t run_size = 0;
+                for(auto last = first;
+                    last != chunk.blocks_.end() && IsUsable(last->second, stream);
+                    ++last)
+                {
+                    run_size += last->second.size_;
+                    if(run_size >= size)
+                        return Take(chunk, first, last, run_size, size, stream);
+                }
+            }
+        }
+
+        // no free slice fits, grow
+        auto& chunk = AddChunk(size);
+        ++num_grows_;
+
+        return Take(chunk, chunk.blocks_.begin(), chunk.blocks_.begin(), size, size, stream);
+    }
+
+    void Release(void* p)
+    {
+        if(p == nullptr)
+            return;
+
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        const auto address = reinterpret_cast<std::uintptr_t>(p);
+        for(auto& chunk : chunks_)
+        {
+            const auto base = reinterpret_cast<std::uintptr_t>(chunk.p_base_);
+            if(address < base || address >= base + chunk.size_)
+                continue;
+
+            const auto it = chunk.blocks_.find(address - base);
+            if(it == chunk.blocks_.end())
+                break;
+
+            if(!it->second.in_use_)
+                throw std::runtime_error("wrong! workspace released twice");
+
+            // reusable by the stream of the op in stream order, by the others after a sync
+            it->second.in_use_          = false;
+            it->second.is_stream_bound_ = true;
+            in_use_byte_ -= it->second.size_;
+
+            Coalesce(chunk, it);
+            return;
+        }
+        throw std::runtime_error("wrong! not a workspace of this arena");
+    }
+
+    // Acquire the workspace of a device op and set it to the argument, nullptr if it needs none.
+    // The slice stays in use until Release
+    template <typename DeviceOp, typename Argument>
+    void*
+    Bind(const DeviceOp& op, Argument* p_arg, const StreamConfig& stream_config = StreamConfig{})
+    {
+        void* p_workspace = Acquire(op.GetWorkSpaceSize(p_arg), stream_config.stream_id_);
+        op.SetWorkSpacePointer(p_arg, p_workspace, stream_config);
+        return p_workspace;
+    }
+
+    // Acquire the device kernel arguments of a grouped GEMM and set them to the argument, which
+    // uploads them in full. The slice stays in use until Release
+    template <typename DeviceOp, typename Argument>
+    void* BindDeviceKernelArgs(const DeviceOp& op, Argument* p_arg, hipStream_t stream = nullptr)
+    {
+        void* p_kernel_args = Acquire(op.GetDeviceKernelArgSize(p_arg), stream);
+        op.SetDeviceKernelArgs(p_arg, p_kernel_args);
+        return p_kernel_args;
+    }
+
+    // wait for the streams of the released slices, which all streams can reuse then
+    void Synchronize()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        std::set<hipStream_t> streams;
+        for(const auto& chunk : chunks_)
+        {
+            for(const auto& [offset, block] : chunk.blocks_)
+            {
+                if(!block.in_use_ && block.is_stream_bound_)
+                    streams.insert(block.stream_);
+            }
+        }
+        for(const auto stream : streams)
+            hip_check_error(hipStreamSynchronize(stream));
+
+        for(auto& chunk : chunks_)
+        {
+            for(auto& [offset, block] : chunk.blocks_)
+            {
+                if(!block.in_use_)
+                    block.is_stream_bound_ = false;
+            }
+            for(auto it = chunk.blocks_.begin(); it != chunk.blocks_.end(); ++it)
+                it = Coalesce(chunk, it);
+        }
+    }
+
+    // Replace the chunks by a single one of at least size_byte, only while no slice is in use
+    // (the chunks are kept otherwise). Synchronizes the streams of the released slices.
+    void Reserve(std::size_t size_byte)
+    {
+        Synchronize();
+
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        const std::size_t size = (size_byte + alignment_ - 1) / alignment_ * alignment_;
+        if(in_use_byte_ != 0 || size == 0 ||
+           (chunks_.size() == 1 && chunks_.front().size_ >= size))
+            return;
+
+        for(const auto& chunk : chunks_)
+            store_->Free(chunk.p_base_);
+        chunks_.clear();
+
+        AddChunk(size);
+    }
+
+    // bytes held from the backing store
+    std::size_t GetCapacity() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        std::size_t capacity = 0;
+        for(const auto& chunk : chunks_)
+            capacity += chunk.size_;
+        return capacity;
+    }
+
+    // bytes of the slices in use, alignment included
+    std::size_t GetInUseBytes() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return in_use_byte_;
+    }
+
+    // largest footprint so far, the end of the last slice in use summed over the chunks: about
+    // the single chunk the same sequence of ops needs, exactly so when it ran in one chunk
+    std::size_t GetHighWaterMark() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return high_water_mark_;
+    }
+
+    std::size_t GetNumChunks() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return chunks_.size();
+    }
+
+    // number of allocations from the backing store by Acquire
+    std::size_t GetNumGrows() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return num_grows_;
+    }
+
+    std::size_t GetAlignment() const { return alignment_; }
+
+    private:
+    struct Block
+    {
+        std::size_t size_;
+        bool in_use_          = false;
+        bool is_stream_bound_ = false;
+        hipStream_t stream_   = nullptr;
+    };
+
+    struct Chunk
+    {
+        void* p_base_;
+        std::size_t size_;
+        // by offset
+        std::map<std::size_t, Block> blocks_;
+    };
+
+    using BlockIterator = std::map<std::size_t, Block>::iterator;
+
+    Chunk& AddChunk(std::size_t size)
+    {
+        void* p_base = store_->Allocate(size);
+        if(reinterpret_cast<std::uintptr_t>(p_base) % alignment_ != 0)
+        {
+            store_->Free(p_base);
+            throw std::runtime_error("wrong! misaligned workspace backing store");
+        }
+
+        chunks_.push_back(Chunk{p_base, size, {}});
+        chunks_.back().blocks_.emplace(0, Block{size});
+        return chunks_.back();
+    }
+
+    static bool IsUsable(const Block& block, hipStream_t stream)
+    {
+        return !block.in_use_ && (!block.is_stream_bound_ || block.stream_ == stream);
+    }
+
+    // use the first size bytes of the free blocks [first, last]
+    void* Take(Chunk& chunk,
+               BlockIterator first,
+               BlockIterator last,
+               std::size_t run_size,
+               std::size_t size,
+               hipStream_t stream)
+    {
+        const std::size_t offset = first->first;
+
+        // the rest keeps the reuse restriction of its block
+        Block rest = last->second;
+        rest.size_ = run_size - size;
+
+        chunk.blocks_.erase(std::next(first), std::next(last));
+        first->second = Block{size, true, true, stream};
+        if(rest.size_ > 0)
+            chunk.blocks_.emplace(offset + size, rest);
+
+        in_use_byte_ += size;
+
+        std::size_t footprint = 0;
+        for(const auto& c : chunks_)
+        {
+            for(auto b = c.blocks_.rbegin(); b != c.blocks_.rend(); ++b)
+            {
+                if(b->second.in_use_)
+                {
+                    footprint += b->first + b->second.size_;
+                    break;
+                }
+            }
+        }
+        high_water_mark_ = std::max(high_water_mark_, footprint);
+
+        return static_cast<unsigned char*>(chunk.p_base_) + offset;
+    }
+
+    static bool IsMergeable(const Block& lhs, const Block& rhs)
+    {
+        return !lhs.in_use_ && !rhs.in_use_ && lhs.is_stream_bound_ == rhs.is_stream_bound_ &&
+               (!lhs.is_stream_bound_ || lhs.stream_ == rhs.stream_);
+    }
+
+    // merge a free block with its free neighbours of the same reuse restriction
+    static BlockIterator Coalesce(Chunk& chunk, BlockIterator it)
+    {
+        auto next = std::next(it);
+        if(next != chunk.blocks_.end() && IsMergeable(it->second, next->second))
+        {
+            it->second.size_ += next->second.size_;
+            chunk.blocks_.erase(next);
+        }
+        if(it != chunk.blocks_.begin())
+        {
+            auto prev = std::prev(it);
+            if(IsMergeable(prev->second, it->second))
+            {
+                prev->second.size_ += it->second.size_;
+                chunk.blocks_.erase(it);
+                return prev;
+            }
+        }
+        return it;
+    }
+
+    std::unique_ptr<WorkspaceBackingStore> store_;
+    std::size_t alignment_;
+
+    mutable std::mutex mutex_;
+    std::vector<Chunk> chunks_;
+    std::size_t in_use_byte_     = 0;
+    std::size_t high_water_mark_ = 0;
+    std::size_t num_grows_       = 0;
+};
+
+// the workspace of one op, and the device kernel arguments it binds next to it (Bind, then
+// BindDeviceKernelArgs); the ops of a stream run one after another
+struct WorkspaceRequest
+{
+    std::size_t size_byte_;
+    hipStream_t stream_               = nullptr;
+    std::size_t kernel_arg_size_byte_ = 0;
+};
+
+namespace detail {
+
+template <typename DeviceOp, typename Argument>
+using get_device_kernel_arg_size_t =
+    decltype(std::declval<const DeviceOp&>().GetDeviceKernelArgSize(std::declval<Argument*>()));
+
+} // namespace detail
+
+// the workspace request of a device op argument, with its device kernel arguments if the op has
+// some
+template <typename DeviceOp, typename Argument>
+WorkspaceRequest
+make_workspace_request(const DeviceOp& op, const Argument* p_arg, hipStream_t stream = nullptr)
+{
+    WorkspaceRequest request{op.GetWorkSpaceSize(p_arg), stream};
+    if constexpr(is_detected<detail::get_device_kernel_arg_size_t, DeviceOp, const Argument>::value)
+        request.kernel_arg_size_byte_ = op.GetDeviceKernelArgSize(p_arg);
+    return request;
+}
+
+namespace detail {
+
+// hands out addresses without memory, to replay a sequence of ops
+struct PlanningWorkspaceBackingStore : public WorkspaceBackingStore
+{
+    explicit PlanningWorkspaceBackingStore(std::size_t alignment)
+        : next_(alignment), alignment_(alignment)
+    {
+    }
+
+    void* Allocate(std::size_t size_byte) override
+    {
+        void* p = reinterpret_cast<void*>(next_);
+        next_ += (size_byte / alignment_ + 1) * alignment_;
+        return p;
+    }
+
+    void Free(void*) override {}
+
+    std::uintptr_t next_;
+    std::size_t alignment_;
+};
+
+} // namespace detail
+
+// Workspace a WorkspaceArena needs for the ops, in launch order: the workspace and kernel
+// arguments of an op are released when the next op of its stream is launched, the ops of other
+// streams run concurrently. An arena reserving it runs the ops without growing.
+inline std::size_t plan_workspace(const std::vector<WorkspaceRequest>& requests,
+                                  std::size_t alignment = WorkspaceArena::DefaultAlignment)
+{
+    const auto align = [&](std::size_t size) {
+        return (size + alignment - 1) / alignment * alignment;
+    };
+
+    std::size_t total_byte = 0;
+    for(const auto& request : requests)
+        total_byte += align(request.size_byte_) + align(request.kernel_arg_size_byte_);
+
+    WorkspaceArena arena(std::make_unique<detail::PlanningWorkspaceBackingStore>(alignment),
+                         alignment);
+    arena.Reserve(total_byte);
+
+    std::map<hipStream_t, std::pair<void*, void*>> live;
+    for(const auto& request : requests)
+    {
+        auto& [p_workspace, p_kernel_args] = live[request.stream_];
+        arena.Release(p_workspace);
+        arena.Release(p_kernel_args);
+        p_workspace   = arena.Acquire(request.size_byte_, request.stream_);
+        p_kernel_args = arena.Acquire(request.kernel_arg_size_byte_, request.stream_);
+    }
+    return arena.GetHighWaterMark();
+}
+
+} // namespace ck
@@ -0,0 +1,535 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "ck/ck.hpp"
+#include "ck/library/utility/convolution_parameter.hpp"
+
+namespace ck {
+namespace utils {
+namespace conv {
+
+//
+// Host side planner of grouped convolutions. For a problem it predicts which implementation,
+// number of merged groups, split of N and split of K (K-batch) run fastest, from a model of
+// the tiles, the occupancy and the memory traffic of every candidate, so that only the matching
+// instances have to be profiled or run.
+//
+// The legality rules mirror IsSupportedArgument of the device ops and the transforms they use
+// (TransformConvFwdToGemm, TransformConvBwdWeightToGemmV2), for packed tensors. Layout and
+// vector access restrictions are not modelled, they are left to IsSupportedArgument.
+//
+
+enum struct ConvDirection
+{
+    Forward,
+    BackwardWeight,
+};
+
+enum struct ConvAlgorithm
+{
+    // DeviceGroupedConvFwdMultipleABD_Xdl_CShuffle, splits N and merges groups
+    FwdXdl,
+    // DeviceGroupedConvFwdMultipleD_Xdl_CShuffle_Large_Tensor, for tensors over 2GB
+    FwdLargeTensor,
+    // DeviceGroupedConvBwdWeight_Xdl_CShuffle, K-batches reduced with atomics on the weight
+    BwdWeightAtomic,
+    // DeviceGroupedConvBwdWeightTwoStage_Xdl_CShuffle, K-batches reduced in a fp32 workspace
+    // which a second kernel converts to the weight type, merges groups
+    BwdWeightTwoStage,
+    // any other implementation
+    Unknown,
+};
+
+inline const char* get_conv_algorithm_name(ConvAlgorithm algorithm)
+{
+    switch(algorithm)
+    {
+    case ConvAlgorithm::FwdXdl: return "DeviceGroupedConvFwdMultipleABD_Xdl_CShuffle";
+    case ConvAlgorithm::FwdLargeTensor:
+        return "DeviceGroupedConvFwdMultipleD_Xdl_CShuffle_Large_Tensor";
+    case ConvAlgorithm::BwdWeightAtomic: return "DeviceGroupedConvBwdWeight_Xdl_CShuffle";
+    case ConvAlgorithm::BwdWeightTwoStage: return "DeviceGroupedConvBwdWeightTwoStage_Xdl_CShuffle";
+    case ConvAlgorithm::Unknown: break;
+    }
+    return "Unknown";
+}
+
+inline ConvDirection get_conv_direction(ConvAlgorithm algorithm)
+{
+    return algorithm == ConvAlgorithm::FwdXdl || algorithm == ConvAlgorithm::FwdLargeTensor
+               ? ConvDirection::Forward
+               : ConvDirection::BackwardWeight;
+}
+
+// an implementation and the block tile of its typical instances
+struct ConvTileConfig
+{
+    ConvAlgorithm algorithm_;
+    index_t num_groups_to_merge_;
+    index_t m_per_block_;
+    index_t n_per_block_;
+    index_t k_per_block_;
+};
+
+struct ConvDeviceModel
+{
+    index_t num_cu_        = 304;
+    index_t blocks_per_cu_ = 2;
+
+    // dense fp16 xdl throughput and HBM bandwidth of a MI300X
+    double flop_per_ns_per_cu_ = 4300;
+    double byte_per_ns_        = 5300;
+
+    // atomic add traffic relative to plain stores, fp32 and 16 bit types
+    double atomic_efficiency_        = 0.25;
+    double packed_atomic_efficiency_ = 0.05;
+
+    // cost of an extra kernel launch
+    double launch_ns_ = 4000;
+
+    index_t max_k_batch_ = 128;
+
+    // the group merge factors and tiles of the instance library
+    std::vector<ConvTileConfig> configs_{{ConvAlgorithm::FwdXdl, 1, 256, 128, 32},
+                                         {ConvAlgorithm::FwdXdl, 8, 64, 16, 16},
+                                         {ConvAlgorithm::FwdXdl, 16, 64, 16, 16},
+                                         {ConvAlgorithm::FwdXdl, 32, 64, 16, 16},
+                                         {ConvAlgorithm::FwdLargeTensor, 1, 256, 128, 32},
+                                         {ConvAlgorithm::BwdWeightAtomic, 1, 256, 128, 32},
+                                         {ConvAlgorithm::BwdWeightTwoStage, 1, 128, 128, 32},
+                                         {ConvAlgorithm::BwdWeightTwoStage, 2, 32, 32, 32},
+                                         {ConvAlgorithm::BwdWeightTwoStage, 4, 32, 64, 32},
+                                         {ConvAlgorithm::BwdWeightTwoStage, 8, 32, 128, 32}};
+};
+
+struct ConvDataTypeSize
+{
+    std::size_t in_;
+    std::size_t wei_;
+    std::size_t out_;
+};
+
+template <typename InDataType, typename WeiDataType, typename OutDataType>
+ConvDataTypeSize get_conv_data_type_size()
+{
+    return {sizeof(InDataType), sizeof(WeiDataType), sizeof(OutDataType)};
+}
+
+struct ConvPlan
+{
+    ConvTileConfig config_{ConvAlgorithm::Unknown, 1, 0, 0, 0};
+
+    // N of every kernel launch (forward), the batch is processed in N / n_per_launch_ pieces
+    long_index_t n_per_launch_ = 0;
+    // split_k of the backward weight device ops
+    index_t k_batch_ = 1;
+
+    // GEMM of one block of merged groups and one piece of N
+    long_index_t gemm_m_ = 0;
+    long_index_t gemm_n_ = 0;
+    long_index_t gemm_k_ = 0;
+
+    long_index_t num_tiles_     = 0;
+    std::size_t workspace_byte_ = 0;
+    double predicted_ns_        = 0;
+};
+
+namespace detail {
+
+inline long_index_t product(const std::vector<long_index_t>& lengths)
+{
+    return std::accumulate(
+        lengths.begin(), lengths.end(), long_index_t{1}, std::multiplies<long_index_t>());
+}
+
+inline long_index_t get_input_element_count(const ConvParam& param)
+{
+    return param.G_ * param.N_ * param.C_ * product(param.input_spatial_lengths_);
+}
+
+inline long_index_t get_weight_element_count(const ConvParam& param)
+{
+    return param.G_ * param.K_ * param.C_ * product(param.filter_spatial_lengths_);
+}
+
+inline long_index_t get_output_element_count(const ConvParam& param)
+{
+    return param.G_ * param.N_ * param.K_ * product(param.output_spatial_lengths_);
+}
+
+inline long_index_t integer_divide_ceil(long_index_t x, long_index_t y) { return (x + y - 1) / y; }
+
+constexpr long_index_t TwoGB = long_index_t{1} << 31;
+
+// largest of the input and output tensors of one launch, in bytes
+inline long_index_t get_launch_byte(const ConvParam& param,
+                                    const ConvDataTypeSize& type_size,
+                                    long_index_t n_per_launch)
+{
+    const long_index_t in_byte  = get_input_element_count(param) * type_size.in_;
+    const long_index_t out_byte = get_output_element_count(param) * type_size.out_;
+
+    return std::max(in_byte, out_byte) / param.N_ * n_per_launch;
+}
+
+} // namespace detail
+
+//
+// N processed by one launch of DeviceGroupedConvFwdMultipleABD_Xdl_CShuffle, the same as
+// TransformConvFwdToGemm::GetSplitedNSize for packed tensors: N divided by its least divisor
+// that keeps the input and output of a launch under 2GB, N if no split is needed or none helps.
+//
+inline long_index_t get_split_n_size(const ConvParam& param, const ConvDataTypeSize& type_size)
+{
+    const long_index_t element_space_size = detail::get_launch_byte(param, type_size, param.N_);
+    const long_index_t N                  = param.N_;
+
+    if(element_space_size <= detail::TwoGB)
+        return N;
+
+    const long_index_t divisor = detail::integer_divide_ceil(element_space_size, detail::TwoGB);
+
+    if(divisor > N)
+        return N;
+
+    for(long_index_t least_divisor = divisor; least_divisor * least_divisor <= N; least_divisor++)
+    {
+        if(N % least_divisor == 0)
+            return N / least_divisor;
+    }
+
+    return 1;
+}
+
+//
+// Whether the device op of the plan accepts the problem with the plan's merge factor, N
+// per launch and K-batch, and whether the GEMM sizes of the plan are the ones of its transform
+//
+inline bool is_conv_plan_legal(const ConvParam& param,
+                               const ConvDataTypeSize& type_size,
+                               const ConvPlan& plan)
+{
+    const auto& config  = plan.config_;
+    const index_t merge = config.num_groups_to_merge_;
+
+    if(config.algorithm_ == ConvAlgorithm::Unknown || merge < 1 || param.G_ % merge != 0)
+        return false;
+
+    if(plan.k_batch_ < 1)
+        return false;
+
+    const long_index_t filter_size = detail::product(param.filter_spatial_lengths_);
+    const long_index_t output_size = detail::product(param.output_spatial_lengths_);
+
+    if(get_conv_direction(config.algorithm_) == ConvDirection::Forward)
+    {
+        if(plan.k_batch_ != 1)
+            return false;
+
+        if(config.algorithm_ == ConvAlgorithm::FwdXdl)
+        {
+            // the split of TransformConvFwdToGemm, and launches under 2GB
+            if(plan.n_per_launch_ != get_split_n_size(param, type_size) ||
+               detail::get_launch_byte(param, type_size, plan.n_per_launch_) > detail::TwoGB)
+                return false;
+
+            // groups are merged along GemmN, only for C == 1
+            if(merge > 1 && param.C_ != 1)
+                return false;
+        }
+        else if(merge != 1 || plan.n_per_launch_ != param.N_)
+        {
+            return false;
+        }
+
+        return plan.gemm_m_ == plan.n_per_launch_ * output_size &&
+               plan.gemm_n_ == param.K_ * merge && plan.gemm_k_ == param.C_ * filter_size;
+    }
+
+    if(plan.n_per_launch_ != param.N_)
+        return false;
+
+    const long_index_t gemm_m = param.K_ * merge;
+    const long_index_t gemm_n = param.C_ * filter_size * merge;
+    const long_index_t gemm_k = param.N_ * output_size;
+
+    if(plan.gemm_m_ != gemm_m || plan.gemm_n_ != gemm_n || plan.gemm_k_ != gemm_k)
+        return false;
+
+    // every K-batch has work
+    if(plan.k_batch_ > detail::integer_divide_ceil(gemm_k, config.k_per_block_))
+        return false;
+
+    if(config.algorithm_ == ConvAlgorithm::BwdWeightAtomic)
+        return merge == 1 && plan.workspace_byte_ == 0;
+
+    // the whole merged GEMM on one block, for depthwise convolutions only
+    if(merge > 1 && !(param.C_ == 1 && param.K_ == 1 && gemm_m <= config.m_per_block_ &&
+                      gemm_n <= config.n_per_block_))
+        return false;
+
+    return plan.workspace_byte_ ==
+           static_cast<std::size_t>(detail::get_weight_element_count(param)) * sizeof(float);
+}
+
+namespace detail {
+
+inline double get_compute_ns(const ConvDeviceModel& model,
+                             const ConvTileConfig& config,
+                             long_index_t num_tiles,
+                             long_index_t k_per_tile)
+{
+    const long_index_t num_blocks = long_index_t{model.num_cu_} * model.blocks_per_cu_;
+    const long_index_t num_waves  = integer_divide_ceil(num_tiles, num_blocks);
+
+    // padded tiles cost as much as full ones
+    const double tile_flop = 2. * config.m_per_block_ * config.n_per_block_ *
+                             integer_divide_ceil(k_per_tile, config.k_per_block_) *
+                             config.k_per_block_;
+
+    return num_waves * model.blocks_per_cu_ * tile_flop / model.flop_per_ns_per_cu_;
+}
+
+inline long_index_t get_num_tiles(const ConvTileConfig& config,
+                                  long_index_t gemm_m,
+                                  long_index_t gemm_n,
+                                  long_index_t gemm_batch)
+{
+    return integer_divide_ceil(gemm_m, config.m_per_block_) *
+           integer_divide_ceil(gemm_n, config.n_per_block_) * gemm_batch;
+}
+
+inline void add_fwd_plans(const ConvParam& param,
+                          const ConvDataTypeSize& type_size,
+                          const ConvDeviceModel& model,
+                          const ConvTileConfig& config,
+                          std::vector<ConvPlan>& plans)
+{
+    const long_index_t split_n_size = get_split_n_size(param, type_size);
+    const bool too_large            = get_launch_byte(param, type_size, split_n_size) > TwoGB;
+
+    // the large tensor implementation only when splitting N is not enough
+    if((config.algorithm_ == ConvAlgorithm::FwdLargeTensor) != too_large)
+        return;
+
+    ConvPlan plan;
+    plan.config_       = config;
+    plan.n_per_launch_ = config.algorithm_ == ConvAlgorithm::FwdXdl ? split_n_size : param.N_;
+    plan.gemm_m_       = plan.n_per_launch_ * product(param.output_spatial_lengths_);
+    plan.gemm_n_       = param.K_ * config.num_groups_to_merge_;
+    plan.gemm_k_       = param.C_ * product(param.filter_spatial_lengths_);
+
+    if(!is_conv_plan_legal(param, type_size, plan))
+        return;
+
+    const long_index_t gemm_batch =
+        param.G_ / config.num_groups_to_merge_ * (param.N_ / plan.n_per_launch_);
+
+    plan.num_tiles_ = get_num_tiles(config, plan.gemm_m_, plan.gemm_n_, gemm_batch);
+
+    const double byte = get_input_element_count(param) * type_size.in_ +
+                        get_weight_element_count(param) * type_size.wei_ +
+                        get_output_element_count(param) * type_size.out_;
+
+    plan.predicted_ns_ = std::max(get_compute_ns(model, config, plan.num_tiles_, plan.gemm_k_),
+                                  byte / model.byte_per_ns_);
+
+    plans.push_back(plan);
+}
+
+inline void add_bwd_weight_plans(const ConvParam& param,
+                                 const ConvDataTypeSize& type_size,
+                                 const ConvDeviceModel& model,
+                                 const ConvTileConfig& config,
+                                 std::vector<ConvPlan>& plans)
+{
+    const index_t merge               = config.num_groups_to_merge_;
+    const bool is_two_stage           = config.algorithm_ == ConvAlgorithm::BwdWeightTwoStage;
+    const long_index_t weight_element = get_weight_element_count(param);
+
+    ConvPlan plan;
+    plan.config_         = config;
+    plan.n_per_launch_   = param.N_;
+    plan.gemm_m_         = param.K_ * merge;
+    plan.gemm_n_         = param.C_ * product(param.filter_spatial_lengths_) * merge;
+    plan.gemm_k_         = param.N_ * product(param.output_spatial_lengths_);
+    plan.workspace_byte_ = is_two_stage ? weight_element * sizeof(float) : 0;
+
+    const double read_byte = get_input_element_count(param) * type_size.in_ +
+                             get_output_element_count(param) * type_size.out_;
+
+    for(index_t k_batch = 1; k_batch <= model.max_k_batch_; k_batch *= 2)
+    {
+        plan.k_batch_ = k_batch;
+
+        if(!is_conv_plan_legal(param, type_size, plan))
+            continue;
+
+        plan.num_tiles_ = get_num_tiles(config, plan.gemm_m_, plan.gemm_n_, param.G_ / merge);
+        plan.num_tiles_ *= k_batch;
+
+        const double compute_ns = get_compute_ns(
+            model, config, plan.num_tiles_, integer_divide_ceil(plan.gemm_k_, k_batch));
+
+        // every K-batch adds its partial result to the weight or the workspace
+        const std::size_t acc_size = is_two_stage ? sizeof(float) : type_size.wei_;
+        const double efficiency    = k_batch == 1 ? 1.
+                                     : acc_size >= sizeof(float)
+                                         ? model.atomic_efficiency_
+                                         : model.packed_atomic_efficiency_;
+        double reduce_ns = k_batch * weight_element * acc_size / (model.byte_per_ns_ * efficiency);
+
+        // clearing and converting the workspace
+        if(is_two_stage)
+        {
+            const std::size_t byte = 2 * sizeof(float) + type_size.wei_;
+
+            reduce_ns += weight_element * byte / model.byte_per_ns_ + model.launch_ns_;
+        }
+
+        plan.predicted_ns_ = std::max(compute_ns, read_byte / model.byte_per_ns_) + reduce_ns;
+
+        plans.push_back(plan);
+    }
+}
+
+} // namespace detail
+
+// every legal plan of the model's configs for the problem
+inline std::vector<ConvPlan> enumerate_conv_plans(const ConvParam& param,
+                                                  ConvDirection direction,
+                                                  const ConvDataTypeSize& type_size,
+                                                  const ConvDeviceModel& model = ConvDeviceModel{})
+{
+    std::vector<ConvPlan> plans;
+
+    for(const auto& config : model.configs_)
+    {
+        if(config.algorithm_ == ConvAlgorithm::Unknown ||
+           get_conv_direction(config.algorithm_) != direction)
+            continue;
+
+        if(direction == ConvDirection::Forward)
+            detail::add_fwd_plans(param, type_size, model, config, plans);
+        else
+            detail::add_bwd_weight_plans(param, type_size, model, config, plans);
+    }
+
+    return plans;
+}
+
+// the legal plan of least predicted time, of fewest tiles among equal ones
+inline ConvPlan make_conv_plan(const ConvParam& param,
+                               ConvDirection direction,
+                               const ConvDataTypeSize& type_size,
+                               const ConvDeviceModel& model = ConvDeviceModel{})
+{
+    const auto plans = enumerate_conv_plans(param, direction, type_size, model);
+
+    if(plans.empty())
+        throw std::runtime_error("no legal convolution plan in the device model");
+
+    return *std::min_element(plans.begin(), plans.end(), [](const auto& x, const auto& y) {
+        return x.predicted_ns_ < y.predicted_ns_ ||
+               (x.predicted_ns_ == y.predicted_ns_ && x.num_tiles_ < y.num_tiles_);
+    });
+}
+
+template <typename InDataType, typename WeiDataType, typename OutDataType>
+ConvPlan make_conv_plan(const ConvParam& param,
+                        ConvDirection direction,
+                        const ConvDeviceModel& model = ConvDeviceModel{})
+{
+    return make_conv_plan(
+        param, direction, get_conv_data_type_size<InDataType, WeiDataType, OutDataType>(), model);
+}
+
+//
+// Instance type strings, "Name<param, param, ...>"
+//
+inline ConvAlgorithm get_conv_algorithm(const std::string& type_string)
+{
+    const std::string name = type_string.substr(0, type_string.find('<'));
+
+    for(auto algorithm : {ConvAlgorithm::FwdXdl,
+                          ConvAlgorithm::FwdLargeTensor,
+                          ConvAlgorithm::BwdWeightAtomic,
+                          ConvAlgorithm::BwdWeightTwoStage})
+    {
+        if(name == get_conv_algorithm_name(algorithm))
+            return algorithm;
+    }
+
+    return ConvAlgorithm::Unknown;
+}
+
+// NumGroupsToMerge of an instance, 1 for implementations which do not merge groups
+inline index_t get_num_groups_to_merge(const std::string& type_string)
+{
+    const auto begin = type_string.find('<');
+    const auto end   = type_string.rfind('>');
+
+    if(begin == std::string::npos || end == std::string::npos || end < begin)
+        return 1;
+
+    std::vector<std::string> params;
+    for(std::size_t pos = begin + 1; pos <= end;)
+    {
+        const auto next = std::min(type_string.find(", ", pos), end);
+        params.push_back(type_string.substr(pos, next - pos));
+        pos = next + (next == end ? 1 : 2);
+    }
+
+    switch(get_conv_algorithm(type_string))
+    {
+    case ConvAlgorithm::FwdXdl: return std::stoi(params.back());
+    case ConvAlgorithm::BwdWeightTwoStage:
+        // the parameter after the pipeline version
+        for(std::size_t i = 0; i + 1 < params.size(); ++i)
+        {
+            if(params[i].rfind("BlkGemmPipelineVersion", 0) == 0)
+                return std::stoi(params[i + 1]);
+        }
+        return 1;
+    default: return 1;
+    }
+}
+
+// whether an instance implements the plan; instances the planner does not model are kept
+inline bool is_instance_in_conv_plan(const std::string& type_string, const ConvPlan& plan)
+{
+    const ConvAlgorithm algorithm = get_conv_algorithm(type_string);
+
+    if(algorithm == ConvAlgorithm::Unknown)
+        return true;
+
+    return algorithm == plan.config_.algorithm_ &&
+           get_num_groups_to_merge(type_string) == plan.config_.num_groups_to_merge_;
+}
+
+// drop the instances (pointers to device ops) which do not implement the plan
+template <typename InstancePtrs>
+void filter_conv_instances(InstancePtrs& op_ptrs, const ConvPlan& plan)
+{
+    op_ptrs.erase(std::remove_if(op_ptrs.begin(),
+                                 op_ptrs.end(),
+                                 [&](const auto& op_ptr) {
+                                     return !is_instance_in_conv_plan(op_ptr->GetTypeString(),
+                                                                      plan);
+                                 }),
+                  op_ptrs.end());
+}
+
+} // namespace conv
+} // namespace utils
+} // namespace ck
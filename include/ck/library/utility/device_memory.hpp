@@ -3,8 +3,13 @@
 
 #pragma once
 
-#include <hip/hip_runtime.h>
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
 
+#include "ck/host_utility/hip_runtime.hpp"
+
+#ifndef CK_USE_MOCK_HIP_RUNTIME
 template <typename T>
 __global__ void set_buffer_value(T* p, T x, uint64_t buffer_element_size)
 {
@@ -13,6 +18,7 @@ __global__ void set_buffer_value(T* p, T x, uint64_t buffer_element_size)
         p[i] = x;
     }
 }
+#endif
 
 /**
  * @brief Container for storing data in GPU device memory
@@ -46,5 +52,10 @@ void DeviceMem::SetValue(T x) const
         throw std::runtime_error("wrong! not entire DeviceMem will be set");
     }
 
+#ifdef CK_USE_MOCK_HIP_RUNTIME
+    // mock device memory is host memory
+    std::fill_n(static_cast<T*>(mpDeviceBuf), mMemSize / sizeof(T), x);
+#else
     set_buffer_value<T><<<1, 1024>>>(static_cast<T*>(mpDeviceBuf), x, mMemSize / sizeof(T));
+#endif
 }
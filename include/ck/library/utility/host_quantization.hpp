@@ -0,0 +1,455 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "ck/utility/data_type.hpp"
+#include "ck/utility/type_convert.hpp"
+#include "ck/tensor_operation/gpu/device/tensor_layout.hpp"
+#include "ck/library/utility/host_tensor.hpp"
+
+namespace ck {
+namespace utils {
+
+enum struct QuantRoundingMode
+{
+    NearestEven,
+    Stochastic,
+};
+
+// Region of a rows x cols matrix sharing one scale. Non-positive extents span the whole
+// dimension, so per-tensor, per-row and per-column scales are special cases of block scales.
+struct QuantBlock
+{
+    index_t rows = -1;
+    index_t cols = -1;
+
+    static constexpr QuantBlock PerTensor() { return {-1, -1}; }
+    static constexpr QuantBlock PerRow() { return {1, -1}; }
+    static constexpr QuantBlock PerColumn() { return {-1, 1}; }
+    static constexpr QuantBlock Block2D(index_t r, index_t c) { return {r, c}; }
+};
+
+struct QuantizationConfig
+{
+    QuantBlock block            = QuantBlock::Block2D(128, 128);
+    QuantRoundingMode rounding  = QuantRoundingMode::NearestEven;
+    uint32_t seed               = 0;
+    // floor for amax, keeps all-zero blocks from producing a zero scale
+    float min_amax              = 1e-12f;
+    std::size_t num_thread      = std::thread::hardware_concurrency();
+};
+
+namespace quant_detail {
+
+template <typename Q>
+inline constexpr bool is_integer_quant_v = std::is_same_v<Q, int8_t> || std::is_same_v<Q, pk_i4_t>;
+
+// largest magnitude representable by the quantized type
+template <typename Q>
+inline float QuantMax()
+{
+    if constexpr(std::is_same_v<Q, pk_i4_t>)
+        return 7.f;
+    else if constexpr(std::is_same_v<Q, int8_t>)
+        return 127.f;
+    else
+        return type_convert<float>(NumericLimits<Q>::Max());
+}
+
+// counter based hash, the random stream depends only on (seed, element) and not on threading
+inline float UniformFromCounter(uint32_t seed, uint64_t counter)
+{
+    uint64_t z = counter + (static_cast<uint64_t>(seed) << 32) + 0x9e3779b97f4a7c15ull;
+    z          = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z          = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    z          = z ^ (z >> 31);
+    return static_cast<float>(z >> 40) * (1.f / 16777216.f);
+}
+
+// Round x (already divided by the scale) to the grid of Q: to nearest, or up with probability
+// equal to the distance from the grid point below when u is uniform in [0, 1). The result is
+// exactly representable in Q, so the final conversion does not round again.
+template <typename Q>
+inline float RoundToGrid(float x, QuantRoundingMode rounding, float u)
+{
+    const float qmax = QuantMax<Q>();
+    x                = std::min(std::max(x, -qmax), qmax);
+
+    if constexpr(is_integer_quant_v<Q>)
+    {
+        return rounding == QuantRoundingMode::Stochastic ? std::min(std::floor(x + u), qmax)
+                                                         : std::nearbyint(x);
+    }
+    else
+    {
+        if(rounding != QuantRoundingMode::Stochastic)
+            return x;
+
+        // spacing of the grid around x, subnormals share the spacing of the smallest normal
+        constexpr int mant    = NumericUtils<Q>::mant;
+        constexpr int min_exp = 1 - NumericUtils<Q>::bias;
+
+        int e = 0;
+        std::frexp(x, &e);
+        const float ulp = std::ldexp(1.f, std::max(e - 1, min_exp) - mant);
+
+        return std::min(std::floor(x / ulp + u) * ulp, qmax);
+    }
+}
+
+template <typename Q>
+inline Q ConvertQuantized(float v)
+{
+    if constexpr(std::is_same_v<Q, int8_t>)
+        return static_cast<int8_t>(v);
+    else
+        return type_convert<Q>(v);
+}
+
+inline index_t BlockExtent(index_t block, index_t length) { return block > 0 ? block : length; }
+
+} // namespace quant_detail
+
+// Number of scales along each dimension
+inline std::array<index_t, 2> GetQuantScaleLengths(index_t rows, index_t cols, QuantBlock block)
+{
+    const index_t br = quant_detail::BlockExtent(block.rows, rows);
+    const index_t bc = quant_detail::BlockExtent(block.cols, cols);
+    return {(rows + br - 1) / br, (cols + bc - 1) / bc};
+}
+
+// scale(i / br, j / bc) = max(amax over the block, min_amax) / max(Q)
+//
+// x is any 2D host tensor, its strides define the layout. Work is split over rows; a row is
+// gathered into a contiguous fp32 buffer first so the amax loop vectorizes.
+template <typename Q, typename XDataType, typename ScaleDataType>
+void ComputeQuantScales(const Tensor<XDataType>& x,
+                        Tensor<ScaleDataType>& scale,
+                        const QuantizationConfig& config)
+{
+    const index_t rows = x.mDesc.GetLengths()[0];
+    const index_t cols = x.mDesc.GetLengths()[1];
+    const index_t br   = quant_detail::BlockExtent(config.block.rows, rows);
+    const index_t bc   = quant_detail::BlockExtent(config.block.cols, cols);
+    const auto lens    = GetQuantScaleLengths(rows, cols, config.block);
+
+    if(scale.mDesc.GetLengths()[0] != static_cast<std::size_t>(lens[0]) ||
+       scale.mDesc.GetLengths()[1] != static_cast<std::size_t>(lens[1]))
+    {
+        throw std::runtime_error("ComputeQuantScales: wrong scale tensor lengths");
+    }
+
+    // amax of every (row, column block), reduced over the block rows afterwards
+    std::vector<float> row_amax(static_cast<std::size_t>(rows) * lens[1]);
+
+    auto f_row = [&](auto i) {
+        std::vector<float> buf(cols);
+        for(index_t j = 0; j < cols; ++j)
+            buf[j] = type_convert<float>(x(i, j));
+
+        for(index_t jb = 0; jb < lens[1]; ++jb)
+        {
+            const index_t end = std::min(cols, (jb + 1) * bc);
+            float amax        = 0.f;
+            for(index_t j = jb * bc; j < end; ++j)
+                amax = std::max(amax, std::abs(buf[j]));
+            row_amax[i * lens[1] + jb] = amax;
+        }
+    };
+    make_ParallelTensorFunctor(f_row, rows)(config.num_thread);
+
+    const float qmax = quant_detail::QuantMax<Q>();
+
+    for(index_t ib = 0; ib < lens[0]; ++ib)
+    {
+        for(index_t jb = 0; jb < lens[1]; ++jb)
+        {
+            float amax = 0.f;
+            for(index_t i = ib * br; i < std::min(rows, (ib + 1) * br); ++i)
+                amax = std::max(amax, row_amax[i * lens[1] + jb]);
+
+            scale(ib, jb) = type_convert<ScaleDataType>(std::max(amax, config.min_amax) / qmax);
+        }
+    }
+}
+
+// q(i, j) = round(x(i, j) / scale(i / br, j / bc)); x and q may have different layouts.
+// Stochastic rounding draws its random number from (seed, row major element index).
+template <typename Q, typename XDataType, typename ScaleDataType>
+void QuantizeWithScales(const Tensor<XDataType>& x,
+                        const Tensor<ScaleDataType>& scale,
+                        Tensor<Q>& q,
+                        const QuantizationConfig& config)
+{
+    const index_t rows = x.mDesc.GetLengths()[0];
+    const index_t cols = x.mDesc.GetLengths()[1];
+    const index_t br   = quant_detail::BlockExtent(config.block.rows, rows);
+    const index_t bc   = quant_detail::BlockExtent(config.block.cols, cols);
+
+    auto f_row = [&](auto i) {
+        std::vector<float> buf(cols);
+        for(index_t j = 0; j < cols; ++j)
+            buf[j] = type_convert<float>(x(i, j)) / type_convert<float>(scale(i / br, j / bc));
+
+        for(index_t j = 0; j < cols; ++j)
+        {
+            const float u =
+                config.rounding == QuantRoundingMode::Stochastic
+                    ? quant_detail::UniformFromCounter(config.seed,
+                                                       static_cast<uint64_t>(i) * cols + j)
+                    : 0.f;
+            buf[j] = quant_detail::RoundToGrid<Q>(buf[j], config.rounding, u);
+        }
+
+        if constexpr(std::is_same_v<Q, pk_i4_t>)
+        {
+            // two values per byte, even index in the high nibble, stored with an offset of 8
+            for(index_t j = 0; j < cols; ++j)
+            {
+                const int nibble = static_cast<int>(buf[j]) + 8;
+                auto& packed     = q(i, j).data;
+                const bool high  = (q.mDesc.GetOffsetFromMultiIndex(i, j) % 2) == 0;
+                packed           = high ? static_cast<int8_t>((packed & 0x0f) | (nibble << 4))
+                                        : static_cast<int8_t>((packed & 0xf0) | nibble);
+            }
+        }
+        else
+        {
+            for(index_t j = 0; j < cols; ++j)
+                q(i, j) = quant_detail::ConvertQuantized<Q>(buf[j]);
+        }
+    };
+
+    if constexpr(std::is_same_v<Q, pk_i4_t>)
+    {
+        // neighbouring rows of a column major tensor share bytes, keep each pair on one thread
+        auto f_row_pair = [&](auto p) {
+            f_row(2 * p);
+            if(2 * p + 1 < static_cast<std::size_t>(rows))
+                f_row(2 * p + 1);
+        };
+        make_ParallelTensorFunctor(f_row_pair, (rows + 1) / 2)(config.num_thread);
+    }
+    else
+    {
+        make_ParallelTensorFunctor(f_row, rows)(config.num_thread);
+    }
+}
+
+// amax scales followed by quantization, returns nothing as both outputs are caller owned so they
+// can be created with the exact lengths/strides the device operation expects
+template <typename Q, typename XDataType, typename ScaleDataType>
+void Quantize(const Tensor<XDataType>& x,
+              Tensor<Q>& q,
+              Tensor<ScaleDataType>& scale,
+              const QuantizationConfig& config)
+{
+    ComputeQuantScales<Q>(x, scale, config);
+    QuantizeWithScales(x, scale, q, config);
+}
+
+template <typename Q, typename ScaleDataType, typename YDataType>
+void Dequantize(const Tensor<Q>& q,
+                const Tensor<ScaleDataType>& scale,
+                Tensor<YDataType>& y,
+                QuantBlock block,
+                std::size_t num_thread = std::thread::hardware_concurrency())
+{
+    const index_t rows = q.mDesc.GetLengths()[0];
+    const index_t cols = q.mDesc.GetLengths()[1];
+    const index_t br   = quant_detail::BlockExtent(block.rows, rows);
+    const index_t bc   = quant_detail::BlockExtent(block.cols, cols);
+
+    auto f = [&](auto i, auto j) {
+        float v;
+        if constexpr(std::is_same_v<Q, pk_i4_t>)
+        {
+            const int8_t packed = q(i, j).data;
+            const bool high     = (q.mDesc.GetOffsetFromMultiIndex(i, j) % 2) == 0;
+            v = static_cast<float>((high ? (packed >> 4) & 0xf : packed & 0xf) - 8);
+        }
+        else
+        {
+            v = type_convert<float>(q(i, j));
+        }
+        y(i, j) = type_convert<YDataType>(v * type_convert<float>(scale(i / br, j / bc)));
+    };
+    make_ParallelTensorFunctor(f, rows, cols)(num_thread);
+}
+
+// Lengths/strides of the operands of DeviceGemmMultiD_ABScale_Xdl_CShuffle_V3 and
+// DeviceGemm_Xdl_CShuffleV3 with B scales: A is M x K, B is K x N, and each scale tensor uses
+// the layout of its data tensor, packed.
+template <typename Layout>
+HostTensorDescriptor
+MakeGemmOperandDescriptor(std::size_t rows, std::size_t cols, std::size_t stride, Layout)
+{
+    if constexpr(std::is_same_v<Layout, tensor_layout::gemm::RowMajor>)
+        return HostTensorDescriptor({rows, cols}, {stride, std::size_t{1}});
+    else
+        return HostTensorDescriptor({rows, cols}, {std::size_t{1}, stride});
+}
+
+template <typename ADataType,
+          typename AScaleDataType,
+          typename BDataType,
+          typename BScaleDataType,
+          typename ALayout = tensor_layout::gemm::RowMajor,
+          typename BLayout = tensor_layout::gemm::ColumnMajor>
+struct GemmABScaleOperands
+{
+    Tensor<ADataType> a_m_k;
+    Tensor<AScaleDataType> a_scale;
+    Tensor<BDataType> b_k_n;
+    Tensor<BScaleDataType> b_scale;
+
+    index_t StrideA;
+    index_t StrideB;
+    // leading dimensions of the scale tensors, as passed to MakeArgument
+    index_t Scale_Stride_AM;
+    index_t Scale_Stride_BN;
+};
+
+// Quantize fp32/fp16/bf16 A (M x K) and B (K x N) with ScaleBlockM x ScaleBlockK and
+// ScaleBlockK x ScaleBlockN block scales into the packed (ALayout, BLayout) operands of the
+// ab_scale GEMM. Only the block shape and the rounding of `config` are used.
+template <typename ADataType,
+          typename AScaleDataType,
+          typename BDataType,
+          typename BScaleDataType,
+          typename ALayout = tensor_layout::gemm::RowMajor,
+          typename BLayout = tensor_layout::gemm::ColumnMajor,
+          typename XADataType,
+          typename XBDataType>
+GemmABScaleOperands<ADataType, AScaleDataType, BDataType, BScaleDataType, ALayout, BLayout>
+QuantizeGemmABScale(const Tensor<XADataType>& a_m_k,
+                    const Tensor<XBDataType>& b_k_n,
+                    index_t ScaleBlockM,
+                    index_t ScaleBlockN,
+                    index_t ScaleBlockK,
+                    QuantizationConfig config = {})
+{
+    const index_t M = a_m_k.mDesc.GetLengths()[0];
+    const index_t K = a_m_k.mDesc.GetLengths()[1];
+    const index_t N = b_k_n.mDesc.GetLengths()[1];
+
+    const index_t StrideA = std::is_same_v<ALayout, tensor_layout::gemm::RowMajor> ? K : M;
+    const index_t StrideB = std::is_same_v<BLayout, tensor_layout::gemm::RowMajor> ? N : K;
+
+    const auto a_scale_lens = GetQuantScaleLengths(M, K, {ScaleBlockM, ScaleBlockK});
+    const auto b_scale_lens = GetQuantScaleLengths(K, N, {ScaleBlockK, ScaleBlockN});
+
+    const index_t Scale_Stride_AM =
+        std::is_same_v<ALayout, tensor_layout::gemm::RowMajor> ? a_scale_lens[1] : a_scale_lens[0];
+    const index_t Scale_Stride_BN =
+        std::is_same_v<BLayout, tensor_layout::gemm::RowMajor> ? b_scale_lens[1] : b_scale_lens[0];
+
+    GemmABScaleOperands<ADataType, AScaleDataType, BDataType, BScaleDataType, ALayout, BLayout>
+        r{Tensor<ADataType>(MakeGemmOperandDescriptor(M, K, StrideA, ALayout{})),
+          Tensor<AScaleDataType>(MakeGemmOperandDescriptor(
+              a_scale_lens[0], a_scale_lens[1], Scale_Stride_AM, ALayout{})),
+          Tensor<BDataType>(MakeGemmOperandDescriptor(K, N, StrideB, BLayout{})),
+          Tensor<BScaleDataType>(MakeGemmOperandDescriptor(
+              b_scale_lens[0], b_scale_lens[1], Scale_Stride_BN, BLayout{})),
+          StrideA,
+          StrideB,
+          Scale_Stride_AM,
+          Scale_Stride_BN};
+
+    config.block = {ScaleBlockM, ScaleBlockK};
+    Quantize(a_m_k, r.a_m_k, r.a_scale, config);
+
+    config.block = {ScaleBlockK, ScaleBlockN};
+    config.seed += 1;
+    Quantize(b_k_n, r.b_k_n, r.b_scale, config);
+
+    return r;
+}
+
+// Reorder every 8 consecutive int4 values along K from 01234567 to 20643175, the order in which
+// the b_scale / pk_i4 GEMM instances unpack them. B is K x N column major.
+inline void PermutePkI4ForGemm(Tensor<pk_i4_t>& b_k_n,
+                               std::size_t num_thread = std::thread::hardware_concurrency())
+{
+    const index_t K = b_k_n.mDesc.GetLengths()[0];
+    const index_t N = b_k_n.mDesc.GetLengths()[1];
+
+    if(K % 8 != 0)
+        throw std::runtime_error("PermutePkI4ForGemm: K must be a multiple of 8");
+
+    auto f = [&](auto n) {
+        for(index_t k = 0; k < K; k += 8)
+        {
+            int v[8];
+            for(int i = 0; i < 4; ++i)
+            {
+                const int i4x2 = b_k_n(k + i * 2, n).data;
+                v[i * 2 + 0]   = (i4x2 >> 4) & 0xf;
+                v[i * 2 + 1]   = (i4x2 >> 0) & 0xf;
+            }
+            b_k_n(k + 0, n) = static_cast<int8_t>((v[2] << 4) | v[0]);
+            b_k_n(k + 2, n) = static_cast<int8_t>((v[6] << 4) | v[4]);
+            b_k_n(k + 4, n) = static_cast<int8_t>((v[3] << 4) | v[1]);
+            b_k_n(k + 6, n) = static_cast<int8_t>((v[7] << 4) | v[5]);
+        }
+    };
+    make_ParallelTensorFunctor(f, N)(num_thread);
+}
+
+template <typename BScaleDataType>
+struct GemmBScaleOperands
+{
+    // unpermuted values, for host reference/dequantization
+    Tensor<pk_i4_t> b_k_n;
+    // what the device operation consumes
+    Tensor<pk_i4_t> b_k_n_permute;
+    Tensor<BScaleDataType> b_scale;
+
+    index_t StrideB;
+    index_t Scale_Stride_BN;
+};
+
+// Quantize B (K x N) to int4 with ScaleBlockK x ScaleBlockN scales for the column major
+// pk_i4 b_scale GEMM instances.
+template <typename BScaleDataType, typename XBDataType>
+GemmBScaleOperands<BScaleDataType> QuantizeGemmBScale(const Tensor<XBDataType>& b_k_n,
+                                                      index_t ScaleBlockN,
+                                                      index_t ScaleBlockK,
+                                                      QuantizationConfig config = {})
+{
+    using Col = tensor_layout::gemm::ColumnMajor;
+
+    const index_t K = b_k_n.mDesc.GetLengths()[0];
+    const index_t N = b_k_n.mDesc.GetLengths()[1];
+
+    const auto scale_lens = GetQuantScaleLengths(K, N, {ScaleBlockK, ScaleBlockN});
+
+    GemmBScaleOperands<BScaleDataType> r{
+        Tensor<pk_i4_t>(MakeGemmOperandDescriptor(K, N, K, Col{})),
+        Tensor<pk_i4_t>(MakeGemmOperandDescriptor(K, N, K, Col{})),
+        Tensor<BScaleDataType>(
+            MakeGemmOperandDescriptor(scale_lens[0], scale_lens[1], scale_lens[0], Col{})),
+        K,
+        scale_lens[0]};
+
+    config.block = {ScaleBlockK, ScaleBlockN};
+    Quantize(b_k_n, r.b_k_n, r.b_scale, config);
+
+    r.b_k_n_permute.mData = r.b_k_n.mData;
+    PermutePkI4ForGemm(r.b_k_n_permute, config.num_thread);
+
+    return r;
+}
+
+} // namespace utils
+} // namespace ck
@@ -0,0 +1,456 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
+
+#include "ck/utility/data_type.hpp"
+#include "ck/utility/type_convert.hpp"
+#include "ck/tensor_operation/gpu/device/tensor_layout.hpp"
+#include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/utility/host_quantization.hpp"
+
+namespace ck {
+namespace utils {
+
+// How quantized weights are laid out for the device. The storage type of the packed weight
+// selects the instance family:
+//   pk_i4_t : DeviceGemm_Xdl_CShuffleV3 with pk_i4 B (with or without B scales). B is column
+//             major, every 8 values along K are reordered 01234567 -> 20643175 and stored
+//             biased by 8. With k_per_block > 0 the PermuteB = true instances are targeted and
+//             B is tiled as K0 x N x K1 with K1 = k_per_block.
+//   uint8_t : DeviceFpAintBGemm_Wmma_CShuffle, int8 values biased by 128 (see
+//             example/64_fpAintB_gemm), one scale per column.
+//   int8_t  : plain int8 B of the bf16Aint8B instances, the per column scale is passed as a
+//             broadcast D tensor and applied by the Multiply element-wise operation.
+struct WeightPackingSpec
+{
+    index_t k_per_block = 0;
+    // shape of the blocks sharing a scale and a zero point, -1 spans the whole dimension
+    index_t scale_block_k = -1;
+    index_t scale_block_n = 1;
+
+    std::size_t num_thread = std::thread::hardware_concurrency();
+
+    static WeightPackingSpec PkI4(index_t k_per_block = 0)
+    {
+        return {k_per_block, -1, 1};
+    }
+    static WeightPackingSpec PkI4BScale(index_t scale_block_k,
+                                                  index_t scale_block_n = 1,
+                                                  index_t k_per_block   = 0)
+    {
+        return {k_per_block, scale_block_k, scale_block_n};
+    }
+    static WeightPackingSpec PerColumn() { return {0, -1, 1}; }
+};
+
+template <typename BDataType, typename ScaleDataType>
+struct PackedWeight
+{
+    // device ready values; the descriptor is the K x N view the kernel is given
+    Tensor<BDataType> b_k_n;
+    Tensor<ScaleDataType> scale;
+
+    index_t StrideB;
+    // leading dimension of the scale tensor, 0 for the broadcast per column scales
+    index_t StrideScale;
+
+    uint64_t key;
+
+    std::size_t GetSizeInBytes() const
+    {
+        return b_k_n.GetElementSpaceSizeInBytes() + scale.GetElementSpaceSizeInBytes();
+    }
+};
+
+namespace packing_detail {
+
+// FNV-1a
+inline uint64_t HashBytes(const void* p, std::size_t size, uint64_t h = 0xcbf29ce484222325ull)
+{
+    const auto* bytes = static_cast<const unsigned char*>(p);
+    for(std::size_t i = 0; i < size; ++i)
+    {
+        h ^= bytes[i];
+        h *= 0x100000001b3ull;
+    }
+    return h;
+}
+
+inline uint64_t HashCombine(uint64_t seed, uint64_t v)
+{
+    return seed ^ (v + 0x9e3779b97f4a7c15ull + (seed << 12) + (seed >> 4));
+}
+
+// the chunks are hashed concurrently and then combined in order, so the result does not
+// depend on the number of threads
+inline uint64_t
+HashBuffer(const void* p, std::size_t size, std::size_t num_thread, std::size_t chunk = 1 << 20)
+{
+    const std::size_t num_chunk = std::max<std::size_t>(1, (size + chunk - 1) / chunk);
+
+    std::vector<uint64_t> chunk_hashes(num_chunk);
+
+    auto f = [&](auto i) {
+        const std::size_t begin = i * chunk;
+        const std::size_t end   = std::min(size, begin + chunk);
+        chunk_hashes[i] =
+            HashBytes(static_cast<const unsigned char*>(p) + begin, end > begin ? end - begin : 0);
+    };
+    make_ParallelTensorFunctor(f, num_chunk)(std::min(num_thread, num_chunk));
+
+    uint64_t h = size;
+    for(uint64_t c : chunk_hashes)
+        h = HashCombine(h, c);
+    return h;
+}
+
+template <typename T>
+uint64_t HashTensor(const Tensor<T>& t, std::size_t num_thread)
+{
+    uint64_t h = 0;
+    for(std::size_t len : t.mDesc.GetLengths())
+        h = HashCombine(h, len);
+    for(std::size_t stride : t.mDesc.GetStrides())
+        h = HashCombine(h, stride);
+    return HashCombine(h, HashBuffer(t.mData.data(), t.mData.size() * sizeof(T), num_thread));
+}
+
+template <typename BDataType>
+constexpr int PackedMin()
+{
+    return std::is_same_v<BDataType, pk_i4_t> ? -8 : -128;
+}
+
+template <typename BDataType>
+constexpr int PackedMax()
+{
+    return std::is_same_v<BDataType, pk_i4_t> ? 7 : 127;
+}
+
+} // namespace packing_detail
+
+// Key under which the packed form of the inputs is cached: content hash of the weight, scale and
+// zero point tensors combined with the target type and packing spec.
+template <typename BDataType, typename ScaleDataType, typename BLayout>
+uint64_t GetWeightPackingKey(const Tensor<int8_t>& w_k_n,
+                             const Tensor<float>* scale,
+                             const Tensor<int8_t>* zero_point,
+                             const WeightPackingSpec& spec)
+{
+    using namespace packing_detail;
+
+    uint64_t h = HashTensor(w_k_n, spec.num_thread);
+    h          = HashCombine(h, scale != nullptr ? HashTensor(*scale, spec.num_thread) : 0);
+    h = HashCombine(h, zero_point != nullptr ? HashTensor(*zero_point, spec.num_thread) : 0);
+
+    h = HashCombine(h, typeid(BDataType).hash_code());
+    h = HashCombine(h, typeid(ScaleDataType).hash_code());
+    h = HashCombine(h, typeid(BLayout).hash_code());
+    h = HashCombine(h, static_cast<uint64_t>(spec.k_per_block));
+    h = HashCombine(h, static_cast<uint64_t>(spec.scale_block_k));
+    h = HashCombine(h, static_cast<uint64_t>(spec.scale_block_n));
+
+    return h;
+}
+
+// Convert int8 weights (int4 values for pk_i4_t, in [-8, 7]) stored in any K x N layout into
+// the operand a BDataType instance family consumes (see WeightPackingSpec). The dequantized
+// weight is (w - zero_point) * scale; zero points are folded into the values, so an error is
+// thrown if a folded value does not fit BDataType. Without scales a single scale of 1 is
+// emitted. Work is split over the N columns.
+template <typename BDataType,
+          typename ScaleDataType,
+          typename BLayout = tensor_layout::gemm::ColumnMajor>
+PackedWeight<BDataType, ScaleDataType> PackWeight(const Tensor<int8_t>& w_k_n,
+                                                  const Tensor<float>* scale,
+                                                  const Tensor<int8_t>* zero_point,
+                                                  const WeightPackingSpec& spec = {})
+{
+    using Row = tensor_layout::gemm::RowMajor;
+    using Col = tensor_layout::gemm::ColumnMajor;
+
+    constexpr bool is_pk_i4 = std::is_same_v<BDataType, pk_i4_t>;
+
+    static_assert(is_pk_i4 || std::is_same_v<BDataType, int8_t> ||
+                      std::is_same_v<BDataType, uint8_t>,
+                  "PackWeight: unsupported packed weight type");
+    static_assert(!is_pk_i4 || std::is_same_v<BLayout, Col>,
+                  "PackWeight: pk_i4 weights are column major");
+
+    const index_t K = w_k_n.mDesc.GetLengths()[0];
+    const index_t N = w_k_n.mDesc.GetLengths()[1];
+
+    const index_t block_k = quant_detail::BlockExtent(spec.scale_block_k, K);
+    const index_t block_n = quant_detail::BlockExtent(spec.scale_block_n, N);
+
+    const auto scale_lens = GetQuantScaleLengths(K, N, {spec.scale_block_k, spec.scale_block_n});
+
+    auto check_lengths = [&](const auto* t, const char* name) {
+        if(t != nullptr && (static_cast<index_t>(t->mDesc.GetLengths()[0]) != scale_lens[0] ||
+                            static_cast<index_t>(t->mDesc.GetLengths()[1]) != scale_lens[1]))
+        {
+            throw std::runtime_error(std::string("PackWeight: ") + name + " must be " +
+                                     std::to_string(scale_lens[0]) + " x " +
+                                     std::to_string(scale_lens[1]));
+        }
+    };
+    check_lengths(scale, "scale");
+    check_lengths(zero_point, "zero_point");
+
+    if constexpr(is_pk_i4)
+    {
+        if(K % 8 != 0)
+            throw std::runtime_error("PackWeight: K must be a multiple of 8 for pk_i4");
+        if(spec.k_per_block > 0 && (K % spec.k_per_block != 0 || spec.k_per_block % 8 != 0))
+            throw std::runtime_error(
+                "PackWeight: k_per_block must be a multiple of 8 and divide K");
+    }
+    else
+    {
+        if(spec.k_per_block > 0)
+            throw std::runtime_error("PackWeight: K tiling is only supported for pk_i4");
+        if(scale != nullptr && (scale_lens[0] != 1 || block_n != 1))
+            throw std::runtime_error("PackWeight: int8 weights take one scale per column");
+    }
+
+    const index_t StrideB = std::is_same_v<BLayout, Row> ? N : K;
+
+    // int8 instance families read the per column scale through a broadcast K x N view
+    const bool broadcast_scale = !is_pk_i4 && scale != nullptr;
+    const index_t StrideScale  = scale == nullptr ? 1 : (broadcast_scale ? 0 : scale_lens[0]);
+
+    PackedWeight<BDataType, ScaleDataType> r{
+        Tensor<BDataType>(MakeGemmOperandDescriptor(K, N, StrideB, BLayout{})),
+        Tensor<ScaleDataType>(
+            scale == nullptr
+                ? HostTensorDescriptor({1, 1})
+                : (broadcast_scale ? HostTensorDescriptor({std::size_t(K), std::size_t(N)},
+                                                          {std::size_t{0}, std::size_t{1}})
+                                   : MakeGemmOperandDescriptor(
+                                         scale_lens[0], scale_lens[1], StrideScale, Col{}))),
+        StrideB,
+        StrideScale,
+        GetWeightPackingKey<BDataType, ScaleDataType, BLayout>(w_k_n, scale, zero_point, spec)};
+
+    if(scale == nullptr)
+    {
+        r.scale.mData[0] = type_convert<ScaleDataType>(1.f);
+    }
+    else if(broadcast_scale)
+    {
+        for(index_t n = 0; n < N; ++n)
+            r.scale(0, n) = type_convert<ScaleDataType>((*scale)(0, n));
+    }
+    else
+    {
+        for(index_t kb = 0; kb < scale_lens[0]; ++kb)
+            for(index_t nb = 0; nb < scale_lens[1]; ++nb)
+                r.scale(kb, nb) = type_convert<ScaleDataType>((*scale)(kb, nb));
+    }
+
+    constexpr int qmin = packing_detail::PackedMin<BDataType>();
+    constexpr int qmax = packing_detail::PackedMax<BDataType>();
+
+    std::atomic<std::size_t> num_out_of_range{0};
+
+    auto folded = [&](index_t k, index_t n) {
+        int v = w_k_n(k, n);
+        if(zero_point != nullptr)
+            v -= (*zero_point)(k / block_k, n / block_n);
+        if(v < qmin || v > qmax)
+        {
+            ++num_out_of_range;
+            v = std::clamp(v, qmin, qmax);
+        }
+        return v;
+    };
+
+    if constexpr(is_pk_i4)
+    {
+        const index_t K1 = spec.k_per_block > 0 ? spec.k_per_block : K;
+
+        auto f = [&](auto n) {
+            for(index_t k = 0; k < K; k += 8)
+            {
+                // stored biased by 8, in the 20643175 order of the device unpacking
+                int u[8];
+                for(int i = 0; i < 8; ++i)
+                    u[i] = folded(k + i, n) + 8;
+
+                // K0 x N x K1; with K1 = K this is the plain column major layout
+                const std::size_t offset =
+                    (static_cast<std::size_t>(k / K1) * N + n) * K1 + k % K1;
+                BDataType* dst = r.b_k_n.mData.data() + offset / 2;
+
+                dst[0] = static_cast<int8_t>((u[2] << 4) | u[0]);
+                dst[1] = static_cast<int8_t>((u[6] << 4) | u[4]);
+                dst[2] = static_cast<int8_t>((u[3] << 4) | u[1]);
+                dst[3] = static_cast<int8_t>((u[7] << 4) | u[5]);
+            }
+        };
+        make_ParallelTensorFunctor(f, N)(spec.num_thread);
+    }
+    else
+    {
+        auto f = [&](auto n) {
+            for(index_t k = 0; k < K; ++k)
+            {
+                if constexpr(std::is_same_v<BDataType, uint8_t>)
+                    r.b_k_n(k, n) = static_cast<uint8_t>(folded(k, n) + 128);
+                else
+                    r.b_k_n(k, n) = static_cast<int8_t>(folded(k, n));
+            }
+        };
+        make_ParallelTensorFunctor(f, N)(spec.num_thread);
+    }
+
+    if(num_out_of_range > 0)
+    {
+        throw std::runtime_error("PackWeight: " + std::to_string(num_out_of_range.load()) +
+                                 " weights do not fit the packed type after subtracting the "
+                                 "zero points");
+    }
+
+    return r;
+}
+
+template <typename BDataType,
+          typename ScaleDataType,
+          typename BLayout = tensor_layout::gemm::ColumnMajor>
+PackedWeight<BDataType, ScaleDataType>
+PackWeight(const Tensor<int8_t>& w_k_n, const Tensor<float>& scale, const WeightPackingSpec& spec)
+{
+    return PackWeight<BDataType, ScaleDataType, BLayout>(w_k_n, &scale, nullptr, spec);
+}
+
+// Thread safe cache of packed weights keyed by GetWeightPackingKey, so a checkpoint loaded
+// again (or a weight shared by several layers) is hashed but not repacked. With a non-zero
+// capacity the least recently used entries are dropped once the packed bytes exceed it;
+// entries still held by callers stay alive through their shared_ptr.
+template <typename BDataType,
+          typename ScaleDataType,
+          typename BLayout = tensor_layout::gemm::ColumnMajor>
+class WeightPackingCache
+{
+    public:
+    using Packed = PackedWeight<BDataType, ScaleDataType>;
+
+    explicit WeightPackingCache(std::size_t capacity_in_bytes = 0)
+        : mCapacityInBytes(capacity_in_bytes)
+    {
+    }
+
+    std::shared_ptr<const Packed> GetOrPack(const Tensor<int8_t>& w_k_n,
+                                            const Tensor<float>* scale,
+                                            const Tensor<int8_t>* zero_point,
+                                            const WeightPackingSpec& spec = {})
+    {
+        const uint64_t key =
+            GetWeightPackingKey<BDataType, ScaleDataType, BLayout>(w_k_n, scale, zero_point, spec);
+
+        if(auto packed = Find(key))
+        {
+            ++mNumHits;
+            return packed;
+        }
+        ++mNumMisses;
+
+        // packing runs outside of the lock, a concurrent miss on the same key packs twice and
+        // the first insertion wins
+        auto packed = std::make_shared<const Packed>(
+            PackWeight<BDataType, ScaleDataType, BLayout>(w_k_n, scale, zero_point, spec));
+
+        return Insert(key, std::move(packed));
+    }
+
+    std::shared_ptr<const Packed> Find(uint64_t key)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        auto it = mIndex.find(key);
+        if(it == mIndex.end())
+            return nullptr;
+
+        mEntries.splice(mEntries.begin(), mEntries, it->second);
+        return it->second->second;
+    }
+
+    void Clear()
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        mEntries.clear();
+        mIndex.clear();
+        mSizeInBytes = 0;
+    }
+
+    std::size_t GetNumEntries() const
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mEntries.size();
+    }
+
+    std::size_t GetSizeInBytes() const
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mSizeInBytes;
+    }
+
+    std::size_t GetNumHits() const { return mNumHits; }
+    std::size_t GetNumMisses() const { return mNumMisses; }
+
+    private:
+    using Entry = std::pair<uint64_t, std::shared_ptr<const Packed>>;
+
+    std::shared_ptr<const Packed> Insert(uint64_t key, std::shared_ptr<const Packed> packed)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        auto it = mIndex.find(key);
+        if(it != mIndex.end())
+            return it->second->second;
+
+        mEntries.emplace_front(key, packed);
+        mIndex.emplace(key, mEntries.begin());
+        mSizeInBytes += packed->GetSizeInBytes();
+
+        // never evict the entry just inserted
+        while(mCapacityInBytes > 0 && mSizeInBytes > mCapacityInBytes && mEntries.size() > 1)
+        {
+            mSizeInBytes -= mEntries.back().second->GetSizeInBytes();
+            mIndex.erase(mEntries.back().first);
+            mEntries.pop_back();
+        }
+
+        return packed;
+    }
+
+    std::size_t mCapacityInBytes;
+    std::size_t mSizeInBytes = 0;
+
+    // most recently used first
+    std::list<Entry> mEntries;
+    std::unordered_map<uint64_t, typename std::list<Entry>::iterator> mIndex;
+    mutable std::mutex mMutex;
+
+    std::atomic<std::size_t> mNumHits{0};
+    std::atomic<std::size_t> mNumMisses{0};
+};
+
+} // namespace utils
+} // namespace ck
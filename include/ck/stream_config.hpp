@@ -3,8 +3,12 @@
 
 #pragma once
 
-#include <hip/hip_runtime.h>
+#include "ck/host_utility/hip_runtime.hpp"
+#ifndef CK_USE_MOCK_HIP_RUNTIME
 #include <hip/hip_fp16.h>
+#endif
+
+#include "ck/host_utility/timing_statistics.hpp"
 
 struct StreamConfig
 {
@@ -16,4 +20,12 @@ struct StreamConfig
 
     bool flush_cache   = false;
     int rotating_count = 1;
+
+    // when set, every timed launch is measured separately, the statistics are written here and
+    // the median instead of the mean time is returned
+    ck::TimingStatistics* timing_stats_ = nullptr;
+    // > 0: repeat the launches (up to max_nrepeat_) until the median is known to this relative
+    // precision, only used together with timing_stats_
+    float target_rel_ci_ = 0.f;
+    int max_nrepeat_     = 1000;
 };
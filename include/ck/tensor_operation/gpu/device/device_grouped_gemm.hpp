@@ -178,6 +178,61 @@ struct DeviceGroupedGemm : public BaseOperator
             << __FILE__ << ":" << __LINE__ << ", in function: " << __func__;
         throw std::runtime_error(err.str());
     }
+
+    //----------------------------------------------------------------------------------------------
+    /// @brief      Rebinds the data pointers of an existing Argument.
+    ///
+    ///             The problem shapes are kept, so the descriptors and validity checks built
+    ///             for them are reused and the next Run only uploads the changed pointers.
+    ///
+    /// @param      p_arg  The pointer to the Argument we're going to update.
+    /// @param[in]  p_a    The new A pointers, one per group.
+    /// @param[in]  p_b    The new B pointers, one per group.
+    /// @param[in]  p_ds   The new Ds pointers, one per group.
+    /// @param[in]  p_e    The new E pointers, one per group.
+    ///
+    virtual void UpdatePointers(BaseArgument* p_arg,
+                                const std::vector<const void*>& p_a,
+                                const std::vector<const void*>& p_b,
+                                const std::vector<std::array<const void*, NumDTensor>>& p_ds,
+                                const std::vector<void*>& p_e) const
+    {
+        ignore = p_arg;
+        ignore = p_a;
+        ignore = p_b;
+        ignore = p_ds;
+        ignore = p_e;
+
+        std::ostringstream err;
+        err << "This function is not implemented by the kernel: " << this->GetTypeString()
+            << __FILE__ << ":" << __LINE__ << ", in function: " << __func__;
+        throw std::runtime_error(err.str());
+    }
+
+    //----------------------------------------------------------------------------------------------
+    /// @brief      Copies new host kernel arguments to the device kernel arguments buffer.
+    ///
+    ///             Only the groups that changed since the last update of the same buffer are
+    ///             copied, which makes it cheap to change pointers or per-group M every call.
+    ///
+    /// @param      p_arg               The pointer to the Argument we're going to update.
+    /// @param[in]  p_host_kernel_args  The pointer to the host memory which contains kernel
+    ///                                 arguments, in the layout of GetDeviceKernelArgSize.
+    /// @param[in]  stream_config       The stream the copy is enqueued on.
+    ///
+    virtual void UpdateDeviceKernelArgs(BaseArgument* p_arg,
+                                        const void* p_host_kernel_args,
+                                        const StreamConfig& stream_config = StreamConfig{}) const
+    {
+        ignore = p_arg;
+        ignore = p_host_kernel_args;
+        ignore = stream_config;
+
+        std::ostringstream err;
+        err << "This function is not implemented by the kernel: " << this->GetTypeString()
+            << __FILE__ << ":" << __LINE__ << ", in function: " << __func__;
+        throw std::runtime_error(err.str());
+    }
 };
 
 } // namespace device
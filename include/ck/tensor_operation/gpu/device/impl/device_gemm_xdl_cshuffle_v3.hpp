@@ -1,9 +1,12 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2018-2023, Advanced Micro Devices, Inc. All rights reserved.
+// Copyright (c) 2018-2025, Advanced Micro Devices, Inc. All rights reserved.
 
 #pragma once
 
+#include <array>
 #include <iostream>
+#include <map>
+#include <mutex>
 #include <sstream>
 
 #include "ck/utility/common_header.hpp"
@@ -12,10 +15,12 @@
 #include "ck/tensor_operation/gpu/device/tensor_layout.hpp"
 #include "ck/tensor_operation/gpu/device/device_gemm_v2.hpp"
 #include "ck/tensor_operation/gpu/device/gemm_specialization.hpp"
+#include "ck/tensor_operation/gpu/element/element_wise_operation.hpp"
 #include "ck/tensor_operation/gpu/grid/gridwise_gemm_xdl_cshuffle_v3.hpp"
 #include "ck/host_utility/device_prop.hpp"
 #include "ck/host_utility/kernel_launch.hpp"
 #include "ck/host_utility/flush_cache.hpp"
+#include "ck/host_utility/split_k_advisor.hpp"
 
 namespace ck {
 namespace tensor_operation {
@@ -642,6 +647,60 @@ struct DeviceGemm_Xdl_CShuffleV3 : public DeviceGemmV2<ALayout,
     bool GetPermuteA() override { return PermuteA; }
     bool GetPermuteB() override { return PermuteB; }
 
+    // The K-batch of the automatic mode: the fastest the split-K advisor estimates for the
+    // problem on the current device that the instance supports, reducing with atomics. The
+    // K-batches add their partial results into C, so only a PassThrough C operation is split,
+    // others run with a K-batch of 1. The K-batch of a problem is picked once per device
+    static index_t GetAutoKBatch(
+        index_t M, index_t N, index_t K, index_t StrideA, index_t StrideB, index_t StrideC)
+    {
+        if constexpr(!is_same_v<CElementwiseOperation,
+                                ck::tensor_operation::element_wise::PassThrough>)
+        {
+            return 1;
+        }
+
+        int device = 0;
+        if(hipGetDevice(&device) != hipSuccess)
+            return 1;
+
+        static std::mutex mutex;
+        static std::map<std::array<index_t, 7>, index_t> k_batches;
+
+        const std::array<index_t, 7> key{device, M, N, K, StrideA, StrideB, StrideC};
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+
+            const auto it = k_batches.find(key);
+            if(it != k_batches.end())
+                return it->second;
+        }
+
+        // the K batches are KRead long, a multiple of lcm(AK1, BK1)
+        SplitKInstance instance{MPerBlock, NPerBlock, KPerBlock, math::lcm(AK1, BK1)};
+        instance.a_size_ = sizeof(ADataType);
+        instance.b_size_ = sizeof(BDataType);
+        instance.c_size_ = sizeof(CDataType);
+
+        index_t k_batch = 1;
+        for(const auto& decision :
+            rank_split_k({{M, N, K}}, instance, get_device_split_k_model()))
+        {
+            const Argument arg{
+                nullptr, nullptr, nullptr, M, N, K, StrideA, StrideB, StrideC, decision.k_batch_};
+            if(IsSupportedArgument(arg))
+            {
+                k_batch = decision.k_batch_;
+                break;
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        k_batches.emplace(key, k_batch);
+        return k_batch;
+    }
+
+    // KBatch <= 0 picks the K-batch with GetAutoKBatch
     static auto MakeArgument(const ADataType* p_a,
                              const BDataType* p_b,
                              CDataType* p_c,
@@ -656,6 +715,10 @@ struct DeviceGemm_Xdl_CShuffleV3 : public DeviceGemmV2<ALayout,
                              BElementwiseOperation,
                              CElementwiseOperation)
     {
+        if(KBatch <= 0)
+        {
+            KBatch = GetAutoKBatch(M, N, K, StrideA, StrideB, StrideC);
+        }
         return Argument{p_a, p_b, p_c, M, N, K, StrideA, StrideB, StrideC, KBatch};
     }
 
@@ -676,6 +739,10 @@ struct DeviceGemm_Xdl_CShuffleV3 : public DeviceGemmV2<ALayout,
                                                       BElementwiseOperation,
                                                       CElementwiseOperation) override
     {
+        if(KBatch <= 0)
+        {
+            KBatch = GetAutoKBatch(M, N, K, StrideA, StrideB, StrideC);
+        }
         return std::make_unique<Argument>(static_cast<const ADataType*>(p_a),
                                           static_cast<const BDataType*>(p_b),
                                           static_cast<CDataType*>(p_c),
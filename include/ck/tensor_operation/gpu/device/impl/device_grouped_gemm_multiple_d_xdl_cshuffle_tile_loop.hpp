@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+// Copyright (c) 2024-2025, Advanced Micro Devices, Inc. All rights reserved.
 
 #pragma once
 
@@ -10,6 +10,7 @@
 #include "ck/host_utility/device_prop.hpp"
 #include "ck/host_utility/kernel_launch.hpp"
 #include "ck/host_utility/hip_check_error.hpp"
+#include "ck/host_utility/kernel_arg_cache.hpp"
 #include "ck/host_utility/stream_utility.hpp"
 #include "ck/utility/common_header.hpp"
 #include "ck/utility/loop_scheduler.hpp"
@@ -557,16 +558,33 @@ struct DeviceGroupedGemmMultipleDXdlCShuffleTileLoop
         }
 
         index_t group_count_;
-        const void* p_dev_gemm_args_;
+        const void* p_dev_gemm_args_ = nullptr;
         int occupancy_num_blocks_;
         int gpu_cu_count_;
-        const std::vector<GemmDesc>& gemm_descs_;
+        // a copy, refreshed by UpdateDeviceKernelArgs
+        std::vector<GemmDesc> gemm_descs_;
         AElementwiseOperation a_element_op_;
         BElementwiseOperation b_element_op_;
         CDEElementwiseOperation cde_element_op_;
         index_t tile_count_;
+
+        // what was last copied to p_dev_gemm_args_
+        mutable KernelArgUploader kernel_arg_uploader_;
+        // the persistent grid size only depends on the kernel and the CUs of the stream
+        mutable int grid_size_                = 0;
+        mutable hipStream_t grid_size_stream_ = nullptr;
+        // the result of IsSupportedArgument for gemm_descs_, dropped when a shape changes
+        mutable bool is_support_checked_ = false;
+        mutable bool is_supported_       = false;
     };
 
+    // shared by all arguments of this instance, keyed by the problem shape of a group
+    static ValidityCache& GetValidityCache()
+    {
+        static ValidityCache validity_cache;
+        return validity_cache;
+    }
+
     struct KernelConfig
     {
         // The oversubscription factor for the number of blocks that can simultaneously reside on
@@ -700,7 +718,13 @@ struct DeviceGroupedGemmMultipleDXdlCShuffleTileLoop
                            const void* dev_gemm_args,
                            const StreamConfig& stream_config) const
         {
-            int grid_size = CalculateMaxOccupancyGridSize(kernel, stream_config);
+            if(arg.grid_size_ == 0 || arg.grid_size_stream_ != stream_config.stream_id_)
+            {
+                arg.grid_size_        = CalculateMaxOccupancyGridSize(kernel, stream_config);
+                arg.grid_size_stream_ = stream_config.stream_id_;
+            }
+
+            const int grid_size = arg.grid_size_;
 
             if(stream_config.log_level_ > 0)
             {
@@ -729,7 +753,7 @@ struct DeviceGroupedGemmMultipleDXdlCShuffleTileLoop
         return true;
     }
 
-    static bool IsSupportedArgument(const Argument& arg)
+    static bool CheckSupportedArgument(const Argument& arg)
     {
         if(!ck::is_xdl_supported())
         {
@@ -741,26 +765,6 @@ struct DeviceGroupedGemmMultipleDXdlCShuffleTileLoop
         constexpr index_t k_batch = 1;
         for(index_t i = 0; i < arg.group_count_; ++i)
         {
-            std::array<const void*, NumDTensor> placeholder_p_ds_grid{};
-            std::array<index_t, NumDTensor> stride_Ds;
-            std::copy_n(arg.gemm_descs_[i].stride_Ds_.begin(), NumDTensor, stride_Ds.begin());
-            using GridArg = typename GridwiseGemm::Argument;
-            GridArg gridwise_arg(nullptr,               // p_a_grid,
-                                 nullptr,               // p_b_grid,
-                                 placeholder_p_ds_grid, // p_ds_grid,
-                                 nullptr,               // p_e_grid  ,
-                                 arg.gemm_descs_[i].M_,
-                                 arg.gemm_descs_[i].N_,
-                                 arg.gemm_descs_[i].K_,
-                                 arg.gemm_descs_[i].stride_A_,
-                                 arg.gemm_descs_[i].stride_B_,
-                                 stride_Ds,
-                                 arg.gemm_descs_[i].stride_C_,
-                                 k_batch,
-                                 arg.a_element_op_,
-                                 arg.b_element_op_,
-                                 arg.cde_element_op_);
-
             if((arg.gemm_descs_[i].K_ % AK1 != 0 || arg.gemm_descs_[i].K_ % BK1 != 0) &&
                !(GemmSpec == GemmSpecialization::MKPadding ||
                  GemmSpec == GemmSpecialization::NKPadding ||
@@ -770,12 +774,51 @@ struct DeviceGroupedGemmMultipleDXdlCShuffleTileLoop
                 return false;
             }
 
-            supported = supported && GridwiseGemm::CheckValidity(gridwise_arg);
+            const auto& desc = arg.gemm_descs_[i];
+
+            ValidityCache::Key key{
+                desc.M_, desc.N_, desc.K_, desc.stride_A_, desc.stride_B_, desc.stride_C_};
+            key.insert(key.end(), desc.stride_Ds_.begin(), desc.stride_Ds_.end());
+
+            supported = supported && GetValidityCache().Get(key, [&] {
+                            std::array<const void*, NumDTensor> placeholder_p_ds_grid{};
+                            std::array<index_t, NumDTensor> stride_Ds;
+                            std::copy_n(desc.stride_Ds_.begin(), NumDTensor, stride_Ds.begin());
+                            using GridArg = typename GridwiseGemm::Argument;
+                            GridArg gridwise_arg(nullptr,               // p_a_grid,
+                                                 nullptr,               // p_b_grid,
+                                                 placeholder_p_ds_grid, // p_ds_grid,
+                                                 nullptr,               // p_e_grid  ,
+                                                 desc.M_,
+                                                 desc.N_,
+                                                 desc.K_,
+                                                 desc.stride_A_,
+                                                 desc.stride_B_,
+                                                 stride_Ds,
+                                                 desc.stride_C_,
+                                                 k_batch,
+                                                 arg.a_element_op_,
+                                                 arg.b_element_op_,
+                                                 arg.cde_element_op_);
+
+                            return GridwiseGemm::CheckValidity(gridwise_arg);
+                        });
         }
 
         return supported;
     }
 
+    static bool IsSupportedArgument(const Argument& arg)
+    {
+        if(!arg.is_support_checked_)
+        {
+            arg.is_supported_       = CheckSupportedArgument(arg);
+            arg.is_support_checked_ = true;
+        }
+
+        return arg.is_supported_;
+    }
+
     bool IsSupportedArgument(const BaseArgument* p_arg) override
     {
         return IsSupportedArgument(*dynamic_cast<const Argument*>(p_arg));
@@ -935,15 +978,62 @@ struct DeviceGroupedGemmMultipleDXdlCShuffleTileLoop
         return str.str();
     }
 
+    // Refresh the group shapes of the argument from the kernel arguments the device reads. A
+    // changed shape drops the cached IsSupportedArgument result and recounts the tiles.
+    static bool UpdateGemmDescs(Argument& arg, const KernelArguments* p_host_kernel_args)
+    {
+        bool is_shape_changed = false;
+        for(index_t i = 0; i < arg.group_count_; ++i)
+        {
+            const auto& kernel_arg = p_host_kernel_args[i];
+            auto& desc             = arg.gemm_descs_[i];
+
+            const std::vector<index_t> stride_Ds(kernel_arg.StrideDs.begin(),
+                                                 kernel_arg.StrideDs.end());
+
+            if(kernel_arg.M != desc.M_ || kernel_arg.N != desc.N_ || kernel_arg.K != desc.K_ ||
+               kernel_arg.StrideA != desc.stride_A_ || kernel_arg.StrideB != desc.stride_B_ ||
+               kernel_arg.StrideE != desc.stride_C_ || stride_Ds != desc.stride_Ds_)
+            {
+                desc = GemmDesc{kernel_arg.M,
+                                kernel_arg.N,
+                                kernel_arg.K,
+                                kernel_arg.StrideA,
+                                kernel_arg.StrideB,
+                                kernel_arg.StrideE,
+                                stride_Ds};
+
+                is_shape_changed = true;
+            }
+        }
+
+        if(is_shape_changed)
+        {
+            arg.is_support_checked_ = false;
+
+            arg.tile_count_ = 0;
+            for(const auto& desc : arg.gemm_descs_)
+            {
+                const auto b2c_tile_map = Block2ETileMap(desc.M_, desc.N_);
+                arg.tile_count_ += b2c_tile_map.CalculateGridSize(desc.M_, desc.N_);
+            }
+        }
+
+        return is_shape_changed;
+    }
+
+    // Bind the device buffer and copy all the kernel arguments to it
     void SetDeviceKernelArgs(Argument& arg,
                              void* p_dev_kernel_args,
                              const void* p_host_kernel_args) const
     {
         arg.p_dev_gemm_args_ = p_dev_kernel_args;
-        hip_check_error(hipMemcpyAsync(p_dev_kernel_args,
-                                       p_host_kernel_args,
-                                       GetDeviceKernelArgSize(&arg),
-                                       hipMemcpyHostToDevice));
+        UpdateGemmDescs(arg, static_cast<const KernelArguments*>(p_host_kernel_args));
+        arg.kernel_arg_uploader_.Invalidate();
+        arg.kernel_arg_uploader_.Upload(p_dev_kernel_args,
+                                        static_cast<const KernelArguments*>(p_host_kernel_args),
+                                        arg.group_count_,
+                                        nullptr);
     }
 
     virtual void SetDeviceKernelArgs(BaseArgument* p_arg,
@@ -954,9 +1044,11 @@ struct DeviceGroupedGemmMultipleDXdlCShuffleTileLoop
             *dynamic_cast<Argument*>(p_arg), p_dev_kernel_args, p_host_kernel_args);
     }
 
+    // Bind a device buffer the caller fills; nothing is known about its content
     void SetDeviceKernelArgs(Argument& arg, void* p_dev_kernel_args) const
     {
         arg.p_dev_gemm_args_ = p_dev_kernel_args;
+        arg.kernel_arg_uploader_.Invalidate();
     }
 
     virtual void SetDeviceKernelArgs(BaseArgument* p_arg, void* p_dev_kernel_args) const override
@@ -968,6 +1060,49 @@ struct DeviceGroupedGemmMultipleDXdlCShuffleTileLoop
     {
         return dynamic_cast<const Argument*>(p_arg)->group_count_ * sizeof(KernelArguments);
     }
+
+    ///
+    /// @brief      Copy new kernel arguments (pointers, per-group M) to the device buffer set
+    ///             with @see SetDeviceKernelArgs. Only the groups which differ from the last
+    ///             upload are copied, the kernel reads the shapes from this buffer so nothing
+    ///             else has to be rebuilt. New shapes are checked before the upload.
+    ///
+    ///             The argument must be the only writer of the buffer since it was bound: set
+    ///             it again with @see SetDeviceKernelArgs after anything else wrote to it (the
+    ///             caller, or another op the memory was lent to).
+    ///
+    void UpdateDeviceKernelArgs(Argument& arg,
+                                const KernelArguments* p_host_kernel_args,
+                                const StreamConfig& stream_config = StreamConfig{}) const
+    {
+        if(arg.p_dev_gemm_args_ == nullptr)
+        {
+            std::ostringstream err;
+            err << "The gemm arguments device buffer is not allocated!"
+                << " In " << __FILE__ << ":" << __LINE__ << ", in function: " << __func__;
+            throw std::runtime_error(err.str());
+        }
+
+        if(UpdateGemmDescs(arg, p_host_kernel_args) && !IsSupportedArgument(arg))
+        {
+            throw std::runtime_error(
+                "wrong! the updated gemm arguments are not supported by this instance");
+        }
+
+        arg.kernel_arg_uploader_.Upload(const_cast<void*>(arg.p_dev_gemm_args_),
+                                        p_host_kernel_args,
+                                        arg.group_count_,
+                                        stream_config.stream_id_);
+    }
+
+    void UpdateDeviceKernelArgs(BaseArgument* p_arg,
+                                const void* p_host_kernel_args,
+                                const StreamConfig& stream_config = StreamConfig{}) const override
+    {
+        return UpdateDeviceKernelArgs(*dynamic_cast<Argument*>(p_arg),
+                                      static_cast<const KernelArguments*>(p_host_kernel_args),
+                                      stream_config);
+    }
 };
 
 } // namespace device
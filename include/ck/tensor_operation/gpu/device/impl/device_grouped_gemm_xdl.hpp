@@ -17,6 +17,7 @@
 #include "ck/tensor_operation/gpu/grid/gridwise_gemm_multiple_d_xdl_cshuffle.hpp"
 #include "ck/host_utility/device_prop.hpp"
 #include "ck/host_utility/kernel_launch.hpp"
+#include "ck/host_utility/kernel_arg_cache.hpp"
 
 namespace ck {
 namespace tensor_operation {
@@ -356,6 +357,27 @@ struct DeviceGroupedGemm_Xdl : public DeviceGroupedGemm<ALayout,
         ck::index_t BlockStart_, BlockEnd_;
     };
 
+    // shared by all arguments of this instance, keyed by the problem shape of a group
+    static ValidityCache& GetValidityCache()
+    {
+        static ValidityCache validity_cache;
+        return validity_cache;
+    }
+
+    static ValidityCache::Key GetValidityKey(const GemmDesc& gemm_desc)
+    {
+        ValidityCache::Key key{gemm_desc.M_,
+                               gemm_desc.N_,
+                               gemm_desc.K_,
+                               gemm_desc.stride_A_,
+                               gemm_desc.stride_B_,
+                               gemm_desc.stride_C_};
+
+        key.insert(key.end(), gemm_desc.stride_Ds_.begin(), gemm_desc.stride_Ds_.end());
+
+        return key;
+    }
+
     // Argument
     struct Argument : public BaseArgument
     {
@@ -381,6 +403,7 @@ struct DeviceGroupedGemm_Xdl : public DeviceGroupedGemm<ALayout,
             }
 
             gemm_desc_kernel_arg_.reserve(group_count_);
+            group_kernel_arg_ids_.reserve(group_count_);
 
             skipped_group_count_ = 0;
 
@@ -396,6 +419,7 @@ struct DeviceGroupedGemm_Xdl : public DeviceGroupedGemm<ALayout,
                 if(M == 0)
                 {
                     skipped_group_count_++;
+                    group_kernel_arg_ids_.push_back(-1);
                     continue;
                 }
 
@@ -448,11 +472,19 @@ struct DeviceGroupedGemm_Xdl : public DeviceGroupedGemm<ALayout,
                 const auto block_2_etile_map =
                     GroupedGemmBlock2ETileMap(e_grid_desc_m_n, BlockStart);
 
-                if(GridwiseGemm::CheckValidity(a_grid_desc_m_k,
-                                               b_grid_desc_n_k,
-                                               ds_grid_desc_m_n,
-                                               e_grid_desc_m_n,
-                                               block_2_etile_map))
+                const bool is_valid =
+                    GetValidityCache().Get(GetValidityKey(gemm_descs[i]), [&] {
+                        return GridwiseGemm::CheckValidity(a_grid_desc_m_k,
+                                                           b_grid_desc_n_k,
+                                                           ds_grid_desc_m_n,
+                                                           e_grid_desc_m_n,
+                                                           block_2_etile_map);
+                    });
+
+                group_kernel_arg_ids_.push_back(
+                    is_valid ? ck::type_convert<index_t>(gemm_desc_kernel_arg_.size()) : -1);
+
+                if(is_valid)
                 {
                     // tensor descriptors for block/thread-wise copy
                     DsGridDesc_MBlock_MPerBlock_NBlock_NPerBlock
@@ -488,6 +520,43 @@ struct DeviceGroupedGemm_Xdl : public DeviceGroupedGemm<ALayout,
             }
         }
 
+        // Point the groups to new tensors of the same shapes. Only the pointers of the kernel
+        // arguments change, the next Run uploads just those.
+        void UpdatePointers(const std::vector<const void*>& p_As,
+                            const std::vector<const void*>& p_Bs,
+                            const std::vector<std::array<const void*, NumDTensor>>& p_Ds,
+                            const std::vector<void*>& p_Es)
+        {
+            if(!(group_count_ == ck::type_convert<ck::index_t>(p_As.size()) &&
+                 group_count_ == ck::type_convert<ck::index_t>(p_Bs.size()) &&
+                 (NumDTensor == 0 ||
+                  group_count_ == ck::type_convert<ck::index_t>(p_Ds.size())) &&
+                 group_count_ == ck::type_convert<ck::index_t>(p_Es.size())))
+            {
+                throw std::runtime_error("wrong! group_count_ != p_As/b/c.size");
+            }
+
+            for(index_t i = 0; i < group_count_; i++)
+            {
+                const index_t id = group_kernel_arg_ids_[i];
+
+                if(id < 0)
+                    continue;
+
+                auto& kernel_arg = gemm_desc_kernel_arg_[id];
+
+                kernel_arg.a_ptr_ = static_cast<const ADataType*>(p_As[i]);
+                kernel_arg.b_ptr_ = static_cast<const BDataType*>(p_Bs[i]);
+                kernel_arg.e_ptr_ = static_cast<EDataType*>(p_Es[i]);
+
+                static_for<0, NumDTensor, 1>{}([&](auto j) {
+                    using DDataType = remove_cvref_t<tuple_element_t<j.value, DsDataType>>;
+
+                    kernel_arg.ds_ptr_(j) = static_cast<const DDataType*>(p_Ds[i][j]);
+                });
+            }
+        }
+
         //  private:
         index_t group_count_;
         index_t skipped_group_count_;
@@ -499,8 +568,15 @@ struct DeviceGroupedGemm_Xdl : public DeviceGroupedGemm<ALayout,
         std::vector<GemmBiasTransKernelArg> gemm_desc_kernel_arg_;
         std::vector<Tuple<index_t, index_t>> a_mtx_mraw_kraw_;
         std::vector<Tuple<index_t, index_t>> b_mtx_nraw_kraw_;
+        // index of every group in gemm_desc_kernel_arg_, -1 for the skipped ones
+        std::vector<index_t> group_kernel_arg_ids_;
 
         index_t grid_size_;
+
+        // the shapes are fixed after construction, so Run checks them only once
+        mutable bool is_validated_ = false;
+        // what was last copied to p_workspace_
+        mutable KernelArgUploader kernel_arg_uploader_;
     };
 
     // Invoker
@@ -512,7 +588,7 @@ struct DeviceGroupedGemm_Xdl : public DeviceGroupedGemm<ALayout,
         {
             bool has_main_k_block_loop = true;
 
-            for(std::size_t i = 0; i < arg.gemm_desc_kernel_arg_.size(); i++)
+            for(std::size_t i = 0; !arg.is_validated_ && i < arg.gemm_desc_kernel_arg_.size(); i++)
             {
                 if(ck::EnvIsEnabled(CK_ENV(CK_LOGGING)))
                 {
@@ -557,12 +633,12 @@ struct DeviceGroupedGemm_Xdl : public DeviceGroupedGemm<ALayout,
                 }
             }
 
-            hipGetErrorString(
-                hipMemcpyAsync(arg.p_workspace_,
-                               arg.gemm_desc_kernel_arg_.data(),
-                               arg.gemm_desc_kernel_arg_.size() * sizeof(GemmBiasTransKernelArg),
-                               hipMemcpyHostToDevice,
-                               stream_config.stream_id_));
+            arg.is_validated_ = true;
+
+            arg.kernel_arg_uploader_.Upload(arg.p_workspace_,
+                                            arg.gemm_desc_kernel_arg_.data(),
+                                            arg.gemm_desc_kernel_arg_.size(),
+                                            stream_config.stream_id_);
 
             float ave_time = 0;
 
@@ -732,10 +808,42 @@ struct DeviceGroupedGemm_Xdl : public DeviceGroupedGemm<ALayout,
         return GetWorkSpaceSize(p_arg);
     }
 
+    // Run uploads all the kernel arguments to a workspace set here, even the same one again,
+    // since another op may have written it in between. Runs on the same workspace then copy only
+    // what changed, the argument has to be its only writer until it is set again
+    void SetWorkSpacePointer(BaseArgument* p_arg,
+                             void* p_workspace,
+                             const StreamConfig& stream_config = StreamConfig{}) const override
+    {
+        BaseOperator::SetWorkSpacePointer(p_arg, p_workspace, stream_config);
+
+        auto p_arg_ = dynamic_cast<Argument*>(p_arg);
+        if(p_arg_)
+        {
+            p_arg_->kernel_arg_uploader_.Invalidate();
+        }
+    }
+
     void SetDeviceKernelArgs(BaseArgument* p_arg, void* p_dev_kernel_args) const override
     {
         return this->SetWorkSpacePointer(p_arg, p_dev_kernel_args);
     }
+
+    void UpdatePointers(BaseArgument* p_arg,
+                        const std::vector<const void*>& p_As,
+                        const std::vector<const void*>& p_Bs,
+                        const std::vector<std::array<const void*, NumDTensor>>& p_Ds,
+                        const std::vector<void*>& p_Es) const override
+    {
+        auto p_arg_ = dynamic_cast<Argument*>(p_arg);
+        if(p_arg_)
+        {
+            p_arg_->UpdatePointers(p_As, p_Bs, p_Ds, p_Es);
+        }
+        else
+            throw std::runtime_error("The argument pointer is not an object of "
+                                     "DeviceGroupedGemmMultipleDXdlCShuffle::Argument structure!");
+    }
 };
 
 } // namespace device
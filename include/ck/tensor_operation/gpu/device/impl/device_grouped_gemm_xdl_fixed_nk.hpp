@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2018-2024, Advanced Micro Devices, Inc. All rights reserved.
+// Copyright (c) 2018-2025, Advanced Micro Devices, Inc. All rights reserved.
 
 #pragma once
 
@@ -15,6 +15,7 @@
 #include "ck/tensor_operation/gpu/grid/gridwise_gemm_multiple_d_xdl_splitk_cshuffle.hpp"
 #include "ck/host_utility/device_prop.hpp"
 #include "ck/host_utility/kernel_launch.hpp"
+#include "ck/host_utility/kernel_arg_cache.hpp"
 
 namespace ck {
 namespace tensor_operation {
@@ -460,6 +461,13 @@ struct DeviceGroupedGemm_Xdl_Fixed_NK : public DeviceGroupedGemmFixedNK<ALayout,
         index_t StrideE_;
     };
 
+    // shared by all arguments of this instance, keyed by the problem shape of a group
+    static ValidityCache& GetValidityCache()
+    {
+        static ValidityCache validity_cache;
+        return validity_cache;
+    }
+
     // Argument
     struct Argument : public BaseArgument
     {
@@ -572,9 +580,15 @@ struct DeviceGroupedGemm_Xdl_Fixed_NK : public DeviceGroupedGemmFixedNK<ALayout,
                     throw std::runtime_error("wrong! block_2_etile_map validation failed");
                 }
 
-                if(!GridwiseGemm::
-                       template CheckValidity<ALayout, BLayout, DsLayout, ELayout, GemmSpec>(
-                           AverM, N, K, StrideA, StrideB, StrideDs, StrideE, 1))
+                ValidityCache::Key key{AverM, N, K, StrideA, StrideB, StrideE};
+                key.insert(key.end(), StrideDs.begin(), StrideDs.end());
+
+                // the groups only differ in their strides, mostly the check runs once
+                if(!GetValidityCache().Get(key, [&] {
+                       return GridwiseGemm::
+                           template CheckValidity<ALayout, BLayout, DsLayout, ELayout, GemmSpec>(
+                               AverM, N, K, StrideA, StrideB, StrideDs, StrideE, 1);
+                   }))
                 {
                     throw std::runtime_error(
                         "wrong! GridwiseGemm_k0mk1_k0nk1_mn_xdlops_v2r3 has invalid setting");
@@ -625,6 +639,11 @@ struct DeviceGroupedGemm_Xdl_Fixed_NK : public DeviceGroupedGemmFixedNK<ALayout,
         index_t sum_of_m;
 
         index_t k_batch_;
+
+        // k_batch_ for which Run has checked has_main_k_block_loop, 0 if none
+        mutable index_t validated_k_batch_ = 0;
+        // what was last copied to grouped_gemm_kernel_args_dev
+        mutable KernelArgUploader kernel_arg_uploader_;
     };
 
     // Invoker
@@ -636,7 +655,9 @@ struct DeviceGroupedGemm_Xdl_Fixed_NK : public DeviceGroupedGemmFixedNK<ALayout,
         {
             bool has_main_k_block_loop = true;
 
-            for(std::size_t i = 0; i < arg.gemm_desc_kernel_arg_.size(); i++)
+            for(std::size_t i = 0;
+                arg.validated_k_batch_ != arg.k_batch_ && i < arg.gemm_desc_kernel_arg_.size();
+                i++)
             {
                 const auto KPad =
                     GridwiseGemm::CalculateKPadded(arg.gemm_desc_kernel_arg_[i].K_, arg.k_batch_);
@@ -647,6 +668,8 @@ struct DeviceGroupedGemm_Xdl_Fixed_NK : public DeviceGroupedGemmFixedNK<ALayout,
                 }
             }
 
+            arg.validated_k_batch_ = arg.k_batch_;
+
             if(arg.grouped_gemm_kernel_args_dev == nullptr)
             {
                 throw std::runtime_error("wrong! grouped_gemm_kernel_args_dev is nullpr");
@@ -902,12 +925,64 @@ struct DeviceGroupedGemm_Xdl_Fixed_NK : public DeviceGroupedGemmFixedNK<ALayout,
     }
 
     // polymorphic
+    // Bind a device buffer the caller fills; nothing is known about its content
     void SetDeviceKernelArgs(BaseArgument* p_arg, void* kernel_args) const override
     {
         auto arg_ptr = dynamic_cast<Argument*>(p_arg);
         if(arg_ptr)
         {
             arg_ptr->grouped_gemm_kernel_args_dev = kernel_args;
+            arg_ptr->kernel_arg_uploader_.Invalidate();
+        }
+        else
+            throw std::runtime_error("The argument pointer is not an object of "
+                                     "DeviceGroupedGemm_Xdl_Fixed_NK::Argument structure!");
+    }
+
+    // Copy new kernel arguments (pointers, per-group M) to the buffer set with
+    // SetDeviceKernelArgs, only the groups which changed since the last update are copied. The
+    // argument must be the only writer of the buffer since it was set: set it again after
+    // anything else wrote to it
+    static void UpdateDeviceKernelArgs(Argument& arg,
+                                       const GroupedGemmKernelArgument<NumDTensor>* kernel_args,
+                                       const StreamConfig& stream_config = StreamConfig{})
+    {
+        if(arg.grouped_gemm_kernel_args_dev == nullptr)
+        {
+            throw std::runtime_error("wrong! grouped_gemm_kernel_args_dev is nullpr");
+        }
+
+        // only M may change, the rest of the shapes was validated with the argument
+        for(index_t i = 0; i < arg.group_count_; ++i)
+        {
+            const auto& desc = arg.gemm_desc_kernel_arg_[i];
+            if(kernel_args[i].N != desc.N_ || kernel_args[i].K != desc.K_ ||
+               kernel_args[i].StrideA != desc.StrideA_ ||
+               kernel_args[i].StrideB != desc.StrideB_ ||
+               kernel_args[i].StrideDs != desc.StrideDs_ || kernel_args[i].StrideE != desc.StrideE_)
+            {
+                throw std::runtime_error("wrong! only M can change in the updated kernel args");
+            }
+        }
+
+        arg.kernel_arg_uploader_.Upload(const_cast<void*>(arg.grouped_gemm_kernel_args_dev),
+                                        kernel_args,
+                                        arg.group_count_,
+                                        stream_config.stream_id_);
+    }
+
+    // polymorphic
+    void UpdateDeviceKernelArgs(BaseArgument* p_arg,
+                                const void* kernel_args,
+                                const StreamConfig& stream_config = StreamConfig{}) const override
+    {
+        auto arg_ptr = dynamic_cast<Argument*>(p_arg);
+        if(arg_ptr)
+        {
+            UpdateDeviceKernelArgs(
+                *arg_ptr,
+                static_cast<const GroupedGemmKernelArgument<NumDTensor>*>(kernel_args),
+                stream_config);
         }
         else
             throw std::runtime_error("The argument pointer is not an object of "
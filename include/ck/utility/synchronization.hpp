@@ -9,7 +9,9 @@ namespace ck {
 
 __device__ void block_sync_lds()
 {
-#if CK_EXPERIMENTAL_BLOCK_SYNC_LDS_WITHOUT_SYNC_VMEM
+#if defined(CK_USE_SIMT_EMULATOR)
+    __syncthreads();
+#elif CK_EXPERIMENTAL_BLOCK_SYNC_LDS_WITHOUT_SYNC_VMEM
 #ifdef __gfx12__
     asm volatile("\
     s_wait_dscnt 0x0 \n \
@@ -31,7 +33,9 @@ __device__ void block_sync_lds()
 
 __device__ void block_sync_lds_direct_load()
 {
-#ifdef __gfx12__
+#if defined(CK_USE_SIMT_EMULATOR)
+    __syncthreads();
+#elif defined(__gfx12__)
     asm volatile("\
     s_wait_vmcnt 0x0 \n \
     s_wait_dscnt 0x0 \n \
@@ -49,7 +53,8 @@ __device__ void block_sync_lds_direct_load()
 
 __device__ void s_nop()
 {
-#if 1
+#if defined(CK_USE_SIMT_EMULATOR)
+#elif 1
     asm volatile("\
     s_nop 0 \n \
     " ::);
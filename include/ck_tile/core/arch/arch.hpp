@@ -51,7 +51,11 @@ CK_TILE_DEVICE index_t get_lane_id() { return __lane_id(); }
 
 CK_TILE_DEVICE index_t get_warp_id()
 {
+#if defined(CK_USE_SIMT_EMULATOR)
+    return threadIdx.x / get_warp_size();
+#else
     return __builtin_amdgcn_readfirstlane(threadIdx.x / get_warp_size());
+#endif
 }
 
 CK_TILE_DEVICE index_t get_thread_id() { return threadIdx.x; }
@@ -60,7 +64,9 @@ CK_TILE_DEVICE index_t get_block_id() { return blockIdx.x; }
 
 CK_TILE_DEVICE void block_sync_lds()
 {
-#if CK_TILE_EXPERIMENTAL_BLOCK_SYNC_LDS_WITHOUT_SYNC_VMEM
+#if defined(CK_USE_SIMT_EMULATOR)
+    __syncthreads();
+#elif CK_TILE_EXPERIMENTAL_BLOCK_SYNC_LDS_WITHOUT_SYNC_VMEM
     // asm volatile("\
     // s_waitcnt lgkmcnt(0) \n \
     // s_barrier \
@@ -75,7 +81,10 @@ CK_TILE_DEVICE void block_sync_lds()
 
 CK_TILE_DEVICE void block_sync_load_raw(index_t cnt = 0)
 {
-#ifdef __gfx12__
+#if defined(CK_USE_SIMT_EMULATOR)
+    (void)cnt;
+    __syncthreads();
+#elif defined(__gfx12__)
     asm volatile("s_wait_loadcnt %0 \n"
                  "s_barrier_signal -1 \n"
                  "s_barrier_wait -1"
@@ -93,16 +102,22 @@ CK_TILE_DEVICE void block_sync_load_raw(index_t cnt = 0)
 
 CK_TILE_DEVICE void block_sync_lds_direct_load()
 {
+#if defined(CK_USE_SIMT_EMULATOR)
+    __syncthreads();
+#else
     asm volatile("\
     s_waitcnt vmcnt(0) \n \
     s_waitcnt lgkmcnt(0) \n \
     s_barrier \
     " ::);
+#endif
 }
 
 CK_TILE_DEVICE void s_nop(index_t cnt = 0)
 {
-#if 1
+#if defined(CK_USE_SIMT_EMULATOR)
+    (void)cnt;
+#elif 1
     asm volatile("s_nop %0" : : "n"(cnt) :);
 #else
     __builtin_amdgcn_sched_barrier(cnt);
@@ -7,6 +7,7 @@
 #include "ck_tile/host/stream_config.hpp"
 #include "ck_tile/host/hip_check_error.hpp"
 #include "ck_tile/host/timer.hpp"
+#include "ck_tile/host/timing_statistics.hpp"
 #include <hip/hip_runtime.h>
 #include <cstddef>
 
@@ -76,6 +77,25 @@ CK_TILE_HOST float launch_kernel(const stream_config& s, Callables... callables)
         (callables(s),...); HIP_CHECK_ERROR(hipGetLastError());
         return 0;
     }
+    if(s.timing_stats_ != nullptr) {
+        auto run = [&]() { (callables(s),...); };
+
+        // warmup
+        for(int i = 0; i < s.cold_niters_; i++) { run(); } HIP_CHECK_ERROR(hipGetLastError());
+
+        HIP_CHECK_ERROR(hipStreamSynchronize(s.stream_id_));
+        if(s.is_gpu_timer_) {
+            gpu_sample_timer timer{s.stream_id_};
+            *s.timing_stats_ = measure_iterations(timer, run, s.nrepeat_, s.max_nrepeat_, s.target_rel_ci_);
+        }
+        else {
+            cpu_sample_timer timer{s.stream_id_};
+            *s.timing_stats_ = measure_iterations(timer, run, s.nrepeat_, s.max_nrepeat_, s.target_rel_ci_);
+        }
+        HIP_CHECK_ERROR(hipGetLastError());
+
+        return s.timing_stats_->median;
+    }
     if(s.is_gpu_timer_) {
         gpu_timer timer {};
 
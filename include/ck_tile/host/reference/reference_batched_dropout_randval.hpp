@@ -0,0 +1,151 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include "ck_tile/core.hpp"
+#include "ck_tile/host/host_tensor.hpp"
+#include <thread>
+#include <vector>
+
+namespace ck_tile {
+
+// Host regeneration of the random bytes BlockDropout (fwd kernels) draws, so that the reference
+// does not need the kernel to store them into a [batch, nhead, seqlen_q, seqlen_k] randval tensor.
+//
+// BlockDropout draws the bytes of one 32x32 tile per warp and step. Lane l of the warp seeds its
+// philox with offset + (i_batch * nhead + i_head) * warp_size + l, and draws 16 bytes with the
+// subsequence (row tile, col tile) of the tile. The bytes are laid out by the C distribution of
+// WarpGemmMfma*M32N32K16SwizzleA, where byte i of lane l lands at
+//
+//   m = (i / 8) * 16 + (l / 32) * 8 + i % 8,  n = l % 32
+//
+// of the tile. This holds for wave64 and the 32x32 warp gemms all fwd dropout tiles use, which
+// BlockDropout checks against its kRandValTileM x kRandValTileN.
+namespace detail {
+
+inline constexpr index_t kDropoutTileM    = 32;
+inline constexpr index_t kDropoutTileN    = 32;
+inline constexpr index_t kDropoutWarpSize = 64;
+
+// fills tile (row-major, kDropoutTileM x kDropoutTileN) with the bytes of tile (i_tile_m,
+// i_tile_n) of head i_head of batch i_batch
+CK_TILE_HOST void generate_dropout_randval_tile(uint8_t* tile,
+                                                index_t i_batch,
+                                                index_t i_head,
+                                                index_t nhead,
+                                                unsigned long long seed,
+                                                unsigned long long offset,
+                                                index_t i_tile_m,
+                                                index_t i_tile_n)
+{
+    const unsigned long long subsequence =
+        (static_cast<unsigned long long>(static_cast<uint32_t>(i_tile_n)) << 32) |
+        static_cast<uint32_t>(i_tile_m);
+
+    for(index_t lane = 0; lane < kDropoutWarpSize; ++lane)
+    {
+        const philox ph(seed, offset + (i_batch * nhead + i_head) * kDropoutWarpSize + lane);
+
+        uint8_t random_uint8_t[16];
+        ph.get_random_16x8(random_uint8_t, subsequence);
+
+        for(index_t i = 0; i < 16; ++i)
+        {
+            const index_t m = (i / 8) * 16 + (lane / 32) * 8 + i % 8;
+            const index_t n = lane % 32;
+            tile[m * kDropoutTileN + n] = random_uint8_t[i];
+        }
+    }
+}
+
+// calls f(head, m, row) for every row of the randval tensor of batch i_batch, where row points at
+// the seqlen_k bytes of that row
+template <typename F>
+CK_TILE_HOST void for_each_dropout_randval_row(index_t i_batch,
+                                               index_t nhead,
+                                               index_t seqlen_q,
+                                               index_t seqlen_k,
+                                               unsigned long long seed,
+                                               unsigned long long offset,
+                                               F&& f)
+{
+    const index_t num_tile_m = integer_divide_ceil(seqlen_q, kDropoutTileM);
+    const index_t num_tile_n = integer_divide_ceil(seqlen_k, kDropoutTileN);
+
+    auto rows = [&](index_t i_head, index_t i_tile_m) {
+        // one strip of tiles at a time, rather than the whole [seqlen_q, seqlen_k] matrix
+        std::vector<uint8_t> strip(kDropoutTileM * num_tile_n * kDropoutTileN);
+        uint8_t tile[kDropoutTileM * kDropoutTileN];
+
+        for(index_t i_tile_n = 0; i_tile_n < num_tile_n; ++i_tile_n)
+        {
+            generate_dropout_randval_tile(
+                tile, i_batch, i_head, nhead, seed, offset, i_tile_m, i_tile_n);
+
+            for(index_t m = 0; m < kDropoutTileM; ++m)
+            {
+                std::copy_n(&tile[m * kDropoutTileN],
+                            kDropoutTileN,
+                            &strip[(m * num_tile_n + i_tile_n) * kDropoutTileN]);
+            }
+        }
+
+        const index_t m_end = std::min<index_t>((i_tile_m + 1) * kDropoutTileM, seqlen_q);
+        for(index_t m = i_tile_m * kDropoutTileM; m < m_end; ++m)
+        {
+            f(i_head, m, &strip[(m - i_tile_m * kDropoutTileM) * num_tile_n * kDropoutTileN]);
+        }
+    };
+
+    make_ParallelTensorFunctor(rows, nhead, num_tile_m)(std::thread::hardware_concurrency());
+}
+
+} // namespace detail
+
+// the randval tensor [nhead, seqlen_q, seqlen_k] the fwd kernel stores for batch i_batch
+template <typename RandValOutputDataType>
+CK_TILE_HOST void
+reference_batched_dropout_randval(HostTensor<RandValOutputDataType>& randval_b_m_n,
+                                  index_t i_batch,
+                                  index_t nhead,
+                                  unsigned long long seed,
+                                  unsigned long long offset)
+{
+    const index_t seqlen_q = randval_b_m_n.mDesc.get_lengths()[1];
+    const index_t seqlen_k = randval_b_m_n.mDesc.get_lengths()[2];
+
+    detail::for_each_dropout_randval_row(
+        i_batch, nhead, seqlen_q, seqlen_k, seed, offset, [&](auto i_head, auto m, auto row) {
+            for(index_t n = 0; n < seqlen_k; ++n)
+                randval_b_m_n(i_head, m, n) = ck_tile::type_convert<RandValOutputDataType>(row[n]);
+        });
+}
+
+// reference_batched_dropout of in_out_b_m_n ([nhead, seqlen_q, seqlen_k] of batch i_batch), with
+// the random bytes regenerated on the fly
+template <typename DataType>
+CK_TILE_HOST void reference_batched_dropout(HostTensor<DataType>& in_out_b_m_n,
+                                            index_t i_batch,
+                                            index_t nhead,
+                                            unsigned long long seed,
+                                            unsigned long long offset,
+                                            const uint8_t& p_undrop_in_uint8_t,
+                                            const float scale)
+{
+    const index_t seqlen_q = in_out_b_m_n.mDesc.get_lengths()[1];
+    const index_t seqlen_k = in_out_b_m_n.mDesc.get_lengths()[2];
+
+    detail::for_each_dropout_randval_row(
+        i_batch, nhead, seqlen_q, seqlen_k, seed, offset, [&](auto i_head, auto m, auto row) {
+            for(index_t n = 0; n < seqlen_k; ++n)
+            {
+                float tmp = ck_tile::type_convert<float>(in_out_b_m_n(i_head, m, n)) * scale;
+                in_out_b_m_n(i_head, m, n) = row[n] <= p_undrop_in_uint8_t
+                                                 ? ck_tile::type_convert<DataType>(tmp)
+                                                 : DataType(0);
+            }
+        });
+}
+
+} // namespace ck_tile
@@ -1,8 +1,13 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+// Copyright (c) 2024-2025, Advanced Micro Devices, Inc. All rights reserved.
 
 #pragma once
 
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <vector>
+
 #include "ck_tile/core.hpp"
 #include "ck_tile/host/host_tensor.hpp"
 
@@ -39,6 +44,110 @@ namespace ck_tile {
 // num_tokens_post_padded_ptr : [28]
 // num_sorted_tiles_ptr : [7]
 
+namespace detail {
+
+// rows of the grouped reference gathered into one panel, and columns of a weight packed at once
+inline constexpr index_t kFusedMoeMaxRowsPerGroup = 128;
+inline constexpr index_t kFusedMoeNPerBlock       = 64;
+
+inline void check_fused_moe_intermediate_size(index_t intermediate_size_0,
+                                              index_t intermediate_size_1,
+                                              index_t gate_only)
+{
+    if(gate_only ? intermediate_size_1 != intermediate_size_0
+                 : intermediate_size_1 * 2 != intermediate_size_0)
+        throw std::runtime_error(
+            "intermediate_size not correct, 0:" + std::to_string(intermediate_size_0) +
+            ", 1:" + std::to_string(intermediate_size_1));
+}
+
+// TODO: better remove this in the future, or modify the token_id value
+template <typename IndexDataType>
+index_t get_fused_moe_topk_id(const HostTensor<IndexDataType>& token_ids_host,
+                              index_t token_id,
+                              index_t expert_id,
+                              index_t topk)
+{
+    for(index_t i_topk = 0; i_topk < topk; i_topk++)
+    {
+        if(token_ids_host(token_id, i_topk) == expert_id)
+            return i_topk;
+    }
+    throw std::runtime_error("not correct token/expert pair\n");
+}
+
+// o[token, n] = sum of out_topk_tokens[token, topk, n] over topk
+template <typename AccDataType, typename ODataType>
+void reduce_fused_moe_topk(const HostTensor<AccDataType>& out_topk_tokens,
+                           HostTensor<ODataType>& o_host,
+                           index_t tokens,
+                           index_t topk,
+                           index_t hidden_size)
+{
+    auto r = [&](auto i_token) {
+        for(index_t i_n = 0; i_n < hidden_size; i_n++)
+        {
+            AccDataType acc = type_convert<AccDataType>(0);
+            for(index_t i_topk = 0; i_topk < topk; i_topk++)
+            {
+                acc += out_topk_tokens(i_token, i_topk, i_n);
+            }
+            o_host(i_token, i_n) = type_convert<ODataType>(acc);
+        }
+    };
+    make_ParallelTensorFunctor(r, tokens)(std::thread::hardware_concurrency());
+}
+
+// c[m, j] = sum over k of a[m, k] * b(j, k), for the rows of the row-major panel a [M, K] and
+// the nb <= kFusedMoeNPerBlock columns b(j, k) reads. b is packed k-major once for all the rows,
+// zero padded to a full block so the j loop vectorizes, and every c[m, j] still sums over k in
+// order, as the per-token reference does.
+template <typename AccDataType, typename LoadB>
+void fused_moe_block_gemm(const AccDataType* a,
+                          index_t M,
+                          index_t K,
+                          index_t nb,
+                          LoadB load_b,
+                          std::vector<AccDataType>& b_packed,
+                          AccDataType* c)
+{
+    constexpr index_t NPerBlock = kFusedMoeNPerBlock;
+
+    b_packed.assign(static_cast<std::size_t>(K) * NPerBlock, static_cast<AccDataType>(0));
+    for(index_t j = 0; j < nb; j++)
+    {
+        for(index_t k = 0; k < K; k++)
+        {
+            b_packed[static_cast<std::size_t>(k) * NPerBlock + j] = load_b(j, k);
+        }
+    }
+
+    for(index_t m = 0; m < M; m++)
+    {
+        const AccDataType* a_m = a + static_cast<std::size_t>(m) * K;
+
+        AccDataType acc[NPerBlock];
+        for(index_t j = 0; j < NPerBlock; j++)
+        {
+            acc[j] = static_cast<AccDataType>(0);
+        }
+        for(index_t k = 0; k < K; k++)
+        {
+            const AccDataType a_mk = a_m[k];
+            const AccDataType* b_k = &b_packed[static_cast<std::size_t>(k) * NPerBlock];
+            for(index_t j = 0; j < NPerBlock; j++)
+            {
+                acc[j] += a_mk * b_k[j];
+            }
+        }
+        std::copy(acc, acc + nb, c + static_cast<std::size_t>(m) * nb);
+    }
+}
+
+} // namespace detail
+
+// The per-token reference: one sorted id at a time, a GEMV against the gate/up and the down
+// weights of its expert. Kept as the oracle of reference_fused_moe for small sizes.
 template <typename AccDataType, // you only need to explcitly set this one
           typename Activation,  // ck_tile::element_wise::Gelu
           typename ADataType,
@@ -51,7 +160,7 @@ template <typename AccDataType, // you only need to explcitly set this one
           typename YSmoothScaleDataType,
           typename TopkWeightDataType,
           typename IndexDataType>
-void reference_fused_moe(
+void reference_fused_moe_per_token(
     const ck_tile::HostTensor<ADataType>& a_host,       // [tokens, hidden_size]
     const ck_tile::HostTensor<GDataType>& g_host,       // [experts, interme_size_0, hidden_size]
     const ck_tile::HostTensor<DDataType>& d_host,       // [experts, hidden_size, interme_size_1]
@@ -85,16 +194,7 @@ void reference_fused_moe(
     ck_tile::index_t intermediate_size_0 = intermediate_size;
     ck_tile::index_t intermediate_size_1 = intermediate_size / (gate_only ? 1 : 2);
 
-    // TODO: better remove this in the future, or modify the token_id value
-    auto get_topk_id = [&](ck_tile::index_t token_id_, ck_tile::index_t expert_id_) {
-        for(ck_tile::index_t i_ = 0; i_ < topk; i_++)
-        {
-            if(token_ids_host(token_id_, i_) == expert_id_)
-                return i_;
-        }
-        throw std::runtime_error("not correct token/expert pair\n");
-        return -1; // TODO: not correct!!
-    };
+    detail::check_fused_moe_intermediate_size(intermediate_size_0, intermediate_size_1, gate_only);
 
     ck_tile::HostTensor<AccDataType> out_topk_tokens({tokens, topk, hidden_size});
 
@@ -108,8 +208,9 @@ void reference_fused_moe(
         ck_tile::index_t i_token  = sorted_token_ids_host.mData[i_flatten];
         if(i_token >= tokens)
             return;
-        ck_tile::index_t i_topk = get_topk_id(i_token, i_expert); // TODO: ugly
-        auto weight             = sorted_weight_host.mData[i_flatten];
+        ck_tile::index_t i_topk =
+            detail::get_fused_moe_topk_id(token_ids_host, i_token, i_expert, topk); // TODO: ugly
+        auto weight = sorted_weight_host.mData[i_flatten];
 
         ck_tile::HostTensor<AccDataType> acc_0({1, intermediate_size_0});
         // first gemm
@@ -128,10 +229,6 @@ void reference_fused_moe(
         ck_tile::HostTensor<AccDataType> y({1, intermediate_size_1});
         if(gate_only)
         {
-            if(intermediate_size_1 != intermediate_size_0)
-                throw std::runtime_error(
-                    "intermediate_size not correct, 0:" + std::to_string(intermediate_size_0) +
-                    ", 1:" + std::to_string(intermediate_size_1));
             for(ck_tile::index_t i_n = 0; i_n < intermediate_size_1; i_n++)
             {
                 Activation{}(y(0, i_n), acc_0(0, i_n));
@@ -140,10 +237,6 @@ void reference_fused_moe(
         }
         else
         {
-            if(intermediate_size_1 * 2 != intermediate_size_0)
-                throw std::runtime_error(
-                    "intermediate_size not correct, 0:" + std::to_string(intermediate_size_0) +
-                    ", 1:" + std::to_string(intermediate_size_1));
             for(ck_tile::index_t i_n = 0; i_n < intermediate_size_1; i_n++)
             {
                 AccDataType tmp;
@@ -170,24 +263,214 @@ void reference_fused_moe(
         }
     };
 
-    // make_ParallelTensorFunctor(f, max_num_tokens_padded)(std::thread::hardware_concurrency());
     make_ParallelTensorFunctor(f, max_num_tokens_padded)(1);
 
-    // reduce
-    auto r = [&](auto i_token) {
-        for(ck_tile::index_t i_n = 0; i_n < hidden_size; i_n++)
+    detail::reduce_fused_moe_topk(out_topk_tokens, o_host, tokens, topk, hidden_size);
+
+    (void)sa_host;
+    (void)sg_host;
+    (void)sd_host;
+    (void)sy_host;
+}
+
+// Computes what reference_fused_moe_per_token does, per expert: the valid tokens of consecutive
+// sorted tiles of one expert are gathered into a panel (up to kFusedMoeMaxRowsPerGroup rows), and
+// the two GEMMs of the panel run kFusedMoeNPerBlock columns at a time, each packed weight block
+// being shared by all the rows. Every sum runs over k in the same order as in the per-token path,
+// so the results match bit for bit unless the compiler contracts the multiply-adds of the two
+// differently. Panels and column blocks run in parallel, and every row writes its own
+// [token, topk] slot. Padded sorted ids (>= tokens) and tiles past num_sorted_tiles are skipped.
+template <typename AccDataType, // you only need to explcitly set this one
+          typename Activation,  // ck_tile::element_wise::Gelu
+          typename ADataType,
+          typename GDataType,
+          typename DDataType,
+          typename ODataType,
+          typename AScaleDataType,
+          typename GScaleDataType,
+          typename DScaleDataType,
+          typename YSmoothScaleDataType,
+          typename TopkWeightDataType,
+          typename IndexDataType>
+void reference_fused_moe(
+    const ck_tile::HostTensor<ADataType>& a_host,       // [tokens, hidden_size]
+    const ck_tile::HostTensor<GDataType>& g_host,       // [experts, interme_size_0, hidden_size]
+    const ck_tile::HostTensor<DDataType>& d_host,       // [experts, hidden_size, interme_size_1]
+    const ck_tile::HostTensor<AScaleDataType>& sa_host, // [tokens, 1],
+    const ck_tile::HostTensor<GScaleDataType>& sg_host, // [experts, 1, interme_size_0]
+    const ck_tile::HostTensor<DScaleDataType>& sd_host, // [experts, 1, hidden_size],
+    const ck_tile::HostTensor<YSmoothScaleDataType>& sy_host,        // [experts, 1, interme_size_0]
+    ck_tile::HostTensor<ODataType>& o_host,                          // [tokens, hidden_size]
+    const ck_tile::HostTensor<IndexDataType>& sorted_token_ids_host, // [max_num_tokens_padded]
+    const ck_tile::HostTensor<TopkWeightDataType>& sorted_weight_host, // [max_num_tokens_padded]
+    const ck_tile::HostTensor<IndexDataType>&
+        sorted_expert_ids_host, // [(max_num_tokens_padded + block_size - 1) / block_size]
+    const ck_tile::HostTensor<IndexDataType>& num_sorted_tiles_host, // [1]
+
+    const ck_tile::HostTensor<IndexDataType>&
+        token_ids_host, // [tokens, topk] --> ugly!!! remove in the future
+
+    ck_tile::index_t block_m,
+    ck_tile::index_t tokens,
+    ck_tile::index_t experts,
+    ck_tile::index_t hidden_size,
+    ck_tile::index_t intermediate_size, // this size is for gate/up
+    ck_tile::index_t topk,
+    ck_tile::index_t gate_only)
+{
+    assert(sorted_token_ids_host.get_num_of_dimension() == 1);
+    assert(sorted_weight_host.get_num_of_dimension() == 1);
+    assert(sorted_expert_ids_host.get_num_of_dimension() == 1);
+    assert(num_sorted_tiles_host.get_element_size() == 1);
+    ck_tile::index_t num_sorted_tiles    = num_sorted_tiles_host.mData[0] / block_m;
+    ck_tile::index_t intermediate_size_0 = intermediate_size;
+    ck_tile::index_t intermediate_size_1 = intermediate_size / (gate_only ? 1 : 2);
+
+    detail::check_fused_moe_intermediate_size(intermediate_size_0, intermediate_size_1, gate_only);
+
+    // the valid sorted ids of consecutive tiles of one expert
+    struct expert_group
+    {
+        ck_tile::index_t expert;
+        std::vector<ck_tile::index_t> token, topk;
+        std::vector<TopkWeightDataType> weight;
+        std::vector<AccDataType> a, y; // [rows, hidden_size], [rows, intermediate_size_1]
+    };
+
+    int max_num_tokens_padded = topk * tokens + experts * block_m - topk;
+
+    std::vector<expert_group> groups;
+    for(int i_flatten = 0; i_flatten < max_num_tokens_padded; i_flatten++)
+    {
+        ck_tile::index_t i_tile = i_flatten / block_m;
+        if(i_tile >= num_sorted_tiles)
+            break;
+        ck_tile::index_t i_expert = sorted_expert_ids_host.mData[i_tile];
+        ck_tile::index_t i_token  = sorted_token_ids_host.mData[i_flatten];
+        if(i_token >= tokens)
+            continue;
+
+        if(groups.empty() || groups.back().expert != i_expert ||
+           static_cast<ck_tile::index_t>(groups.back().token.size()) ==
+               detail::kFusedMoeMaxRowsPerGroup)
+            groups.push_back({i_expert, {}, {}, {}, {}, {}});
+
+        auto& group = groups.back();
+        group.token.push_back(i_token);
+        group.topk.push_back(
+            detail::get_fused_moe_topk_id(token_ids_host, i_token, i_expert, topk));
+        group.weight.push_back(sorted_weight_host.mData[i_flatten]);
+    }
+
+    const ck_tile::index_t num_groups = groups.size();
+    const auto num_threads            = std::thread::hardware_concurrency();
+
+    auto num_n_blocks = [](ck_tile::index_t n) {
+        return (n + detail::kFusedMoeNPerBlock - 1) / detail::kFusedMoeNPerBlock;
+    };
+
+    // gather the rows of A each group multiplies
+    auto f_gather = [&](auto i_group) {
+        auto& group                 = groups[i_group];
+        const ck_tile::index_t rows = group.token.size();
+        group.a.resize(static_cast<std::size_t>(rows) * hidden_size);
+        group.y.resize(static_cast<std::size_t>(rows) * intermediate_size_1);
+        for(ck_tile::index_t i_m = 0; i_m < rows; i_m++)
         {
-            AccDataType acc = type_convert<AccDataType>(0);
-            for(ck_tile::index_t i_topk = 0; i_topk < topk; i_topk++)
+            for(ck_tile::index_t i_k = 0; i_k < hidden_size; i_k++)
             {
-                acc += out_topk_tokens(i_token, i_topk, i_n);
+                group.a[static_cast<std::size_t>(i_m) * hidden_size + i_k] =
+                    type_convert<AccDataType>(a_host(group.token[i_m], i_k));
             }
-            o_host(i_token, i_n) = type_convert<ODataType>(acc);
         }
     };
-    make_ParallelTensorFunctor(r, tokens)(std::thread::hardware_concurrency());
+    make_ParallelTensorFunctor(f_gather, num_groups)(num_threads);
+
+    // first gemm and activation, a block of y columns with its gate (and up) columns at a time
+    auto f_gemm_0 = [&](auto i_group, auto i_n_block) {
+        auto& group                 = groups[i_group];
+        const ck_tile::index_t rows = group.token.size();
+        const ck_tile::index_t n0   = i_n_block * detail::kFusedMoeNPerBlock;
+        const ck_tile::index_t nb =
+            std::min(detail::kFusedMoeNPerBlock, intermediate_size_1 - n0);
+
+        std::vector<AccDataType> b_packed;
+        std::vector<AccDataType> acc_gate(static_cast<std::size_t>(rows) * nb);
+        std::vector<AccDataType> acc_up(gate_only ? 0 : acc_gate.size());
+
+        auto gemm_0 = [&](ck_tile::index_t col0, AccDataType* acc) {
+            detail::fused_moe_block_gemm(
+                group.a.data(),
+                rows,
+                hidden_size,
+                nb,
+                [&](auto j, auto k) {
+                    return type_convert<AccDataType>(g_host(group.expert, col0 + j, k));
+                },
+                b_packed,
+                acc);
+        };
+        gemm_0(n0, acc_gate.data());
+        if(!gate_only)
+            gemm_0(n0 + intermediate_size_1, acc_up.data());
+
+        for(ck_tile::index_t i_m = 0; i_m < rows; i_m++)
+        {
+            AccDataType* y = &group.y[static_cast<std::size_t>(i_m) * intermediate_size_1 + n0];
+            for(ck_tile::index_t j = 0; j < nb; j++)
+            {
+                const std::size_t i_acc = static_cast<std::size_t>(i_m) * nb + j;
+                if(gate_only)
+                {
+                    Activation{}(y[j], acc_gate[i_acc]);
+                }
+                else
+                {
+                    AccDataType tmp;
+                    Activation{}(tmp, acc_gate[i_acc]);
+                    y[j] = tmp * acc_up[i_acc];
+                }
+            }
+        }
+    };
+    make_ParallelTensorFunctor(f_gemm_0, num_groups, num_n_blocks(intermediate_size_1))(
+        num_threads);
+
+    ck_tile::HostTensor<AccDataType> out_topk_tokens({tokens, topk, hidden_size});
+
+    // second gemm, weighted into the [token, topk] slot of each row
+    auto f_gemm_1 = [&](auto i_group, auto i_n_block) {
+        const auto& group           = groups[i_group];
+        const ck_tile::index_t rows = group.token.size();
+        const ck_tile::index_t n0   = i_n_block * detail::kFusedMoeNPerBlock;
+        const ck_tile::index_t nb   = std::min(detail::kFusedMoeNPerBlock, hidden_size - n0);
+
+        std::vector<AccDataType> b_packed;
+        std::vector<AccDataType> acc_1(static_cast<std::size_t>(rows) * nb);
+        detail::fused_moe_block_gemm(
+            group.y.data(),
+            rows,
+            intermediate_size_1,
+            nb,
+            [&](auto j, auto k) {
+                return type_convert<AccDataType>(d_host(group.expert, n0 + j, k));
+            },
+            b_packed,
+            acc_1.data());
+
+        for(ck_tile::index_t i_m = 0; i_m < rows; i_m++)
+        {
+            for(ck_tile::index_t j = 0; j < nb; j++)
+            {
+                out_topk_tokens(group.token[i_m], group.topk[i_m], n0 + j) =
+                    acc_1[static_cast<std::size_t>(i_m) * nb + j] * group.weight[i_m];
+            }
+        }
+    };
+    make_ParallelTensorFunctor(f_gemm_1, num_groups, num_n_blocks(hidden_size))(num_threads);
+
+    detail::reduce_fused_moe_topk(out_topk_tokens, o_host, tokens, topk, hidden_size);
 
-    (void)num_sorted_tiles_host;
     (void)sa_host;
     (void)sg_host;
     (void)sd_host;
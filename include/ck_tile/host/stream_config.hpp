@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include "ck_tile/host/timing_statistics.hpp"
 #include <hip/hip_runtime.h>
 
 namespace ck_tile {
@@ -20,6 +21,11 @@ namespace ck_tile {
  *
  *   // create stream config with _some_stream_id_, and benchmark using cpu timer
  *   stream_config s = stream_config{_some_stream_id_, true, 0, 3, 10, false};
+ *
+ *   // time every launch separately and collect median/p10/p90/outliers into stats, repeating
+ *   // (up to 1000 times) until the median is known within 1%
+ *   ck_tile::timing_statistics stats;
+ *   stream_config s = stream_config{_some_stream_id_, true, 0, 3, 10, true, &stats, 0.01f};
  **/
 
 struct stream_config
@@ -30,5 +36,9 @@ struct stream_config
     int cold_niters_       = 3;
     int nrepeat_           = 10;
     bool is_gpu_timer_     = true; // keep compatible
+    // if not null, per-launch statistics are written here and the median is returned
+    timing_statistics* timing_stats_ = nullptr;
+    float target_rel_ci_             = 0.f; // > 0 enables adaptive repetition
+    int max_nrepeat_                 = 1000;
 };
 } // namespace ck_tile
@@ -8,6 +8,7 @@
 #include <hip/hip_runtime.h>
 #include <cstddef>
 #include <chrono>
+#include <vector>
 
 namespace ck_tile {
 
@@ -76,4 +77,73 @@ struct cpu_timer
     std::chrono::time_point<std::chrono::high_resolution_clock> stop_tick;
 };
 
+// per-launch timers for measure_iterations(), see timing_statistics.hpp
+struct gpu_sample_timer
+{
+    CK_TILE_HOST explicit gpu_sample_timer(const hipStream_t& s) : stream(s) {}
+
+    CK_TILE_HOST gpu_sample_timer(const gpu_sample_timer&) = delete;
+    CK_TILE_HOST gpu_sample_timer& operator=(const gpu_sample_timer&) = delete;
+
+    CK_TILE_HOST ~gpu_sample_timer() noexcept(false)
+    {
+        for(auto& e : events)
+            HIP_CHECK_ERROR(hipEventDestroy(e));
+    }
+
+    CK_TILE_HOST void start() { record(); }
+    CK_TILE_HOST void stop() { record(); }
+
+    // return in ms, one entry per start()/stop() pair
+    CK_TILE_HOST std::vector<float> collect()
+    {
+        std::vector<float> r;
+        if(used == 0)
+            return r;
+        HIP_CHECK_ERROR(hipEventSynchronize(events[used - 1]));
+        for(std::size_t i = 0; i + 1 < used; i += 2)
+        {
+            float ms = 0;
+            HIP_CHECK_ERROR(hipEventElapsedTime(&ms, events[i], events[i + 1]));
+            r.push_back(ms);
+        }
+        used = 0;
+        return r;
+    }
+
+    private:
+    CK_TILE_HOST void record()
+    {
+        if(used == events.size())
+        {
+            hipEvent_t e;
+            HIP_CHECK_ERROR(hipEventCreate(&e));
+            events.push_back(e);
+        }
+        HIP_CHECK_ERROR(hipEventRecord(events[used++], stream));
+    }
+
+    hipStream_t stream;
+    std::vector<hipEvent_t> events;
+    std::size_t used = 0;
+};
+
+struct cpu_sample_timer
+{
+    CK_TILE_HOST explicit cpu_sample_timer(const hipStream_t& s) : stream(s) {}
+
+    CK_TILE_HOST void start() { timer.start(stream); }
+    CK_TILE_HOST void stop()
+    {
+        timer.stop(stream);
+        samples.push_back(timer.duration());
+    }
+    CK_TILE_HOST std::vector<float> collect() { return std::move(samples); }
+
+    private:
+    hipStream_t stream;
+    cpu_timer timer;
+    std::vector<float> samples;
+};
+
 } // namespace ck_tile
@@ -0,0 +1,138 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <vector>
+
+namespace ck_tile {
+
+// summary of per-launch times, all in ms
+struct timing_statistics
+{
+    std::vector<float> samples;
+
+    float mean   = 0;
+    float median = 0;
+    float p10    = 0;
+    float p90    = 0;
+    float min    = 0;
+    float max    = 0;
+    float stddev = 0;
+    float cv     = 0; // stddev / mean
+    // samples outside of the Tukey fences [q1 - 1.5 * iqr, q3 + 1.5 * iqr]
+    int num_outliers = 0;
+    // relative half width of the ~95% confidence interval of the median
+    float median_rel_ci = 0;
+    // adaptive repetition reached its precision target before running out of iterations
+    bool converged = false;
+};
+
+// linear interpolation between the closest ranks, same as numpy.percentile
+inline float percentile(const std::vector<float>& sorted, float p)
+{
+    if(sorted.empty())
+        return 0;
+
+    const float pos  = p / 100.f * static_cast<float>(sorted.size() - 1);
+    const auto lower = static_cast<std::size_t>(std::floor(pos));
+    const auto upper = std::min(lower + 1, sorted.size() - 1);
+
+    return sorted[lower] + (pos - static_cast<float>(lower)) * (sorted[upper] - sorted[lower]);
+}
+
+inline timing_statistics compute_timing_statistics(std::vector<float> samples)
+{
+    timing_statistics r;
+    if(samples.empty())
+        return r;
+
+    std::vector<float> sorted = samples;
+    std::sort(sorted.begin(), sorted.end());
+
+    const int n = static_cast<int>(sorted.size());
+
+    r.mean   = std::accumulate(sorted.begin(), sorted.end(), 0.f) / n;
+    r.median = percentile(sorted, 50.f);
+    r.p10    = percentile(sorted, 10.f);
+    r.p90    = percentile(sorted, 90.f);
+    r.min    = sorted.front();
+    r.max    = sorted.back();
+
+    float sq_sum = 0;
+    for(float t : sorted)
+        sq_sum += (t - r.mean) * (t - r.mean);
+    r.stddev = n > 1 ? std::sqrt(sq_sum / (n - 1)) : 0.f;
+    r.cv     = r.mean > 0 ? r.stddev / r.mean : 0.f;
+
+    const float q1  = percentile(sorted, 25.f);
+    const float q3  = percentile(sorted, 75.f);
+    const float iqr = q3 - q1;
+
+    r.num_outliers = static_cast<int>(std::count_if(sorted.begin(), sorted.end(), [&](float t) {
+        return t < q1 - 1.5f * iqr || t > q3 + 1.5f * iqr;
+    }));
+
+    // distribution free CI of the median, order statistics at n/2 -+ 1.96 * sqrt(n) / 2
+    if(n > 1 && r.median > 0)
+    {
+        const float hw = 0.98f * std::sqrt(static_cast<float>(n));
+        const int lo   = std::max(0, static_cast<int>(std::floor(n / 2.f - hw)));
+        const int hi   = std::min(n - 1, static_cast<int>(std::ceil(n / 2.f + hw)));
+
+        r.median_rel_ci = (sorted[hi] - sorted[lo]) / (2.f * r.median);
+    }
+    else
+    {
+        r.median_rel_ci = INFINITY;
+    }
+
+    r.samples = std::move(samples);
+    return r;
+}
+
+//
+// time every launch separately
+//
+// the timer needs "start()", "stop()" around every sample and "collect()" returning the ms of
+// all samples since the last collect(), so a batch is enqueued without host synchronization and
+// a virtual clock can be used on host. with target_rel_ci > 0 the callable is repeated in
+// doubling batches until the median is known to that relative precision or max_nrepeat is hit
+//
+template <typename Timer, typename Callable>
+timing_statistics measure_iterations(
+    Timer& timer, Callable&& callable, int nrepeat, int max_nrepeat = 0, float target_rel_ci = 0)
+{
+    std::vector<float> samples;
+    timing_statistics r;
+
+    max_nrepeat = std::max(nrepeat, max_nrepeat);
+
+    for(int batch = nrepeat; batch > 0;)
+    {
+        for(int i = 0; i < batch; i++)
+        {
+            timer.start();
+            callable();
+            timer.stop();
+        }
+        const auto batch_samples = timer.collect();
+        samples.insert(samples.end(), batch_samples.begin(), batch_samples.end());
+
+        r = compute_timing_statistics(samples);
+        if(target_rel_ci <= 0 || r.median_rel_ci <= target_rel_ci)
+        {
+            r.converged = true;
+            break;
+        }
+
+        const int total = static_cast<int>(samples.size());
+        batch           = std::min(total, max_nrepeat - total);
+    }
+    return r;
+}
+
+} // namespace ck_tile
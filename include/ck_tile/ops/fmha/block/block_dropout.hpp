@@ -24,6 +24,11 @@ struct NullBlockDropout
 
 struct BlockDropout
 {
+    // each warp draws the bytes of one tile per step, in the C layout of the 32x32 SwizzleA warp
+    // gemms; reference_batched_dropout_randval regenerates them on the host with the same tile
+    static constexpr index_t kRandValTileM = 32;
+    static constexpr index_t kRandValTileN = 32;
+
     CK_TILE_HOST_DEVICE BlockDropout(index_t i_batch,
                                      index_t i_head,
                                      index_t nheads,
@@ -189,6 +194,8 @@ struct BlockDropout
         constexpr index_t kNPerBlock = BlockGemmShape::kN;
         constexpr index_t kMPerStep  = MWarp * WG::kM;
         constexpr index_t kNPerStep  = NWarp * WG::kN;
+        static_assert(WG::kM == kRandValTileM && WG::kN == kRandValTileN,
+                      "wrong! the random bytes are drawn per 32x32 tile");
 
         // randval tile in LDS
         auto randval_lds = make_tensor_view<address_space_enum::lds>(
@@ -519,6 +526,8 @@ struct BlockDropoutBwd<true, IsWG32_, IsStoreRandval_>
         constexpr index_t kNPerBlock = BlockGemmShape::kN;
         constexpr index_t kMPerStep  = MWarp * WG::kM;
         constexpr index_t kNPerStep  = NWarp * WG::kN;
+        static_assert(WG::kM == kRandValTileM && WG::kN == kRandValTileN,
+                      "wrong! the random bytes are drawn per 32x32 tile");
 
         // randval tile in LDS
         auto randval_lds = make_tensor_view<address_space_enum::lds>(
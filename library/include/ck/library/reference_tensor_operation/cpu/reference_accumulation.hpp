@@ -0,0 +1,309 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iomanip>
+#include <ostream>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "ck/ck.hpp"
+#include "ck/utility/data_type.hpp"
+#include "ck/utility/type_convert.hpp"
+#include "ck/library/utility/host_tensor.hpp"
+
+namespace ck {
+namespace tensor_operation {
+namespace host {
+
+enum struct AccumulationMode
+{
+    Sequential, // plain running sums
+    Kahan,      // compensated running sums
+    Pairwise,   // sums of halves, recursively
+    Fp64,       // all products summed in double and rounded once, the oracle
+};
+
+// Order in which a reference reduces the K products of one output, to reproduce the partial sums
+// of a device instance rather than a plain loop:
+//
+// - the K range is cut at k_split_begins into ranges reduced separately, whose sums are added in
+//   order: the K batches of split-K, or the work units a stream-K tile is shared between;
+// - within a range starting at begin, the products of every K tile
+//   [begin + i * k_per_block, begin + (i + 1) * k_per_block) are summed into a fresh partial that
+//   then joins the range's sum, as a block GEMM does with the products of one K loop step.
+//
+// mode says how each of these sums is formed. The default policy is the plain loop the references
+// always ran.
+struct AccumulationPolicy
+{
+    AccumulationMode mode = AccumulationMode::Sequential;
+    index_t k_per_block   = 0;           // 0: no K tiles
+    std::vector<index_t> k_split_begins; // empty: one range
+
+    bool IsDefault() const
+    {
+        return mode == AccumulationMode::Sequential && k_per_block == 0 &&
+               (k_split_begins.empty() || k_split_begins == std::vector<index_t>{0});
+    }
+};
+
+// the split-K order of a device GEMM cutting K into k_batch batches of KPerBlock multiples
+inline AccumulationPolicy
+make_split_k_accumulation_policy(index_t K,
+                                 index_t k_per_block,
+                                 index_t k_batch,
+                                 AccumulationMode mode = AccumulationMode::Sequential)
+{
+    if(k_per_block <= 0 || k_batch <= 0)
+        throw std::runtime_error("wrong! invalid split-K parameters");
+
+    const index_t k_per_batch =
+        (K + k_per_block * k_batch - 1) / (k_per_block * k_batch) * k_per_block;
+
+    AccumulationPolicy policy{mode, k_per_block, {}};
+    for(index_t k = 0; k < K; k += k_per_batch)
+        policy.k_split_begins.push_back(k);
+    return policy;
+}
+
+// the split-K order of the universal GEMMs (the xdl cshuffle v3 gridwise GEMM): their batches are
+// KRead long, a multiple of k_read_vec = lcm(AK1, BK1) rather than of KPerBlock, the last one
+// taking the rest
+inline AccumulationPolicy
+make_universal_split_k_accumulation_policy(index_t K,
+                                           index_t k_per_block,
+                                           index_t k_read_vec,
+                                           index_t k_batch,
+                                           AccumulationMode mode = AccumulationMode::Sequential)
+{
+    if(k_per_block <= 0 || k_read_vec <= 0 || k_batch <= 0)
+        throw std::runtime_error("wrong! invalid split-K parameters");
+
+    const index_t k_read = (K + k_read_vec * k_batch - 1) / (k_read_vec * k_batch) * k_read_vec;
+
+    AccumulationPolicy policy{mode, k_per_block, {}};
+    for(index_t i = 0; i < k_batch && i * k_read < K; ++i)
+        policy.k_split_begins.push_back(i * k_read);
+    return policy;
+}
+
+// the stream-K order of a tile whose K loop iterations (of k_per_block each) are shared between
+// work units starting at the given iterations
+inline AccumulationPolicy
+make_stream_k_accumulation_policy(index_t k_per_block,
+                                  const std::vector<index_t>& unit_begin_iters,
+                                  AccumulationMode mode = AccumulationMode::Sequential)
+{
+    if(k_per_block <= 0)
+        throw std::runtime_error("wrong! invalid stream-K parameters");
+
+    AccumulationPolicy policy{mode, k_per_block, {}};
+    for(const index_t iter : unit_begin_iters)
+        policy.k_split_begins.push_back(iter * k_per_block);
+    return policy;
+}
+
+namespace detail {
+
+template <typename T>
+T pairwise_sum(const T* values, std::size_t n)
+{
+    if(n == 0)
+        return T{0};
+    if(n == 1)
+        return values[0];
+    return pairwise_sum(values, n / 2) + pairwise_sum(values + n / 2, n - n / 2);
+}
+
+// one sum of an accumulation policy
+template <typename T>
+struct AccumulationSum
+{
+    explicit AccumulationSum(AccumulationMode mode) : mode_(mode) {}
+
+    void Add(T v)
+    {
+        if(mode_ == AccumulationMode::Kahan)
+        {
+            const T y = v - compensation_;
+            const T t = sum_ + y;
+
+            compensation_ = (t - sum_) - y;
+            sum_          = t;
+        }
+        else if(mode_ == AccumulationMode::Pairwise)
+        {
+            values_.push_back(v);
+        }
+        else
+        {
+            sum_ += v;
+        }
+    }
+
+    T Get() const
+    {
+        return mode_ == AccumulationMode::Pairwise ? pairwise_sum(values_.data(), values_.size())
+                                                   : sum_;
+    }
+
+    private:
+    AccumulationMode mode_;
+    T sum_{0};
+    T compensation_{0};
+    std::vector<T> values_;
+};
+
+} // namespace detail
+
+// sum of a(k) * b(k) over k in [0, K) in the order of policy, f(k, a, b) giving the operands
+template <typename AccDataType, typename F>
+AccDataType accumulate_products(index_t K, const AccumulationPolicy& policy, F&& f)
+{
+    AccDataType v_a{0};
+    AccDataType v_b{0};
+
+    if(policy.IsDefault())
+    {
+        AccDataType v_acc{0};
+        for(index_t k = 0; k < K; ++k)
+        {
+            f(k, v_a, v_b);
+            v_acc += v_a * v_b;
+        }
+        return v_acc;
+    }
+
+    if(policy.mode == AccumulationMode::Fp64)
+    {
+        double v_acc = 0;
+        for(index_t k = 0; k < K; ++k)
+        {
+            f(k, v_a, v_b);
+            v_acc += static_cast<double>(v_a) * static_cast<double>(v_b);
+        }
+        return static_cast<AccDataType>(v_acc);
+    }
+
+    std::vector<index_t> begins = policy.k_split_begins;
+    if(begins.empty() || begins.front() != 0)
+        begins.insert(begins.begin(), 0);
+    if(!std::is_sorted(begins.begin(), begins.end()) || begins.back() > K)
+        throw std::runtime_error("wrong! invalid K splits");
+
+    detail::AccumulationSum<AccDataType> total(policy.mode);
+    for(std::size_t i = 0; i < begins.size(); ++i)
+    {
+        const index_t end = i + 1 < begins.size() ? begins[i + 1] : K;
+
+        detail::AccumulationSum<AccDataType> range(policy.mode);
+        for(index_t k = begins[i]; k < end;)
+        {
+            const index_t tile_end =
+                policy.k_per_block > 0 ? std::min(end, k + policy.k_per_block) : end;
+
+            detail::AccumulationSum<AccDataType> tile(policy.mode);
+            for(; k < tile_end; ++k)
+            {
+                f(k, v_a, v_b);
+                tile.Add(v_a * v_b);
+            }
+            range.Add(tile.Get());
+        }
+        total.Add(range.Get());
+    }
+    return total.Get();
+}
+
+// Error budget of a device result against an oracle (an Fp64 reference run): the expected error
+// of an element is that of the reference emulating the instance's accumulation order, plus the
+// rounding of the output type. Elements past it point at a precision problem rather than at the
+// order of the sums, and the observed error bounds the tolerance the instance needs.
+struct AccumulationErrorReport
+{
+    std::size_t num_elements    = 0;
+    std::size_t num_over_budget = 0;
+    double max_abs_oracle       = 0;
+    double max_expected_error   = 0; // |emulated - oracle|
+    double max_observed_error   = 0; // |result - oracle|
+    double mean_observed_error  = 0;
+
+    // the relative tolerance the result passes with
+    double GetRelativeThreshold() const
+    {
+        return max_abs_oracle > 0 ? max_observed_error / max_abs_oracle : max_observed_error;
+    }
+
+    void Print(std::ostream& os) const
+    {
+        const auto flags     = os.flags();
+        const auto precision = os.precision();
+        os << std::scientific << std::setprecision(3) << "expected error " << max_expected_error
+           << ", observed error " << max_observed_error << " (mean " << mean_observed_error
+           << "), relative threshold " << GetRelativeThreshold() << ", " << num_over_budget
+           << " of " << num_elements << " elements over budget" << std::endl;
+        os.flags(flags);
+        os.precision(precision);
+    }
+};
+
+namespace detail {
+
+template <typename T>
+double to_error_double(const T& x)
+{
+    if constexpr(std::is_integral_v<T> || std::is_same_v<T, double>)
+        return static_cast<double>(x);
+    else
+        return static_cast<double>(ck::type_convert<float>(x));
+}
+
+} // namespace detail
+
+template <typename OutDataType, typename EmulatedDataType, typename OracleDataType>
+AccumulationErrorReport get_accumulation_error_report(const Tensor<OutDataType>& result,
+                                                      const Tensor<EmulatedDataType>& emulated,
+                                                      const Tensor<OracleDataType>& oracle)
+{
+    if(result.mData.size() != oracle.mData.size() ||
+       emulated.mData.size() != oracle.mData.size())
+        throw std::runtime_error("wrong! inconsistent size");
+
+    AccumulationErrorReport report;
+    report.num_elements = oracle.mData.size();
+
+    double sum_observed_error = 0;
+    for(std::size_t i = 0; i < oracle.mData.size(); ++i)
+    {
+        const double v_oracle = detail::to_error_double(oracle.mData[i]);
+        const double expected = std::abs(detail::to_error_double(emulated.mData[i]) - v_oracle);
+        const double observed = std::abs(detail::to_error_double(result.mData[i]) - v_oracle);
+
+        // an ulp of the output type at the oracle, at least its rounding
+        double rounding = 0;
+        if constexpr(!std::is_integral_v<OutDataType>)
+            rounding = std::ldexp(std::abs(v_oracle), -NumericUtils<OutDataType>::mant);
+
+        if(observed > expected + rounding)
+            ++report.num_over_budget;
+
+        report.max_abs_oracle     = std::max(report.max_abs_oracle, std::abs(v_oracle));
+        report.max_expected_error = std::max(report.max_expected_error, expected);
+        report.max_observed_error = std::max(report.max_observed_error, observed);
+        sum_observed_error += observed;
+    }
+    if(report.num_elements > 0)
+        report.mean_observed_error = sum_observed_error / report.num_elements;
+
+    return report;
+}
+
+} // namespace host
+} // namespace tensor_operation
+} // namespace ck
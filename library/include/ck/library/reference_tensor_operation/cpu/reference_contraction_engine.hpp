@@ -0,0 +1,476 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <complex>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "ck/library/utility/host_tensor.hpp"
+
+namespace ck {
+namespace tensor_operation {
+namespace host {
+
+// Host contraction of two tensors by mode labels, einsum style:
+//
+//   "gmk,gnk->gmn"  C[g, m, n] = sum_k A[g, m, k] * B[g, n, k]
+//
+// Each label is one letter and names one dimension of an operand, in the order of its lengths.
+// Labels of C that both A and B have are batch (G) modes, the other labels of C are the M modes
+// (from A) and N modes (from B), and the labels A and B share but C does not are the K modes.
+// G, M, N and K each linearize their modes, in the order they appear in C (G, M, N) and A (K).
+//
+// The contraction is lowered onto the batched GEMM C[g, m, n] = sum_k A[g, m, k] * B[g, n, k]
+// without transposing any operand into a packed copy: per operand and GEMM dimension the plan
+// keeps the offset of every linear index, the blocked GEMM gathers its panels straight out of the
+// strided tensors, and C (and the D tensors of the epilogue) are addressed through their own
+// strides. Every C element sums its K products in order, as the nested loops of a naive
+// reference would.
+class ContractionPlan
+{
+    public:
+    ContractionPlan(const std::string& spec,
+                    const HostTensorDescriptor& a_desc,
+                    const HostTensorDescriptor& b_desc,
+                    const HostTensorDescriptor& c_desc)
+    {
+        const auto arrow = spec.find("->");
+        const auto comma = spec.find(',');
+        if(arrow == std::string::npos || comma == std::string::npos || comma > arrow)
+            throw std::runtime_error("wrong! contraction spec is not \"A,B->C\": " + spec);
+
+        a_modes_ = spec.substr(0, comma);
+        b_modes_ = spec.substr(comma + 1, arrow - comma - 1);
+        c_modes_ = spec.substr(arrow + 2);
+
+        std::array<std::size_t, 128> lengths{};
+        CheckOperand(a_modes_, a_desc, lengths);
+        CheckOperand(b_modes_, b_desc, lengths);
+        CheckOperand(c_modes_, c_desc, lengths);
+
+        for(char mode : c_modes_)
+        {
+            const bool in_a = Has(a_modes_, mode);
+            const bool in_b = Has(b_modes_, mode);
+
+            if(in_a && in_b)
+                g_modes_ += mode;
+            else if(in_a)
+                m_modes_ += mode;
+            else if(in_b)
+                n_modes_ += mode;
+            else
+                throw std::runtime_error(std::string("wrong! mode of C not in A or B: ") + mode);
+        }
+
+        for(char mode : a_modes_)
+        {
+            if(!Has(c_modes_, mode))
+            {
+                if(!Has(b_modes_, mode))
+                    throw std::runtime_error(std::string("wrong! mode only A has: ") + mode);
+                k_modes_ += mode;
+            }
+        }
+
+        for(char mode : b_modes_)
+        {
+            if(!Has(a_modes_, mode) && !Has(c_modes_, mode))
+                throw std::runtime_error(std::string("wrong! mode only B has: ") + mode);
+        }
+
+        a_g_ = MakeOffsets(g_modes_, a_modes_, a_desc);
+        a_m_ = MakeOffsets(m_modes_, a_modes_, a_desc);
+        a_k_ = MakeOffsets(k_modes_, a_modes_, a_desc);
+        b_g_ = MakeOffsets(g_modes_, b_modes_, b_desc);
+        b_n_ = MakeOffsets(n_modes_, b_modes_, b_desc);
+        b_k_ = MakeOffsets(k_modes_, b_modes_, b_desc);
+
+        c_lengths_ = c_desc.GetLengths();
+        c_offsets_ = MakeOutputOffsets(c_desc);
+    }
+
+    std::size_t GetG() const { return a_g_.size(); }
+    std::size_t GetM() const { return a_m_.size(); }
+    std::size_t GetN() const { return b_n_.size(); }
+    std::size_t GetK() const { return a_k_.size(); }
+
+    const std::string& GetGModes() const { return g_modes_; }
+    const std::string& GetMModes() const { return m_modes_; }
+    const std::string& GetNModes() const { return n_modes_; }
+    const std::string& GetKModes() const { return k_modes_; }
+
+    // offsets of G, M and N indices of a tensor laid out like C (C itself or a D tensor)
+    struct OutputOffsets
+    {
+        std::vector<std::size_t> g_, m_, n_;
+    };
+
+    OutputOffsets MakeOutputOffsets(const HostTensorDescriptor& desc) const
+    {
+        if(desc.GetLengths() != c_lengths_)
+            throw std::runtime_error("wrong! D tensor lengths differ from C");
+
+        return {MakeOffsets(g_modes_, c_modes_, desc),
+                MakeOffsets(m_modes_, c_modes_, desc),
+                MakeOffsets(n_modes_, c_modes_, desc)};
+    }
+
+    std::string a_modes_, b_modes_, c_modes_;
+    std::string g_modes_, m_modes_, n_modes_, k_modes_;
+
+    // a_m_[m] is the offset into A of linear M index m, and so on
+    std::vector<std::size_t> a_g_, a_m_, a_k_;
+    std::vector<std::size_t> b_g_, b_n_, b_k_;
+    OutputOffsets c_offsets_;
+
+    private:
+    static bool Has(const std::string& modes, char mode)
+    {
+        return modes.find(mode) != std::string::npos;
+    }
+
+    static void CheckOperand(const std::string& modes,
+                             const HostTensorDescriptor& desc,
+                             std::array<std::size_t, 128>& lengths)
+    {
+        if(modes.size() != desc.GetNumOfDimension())
+            throw std::runtime_error("wrong! number of modes differs from tensor rank: " + modes);
+
+        for(std::size_t i = 0; i < modes.size(); ++i)
+        {
+            const char mode = modes[i];
+
+            if(!std::isalpha(static_cast<unsigned char>(mode)))
+                throw std::runtime_error("wrong! mode labels are letters: " + modes);
+            if(modes.find(mode, i + 1) != std::string::npos)
+                throw std::runtime_error("wrong! repeated mode in one operand: " + modes);
+
+            auto& length = lengths[static_cast<unsigned char>(mode)];
+            if(length != 0 && length != desc.GetLengths()[i])
+                throw std::runtime_error(std::string("wrong! inconsistent length of mode ") +
+                                         mode);
+            length = desc.GetLengths()[i];
+        }
+    }
+
+    // offset into the operand (labelled by operand_modes) of every linear index over modes, the
+    // first of modes being the slowest
+    static std::vector<std::size_t> MakeOffsets(const std::string& modes,
+                                                const std::string& operand_modes,
+                                                const HostTensorDescriptor& desc)
+    {
+        std::vector<std::size_t> offsets{0};
+
+        for(char mode : modes)
+        {
+            const std::size_t dim    = operand_modes.find(mode);
+            const std::size_t length = desc.GetLengths()[dim];
+            const std::size_t stride = desc.GetStrides()[dim];
+
+            std::vector<std::size_t> next;
+            next.reserve(offsets.size() * length);
+            for(std::size_t offset : offsets)
+                for(std::size_t i = 0; i < length; ++i)
+                    next.push_back(offset + i * stride);
+
+            offsets = std::move(next);
+        }
+
+        return offsets;
+    }
+
+    std::vector<std::size_t> c_lengths_;
+};
+
+namespace detail {
+
+inline constexpr std::size_t kContractionTileM = 64;
+inline constexpr std::size_t kContractionTileN = 64;
+inline constexpr std::size_t kContractionTileK = 128;
+
+// C[g, m, n] = sum_k A[g, m, k] * B[g, n, k], in kContractionTileM x kContractionTileN tiles of C
+// run in parallel. load_a(g, m, k) and load_b(g, n, k) return the (converted) operands, as
+// std::complex for a complex contraction, and store(g, m, n, acc) writes back one element of C.
+// Each tile gathers panels of kContractionTileK of A and B into contiguous buffers, real and
+// imaginary parts apart, and accumulates into a tile of AccDataType.
+template <typename AccDataType, bool IsComplex, typename LoadA, typename LoadB, typename Store>
+void run_blocked_contraction_gemm(std::size_t G,
+                                  std::size_t M,
+                                  std::size_t N,
+                                  std::size_t K,
+                                  LoadA load_a,
+                                  LoadB load_b,
+                                  Store store)
+{
+    constexpr std::size_t kTileM   = kContractionTileM;
+    constexpr std::size_t kTileN   = kContractionTileN;
+    constexpr std::size_t kTileK   = kContractionTileK;
+    constexpr std::size_t kNumPart = IsComplex ? 2 : 1;
+
+    auto f_tile = [&](auto g, auto i_tile_m, auto i_tile_n) {
+        const std::size_t m0 = i_tile_m * kTileM;
+        const std::size_t n0 = i_tile_n * kTileN;
+        const std::size_t ml = std::min(kTileM, M - m0);
+        const std::size_t nl = std::min(kTileN, N - n0);
+
+        std::array<std::vector<AccDataType>, kNumPart> a_panel, b_panel, c_tile;
+        for(std::size_t p = 0; p < kNumPart; ++p)
+        {
+            a_panel[p].resize(kTileM * kTileK);
+            b_panel[p].resize(kTileK * kTileN);
+            c_tile[p].assign(kTileM * kTileN, AccDataType{0});
+        }
+
+        auto pack = [&](auto& panel, std::size_t i, auto v) {
+            if constexpr(IsComplex)
+            {
+                panel[0][i] = v.real();
+                panel[1][i] = v.imag();
+            }
+            else
+            {
+                panel[0][i] = v;
+            }
+        };
+
+        for(std::size_t k0 = 0; k0 < K; k0 += kTileK)
+        {
+            const std::size_t kl = std::min(kTileK, K - k0);
+
+            // A panel [ml, kl] and B panel [kl, nl], both row-major
+            for(std::size_t i = 0; i < ml; ++i)
+                for(std::size_t k = 0; k < kl; ++k)
+                    pack(a_panel, i * kl + k, load_a(g, m0 + i, k0 + k));
+
+            for(std::size_t j = 0; j < nl; ++j)
+                for(std::size_t k = 0; k < kl; ++k)
+                    pack(b_panel, k * nl + j, load_b(g, n0 + j, k0 + k));
+
+            for(std::size_t i = 0; i < ml; ++i)
+            {
+                for(std::size_t k = 0; k < kl; ++k)
+                {
+                    if constexpr(IsComplex)
+                    {
+                        const AccDataType a_re = a_panel[0][i * kl + k];
+                        const AccDataType a_im = a_panel[1][i * kl + k];
+                        const AccDataType* b_re = &b_panel[0][k * nl];
+                        const AccDataType* b_im = &b_panel[1][k * nl];
+                        AccDataType* c_re       = &c_tile[0][i * kTileN];
+                        AccDataType* c_im       = &c_tile[1][i * kTileN];
+
+                        for(std::size_t j = 0; j < nl; ++j)
+                        {
+                            c_re[j] += a_re * b_re[j] - a_im * b_im[j];
+                            c_im[j] += a_re * b_im[j] + a_im * b_re[j];
+                        }
+                    }
+                    else
+                    {
+                        const AccDataType a = a_panel[0][i * kl + k];
+                        const AccDataType* b = &b_panel[0][k * nl];
+                        AccDataType* c       = &c_tile[0][i * kTileN];
+
+                        for(std::size_t j = 0; j < nl; ++j)
+                            c[j] += a * b[j];
+                    }
+                }
+            }
+        }
+
+        for(std::size_t i = 0; i < ml; ++i)
+        {
+            for(std::size_t j = 0; j < nl; ++j)
+            {
+                if constexpr(IsComplex)
+                    store(g,
+                          m0 + i,
+                          n0 + j,
+                          std::complex<AccDataType>{c_tile[0][i * kTileN + j],
+                                                    c_tile[1][i * kTileN + j]});
+                else
+                    store(g, m0 + i, n0 + j, c_tile[0][i * kTileN + j]);
+            }
+        }
+    };
+
+    make_ParallelTensorFunctor(f_tile,
+                               G,
+                               (M + kTileM - 1) / kTileM,
+                               (N + kTileN - 1) / kTileN)(std::thread::hardware_concurrency());
+}
+
+} // namespace detail
+
+// real and imaginary part of a complex tensor, kept apart as in the complex device ops
+template <typename TensorType>
+struct SplitComplexTensor
+{
+    TensorType& real_;
+    TensorType& imag_;
+};
+
+template <typename TensorType>
+SplitComplexTensor<TensorType> split_complex(TensorType& real, TensorType& imag)
+{
+    return {real, imag};
+}
+
+// Runs the contraction of a ContractionPlan. The operands go through the conversions of the
+// device ops: a_op(v_a, type_convert<AccDataType>(type_convert<ComputeDataType>(a))), and alike
+// for B. Each element of E is written by cde_op(e, c, ds...), c being the AccDataType sum and ds
+// the elements of the D tensors (laid out like E) at the same index; this covers the scale and
+// bilinear epilogues of the contraction device ops.
+class ReferenceContractionEngine
+{
+    public:
+    ReferenceContractionEngine(const std::string& spec,
+                               const HostTensorDescriptor& a_desc,
+                               const HostTensorDescriptor& b_desc,
+                               const HostTensorDescriptor& e_desc)
+        : plan_{spec, a_desc, b_desc, e_desc}
+    {
+    }
+
+    const ContractionPlan& GetPlan() const { return plan_; }
+
+    template <typename AccDataType,
+              typename ComputeDataType = AccDataType,
+              typename ADataType,
+              typename BDataType,
+              typename EDataType,
+              typename AElementwiseOperation,
+              typename BElementwiseOperation,
+              typename CDEElementwiseOperation,
+              typename... DsDataType>
+    void Run(const Tensor<ADataType>& a,
+             const Tensor<BDataType>& b,
+             Tensor<EDataType>& e,
+             AElementwiseOperation a_element_op,
+             BElementwiseOperation b_element_op,
+             CDEElementwiseOperation cde_element_op,
+             const Tensor<DsDataType>&... ds) const
+    {
+        const auto& p = plan_;
+        const std::array<ContractionPlan::OutputOffsets, sizeof...(DsDataType)> ds_offsets{
+            p.MakeOutputOffsets(ds.mDesc)...};
+
+        auto load_a = [&](auto g, auto m, auto k) {
+            return Convert<AccDataType, ComputeDataType>(
+                a_element_op, a.mData[p.a_g_[g] + p.a_m_[m] + p.a_k_[k]]);
+        };
+        auto load_b = [&](auto g, auto n, auto k) {
+            return Convert<AccDataType, ComputeDataType>(
+                b_element_op, b.mData[p.b_g_[g] + p.b_n_[n] + p.b_k_[k]]);
+        };
+        auto store = [&](auto g, auto m, auto n, const AccDataType& c) {
+            ForEachIndex(std::index_sequence_for<DsDataType...>{}, [&](auto... is) {
+                cde_element_op(e.mData[Offset(p.c_offsets_, g, m, n)],
+                               c,
+                               ds.mData[Offset(ds_offsets[is], g, m, n)]...);
+            });
+        };
+
+        detail::run_blocked_contraction_gemm<AccDataType, false>(
+            p.GetG(), p.GetM(), p.GetN(), p.GetK(), load_a, load_b, store);
+    }
+
+    // Complex contraction of split complex tensors, in one pass rather than one real contraction
+    // per pair of parts. The element ops of A and B apply to either part alike, and cde_op takes
+    // std::complex<AccDataType> for E, C and every D; E is written back part by part through
+    // type_convert.
+    template <typename AccDataType,
+              typename ComputeDataType = AccDataType,
+              typename ATensor,
+              typename BTensor,
+              typename ETensor,
+              typename AElementwiseOperation,
+              typename BElementwiseOperation,
+              typename CDEElementwiseOperation,
+              typename... DsTensor>
+    void RunComplex(const SplitComplexTensor<ATensor>& a,
+                    const SplitComplexTensor<BTensor>& b,
+                    const SplitComplexTensor<ETensor>& e,
+                    AElementwiseOperation a_element_op,
+                    BElementwiseOperation b_element_op,
+                    CDEElementwiseOperation cde_element_op,
+                    const SplitComplexTensor<DsTensor>&... ds) const
+    {
+        using Complex   = std::complex<AccDataType>;
+        using EDataType = typename std::remove_const_t<ETensor>::Data::value_type;
+
+        const auto& p = plan_;
+        const std::array<ContractionPlan::OutputOffsets, sizeof...(DsTensor)> ds_offsets{
+            p.MakeOutputOffsets(ds.real_.mDesc)...};
+
+        auto load = [&](const auto& x, auto& op, std::size_t offset) {
+            return Complex{Convert<AccDataType, ComputeDataType>(op, x.real_.mData[offset]),
+                           Convert<AccDataType, ComputeDataType>(op, x.imag_.mData[offset])};
+        };
+        auto load_a = [&](auto g, auto m, auto k) {
+            return load(a, a_element_op, p.a_g_[g] + p.a_m_[m] + p.a_k_[k]);
+        };
+        auto load_b = [&](auto g, auto n, auto k) {
+            return load(b, b_element_op, p.b_g_[g] + p.b_n_[n] + p.b_k_[k]);
+        };
+        auto store = [&](auto g, auto m, auto n, const Complex& c) {
+            const std::size_t e_offset = Offset(p.c_offsets_, g, m, n);
+
+            auto load_d = [&](const auto& d, const auto& offsets) {
+                const std::size_t d_offset = Offset(offsets, g, m, n);
+                return Complex{ck::type_convert<AccDataType>(d.real_.mData[d_offset]),
+                               ck::type_convert<AccDataType>(d.imag_.mData[d_offset])};
+            };
+
+            Complex v_e;
+            ForEachIndex(std::index_sequence_for<DsTensor...>{}, [&](auto... is) {
+                cde_element_op(v_e, c, load_d(ds, ds_offsets[is])...);
+            });
+
+            e.real_.mData[e_offset] = ck::type_convert<EDataType>(v_e.real());
+            e.imag_.mData[e_offset] = ck::type_convert<EDataType>(v_e.imag());
+        };
+
+        detail::run_blocked_contraction_gemm<AccDataType, true>(
+            p.GetG(), p.GetM(), p.GetN(), p.GetK(), load_a, load_b, store);
+    }
+
+    private:
+    template <std::size_t... Is, typename F>
+    static void ForEachIndex(std::index_sequence<Is...>, F&& f)
+    {
+        f(std::integral_constant<std::size_t, Is>{}...);
+    }
+
+    template <typename AccDataType, typename ComputeDataType, typename Op, typename X>
+    static AccDataType Convert(Op& op, const X& x)
+    {
+        // simulate the possible casting when ComputeDataType differs from the input data type
+        AccDataType v;
+        op(v, ck::type_convert<AccDataType>(ck::type_convert<ComputeDataType>(x)));
+        return v;
+    }
+
+    static std::size_t
+    Offset(const ContractionPlan::OutputOffsets& o, std::size_t g, std::size_t m, std::size_t n)
+    {
+        return o.g_[g] + o.m_[m] + o.n_[n];
+    }
+
+    ContractionPlan plan_;
+};
+
+} // namespace host
+} // namespace tensor_operation
+} // namespace ck
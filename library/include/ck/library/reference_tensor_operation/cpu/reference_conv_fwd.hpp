@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2018-2024, Advanced Micro Devices, Inc. All rights reserved.
+// Copyright (c) 2018-2025, Advanced Micro Devices, Inc. All rights reserved.
 
 #pragma once
 
@@ -20,6 +20,7 @@
 #include "ck/library/utility/host_tensor.hpp"
 #include "ck/library/utility/convolution_parameter.hpp"
 #include "ck/library/utility/convolution_host_tensor_descriptor_helper.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_accumulation.hpp"
 
 namespace ck {
 namespace tensor_operation {
@@ -49,6 +50,10 @@ namespace host {
 // weight descriptor in [G, K, C, Z, Y, X] order
 // output descriptor in [G, N, K, Di, Hi, Wi] order
 // phyiscal layout is irrelavent
+//
+// Without an accumulation policy products are summed in [C, Z, Y, X] loop order, skipping padding.
+// With one they are reduced in the GEMM K order of the channels-last implicit GEMM instances,
+// [Z, Y, X, C], padding contributing zeros as on the device.
 template <ck::index_t NDimSpatial,
           typename InDataType,
           typename WeiDataType,
@@ -78,7 +83,8 @@ struct ReferenceConvFwd : public device::BaseOperator
             OutElementwiseOperation out_element_op,
             const std::array<Tensor<InDataType>, NumAElementwiseTensor>& elementwise_a_tensors,
             const std::array<Tensor<WeiDataType>, NumBElementwiseTensor>& elementwise_b_tensors,
-            const std::array<Tensor<OutDataType>, NumDElementwiseTensor>& elementwise_d_tensors)
+            const std::array<Tensor<OutDataType>, NumDElementwiseTensor>& elementwise_d_tensors,
+            const AccumulationPolicy& accumulation_policy = {})
             : input_{input},
               weight_{weight},
               output_{output},
@@ -91,7 +97,8 @@ struct ReferenceConvFwd : public device::BaseOperator
               in_right_pads_{input_right_pads},
               in_element_op_{in_element_op},
               wei_element_op_{wei_element_op},
-              out_element_op_{out_element_op}
+              out_element_op_{out_element_op},
+              accumulation_policy_{accumulation_policy}
         {
         }
 
@@ -111,6 +118,8 @@ struct ReferenceConvFwd : public device::BaseOperator
         InElementwiseOperation in_element_op_;
         WeiElementwiseOperation wei_element_op_;
         OutElementwiseOperation out_element_op_;
+
+        AccumulationPolicy accumulation_policy_;
     };
 
     struct Invoker : public device::BaseInvoker
@@ -126,6 +135,11 @@ struct ReferenceConvFwd : public device::BaseOperator
                 throw std::runtime_error("wrong! inconsistent dimension");
             }
 
+            if(!arg.accumulation_policy_.IsDefault())
+            {
+                return RunGemmK(arg);
+            }
+
             if constexpr(NDimSpatial == 1)
             {
                 auto func = [&](auto g, auto n, auto k, auto wo) {
@@ -364,6 +378,107 @@ struct ReferenceConvFwd : public device::BaseOperator
             return 1;
         }
 
+        // one output at a time, reducing its products in GEMM K order under the accumulation
+        // policy
+        float RunGemmK(const Argument& arg)
+        {
+            const auto& in_lengths  = arg.input_.GetLengths();
+            const auto& wei_lengths = arg.weight_.GetLengths();
+            const auto& out_lengths = arg.output_.GetLengths();
+
+            const std::size_t C = wei_lengths[2];
+
+            std::size_t filter_size = 1;
+            std::size_t out_size    = 1;
+            for(ck::index_t i = 0; i < NDimSpatial; ++i)
+            {
+                filter_size *= wei_lengths[3 + i];
+                out_size *= out_lengths[3 + i];
+            }
+
+            auto func = [&](auto g, auto n, auto k, auto i_out) {
+                std::vector<std::size_t> in_idx{g, n, 0}, wei_idx{g, k, 0}, out_idx{g, n, k};
+                in_idx.resize(NDimSpatial + 3);
+                wei_idx.resize(NDimSpatial + 3);
+                out_idx.resize(NDimSpatial + 3);
+
+                for(ck::index_t i = NDimSpatial; i-- > 0;)
+                {
+                    out_idx[3 + i] = i_out % out_lengths[3 + i];
+                    i_out /= out_lengths[3 + i];
+                }
+
+                auto f_k = [&](auto gemm_k, float& v_acc_in, float& v_acc_wei) {
+                    const std::size_t c = gemm_k % C;
+                    std::size_t tap     = gemm_k / C;
+
+                    bool in_range = true;
+                    for(ck::index_t i = NDimSpatial; i-- > 0;)
+                    {
+                        const std::size_t x = tap % wei_lengths[3 + i];
+                        tap /= wei_lengths[3 + i];
+
+                        const auto wi =
+                            static_cast<ck::long_index_t>(out_idx[3 + i] * arg.conv_strides_[i]) +
+                            static_cast<ck::long_index_t>(x * arg.conv_dilations_[i]) -
+                            static_cast<ck::long_index_t>(arg.in_left_pads_[i]);
+
+                        in_range = in_range && wi >= 0 &&
+                                   ck::type_convert<std::size_t>(wi) < in_lengths[3 + i];
+                        in_idx[3 + i]  = in_range ? wi : 0;
+                        wei_idx[3 + i] = x;
+                    }
+
+                    if(!in_range)
+                    {
+                        v_acc_in  = 0;
+                        v_acc_wei = 0;
+                        return;
+                    }
+
+                    in_idx[2]  = c;
+                    wei_idx[2] = c;
+
+                    InDataType v_in;
+                    WeiDataType v_wei;
+
+                    ExecuteElementwiseOp(arg.in_element_op_,
+                                         arg.elementwise_a_tensors_,
+                                         Number<NumAElementwiseTensor>{},
+                                         v_in,
+                                         arg.input_(in_idx),
+                                         in_idx);
+                    ExecuteElementwiseOp(arg.wei_element_op_,
+                                         arg.elementwise_b_tensors_,
+                                         Number<NumBElementwiseTensor>{},
+                                         v_wei,
+                                         arg.weight_(wei_idx),
+                                         wei_idx);
+
+                    v_acc_in  = ck::type_convert<float>(v_in);
+                    v_acc_wei = ck::type_convert<float>(v_wei);
+                };
+
+                const float v_acc = accumulate_products<float>(
+                    filter_size * C, arg.accumulation_policy_, f_k);
+
+                OutDataType v_acc_converted = ck::type_convert<OutDataType>(v_acc);
+                OutDataType& v_out          = arg.output_(out_idx);
+                ExecuteElementwiseOp(arg.out_element_op_,
+                                     arg.elementwise_d_tensors_,
+                                     Number<NumDElementwiseTensor>{},
+                                     v_out,
+                                     v_acc_converted,
+                                     out_idx);
+            };
+
+            make_ParallelTensorFunctor(
+                func, out_lengths[0], out_lengths[1], out_lengths[2], out_size)(
+                std::thread::hardware_concurrency());
+
+            return 0;
+        }
+
         float Run(const device::BaseArgument* p_arg,
                   const StreamConfig& /*stream_config*/ = StreamConfig{}) override
         {
@@ -425,7 +540,8 @@ struct ReferenceConvFwd : public device::BaseOperator
         OutElementwiseOperation out_element_op,
         const std::array<Tensor<InDataType>, NumAElementwiseTensor>& elementwise_a_tensors  = {},
         const std::array<Tensor<WeiDataType>, NumBElementwiseTensor>& elementwise_b_tensors = {},
-        const std::array<Tensor<OutDataType>, NumDElementwiseTensor>& elementwise_d_tensors = {})
+        const std::array<Tensor<OutDataType>, NumDElementwiseTensor>& elementwise_d_tensors = {},
+        const AccumulationPolicy& accumulation_policy                                      = {})
     {
         return Argument{input,
                         weight,
@@ -439,7 +555,8 @@ struct ReferenceConvFwd : public device::BaseOperator
                         out_element_op,
                         elementwise_a_tensors,
                         elementwise_b_tensors,
-                        elementwise_d_tensors};
+                        elementwise_d_tensors,
+                        accumulation_policy};
     }
 
     static auto MakeInvoker() { return Invoker{}; }
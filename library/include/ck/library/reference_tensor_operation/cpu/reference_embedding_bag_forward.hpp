@@ -0,0 +1,383 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ck/tensor_operation/gpu/device/device_base.hpp"
+#include "ck/library/utility/host_tensor.hpp"
+
+namespace ck {
+namespace tensor_operation {
+namespace host {
+
+enum struct EmbeddingBagPoolMode
+{
+    Sum,
+    Mean,
+    Max,
+};
+
+// lookups of the bags of a batch and the distinct rows they read, summed over the tables
+struct EmbeddingBagGatherStats
+{
+    std::size_t num_lookups     = 0;
+    std::size_t num_unique_rows = 0;
+
+    // the fraction of row reads deduplication saves
+    double Savings() const
+    {
+        return num_lookups > 0 ? 1. - static_cast<double>(num_unique_rows) / num_lookups : 0.;
+    }
+};
+
+namespace detail {
+
+// samples whose lookups are deduplicated and gathered together by one task
+inline constexpr std::size_t kEmbeddingBagSamplesPerBlock = 64;
+
+// sorts and dedupes the rows samples [b0, b1) of a table look up, and maps every lookup to its
+// slot in rows
+template <typename IndexType>
+void dedupe_embedding_bag_rows(const Tensor<IndexType>& indices,
+                               const Tensor<IndexType>& offsets,
+                               std::size_t b0,
+                               std::size_t b1,
+                               std::vector<IndexType>& rows,
+                               std::vector<std::size_t>& slots)
+{
+    const std::size_t begin = offsets.mData[b0];
+    const std::size_t end   = offsets.mData[b1];
+
+    rows.assign(indices.mData.begin() + begin, indices.mData.begin() + end);
+    std::sort(rows.begin(), rows.end());
+    rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+
+    slots.resize(end - begin);
+    for(std::size_t j = begin; j < end; ++j)
+        slots[j - begin] =
+            std::lower_bound(rows.begin(), rows.end(), indices.mData[j]) - rows.begin();
+}
+
+} // namespace detail
+
+// row reads of a batch with and without the per-block deduplication the embedding-bag reference
+// does, for lookups given as in its argument
+template <typename IndexType>
+EmbeddingBagGatherStats
+get_embedding_bag_gather_stats(const std::vector<const Tensor<IndexType>*>& indices,
+                               const std::vector<const Tensor<IndexType>*>& offsets)
+{
+    EmbeddingBagGatherStats stats;
+    std::vector<IndexType> rows;
+    std::vector<std::size_t> slots;
+
+    for(std::size_t t = 0; t < indices.size(); ++t)
+    {
+        const std::size_t batch = offsets[t]->mData.size() - 1;
+        for(std::size_t b0 = 0; b0 < batch; b0 += detail::kEmbeddingBagSamplesPerBlock)
+        {
+            const std::size_t b1 = std::min(b0 + detail::kEmbeddingBagSamplesPerBlock, batch);
+            detail::dedupe_embedding_bag_rows(*indices[t], *offsets[t], b0, b1, rows, slots);
+            stats.num_lookups += slots.size();
+            stats.num_unique_rows += rows.size();
+        }
+    }
+    return stats;
+}
+
+// Embedding bags of NumTables tables, summed over the tables and optionally layer normalized:
+//
+//   x(b, d)      = sum_t pool_{j in bag_t(b)} w_t(j) * emb_t(index_t(j), d)
+//   output(b, d) = layernorm ? (x(b, d) - mean(b)) / sqrt(var(b) + epsilon) * gamma(d) + beta(d)
+//                            : x(b, d)
+//
+// bag_t(b) being the lookups [offsets_t(b), offsets_t(b + 1)) of table t, so offsets_t has
+// batch + 1 elements, and pool a sum, mean or max over them; an empty bag adds nothing. The
+// per-lookup weights w_t (1 if none given) only go with sum pooling.
+//
+// Samples run in parallel in blocks of kEmbeddingBagSamplesPerBlock; each block first gathers the
+// distinct rows its bags read from every table, converted to AccDataType, so a row hot in a
+// recommendation batch is read once per block rather than once per lookup. Within a bag lookups
+// accumulate in offset order and tables in table order, as in the sequential loop.
+template <typename EmbType,
+          typename IndexType,
+          typename WeightType,
+          typename GammaDataType,
+          typename BetaDataType,
+          typename AccDataType,
+          typename OutType>
+struct ReferenceEmbeddingBagForward : public device::BaseOperator
+{
+    struct Argument : public device::BaseArgument
+    {
+        Argument(Tensor<OutType>& output,
+                 const std::vector<const Tensor<EmbType>*>& embs,
+                 const std::vector<const Tensor<IndexType>*>& indices,
+                 const std::vector<const Tensor<IndexType>*>& offsets,
+                 const std::vector<const Tensor<WeightType>*>& weights,
+                 EmbeddingBagPoolMode pool_mode,
+                 const Tensor<GammaDataType>* gamma,
+                 const Tensor<BetaDataType>* beta,
+                 AccDataType epsilon)
+            : output_(output),
+              embs_(embs),
+              indices_(indices),
+              offsets_(offsets),
+              weights_(weights),
+              pool_mode_(pool_mode),
+              gamma_(gamma),
+              beta_(beta),
+              epsilon_(epsilon)
+        {
+        }
+
+        Tensor<OutType>& output_;
+        std::vector<const Tensor<EmbType>*> embs_;
+        std::vector<const Tensor<IndexType>*> indices_;
+        std::vector<const Tensor<IndexType>*> offsets_;
+        std::vector<const Tensor<WeightType>*> weights_; // empty: unweighted
+        EmbeddingBagPoolMode pool_mode_;
+        const Tensor<GammaDataType>* gamma_; // nullptr: no layernorm
+        const Tensor<BetaDataType>* beta_;
+        AccDataType epsilon_;
+    };
+
+    // Invoker
+    struct Invoker : public device::BaseInvoker
+    {
+        static void CheckArgument(const Argument& arg)
+        {
+            const std::size_t num_tables = arg.embs_.size();
+            if(num_tables == 0 || arg.indices_.size() != num_tables ||
+               arg.offsets_.size() != num_tables ||
+               !(arg.weights_.empty() || arg.weights_.size() == num_tables))
+                throw std::runtime_error("wrong! inconsistent number of tables");
+
+            if(!arg.weights_.empty() && arg.pool_mode_ != EmbeddingBagPoolMode::Sum)
+                throw std::runtime_error("wrong! per-index weights need sum pooling");
+
+            if((arg.gamma_ == nullptr) != (arg.beta_ == nullptr))
+                throw std::runtime_error("wrong! layernorm needs both gamma and beta");
+
+            const auto& out_lengths = arg.output_.mDesc.GetLengths();
+            if(out_lengths.size() != 2)
+                throw std::runtime_error("wrong! output is not [batch, embedding dim]");
+            const std::size_t batch = out_lengths[0];
+            const std::size_t D     = out_lengths[1];
+
+            if(arg.gamma_ != nullptr && (arg.gamma_->mData.size() != D ||
+                                         arg.beta_->mData.size() != D))
+                throw std::runtime_error("wrong! gamma and beta are not [embedding dim]");
+
+            for(std::size_t t = 0; t < num_tables; ++t)
+            {
+                const auto& emb_lengths = arg.embs_[t]->mDesc.GetLengths();
+                if(emb_lengths.size() != 2 || emb_lengths[1] != D)
+                    throw std::runtime_error("wrong! table is not [rows, embedding dim]");
+
+                const auto& indices = arg.indices_[t]->mData;
+                const auto& offsets = arg.offsets_[t]->mData;
+                if(offsets.size() != batch + 1 || offsets.front() != 0 ||
+                   static_cast<std::size_t>(offsets.back()) != indices.size() ||
+                   !std::is_sorted(offsets.begin(), offsets.end()))
+                    throw std::runtime_error("wrong! invalid bag offsets");
+
+                if(!arg.weights_.empty() && arg.weights_[t]->mData.size() != indices.size())
+                    throw std::runtime_error("wrong! weights and indices differ in length");
+
+                for(const auto index : indices)
+                {
+                    if(index < 0 || static_cast<std::size_t>(index) >= emb_lengths[0])
+                        throw std::runtime_error("wrong! out of range");
+                }
+            }
+        }
+
+        float Run(const Argument& arg)
+        {
+            CheckArgument(arg);
+
+            const std::size_t num_tables = arg.embs_.size();
+            const std::size_t batch      = arg.output_.mDesc.GetLengths()[0];
+            const std::size_t D          = arg.output_.mDesc.GetLengths()[1];
+            const std::size_t num_blocks =
+                (batch + detail::kEmbeddingBagSamplesPerBlock - 1) /
+                detail::kEmbeddingBagSamplesPerBlock;
+
+            auto f_block = [&](auto i_block) {
+                const std::size_t b0 = i_block * detail::kEmbeddingBagSamplesPerBlock;
+                const std::size_t b1 =
+                    std::min(b0 + detail::kEmbeddingBagSamplesPerBlock, batch);
+
+                // the distinct rows of every table, [slot, d], and the slot of every lookup
+                std::vector<std::vector<AccDataType>> rows(num_tables);
+                std::vector<std::vector<std::size_t>> slots(num_tables);
+                std::vector<IndexType> row_indices;
+
+                for(std::size_t t = 0; t < num_tables; ++t)
+                {
+                    detail::dedupe_embedding_bag_rows(
+                        *arg.indices_[t], *arg.offsets_[t], b0, b1, row_indices, slots[t]);
+
+                    const auto& emb     = *arg.embs_[t];
+                    const auto& strides = emb.mDesc.GetStrides();
+                    rows[t].resize(row_indices.size() * D);
+                    for(std::size_t s = 0; s < row_indices.size(); ++s)
+                    {
+                        const EmbType* p_row = &emb.mData[row_indices[s] * strides[0]];
+                        for(std::size_t d = 0; d < D; ++d)
+                            rows[t][s * D + d] =
+                                ck::type_convert<AccDataType>(p_row[d * strides[1]]);
+                    }
+                }
+
+                std::vector<AccDataType> x(D), bag(D);
+                for(std::size_t b = b0; b < b1; ++b)
+                {
+                    std::fill(x.begin(), x.end(), AccDataType{0});
+
+                    for(std::size_t t = 0; t < num_tables; ++t)
+                    {
+                        const std::size_t begin = arg.offsets_[t]->mData[b];
+                        const std::size_t end   = arg.offsets_[t]->mData[b + 1];
+                        const std::size_t first = arg.offsets_[t]->mData[b0];
+                        if(begin == end)
+                            continue;
+
+                        std::fill(bag.begin(),
+                                  bag.end(),
+                                  arg.pool_mode_ == EmbeddingBagPoolMode::Max
+                                      ? std::numeric_limits<AccDataType>::lowest()
+                                      : AccDataType{0});
+
+                        for(std::size_t j = begin; j < end; ++j)
+                        {
+                            const AccDataType* row = &rows[t][slots[t][j - first] * D];
+
+                            if(arg.pool_mode_ == EmbeddingBagPoolMode::Max)
+                            {
+                                for(std::size_t d = 0; d < D; ++d)
+                                    bag[d] = std::max(bag[d], row[d]);
+                            }
+                            else if(!arg.weights_.empty())
+                            {
+                                const auto w =
+                                    ck::type_convert<AccDataType>(arg.weights_[t]->mData[j]);
+                                for(std::size_t d = 0; d < D; ++d)
+                                    bag[d] += w * row[d];
+                            }
+                            else
+                            {
+                                for(std::size_t d = 0; d < D; ++d)
+                                    bag[d] += row[d];
+                            }
+                        }
+
+                        if(arg.pool_mode_ == EmbeddingBagPoolMode::Mean)
+                        {
+                            const auto bag_size = static_cast<AccDataType>(end - begin);
+                            for(std::size_t d = 0; d < D; ++d)
+                                bag[d] /= bag_size;
+                        }
+
+                        for(std::size_t d = 0; d < D; ++d)
+                            x[d] += bag[d];
+                    }
+
+                    if(arg.gamma_ == nullptr)
+                    {
+                        for(std::size_t d = 0; d < D; ++d)
+                            arg.output_(b, d) = ck::type_convert<OutType>(x[d]);
+                        continue;
+                    }
+
+                    AccDataType mean = 0;
+                    AccDataType var  = 0;
+                    for(std::size_t d = 0; d < D; ++d)
+                    {
+                        mean += x[d];
+                        var += x[d] * x[d];
+                    }
+                    mean = mean / D;
+                    var  = (var / D) - (mean * mean);
+
+                    for(std::size_t d = 0; d < D; ++d)
+                    {
+                        const auto gamma = ck::type_convert<AccDataType>(arg.gamma_->mData[d]);
+                        const auto beta  = ck::type_convert<AccDataType>(arg.beta_->mData[d]);
+
+                        auto y_val        = (x[d] - mean) / std::sqrt(var + arg.epsilon_);
+                        y_val             = (y_val * gamma) + beta;
+                        arg.output_(b, d) = ck::type_convert<OutType>(y_val);
+                    }
+                }
+            };
+
+            make_ParallelTensorFunctor(f_block, num_blocks)(std::thread::hardware_concurrency());
+
+            return 0;
+        }
+
+        float Run(const device::BaseArgument* p_arg,
+                  const StreamConfig& /* stream_config */ = StreamConfig{}) override
+        {
+            return Run(*dynamic_cast<const Argument*>(p_arg));
+        }
+    };
+
+    static constexpr bool IsValidCompilationParameter()
+    {
+        // TODO: properly implement this check
+        return true;
+    }
+
+    bool IsSupportedArgument(const device::BaseArgument*) override { return true; }
+
+    static auto MakeArgument(Tensor<OutType>& output,
+                             const std::vector<const Tensor<EmbType>*>& embs,
+                             const std::vector<const Tensor<IndexType>*>& indices,
+                             const std::vector<const Tensor<IndexType>*>& offsets,
+                             const std::vector<const Tensor<WeightType>*>& weights,
+                             EmbeddingBagPoolMode pool_mode,
+                             const Tensor<GammaDataType>* gamma,
+                             const Tensor<BetaDataType>* beta,
+                             AccDataType epsilon)
+    {
+        return Argument(
+            output, embs, indices, offsets, weights, pool_mode, gamma, beta, epsilon);
+    }
+
+    static auto MakeInvoker() { return Invoker{}; }
+
+    virtual std::unique_ptr<device::BaseInvoker> MakeInvokerPointer()
+    {
+        return std::make_unique<Invoker>(Invoker{});
+    }
+
+    std::string GetTypeString() const override
+    {
+        auto str = std::stringstream();
+
+        // clang-format off
+        str << "ReferenceEmbeddingBagForward"
+            << std::endl;
+        // clang-format on
+
+        return str.str();
+    }
+};
+
+} // namespace host
+} // namespace tensor_operation
+} // namespace ck
@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2018-2024, Advanced Micro Devices, Inc. All rights reserved.
+// Copyright (c) 2018-2025, Advanced Micro Devices, Inc. All rights reserved.
 
 #pragma once
 
@@ -9,6 +9,7 @@
 #include "ck/tensor_operation/gpu/element/unary_element_wise_operation.hpp"
 #include "ck/tensor_operation/gpu/device/device_base.hpp"
 #include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_accumulation.hpp"
 
 namespace ck {
 namespace tensor_operation {
@@ -33,13 +34,15 @@ struct ReferenceGemm : public device::BaseOperator
                  Tensor<CDataType>& c_m_n,
                  AElementwiseOperation a_element_op,
                  BElementwiseOperation b_element_op,
-                 CElementwiseOperation c_element_op)
+                 CElementwiseOperation c_element_op,
+                 const AccumulationPolicy& accumulation_policy = {})
             : a_m_k_{a_m_k},
               b_k_n_{b_k_n},
               c_m_n_{c_m_n},
               a_element_op_{a_element_op},
               b_element_op_{b_element_op},
-              c_element_op_{c_element_op}
+              c_element_op_{c_element_op},
+              accumulation_policy_{accumulation_policy}
         {
         }
 
@@ -50,6 +53,8 @@ struct ReferenceGemm : public device::BaseOperator
         AElementwiseOperation a_element_op_;
         BElementwiseOperation b_element_op_;
         CElementwiseOperation c_element_op_;
+
+        AccumulationPolicy accumulation_policy_;
     };
 
     // Invoker
@@ -62,12 +67,10 @@ struct ReferenceGemm : public device::BaseOperator
             auto f_mk_kn_mn = [&](auto m, auto n) {
                 const int K = arg.a_m_k_.mDesc.GetLengths()[1];
 
-                AccDataType v_acc{0};
                 ComputeTypeA v_a{0};
                 ComputeTypeB v_b{0};
 
-                for(int k = 0; k < K; ++k)
-                {
+                auto f_k = [&](auto k, AccDataType& v_acc_a, AccDataType& v_acc_b) {
                     // use PassThrough instead of ConvertBF16RTN for reference calculation
                     if constexpr(is_same_v<AElementwiseOperation,
                                            ck::tensor_operation::element_wise::ConvertBF16RTN>)
@@ -111,9 +114,12 @@ struct ReferenceGemm : public device::BaseOperator
                         arg.b_element_op_(v_b, arg.b_k_n_(k, n));
                     }
 
-                    v_acc +=
-                        ck::type_convert<AccDataType>(v_a) * ck::type_convert<AccDataType>(v_b);
-                }
+                    v_acc_a = ck::type_convert<AccDataType>(v_a);
+                    v_acc_b = ck::type_convert<AccDataType>(v_b);
+                };
+
+                const AccDataType v_acc =
+                    accumulate_products<AccDataType>(K, arg.accumulation_policy_, f_k);
 
                 CDataType v_c{0};
 
@@ -149,9 +155,11 @@ struct ReferenceGemm : public device::BaseOperator
                              Tensor<CDataType>& c_m_n,
                              AElementwiseOperation a_element_op,
                              BElementwiseOperation b_element_op,
-                             CElementwiseOperation c_element_op)
+                             CElementwiseOperation c_element_op,
+                             const AccumulationPolicy& accumulation_policy = {})
     {
-        return Argument{a_m_k, b_k_n, c_m_n, a_element_op, b_element_op, c_element_op};
+        return Argument{
+            a_m_k, b_k_n, c_m_n, a_element_op, b_element_op, c_element_op, accumulation_policy};
     }
 
     static auto MakeInvoker() { return Invoker{}; }
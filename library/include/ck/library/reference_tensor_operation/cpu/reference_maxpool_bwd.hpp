@@ -1,21 +1,27 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2018-2023, Advanced Micro Devices, Inc. All rights reserved.
+// Copyright (c) 2018-2025, Advanced Micro Devices, Inc. All rights reserved.
 
 #pragma once
 
+#include <algorithm>
 #include <iostream>
 #include <sstream>
+#include <thread>
 #include <vector>
 
 #include "ck/tensor_operation/gpu/device/device_base.hpp"
 #include "ck/library/utility/host_tensor.hpp"
 #include "ck/library/utility/host_tensor_generator.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_pool_window.hpp"
 
 namespace ck {
 namespace tensor_operation {
 namespace host {
 using namespace std;
 
+// indices hold, for every dout element, the offset in din of the input element it was pooled
+// from, as ReferencePoolingFwd outputs them with din laid out as in. The window is the one of
+// the forward pooling.
 template <typename DOutDataType,
           typename IndexDataType,
           typename ConputeDataType,
@@ -29,44 +35,143 @@ struct ReferenceMaxPoolBwd : public device::BaseOperator
         Argument(const Tensor<DOutDataType>& dout,
                  const Tensor<IndexDataType>& indices,
                  Tensor<DInDataType>& din,
+                 std::vector<ck::index_t> window_spatial_lengths,
+                 std::vector<ck::index_t> window_strides,
+                 std::vector<ck::index_t> window_dilations,
+                 std::vector<ck::index_t> in_left_pads,
+                 std::vector<ck::index_t> in_right_pads,
                  ElementwiseOperation elementwise_op)
-            : dout_(dout), indices_(indices), din_(din), elementwise_op_(elementwise_op)
+            : dout_(dout),
+              indices_(indices),
+              din_(din),
+              window_spatial_lengths_(window_spatial_lengths),
+              window_strides_(window_strides),
+              window_dilations_(window_dilations),
+              in_left_pads_(in_left_pads),
+              in_right_pads_(in_right_pads),
+              elementwise_op_(elementwise_op)
         {
         }
 
         const Tensor<DOutDataType>& dout_;
         const Tensor<IndexDataType>& indices_;
         Tensor<DInDataType>& din_;
+
+        std::vector<ck::index_t> window_spatial_lengths_;
+        std::vector<ck::index_t> window_strides_;
+        std::vector<ck::index_t> window_dilations_;
+        std::vector<ck::index_t> in_left_pads_;
+        std::vector<ck::index_t> in_right_pads_;
+
         ElementwiseOperation elementwise_op_;
     };
 
     // Invoker
     struct Invoker : public device::BaseInvoker
     {
+        // Every din element sums the dout elements whose index points at it, in dout order.
+        // Only the douts of the windows reading a din element can point at it, so rather than
+        // going through all the indices, each din element gathers the douts of its transposed
+        // window (make_pool_bwd_taps) and compares their indices with its own offset. Images,
+        // channels and the outermost spatial dimension of din run in parallel, and the result is
+        // the one of a serial pass over dout.
         float Run(const Argument& arg)
         {
-            int din_length  = arg.din_.GetElementSpaceSize();
-            int dout_length = arg.dout_.GetElementSpaceSize();
-            std::vector<ConputeDataType> buf(din_length, 0);
+            const auto& din_lengths       = arg.din_.GetLengths();
+            const auto& dout_lengths      = arg.dout_.GetLengths();
+            const std::size_t num_spatial = din_lengths.size() - 2;
+
+            if(num_spatial == 0 || dout_lengths.size() != din_lengths.size() ||
+               arg.indices_.GetLengths() != dout_lengths ||
+               arg.window_spatial_lengths_.size() != num_spatial ||
+               arg.window_strides_.size() != num_spatial ||
+               arg.window_dilations_.size() != num_spatial ||
+               arg.in_left_pads_.size() != num_spatial)
+            {
+                throw std::runtime_error("wrong! inconsistent dimension");
+            }
 
-            for(int i = 0; i < dout_length; ++i)
+            // taps[d][i]: the dout positions along d whose window reads din position i, in
+            // increasing order
+            std::vector<detail::PoolTaps> taps;
+            for(std::size_t d = 0; d < num_spatial; ++d)
             {
-                int index = arg.indices_.mData[i];
-                if(index >= 0 && index < din_length)
+                taps.push_back(detail::make_pool_bwd_taps(din_lengths[d + 2],
+                                                          dout_lengths[d + 2],
+                                                          arg.window_spatial_lengths_[d],
+                                                          arg.window_strides_[d],
+                                                          arg.window_dilations_[d],
+                                                          arg.in_left_pads_[d]));
+                for(auto& positions : taps.back())
+                    std::reverse(positions.begin(), positions.end());
+            }
+
+            const auto& din_strides  = arg.din_.GetStrides();
+            const auto& dout_strides = arg.dout_.GetStrides();
+
+            std::size_t inner_volume = 1;
+            for(std::size_t d = 1; d < num_spatial; ++d)
+                inner_volume *= din_lengths[d + 2];
+
+            auto f_ncx = [&](auto n, auto c, auto x) {
+                std::vector<index_t> din_index(num_spatial, 0);
+                std::vector<std::size_t> tap(num_spatial, 0);
+                din_index[0] = x;
+
+                for(std::size_t s = 0; s < inner_volume; ++s)
                 {
-                    if constexpr(is_same_v<ConputeDataType, bhalf_t>)
+                    long_index_t din_offset = n * din_strides[0] + c * din_strides[1];
+                    bool has_taps           = true;
+                    for(std::size_t d = 0; d < num_spatial; ++d)
                     {
-                        float buf_val = ck::type_convert<float>(buf[index]);
-                        buf_val += ck::type_convert<float>(arg.dout_.mData[i]);
-                        buf[index] = ck::type_convert<ConputeDataType>(buf_val);
+                        din_offset += din_index[d] * din_strides[d + 2];
+                        has_taps = has_taps && !taps[d][din_index[d]].empty();
+                    }
+
+                    ConputeDataType v = 0;
+
+                    // the douts of the transposed window, in [z, y, x] order
+                    std::fill(tap.begin(), tap.end(), 0);
+                    while(has_taps)
+                    {
+                        std::size_t dout_offset = n * dout_strides[0] + c * dout_strides[1];
+                        for(std::size_t d = 0; d < num_spatial; ++d)
+                            dout_offset += taps[d][din_index[d]][tap[d]] * dout_strides[d + 2];
+
+                        if(static_cast<long_index_t>(arg.indices_.mData[dout_offset]) ==
+                           din_offset)
+                        {
+                            if constexpr(is_same_v<ConputeDataType, bhalf_t>)
+                            {
+                                float v_acc = ck::type_convert<float>(v);
+                                v_acc += ck::type_convert<float>(arg.dout_.mData[dout_offset]);
+                                v = ck::type_convert<ConputeDataType>(v_acc);
+                            }
+                            else
+                                v += ck::type_convert<ConputeDataType>(
+                                    arg.dout_.mData[dout_offset]);
+                        }
+
+                        std::size_t d = num_spatial;
+                        while(d-- > 0 && ++tap[d] == taps[d][din_index[d]].size())
+                            tap[d] = 0;
+                        has_taps = d < num_spatial;
+                    }
+
+                    arg.din_.mData[din_offset] = ck::type_convert<DInDataType>(v);
+
+                    for(std::size_t d = num_spatial; d-- > 1;)
+                    {
+                        if(++din_index[d] < static_cast<index_t>(din_lengths[d + 2]))
+                            break;
+                        din_index[d] = 0;
                     }
-                    else
-                        buf[index] += ck::type_convert<ConputeDataType>(arg.dout_.mData[i]);
                 }
-            }
+            };
+
+            make_ParallelTensorFunctor(f_ncx, din_lengths[0], din_lengths[1], din_lengths[2])(
+                std::thread::hardware_concurrency());
 
-            for(int i = 0; i < din_length; ++i)
-                arg.din_.mData[i] = ck::type_convert<DInDataType>(buf[i]);
             return 0;
         }
 
@@ -82,9 +187,22 @@ struct ReferenceMaxPoolBwd : public device::BaseOperator
     static auto MakeArgument(const Tensor<DOutDataType>& dout,
                              const Tensor<IndexDataType>& indices,
                              Tensor<DInDataType>& din,
+                             std::vector<ck::index_t> window_spatial_lengths,
+                             std::vector<ck::index_t> window_strides,
+                             std::vector<ck::index_t> window_dilations,
+                             std::vector<ck::index_t> in_left_pads,
+                             std::vector<ck::index_t> in_right_pads,
                              ElementwiseOperation elementwise_op)
     {
-        return Argument{dout, indices, din, elementwise_op};
+        return Argument{dout,
+                        indices,
+                        din,
+                        window_spatial_lengths,
+                        window_strides,
+                        window_dilations,
+                        in_left_pads,
+                        in_right_pads,
+                        elementwise_op};
     }
 
     static auto MakeInvoker() { return Invoker{}; }
@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2018-2023, Advanced Micro Devices, Inc. All rights reserved.
+// Copyright (c) 2018-2025, Advanced Micro Devices, Inc. All rights reserved.
 
 #pragma once
 
@@ -7,17 +7,22 @@
 #include <sstream>
 #include <vector>
 #include <algorithm>
+#include <utility>
 
 #include "ck/tensor_operation/gpu/device/device_base.hpp"
 #include "ck/tensor_operation/gpu/device/reduction_operator_mapping.hpp"
 #include "ck/utility/reduction_functions_accumulate.hpp"
 #include "ck/library/utility/host_tensor.hpp"
 #include "ck/library/utility/host_tensor_generator.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_pool_window.hpp"
 
 namespace ck {
 namespace tensor_operation {
 namespace host {
 
+// in and out descriptors in [N, C, spatial...] order, of any physical layout; out_indices holds
+// the offset in in of the element each output was taken from, the first one of its window in
+// [z, y, x] order. ReferenceMaxPoolBwd takes these indices as they are.
 template <index_t InOutRank,
           index_t WindowRank,
           typename InDataType,
@@ -29,6 +34,8 @@ template <index_t InOutRank,
           bool OutputIndex>
 struct ReferencePoolingFwd : public device::BaseOperator
 {
+    static_assert(InOutRank == WindowRank + 2, "wrong! inconsistent dimension");
+
     using ReduceOperation = typename ck::reduce_binary_operator<ReduceOpId>::opType;
 
     // Argument
@@ -68,131 +75,30 @@ struct ReferencePoolingFwd : public device::BaseOperator
     // Invoker
     struct Invoker : public device::BaseInvoker
     {
-        float RunPooling3dFwd(const Argument& arg)
+        float Run(const Argument& arg)
         {
+            if(arg.in_.GetNumOfDimension() != InOutRank ||
+               arg.out_.GetNumOfDimension() != InOutRank)
+                throw std::runtime_error("wrong! inconsistent dimension");
 
-            auto elementwise_ops =
-                ck::reduce_unary_operator<ReduceOpId, true, true>::GetElementwiseOperator(
-                    arg.reduceLength_);
-
-            auto in_elementwise_op  = std::get<0>(elementwise_ops);
-            auto acc_elementwise_op = std::get<1>(elementwise_ops);
-
-            if constexpr(!OutputIndex)
+            if constexpr(OutputIndex)
             {
-                using Accumulation = ck::detail::
-                    AccumulateWithNanCheck<PropagateNan, ReduceOperation, ComputeDataType>;
-
-                auto f_ncdhw = [&](auto n, auto c, auto do_, auto ho, auto wo) {
-                    auto accuVal = ReduceOperation::template GetIdentityValue<ComputeDataType>();
-
-                    for(ck::index_t z = 0; z < arg.window_spatial_lengths_[0]; ++z)
-                    {
-                        ck::index_t di = do_ * arg.window_strides_[0] +
-                                         z * arg.window_dilations_[0] - arg.in_left_pads_[0];
-                        for(ck::index_t y = 0; y < arg.window_spatial_lengths_[1]; ++y)
-                        {
-                            ck::index_t hi = ho * arg.window_strides_[1] +
-                                             y * arg.window_dilations_[1] - arg.in_left_pads_[1];
-                            for(ck::index_t x = 0; x < arg.window_spatial_lengths_[2]; ++x)
-                            {
-                                ck::index_t wi = wo * arg.window_strides_[2] +
-                                                 x * arg.window_dilations_[2] -
-                                                 arg.in_left_pads_[2];
-                                if(di >= 0 &&
-                                   di < static_cast<ck::index_t>(arg.in_.mDesc.GetLengths()[2]) &&
-                                   hi >= 0 &&
-                                   hi < static_cast<ck::index_t>(arg.in_.mDesc.GetLengths()[3]) &&
-                                   wi >= 0 &&
-                                   wi < static_cast<ck::index_t>(arg.in_.mDesc.GetLengths()[4]))
-                                {
-                                    ComputeDataType currVal = ck::type_convert<ComputeDataType>(
-                                        arg.in_(n, c, di, hi, wi));
-
-                                    in_elementwise_op(currVal, currVal);
-
-                                    Accumulation::Calculate(accuVal, currVal);
-                                }
-                            }
-                        }
-                    }
-                    acc_elementwise_op(accuVal, accuVal);
-
-                    arg.out_(n, c, do_, ho, wo) = ck::type_convert<OutDataType>(accuVal);
-                };
-
-                make_ParallelTensorFunctor(f_ncdhw,
-                                           arg.out_.mDesc.GetLengths()[0],
-                                           arg.out_.mDesc.GetLengths()[1],
-                                           arg.out_.mDesc.GetLengths()[2],
-                                           arg.out_.mDesc.GetLengths()[3],
-                                           arg.out_.mDesc.GetLengths()[4])(
-                    std::thread::hardware_concurrency());
+                // the indices are written at the offsets of out
+                if(arg.out_indices_.mDesc.GetLengths() != arg.out_.mDesc.GetLengths() ||
+                   arg.out_indices_.mDesc.GetStrides() != arg.out_.mDesc.GetStrides())
+                    throw std::runtime_error("wrong! out_indices is not laid out as out");
             }
-            else
-            {
-                using Accumulation = ck::detail::AccumulateWithIndexAndNanCheck<PropagateNan,
-                                                                                ReduceOperation,
-                                                                                ComputeDataType,
-                                                                                IndexDataType>;
-
-                auto f_ncdhw = [&](auto n, auto c, auto do_, auto ho, auto wo) {
-                    auto accuVal = ReduceOperation::template GetIdentityValue<ComputeDataType>();
-                    IndexDataType accuIndex = 0;
-
-                    for(ck::index_t z = 0; z < arg.window_spatial_lengths_[0]; ++z)
-                    {
-                        ck::index_t di = do_ * arg.window_strides_[0] +
-                                         z * arg.window_dilations_[0] - arg.in_left_pads_[0];
-                        for(ck::index_t y = 0; y < arg.window_spatial_lengths_[1]; ++y)
-                        {
-                            ck::index_t hi = ho * arg.window_strides_[1] +
-                                             y * arg.window_dilations_[1] - arg.in_left_pads_[1];
-                            for(ck::index_t x = 0; x < arg.window_spatial_lengths_[2]; ++x)
-                            {
-                                ck::index_t wi = wo * arg.window_strides_[2] +
-                                                 x * arg.window_dilations_[2] -
-                                                 arg.in_left_pads_[2];
-                                if(di >= 0 &&
-                                   di < static_cast<ck::index_t>(arg.in_.mDesc.GetLengths()[2]) &&
-                                   hi >= 0 &&
-                                   hi < static_cast<ck::index_t>(arg.in_.mDesc.GetLengths()[3]) &&
-                                   wi >= 0 &&
-                                   wi < static_cast<ck::index_t>(arg.in_.mDesc.GetLengths()[4]))
-                                {
-                                    ComputeDataType currVal = ck::type_convert<ComputeDataType>(
-                                        arg.in_(n, c, di, hi, wi));
-                                    IndexDataType currIndex =
-                                        arg.in_.GetOffsetFromMultiIndex(n, c, di, hi, wi);
-
-                                    in_elementwise_op(currVal, currVal);
-
-                                    Accumulation::Calculate(accuVal, currVal, accuIndex, currIndex);
-                                }
-                            }
-                        }
-                    }
 
-                    acc_elementwise_op(accuVal, accuVal);
-
-                    arg.out_(n, c, do_, ho, wo)         = ck::type_convert<OutDataType>(accuVal);
-                    arg.out_indices_(n, c, do_, ho, wo) = accuIndex;
-                };
-
-                make_ParallelTensorFunctor(f_ncdhw,
-                                           arg.out_.mDesc.GetLengths()[0],
-                                           arg.out_.mDesc.GetLengths()[1],
-                                           arg.out_.mDesc.GetLengths()[2],
-                                           arg.out_.mDesc.GetLengths()[3],
-                                           arg.out_.mDesc.GetLengths()[4])(
-                    std::thread::hardware_concurrency());
-            };
-
-            return 0;
-        }
-
-        float RunPooling2dFwd(const Argument& arg)
-        {
+            std::vector<detail::PoolTaps> taps;
+            for(index_t d = 0; d < WindowRank; ++d)
+            {
+                taps.push_back(detail::make_pool_fwd_taps(arg.in_.GetLengths()[d + 2],
+                                                          arg.out_.GetLengths()[d + 2],
+                                                          arg.window_spatial_lengths_[d],
+                                                          arg.window_strides_[d],
+                                                          arg.window_dilations_[d],
+                                                          arg.in_left_pads_[d]));
+            }
 
             auto elementwise_ops =
                 ck::reduce_unary_operator<ReduceOpId, true, true>::GetElementwiseOperator(
@@ -201,47 +107,31 @@ struct ReferencePoolingFwd : public device::BaseOperator
             auto in_elementwise_op  = std::get<0>(elementwise_ops);
             auto acc_elementwise_op = std::get<1>(elementwise_ops);
 
+            const auto identity = ReduceOperation::template GetIdentityValue<ComputeDataType>();
+
             if constexpr(!OutputIndex)
             {
                 using Accumulation = ck::detail::
                     AccumulateWithNanCheck<PropagateNan, ReduceOperation, ComputeDataType>;
 
-                auto f_nchw = [&](auto n, auto c, auto ho, auto wo) {
-                    auto accuVal = ReduceOperation::template GetIdentityValue<ComputeDataType>();
-
-                    for(ck::index_t y = 0; y < arg.window_spatial_lengths_[0]; ++y)
-                    {
-                        ck::index_t hi = ho * arg.window_strides_[0] +
-                                         y * arg.window_dilations_[0] - arg.in_left_pads_[0];
-                        for(ck::index_t x = 0; x < arg.window_spatial_lengths_[1]; ++x)
-                        {
-                            ck::index_t wi = wo * arg.window_strides_[1] +
-                                             x * arg.window_dilations_[1] - arg.in_left_pads_[1];
-                            if(hi >= 0 &&
-                               hi < static_cast<ck::index_t>(arg.in_.mDesc.GetLengths()[2]) &&
-                               wi >= 0 &&
-                               wi < static_cast<ck::index_t>(arg.in_.mDesc.GetLengths()[3]))
-                            {
-                                ComputeDataType currVal =
-                                    ck::type_convert<ComputeDataType>(arg.in_(n, c, hi, wi));
-
-                                in_elementwise_op(currVal, currVal);
-
-                                Accumulation::Calculate(accuVal, currVal);
-                            }
-                        }
-                    }
-
-                    acc_elementwise_op(accuVal, accuVal);
-                    arg.out_(n, c, ho, wo) = ck::type_convert<OutDataType>(accuVal);
-                };
-
-                make_ParallelTensorFunctor(f_nchw,
-                                           arg.out_.mDesc.GetLengths()[0],
-                                           arg.out_.mDesc.GetLengths()[1],
-                                           arg.out_.mDesc.GetLengths()[2],
-                                           arg.out_.mDesc.GetLengths()[3])(
-                    std::thread::hardware_concurrency());
+                detail::run_separable_pooling(
+                    arg.in_.mDesc,
+                    arg.out_.mDesc,
+                    taps,
+                    identity,
+                    [&](std::size_t offset) {
+                        ComputeDataType currVal =
+                            ck::type_convert<ComputeDataType>(arg.in_.mData[offset]);
+                        in_elementwise_op(currVal, currVal);
+                        return currVal;
+                    },
+                    [](ComputeDataType& accuVal, ComputeDataType currVal) {
+                        Accumulation::Calculate(accuVal, currVal);
+                    },
+                    [&](std::size_t offset, ComputeDataType accuVal) {
+                        acc_elementwise_op(accuVal, accuVal);
+                        arg.out_.mData[offset] = ck::type_convert<OutDataType>(accuVal);
+                    });
             }
             else
             {
@@ -250,63 +140,33 @@ struct ReferencePoolingFwd : public device::BaseOperator
                                                                                 ComputeDataType,
                                                                                 IndexDataType>;
 
-                auto f_nchw = [&](auto n, auto c, auto ho, auto wo) {
-                    auto accuVal = ReduceOperation::template GetIdentityValue<ComputeDataType>();
-                    IndexDataType accuIndex = 0;
-
-                    for(ck::index_t y = 0; y < arg.window_spatial_lengths_[0]; ++y)
-                    {
-                        ck::index_t hi = ho * arg.window_strides_[0] +
-                                         y * arg.window_dilations_[0] - arg.in_left_pads_[0];
-                        for(ck::index_t x = 0; x < arg.window_spatial_lengths_[1]; ++x)
-                        {
-                            ck::index_t wi = wo * arg.window_strides_[1] +
-                                             x * arg.window_dilations_[1] - arg.in_left_pads_[1];
-                            if(hi >= 0 &&
-                               hi < static_cast<ck::index_t>(arg.in_.mDesc.GetLengths()[2]) &&
-                               wi >= 0 &&
-                               wi < static_cast<ck::index_t>(arg.in_.mDesc.GetLengths()[3]))
-                            {
-                                ComputeDataType currVal =
-                                    ck::type_convert<ComputeDataType>(arg.in_(n, c, hi, wi));
-
-                                IndexDataType currIndex =
-                                    arg.in_.GetOffsetFromMultiIndex(n, c, hi, wi);
-
-                                in_elementwise_op(currVal, currVal);
-
-                                Accumulation::Calculate(accuVal, currVal, accuIndex, currIndex);
-                            }
-                        }
-                    }
-
-                    acc_elementwise_op(accuVal, accuVal);
-                    arg.out_(n, c, ho, wo)         = ck::type_convert<OutDataType>(accuVal);
-                    arg.out_indices_(n, c, ho, wo) = accuIndex;
-                };
-
-                make_ParallelTensorFunctor(f_nchw,
-                                           arg.out_.mDesc.GetLengths()[0],
-                                           arg.out_.mDesc.GetLengths()[1],
-                                           arg.out_.mDesc.GetLengths()[2],
-                                           arg.out_.mDesc.GetLengths()[3])(
-                    std::thread::hardware_concurrency());
-            };
+                // the index of a value is its offset in in
+                using ValueIndex = std::pair<ComputeDataType, IndexDataType>;
+
+                detail::run_separable_pooling(
+                    arg.in_.mDesc,
+                    arg.out_.mDesc,
+                    taps,
+                    ValueIndex{identity, 0},
+                    [&](std::size_t offset) {
+                        ComputeDataType currVal =
+                            ck::type_convert<ComputeDataType>(arg.in_.mData[offset]);
+                        in_elementwise_op(currVal, currVal);
+                        return ValueIndex{currVal, static_cast<IndexDataType>(offset)};
+                    },
+                    [](ValueIndex& accu, const ValueIndex& curr) {
+                        Accumulation::Calculate(accu.first, curr.first, accu.second, curr.second);
+                    },
+                    [&](std::size_t offset, ValueIndex accu) {
+                        acc_elementwise_op(accu.first, accu.first);
+                        arg.out_.mData[offset]         = ck::type_convert<OutDataType>(accu.first);
+                        arg.out_indices_.mData[offset] = accu.second;
+                    });
+            }
 
             return 0;
         }
 
-        float Run(const Argument& arg)
-        {
-            // TODO - support generic pooling
-            if constexpr(InOutRank == 5 && WindowRank == 3)
-                return RunPooling3dFwd(arg);
-            else if constexpr(InOutRank == 4 && WindowRank == 2)
-                return RunPooling2dFwd(arg);
-            else
-                throw std::runtime_error("Only support pooling3d or pooling2d so far");
-        }
-
         float Run(const device::BaseArgument* p_arg,
                   const StreamConfig& /* stream_config */ = StreamConfig{}) override
         {
@@ -0,0 +1,311 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "ck/ck.hpp"
+#include "ck/tensor_operation/gpu/device/tensor_layout.hpp"
+#include "ck/library/utility/host_tensor.hpp"
+
+namespace ck {
+namespace tensor_operation {
+namespace host {
+
+// Descriptor of a pooling tensor in [N, C, spatial...] order, laid out in memory as Layout, the
+// layout the device pooling instances take (NCW, NCHW, NCDHW or NWC, NHWC, NDHWC). The host
+// references index through it, so a channels-last tensor is used as is.
+template <typename Layout, typename... SpatialLengths>
+HostTensorDescriptor
+make_pool_host_tensor_descriptor(std::size_t N, std::size_t C, SpatialLengths... spatial)
+{
+    namespace layout = ck::tensor_layout::convolution;
+
+    constexpr bool is_channels_first = is_same_v<Layout, layout::NCW> ||
+                                       is_same_v<Layout, layout::NCHW> ||
+                                       is_same_v<Layout, layout::NCDHW>;
+    constexpr bool is_channels_last = is_same_v<Layout, layout::NWC> ||
+                                      is_same_v<Layout, layout::NHWC> ||
+                                      is_same_v<Layout, layout::NDHWC>;
+    static_assert(is_channels_first || is_channels_last, "unsupported pooling layout");
+
+    const std::vector<std::size_t> lengths{N, C, static_cast<std::size_t>(spatial)...};
+
+    std::vector<std::size_t> strides(lengths.size());
+    std::size_t stride = is_channels_last ? C : 1;
+    for(std::size_t i = lengths.size(); i-- > 2;)
+    {
+        strides[i] = stride;
+        stride *= lengths[i];
+    }
+
+    if constexpr(is_channels_last)
+    {
+        strides[1] = 1;
+    }
+    else
+    {
+        strides[1] = stride;
+        stride *= C;
+    }
+    strides[0] = stride;
+
+    return HostTensorDescriptor(lengths, strides);
+}
+
+namespace detail {
+
+// channels pooled together by one task; channels are the innermost dimension of the volumes a
+// task works on, so channels-last tensors are read and written in runs
+inline constexpr std::size_t kPoolChannelBlock = 16;
+
+// destination positions of every spatial dimension one task produces
+inline constexpr std::size_t kPoolTileLength = 8;
+
+// taps[o] lists the source positions destination position o of one spatial dimension reduces
+using PoolTaps = std::vector<std::vector<index_t>>;
+
+// forward window: output o reads input o * stride + t * dilation - left_pad, t in [0, window)
+inline PoolTaps make_pool_fwd_taps(index_t in_length,
+                                   index_t out_length,
+                                   index_t window,
+                                   index_t stride,
+                                   index_t dilation,
+                                   index_t left_pad)
+{
+    PoolTaps taps(out_length);
+    for(index_t o = 0; o < out_length; ++o)
+    {
+        for(index_t t = 0; t < window; ++t)
+        {
+            const index_t i = o * stride + t * dilation - left_pad;
+            if(i >= 0 && i < in_length)
+                taps[o].push_back(i);
+        }
+    }
+    return taps;
+}
+
+// the transposed window: input i collects output o of every tap t that reads it in the forward
+// window
+inline PoolTaps make_pool_bwd_taps(index_t in_length,
+                                   index_t out_length,
+                                   index_t window,
+                                   index_t stride,
+                                   index_t dilation,
+                                   index_t left_pad)
+{
+    PoolTaps taps(in_length);
+    for(index_t i = 0; i < in_length; ++i)
+    {
+        for(index_t t = 0; t < window; ++t)
+        {
+            const long_index_t tmp = static_cast<long_index_t>(i) + left_pad -
+                                     static_cast<long_index_t>(t) * dilation;
+            if(tmp % stride == 0 && tmp / stride >= 0 && tmp / stride < out_length)
+                taps[i].push_back(static_cast<index_t>(tmp / stride));
+        }
+    }
+    return taps;
+}
+
+// calls f(i, offset) for the elements of channels [c0, c0 + num_c) of image n in the spatial box
+// of the given begin and extents, i counting them in [spatial..., channel] order, offset being
+// their offset in desc
+template <typename F>
+void for_each_pool_element(const HostTensorDescriptor& desc,
+                           std::size_t n,
+                           std::size_t c0,
+                           std::size_t num_c,
+                           const std::vector<std::size_t>& begin,
+                           const std::vector<std::size_t>& extents,
+                           F&& f)
+{
+    const auto& strides           = desc.GetStrides();
+    const std::size_t num_spatial = extents.size();
+
+    std::size_t volume = 1;
+    std::size_t base   = n * strides[0] + c0 * strides[1];
+    for(std::size_t d = 0; d < num_spatial; ++d)
+    {
+        volume *= extents[d];
+        base += begin[d] * strides[d + 2];
+    }
+
+    std::vector<std::size_t> index(num_spatial, 0);
+    std::size_t spatial_offset = 0;
+
+    for(std::size_t s = 0, i = 0; s < volume; ++s)
+    {
+        for(std::size_t c = 0; c < num_c; ++c)
+            f(i++, base + spatial_offset + c * strides[1]);
+
+        for(std::size_t d = num_spatial; d-- > 0;)
+        {
+            spatial_offset += strides[d + 2];
+            if(++index[d] < extents[d])
+                break;
+            spatial_offset -= index[d] * strides[d + 2];
+            index[d] = 0;
+        }
+    }
+}
+
+// reduces dimension d of the row-major volume src of the given extents along taps into dst
+template <typename T, typename Combine>
+void reduce_pool_dim(const std::vector<T>& src,
+                     std::vector<T>& dst,
+                     std::vector<std::size_t>& extents,
+                     std::size_t d,
+                     const PoolTaps& taps,
+                     const T& identity,
+                     Combine& combine)
+{
+    std::size_t outer = 1, inner = 1;
+    for(std::size_t i = 0; i < d; ++i)
+        outer *= extents[i];
+    for(std::size_t i = d + 1; i < extents.size(); ++i)
+        inner *= extents[i];
+
+    const std::size_t src_length = extents[d];
+    const std::size_t dst_length = taps.size();
+
+    dst.assign(outer * dst_length * inner, identity);
+
+    for(std::size_t o_outer = 0; o_outer < outer; ++o_outer)
+    {
+        for(std::size_t o = 0; o < dst_length; ++o)
+        {
+            T* acc = &dst[(o_outer * dst_length + o) * inner];
+
+            for(index_t i : taps[o])
+            {
+                const T* v = &src[(o_outer * src_length + i) * inner];
+                for(std::size_t j = 0; j < inner; ++j)
+                    combine(acc[j], v[j]);
+            }
+        }
+    }
+
+    extents[d] = dst_length;
+}
+
+// Pooling of [N, C, spatial...] src into dst, one spatial dimension at a time. A window reduction
+// that is the product of per-dimension windows (forward pooling and its transpose) is separable:
+// reducing the last dimension first, every partial result along it is shared by all the windows
+// that overlap there, so an output costs the sum rather than the product of the window lengths.
+// For ordered reductions that keep the first best element (max with argmax) the result is the
+// one of the windows scanned in [z, y, x] order.
+//
+// load(offset) reads an element of src as T, combine(acc, v) folds v into acc, and
+// store(offset, acc) writes an element of dst. dst is split into tiles of kPoolTileLength
+// positions per spatial dimension and kPoolChannelBlock channels, which run in parallel; a task
+// only reads the box of src its tile reduces, so its scratch stays within the size of a tile
+// whatever the size of the image, and only writes its own tile of dst.
+template <typename T, typename Load, typename Combine, typename Store>
+void run_separable_pooling(const HostTensorDescriptor& src_desc,
+                           const HostTensorDescriptor& dst_desc,
+                           const std::vector<PoolTaps>& taps,
+                           const T& identity,
+                           Load load,
+                           Combine combine,
+                           Store store)
+{
+    const auto& src_lengths       = src_desc.GetLengths();
+    const std::size_t num_spatial = src_lengths.size() - 2;
+
+    if(taps.size() != num_spatial || dst_desc.GetNumOfDimension() != src_lengths.size())
+        throw std::runtime_error("wrong! inconsistent dimension");
+
+    std::size_t num_tiles = 1;
+    std::vector<std::size_t> num_dim_tiles(num_spatial);
+    for(std::size_t d = 0; d < num_spatial; ++d)
+    {
+        if(taps[d].size() != dst_desc.GetLengths()[d + 2])
+            throw std::runtime_error("wrong! inconsistent spatial length");
+
+        num_dim_tiles[d] = (taps[d].size() + kPoolTileLength - 1) / kPoolTileLength;
+        num_tiles *= num_dim_tiles[d];
+    }
+
+    const std::size_t C           = src_lengths[1];
+    const std::size_t num_c_block = (C + kPoolChannelBlock - 1) / kPoolChannelBlock;
+
+    auto f_tile = [&](auto n, auto i_c_block, auto i_tile) {
+        const std::size_t c0    = i_c_block * kPoolChannelBlock;
+        const std::size_t num_c = std::min(kPoolChannelBlock, C - c0);
+
+        // per spatial dimension, the positions of the tile in dst, the range of src they read
+        // and their taps relative to the start of that range
+        std::vector<std::size_t> dst_begin(num_spatial), dst_extents(num_spatial);
+        std::vector<std::size_t> src_begin(num_spatial), extents(num_spatial);
+        std::vector<PoolTaps> tile_taps(num_spatial);
+
+        for(std::size_t d = num_spatial, rest = i_tile; d-- > 0;)
+        {
+            dst_begin[d]   = rest % num_dim_tiles[d] * kPoolTileLength;
+            dst_extents[d] = std::min(kPoolTileLength, taps[d].size() - dst_begin[d]);
+            rest /= num_dim_tiles[d];
+
+            const auto first = taps[d].begin() + dst_begin[d];
+            const auto last  = first + dst_extents[d];
+
+            index_t lo = 0, hi = -1;
+            for(auto it = first; it != last; ++it)
+            {
+                for(index_t i : *it)
+                {
+                    lo = hi < lo ? i : std::min(lo, i);
+                    hi = std::max(hi, i);
+                }
+            }
+            src_begin[d] = hi < lo ? 0 : lo;
+            extents[d]   = hi < lo ? 0 : hi - lo + 1;
+
+            for(auto it = first; it != last; ++it)
+            {
+                tile_taps[d].emplace_back();
+                for(index_t i : *it)
+                    tile_taps[d].back().push_back(i - lo);
+            }
+        }
+
+        std::size_t volume = num_c;
+        for(std::size_t e : extents)
+            volume *= e;
+
+        std::vector<T> cur(volume), next;
+        for_each_pool_element(src_desc, n, c0, num_c, src_begin, extents, [&](auto i, auto offset) {
+            cur[i] = load(offset);
+        });
+
+        extents.push_back(num_c);
+        for(std::size_t d = num_spatial; d-- > 0;)
+        {
+            reduce_pool_dim(cur, next, extents, d, tile_taps[d], identity, combine);
+            std::swap(cur, next);
+        }
+
+        for_each_pool_element(dst_desc,
+                              n,
+                              c0,
+                              num_c,
+                              dst_begin,
+                              dst_extents,
+                              [&](auto i, auto offset) { store(offset, cur[i]); });
+    };
+
+    make_ParallelTensorFunctor(f_tile, src_lengths[0], num_c_block, num_tiles)(
+        std::thread::hardware_concurrency());
+}
+
+} // namespace detail
+} // namespace host
+} // namespace tensor_operation
+} // namespace ck
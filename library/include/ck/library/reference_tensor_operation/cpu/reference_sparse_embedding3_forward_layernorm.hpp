@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2018-2023, Advanced Micro Devices, Inc. All rights reserved.
+// Copyright (c) 2018-2025, Advanced Micro Devices, Inc. All rights reserved.
 
 #pragma once
 
@@ -11,6 +11,7 @@
 #include "ck/tensor_operation/gpu/device/device_base.hpp"
 #include "ck/library/utility/host_tensor.hpp"
 #include "ck/library/utility/host_tensor_generator.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_embedding_bag_forward.hpp"
 
 namespace ck {
 namespace tensor_operation {
@@ -72,68 +73,40 @@ struct ReferenceSparseEmbedding3ForwardLayernorm : public device::BaseOperator
     // Invoker
     struct Invoker : public device::BaseInvoker
     {
+        // three bags of one row per sample, summed and normalized by the embedding-bag reference
         float Run(const Argument& arg)
         {
-            ck::index_t D = arg.EmbeddingDim_;
-            ck::index_t L = arg.IndexLength_;
-            ck::index_t E = arg.NumRows_;
-
-            Tensor<AccDataType> accumulator({L, D});
-
-            Tensor<AccDataType> mean({L});
-            Tensor<AccDataType> var({L});
-
-            accumulator.SetZero();
-
-            auto f_emb_per_row = [&](auto idx) {
-                IndexType idx_a = arg.index_a_(idx);
-                IndexType idx_b = arg.index_b_(idx);
-                IndexType idx_c = arg.index_c_(idx);
-
-                if(!((idx_a < E) && (idx_b < E) && (idx_c < E)))
-                {
-                    throw(std::runtime_error("wrong! out of range"));
-                }
-
-                for(auto d = 0; d < D; d++)
-                {
-                    auto v_a = ck::type_convert<AccDataType>(arg.emb_a_(idx_a, d));
-                    auto v_b = ck::type_convert<AccDataType>(arg.emb_b_(idx_b, d));
-                    auto v_c = ck::type_convert<AccDataType>(arg.emb_c_(idx_c, d));
-
-                    accumulator(idx, d) += v_a + v_b + v_c;
-                }
-            };
-            make_ParallelTensorFunctor(f_emb_per_row, L)(std::thread::hardware_concurrency());
-
-            // layernorm
-            for(auto idx = 0; idx < L; ++idx)
+            using ReferenceEmbeddingBag = ReferenceEmbeddingBagForward<EmbType,
+                                                                       IndexType,
+                                                                       AccDataType,
+                                                                       GammaDataType,
+                                                                       BetaDataType,
+                                                                       AccDataType,
+                                                                       OutType>;
+
+            if(arg.emb_a_.mDesc.GetLengths()[0] != static_cast<std::size_t>(arg.NumRows_) ||
+               arg.emb_b_.mDesc.GetLengths()[0] != static_cast<std::size_t>(arg.NumRows_) ||
+               arg.emb_c_.mDesc.GetLengths()[0] != static_cast<std::size_t>(arg.NumRows_))
             {
-                mean(idx) = 0;
-                var(idx)  = 0;
-
-                for(auto d = 0; d < D; ++d)
-                {
-                    auto x_val = accumulator(idx, d);
-                    mean(idx) += x_val;
-                    var(idx) += x_val * x_val;
-                }
-
-                mean(idx) = mean(idx) / D;
-                var(idx)  = (var(idx) / D) - (mean(idx) * mean(idx));
+                throw(std::runtime_error("wrong! inconsistent number of rows"));
             }
 
-            for(auto idx = 0; idx < L; ++idx)
-            {
-                for(auto d = 0; d < D; ++d)
-                {
-                    auto x_val          = accumulator(idx, d);
-                    auto y_val          = (x_val - mean(idx)) / sqrt(var(idx) + arg.epsilon_);
-                    y_val               = (y_val * arg.gamma_(d)) + arg.beta_(d);
-                    arg.output_(idx, d) = ck::type_convert<OutType>(y_val);
-                }
-            }
-            return 0;
+            Tensor<IndexType> offsets(
+                HostTensorDescriptor({static_cast<std::size_t>(arg.IndexLength_ + 1)}));
+            for(ck::index_t idx = 0; idx <= arg.IndexLength_; ++idx)
+                offsets(idx) = idx;
+
+            auto ref = ReferenceEmbeddingBag{};
+            return ref.MakeInvoker().Run(
+                ref.MakeArgument(arg.output_,
+                                 {&arg.emb_a_, &arg.emb_b_, &arg.emb_c_},
+                                 {&arg.index_a_, &arg.index_b_, &arg.index_c_},
+                                 {&offsets, &offsets, &offsets},
+                                 {},
+                                 EmbeddingBagPoolMode::Sum,
+                                 &arg.gamma_,
+                                 &arg.beta_,
+                                 arg.epsilon_));
         }
 
         float Run(const device::BaseArgument* p_arg,
@@ -0,0 +1,530 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <istream>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "ck/host_utility/device_prop.hpp"
+#include "ck/stream_config.hpp"
+#include "ck/tensor_operation/gpu/device/device_base.hpp"
+
+namespace ck {
+namespace tensor_operation {
+namespace device {
+namespace instance {
+
+// Maps problem lengths to the buckets that share one instance selection. Lengths up to
+// exact_limit are kept, above it each power-of-two interval (2^e, 2^(e+1)] is split into
+// 2^sub_octave_bits buckets and a length maps to the upper bound of its bucket, so lengths
+// sharing a bucket differ by less than 2^-sub_octave_bits relative.
+struct ShapeBucketing
+{
+    std::int64_t exact_limit = 16;
+    int sub_octave_bits      = 2;
+    // alignments above this many elements do not change the vector widths an instance can use
+    std::int64_t max_alignment = 16;
+
+    std::int64_t Bucket(std::int64_t length) const
+    {
+        if(length <= exact_limit)
+            return length;
+
+        std::int64_t base = 1;
+        while(base * 2 < length)
+            base *= 2;
+
+        const std::int64_t step = std::max<std::int64_t>(base >> sub_octave_bits, 1);
+        return (length + step - 1) / step * step;
+    }
+
+    std::vector<std::int64_t> Bucket(const std::vector<std::int64_t>& lengths) const
+    {
+        std::vector<std::int64_t> buckets;
+        buckets.reserve(lengths.size());
+        for(const auto length : lengths)
+            buckets.push_back(Bucket(length));
+        return buckets;
+    }
+
+    // the largest power of two, up to max_alignment, dividing every value; the values are the
+    // contiguous lengths and the strides an instance vectorizes its accesses along
+    std::int64_t Alignment(const std::vector<std::int64_t>& values) const
+    {
+        std::int64_t alignment = max_alignment;
+        for(const auto value : values)
+        {
+            while(alignment > 1 && value % alignment != 0)
+                alignment /= 2;
+        }
+        return alignment;
+    }
+};
+
+struct SelectionKey
+{
+    std::string op;   // the instance list of the selector, see InstanceSelector
+    std::string arch; // gfx name of the device
+    std::vector<std::int64_t> buckets;
+    std::int64_t alignment;
+
+    bool operator<(const SelectionKey& rhs) const
+    {
+        return std::tie(op, arch, buckets, alignment) <
+               std::tie(rhs.op, rhs.arch, rhs.buckets, rhs.alignment);
+    }
+
+    bool operator==(const SelectionKey& rhs) const
+    {
+        return std::tie(op, arch, buckets, alignment) ==
+               std::tie(rhs.op, rhs.arch, rhs.buckets, rhs.alignment);
+    }
+};
+
+struct SelectionEntry
+{
+    std::string instance; // GetTypeString() of the selected instance, see InstanceSelector
+    float ave_time;       // ms, 0 if selected without timing
+};
+
+// Thread-safe, bounded map from selection keys to the selected instance, shared by every
+// InstanceSelector (and thread) of a process. Entries come from lazy selection on a miss or
+// from an offline database (Load); the least recently used entry is evicted past max_entries.
+// Threads missing the same key wait for the one selecting it instead of tuning it again.
+class InstanceSelectionCache
+{
+    public:
+    explicit InstanceSelectionCache(std::size_t max_entries = 4096) : max_entries_(max_entries) {}
+
+    std::optional<SelectionEntry> Find(const SelectionKey& key)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return FindLocked(key);
+    }
+
+    // the entry of key, computed by select (outside the lock) on a miss
+    template <typename Select>
+    SelectionEntry GetOrSelect(const SelectionKey& key, Select&& select)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+
+        while(true)
+        {
+            if(auto entry = FindLocked(key))
+                return *entry;
+            if(pending_.count(key) == 0)
+                break;
+            // another thread is selecting this key
+            pending_done_.wait(lock);
+        }
+
+        pending_.insert(key);
+        ++num_misses_;
+        lock.unlock();
+
+        SelectionEntry entry;
+        try
+        {
+            entry = select();
+        }
+        catch(...)
+        {
+            lock.lock();
+            pending_.erase(key);
+            pending_done_.notify_all();
+            throw;
+        }
+
+        lock.lock();
+        pending_.erase(key);
+        InsertLocked(key, entry);
+        pending_done_.notify_all();
+        return entry;
+    }
+
+    void Insert(const SelectionKey& key, const SelectionEntry& entry)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        InsertLocked(key, entry);
+    }
+
+    // drops the entries pred returns true for, returns how many
+    template <typename Pred>
+    std::size_t InvalidateIf(Pred&& pred)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        std::size_t count = 0;
+        for(auto it = lru_.begin(); it != lru_.end();)
+        {
+            if(pred(it->first, it->second))
+            {
+                index_.erase(it->first);
+                it = lru_.erase(it);
+                ++count;
+            }
+            else
+            {
+                ++it;
+            }
+        }
+        return count;
+    }
+
+    std::size_t Invalidate(const SelectionKey& key)
+    {
+        return InvalidateIf(
+            [&](const SelectionKey& k, const SelectionEntry&) { return k == key; });
+    }
+
+    std::size_t InvalidateOp(const std::string& op)
+    {
+        return InvalidateIf(
+            [&](const SelectionKey& k, const SelectionEntry&) { return k.op == op; });
+    }
+
+    std::size_t InvalidateArch(const std::string& arch)
+    {
+        return InvalidateIf(
+            [&](const SelectionKey& k, const SelectionEntry&) { return k.arch == arch; });
+    }
+
+    void Clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        lru_.clear();
+        index_.clear();
+        num_hits_   = 0;
+        num_misses_ = 0;
+    }
+
+    // one entry per line: op, arch, comma-separated buckets, alignment, time and instance,
+    // separated by tabs
+    void Save(std::ostream& os) const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        // least recently used first, so that loading the file keeps the order
+        for(auto it = lru_.rbegin(); it != lru_.rend(); ++it)
+        {
+            const auto& [key, entry] = *it;
+            os << key.op << '\t' << key.arch << '\t';
+            for(std::size_t i = 0; i < key.buckets.size(); ++i)
+                os << (i == 0 ? "" : ",") << key.buckets[i];
+            os << '\t' << key.alignment << '\t' << entry.ave_time << '\t' << entry.instance
+               << '\n';
+        }
+    }
+
+    // adds the entries of a database written by Save, returns how many; malformed lines are
+    // skipped
+    std::size_t Load(std::istream& is)
+    {
+        std::size_t count = 0;
+        std::string line;
+        while(std::getline(is, line))
+        {
+            std::vector<std::string> fields;
+            std::istringstream ls(line);
+            for(std::string field; std::getline(ls, field, '\t');)
+                fields.push_back(field);
+            if(fields.size() != 6)
+                continue;
+
+            SelectionKey key{fields[0], fields[1], {}, 0};
+            SelectionEntry entry{fields[5], 0};
+            try
+            {
+                std::istringstream bs(fields[2]);
+                for(std::string bucket; std::getline(bs, bucket, ',');)
+                    key.buckets.push_back(std::stoll(bucket));
+                key.alignment  = std::stoll(fields[3]);
+                entry.ave_time = std::stof(fields[4]);
+            }
+            catch(const std::exception&)
+            {
+                continue;
+            }
+
+            Insert(key, entry);
+            ++count;
+        }
+        return count;
+    }
+
+    std::size_t GetNumEntries() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return lru_.size();
+    }
+
+    std::size_t GetNumHits() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return num_hits_;
+    }
+
+    std::size_t GetNumMisses() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return num_misses_;
+    }
+
+    private:
+    using Lru = std::list<std::pair<SelectionKey, SelectionEntry>>;
+
+    std::optional<SelectionEntry> FindLocked(const SelectionKey& key)
+    {
+        const auto it = index_.find(key);
+        if(it == index_.end())
+            return std::nullopt;
+
+        lru_.splice(lru_.begin(), lru_, it->second);
+        ++num_hits_;
+        return it->second->second;
+    }
+
+    void InsertLocked(const SelectionKey& key, const SelectionEntry& entry)
+    {
+        const auto it = index_.find(key);
+        if(it != index_.end())
+        {
+            it->second->second = entry;
+            lru_.splice(lru_.begin(), lru_, it->second);
+            return;
+        }
+
+        lru_.emplace_front(key, entry);
+        index_.emplace(key, lru_.begin());
+
+        while(lru_.size() > max_entries_)
+        {
+            index_.erase(lru_.back().first);
+            lru_.pop_back();
+        }
+    }
+
+    std::size_t max_entries_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable pending_done_;
+    Lru lru_;
+    std::map<SelectionKey, Lru::iterator> index_;
+    std::set<SelectionKey> pending_; // keys being selected
+
+    std::size_t num_hits_   = 0;
+    std::size_t num_misses_ = 0;
+};
+
+// the process wide cache InstanceSelector uses by default
+inline InstanceSelectionCache& GetInstanceSelectionCache()
+{
+    static InstanceSelectionCache cache;
+    return cache;
+}
+
+enum struct SelectionPolicy
+{
+    Autotune,       // time every supported instance, take the fastest
+    FirstSupported, // take the first supported instance, no kernel is launched
+};
+
+// Picks an instance of DeviceOp for a problem from the instances of
+// DeviceOperationInstanceFactory (or any list): the first problem of a shape bucket runs the
+// selection, later ones reuse it.
+// A cached instance not supporting the exact problem (its bucket holds lengths it does not
+// handle), or missing from the instance list (a database of another build), is selected anew.
+//
+// The keys do not depend on the compiler: the op of a key defaults to a hash of the type strings
+// of the instances (pass op to share entries between instance lists), and instances sharing a
+// type string (it omits the parameters they differ in) are told apart by a "#<n>" suffix on the
+// n-th repeat.
+template <typename DeviceOp>
+class InstanceSelector
+{
+    public:
+    using DeviceOpPtr  = std::unique_ptr<DeviceOp>;
+    using ArgumentPtr  = std::unique_ptr<BaseArgument>;
+    using MakeArgument = std::function<ArgumentPtr(DeviceOp&)>;
+    using TimeInstance = std::function<float(DeviceOp&, BaseArgument*)>;
+
+    struct Selection
+    {
+        DeviceOp* op = nullptr; // nullptr if no instance supports the problem
+        ArgumentPtr argument;   // the argument of op for the problem
+        bool cached = false;    // whether the selection came from the cache
+    };
+
+    InstanceSelector(std::vector<DeviceOpPtr> instances,
+                     SelectionPolicy policy          = SelectionPolicy::Autotune,
+                     InstanceSelectionCache& cache   = GetInstanceSelectionCache(),
+                     ShapeBucketing bucketing        = ShapeBucketing{},
+                     std::optional<std::string> arch = std::nullopt,
+                     std::optional<std::string> op   = std::nullopt)
+        : instances_(std::move(instances)),
+          policy_(policy),
+          cache_(cache),
+          bucketing_(bucketing),
+          arch_(arch ? *arch : get_device_name()),
+          time_instance_(DefaultTimeInstance)
+    {
+        std::map<std::string, std::size_t> repeats;
+        for(std::size_t i = 0; i < instances_.size(); ++i)
+        {
+            auto name         = instances_[i]->GetTypeString();
+            const auto repeat = repeats[name]++;
+            if(repeat > 0)
+                name += "#" + std::to_string(repeat);
+
+            if(!index_.emplace(name, i).second)
+                throw std::runtime_error("wrong! instances share the name " + name);
+            names_.push_back(std::move(name));
+        }
+
+        op_ = op ? *op : MakeOpKey(names_);
+    }
+
+    // replaces the timing of an instance on a problem, e.g. to run more iterations
+    void SetTimeInstance(TimeInstance time_instance) { time_instance_ = std::move(time_instance); }
+
+    SelectionKey MakeKey(const std::vector<std::int64_t>& lengths,
+                         const std::vector<std::int64_t>& alignment_values) const
+    {
+        return SelectionKey{
+            op_, arch_, bucketing_.Bucket(lengths), bucketing_.Alignment(alignment_values)};
+    }
+
+    // lengths are the problem lengths bucketed (e.g. M, N, K), alignment_values the lengths and
+    // strides that decide the vector widths; make_argument builds the argument of an instance,
+    // with its workspace set if it needs one
+    Selection Select(const std::vector<std::int64_t>& lengths,
+                     const std::vector<std::int64_t>& alignment_values,
+                     const MakeArgument& make_argument)
+    {
+        const auto key = MakeKey(lengths, alignment_values);
+
+        bool selected_here = false;
+        const auto entry   = cache_.GetOrSelect(key, [&] {
+            selected_here = true;
+            return Run(make_argument);
+        });
+
+        if(auto selection = Bind(entry, make_argument))
+        {
+            selection->cached = !selected_here;
+            return std::move(*selection);
+        }
+
+        if(!entry.instance.empty() && index_.count(entry.instance) == 0)
+        {
+            // selected by another build of the library
+            cache_.Invalidate(key);
+            return Select(lengths, alignment_values, make_argument);
+        }
+
+        // the bucket's instance does not support this problem: select for it, uncached
+        ++num_fallbacks_;
+        return Bind(Run(make_argument), make_argument).value_or(Selection{});
+    }
+
+    const std::vector<DeviceOpPtr>& GetInstances() const { return instances_; }
+
+    // the names the cache entries refer to the instances by, in the order of GetInstances()
+    const std::vector<std::string>& GetInstanceNames() const { return names_; }
+
+    const std::string& GetOpKey() const { return op_; }
+
+    std::size_t GetNumFallbacks() const { return num_fallbacks_; }
+
+    private:
+    static float DefaultTimeInstance(DeviceOp& op, BaseArgument* argument)
+    {
+        return op.MakeInvokerPointer()->Run(argument, StreamConfig{nullptr, true, 0, 5, 20});
+    }
+
+    // FNV-1a of the instance names
+    static std::string MakeOpKey(const std::vector<std::string>& names)
+    {
+        std::uint64_t hash = 14695981039346656037ull;
+        for(const auto& name : names)
+        {
+            for(const char c : name + '\n')
+            {
+                hash ^= static_cast<unsigned char>(c);
+                hash *= 1099511628211ull;
+            }
+        }
+
+        std::ostringstream os;
+        os << "instances:" << names.size() << ':' << std::hex << hash;
+        return os.str();
+    }
+
+    SelectionEntry Run(const MakeArgument& make_argument)
+    {
+        SelectionEntry best{"", 0};
+        for(std::size_t i = 0; i < instances_.size(); ++i)
+        {
+            auto& instance = *instances_[i];
+            auto argument  = make_argument(instance);
+            if(!instance.IsSupportedArgument(argument.get()))
+                continue;
+
+            if(policy_ == SelectionPolicy::FirstSupported)
+                return SelectionEntry{names_[i], 0};
+
+            const float ave_time = time_instance_(instance, argument.get());
+            if(best.instance.empty() || ave_time < best.ave_time)
+                best = SelectionEntry{names_[i], ave_time};
+        }
+        return best;
+    }
+
+    std::optional<Selection> Bind(const SelectionEntry& entry, const MakeArgument& make_argument)
+    {
+        const auto it = index_.find(entry.instance);
+        if(it == index_.end())
+            return std::nullopt;
+
+        DeviceOp& op  = *instances_[it->second];
+        auto argument = make_argument(op);
+        if(!op.IsSupportedArgument(argument.get()))
+            return std::nullopt;
+
+        return Selection{&op, std::move(argument), false};
+    }
+
+    std::vector<DeviceOpPtr> instances_;
+    SelectionPolicy policy_;
+    InstanceSelectionCache& cache_;
+    ShapeBucketing bucketing_;
+    std::string op_;
+    std::string arch_;
+    TimeInstance time_instance_;
+    std::vector<std::string> names_;
+    std::map<std::string, std::size_t> index_;
+    std::atomic<std::size_t> num_fallbacks_{0};
+};
+
+} // namespace instance
+} // namespace device
+} // namespace tensor_operation
+} // namespace ck
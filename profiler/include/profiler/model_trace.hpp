@@ -0,0 +1,840 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <istream>
+#include <map>
+#include <optional>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "profiler/data_type_enum.hpp"
+#include "profiler/roofline_model.hpp"
+
+namespace ck {
+namespace profiler {
+
+// Replay of a model's op trace: the ops of a trace are parsed, deduplicated by shape, profiled
+// with the ckProfiler operation covering them (or looked up in a timing database, or estimated
+// at their roofline) and the times aggregated per layer and per op family.
+//
+// A trace has one op per line, '#' starting a comment:
+//
+//   <layer> <family> dtype=<type> [layout=<layout>] <param>=<value>... [count=<runs>]
+//
+// a value being an integer or a list of them separated by 'x' (e.g. input=56x56), and count the
+// number of times the op runs per model step (default 1). The families and their parameters:
+//
+//   gemm          M N K, layout rr, rc, cr or cc (A and B row or column major, C row major)
+//   batched_gemm  B M N K, layout as gemm
+//   conv          forward grouped convolution: [G] N K C filter input [stride] [dilation]
+//                 [left_pad] [right_pad], layout gnhwc, nhwgc or ngchw (or their 1D/3D names)
+//   layernorm     length (2 or 4 dimensions, the last normalized)
+//   softmax       length (3 or 4 dimensions), reduce
+//   attention     batch heads seqlen_q seqlen_k hdim_q [hdim_v]
+//
+// and dtype one of fp32, fp16, bf16, int8 and fp8.
+
+enum struct TraceOpFamily
+{
+    Gemm,
+    BatchedGemm,
+    Conv,
+    Layernorm,
+    Softmax,
+    Attention,
+};
+
+inline const char* to_string(TraceOpFamily family)
+{
+    switch(family)
+    {
+    case TraceOpFamily::Gemm: return "gemm";
+    case TraceOpFamily::BatchedGemm: return "batched_gemm";
+    case TraceOpFamily::Conv: return "conv";
+    case TraceOpFamily::Layernorm: return "layernorm";
+    case TraceOpFamily::Softmax: return "softmax";
+    case TraceOpFamily::Attention: return "attention";
+    }
+    return "";
+}
+
+inline std::optional<TraceOpFamily> parse_trace_op_family(const std::string& name)
+{
+    for(auto family : {TraceOpFamily::Gemm,
+                       TraceOpFamily::BatchedGemm,
+                       TraceOpFamily::Conv,
+                       TraceOpFamily::Layernorm,
+                       TraceOpFamily::Softmax,
+                       TraceOpFamily::Attention})
+    {
+        if(name == to_string(family))
+            return family;
+    }
+    return std::nullopt;
+}
+
+// the element size and the roofline compute type of a trace data type
+inline std::size_t get_trace_type_size(const std::string& data_type)
+{
+    if(data_type == "fp32")
+        return 4;
+    if(data_type == "fp16" || data_type == "bf16")
+        return 2;
+    if(data_type == "int8" || data_type == "fp8")
+        return 1;
+    throw std::runtime_error("wrong! unknown data type " + data_type);
+}
+
+inline DataTypeEnum get_trace_compute_type(const std::string& data_type)
+{
+    if(data_type == "fp16")
+        return DataTypeEnum::Half;
+    if(data_type == "bf16")
+        return DataTypeEnum::BFloat16;
+    if(data_type == "int8")
+        return DataTypeEnum::Int8;
+    if(data_type == "fp8")
+        return DataTypeEnum::Float8;
+    return DataTypeEnum::Float;
+}
+
+struct TraceOp
+{
+    using Value = std::vector<std::int64_t>;
+
+    std::string layer;
+    TraceOpFamily family;
+    std::string data_type;
+    std::string layout;
+    std::map<std::string, Value> params;
+    std::int64_t count = 1; // runs per model step
+
+    bool Has(const std::string& name) const { return params.count(name) != 0; }
+
+    const Value& Get(const std::string& name) const
+    {
+        const auto found = params.find(name);
+        if(found == params.end())
+            throw std::runtime_error("wrong! " + layer + " has no " + name);
+        return found->second;
+    }
+
+    std::int64_t GetScalar(const std::string& name) const
+    {
+        const auto& value = Get(name);
+        if(value.size() != 1)
+            throw std::runtime_error("wrong! " + layer + ": " + name + " is not a scalar");
+        return value[0];
+    }
+
+    // the shape the op is profiled for: everything but the layer name and the count
+    std::string ShapeKey() const
+    {
+        std::ostringstream os;
+        os << to_string(family) << ' ' << data_type;
+        if(!layout.empty())
+            os << ' ' << layout;
+        for(const auto& [name, value] : params)
+        {
+            os << ' ' << name << '=';
+            for(std::size_t i = 0; i < value.size(); ++i)
+                os << (i == 0 ? "" : "x") << value[i];
+        }
+        return os.str();
+    }
+};
+
+namespace detail {
+
+inline TraceOp::Value parse_trace_value(const std::string& text)
+{
+    TraceOp::Value value;
+    std::size_t begin = 0;
+    while(true)
+    {
+        const auto end           = text.find('x', begin);
+        const std::string number = text.substr(begin, end - begin);
+        if(number.empty() || !std::all_of(number.begin(), number.end(), [](char c) {
+               return std::isdigit(static_cast<unsigned char>(c));
+           }))
+            throw std::runtime_error("not an integer list: " + text);
+        value.push_back(std::stoll(number));
+
+        if(end == std::string::npos)
+            return value;
+        begin = end + 1;
+    }
+}
+
+// the spatial rank of a convolution, checking its parameters; the optional ones get their
+// defaults
+inline void complete_trace_conv(TraceOp& op)
+{
+    const std::size_t rank = op.Get("filter").size();
+    if(rank < 1 || rank > 3 || op.Get("input").size() != rank)
+        throw std::runtime_error("filter and input must have 1 to 3 matching dimensions");
+
+    op.params.emplace("G", TraceOp::Value{1});
+    op.params.emplace("stride", TraceOp::Value(rank, 1));
+    op.params.emplace("dilation", TraceOp::Value(rank, 1));
+    op.params.emplace("left_pad", TraceOp::Value(rank, 0));
+    op.params.emplace("right_pad", TraceOp::Value(rank, 0));
+
+    for(const char* name : {"stride", "dilation", "left_pad", "right_pad"})
+    {
+        if(op.Get(name).size() != rank)
+            throw std::runtime_error(std::string(name) + " must have as many dimensions as filter");
+    }
+}
+
+inline void check_trace_op(TraceOp& op)
+{
+    get_trace_type_size(op.data_type);
+
+    auto require = [&](std::initializer_list<const char*> names) {
+        for(const char* name : names)
+        {
+            if(op.GetScalar(name) <= 0)
+                throw std::runtime_error(std::string(name) + " must be positive");
+        }
+    };
+    auto require_layout = [&](std::initializer_list<const char*> layouts) {
+        if(std::find(layouts.begin(), layouts.end(), op.layout) == layouts.end())
+            throw std::runtime_error("unknown " + std::string(to_string(op.family)) +
+                                     " layout \"" + op.layout + "\"");
+    };
+
+    switch(op.family)
+    {
+    case TraceOpFamily::Gemm:
+        require({"M", "N", "K"});
+        require_layout({"rr", "rc", "cr", "cc"});
+        break;
+    case TraceOpFamily::BatchedGemm:
+        require({"B", "M", "N", "K"});
+        require_layout({"rr", "rc", "cr", "cc"});
+        break;
+    case TraceOpFamily::Conv:
+        require({"N", "K", "C"});
+        require_layout({"gnwc",
+                        "gnhwc",
+                        "gndhwc",
+                        "nwgc",
+                        "nhwgc",
+                        "ndhwgc",
+                        "ngcw",
+                        "ngchw",
+                        "ngcdhw"});
+        complete_trace_conv(op);
+        require({"G"});
+        break;
+    case TraceOpFamily::Layernorm:
+        if(op.Get("length").size() != 2 && op.Get("length").size() != 4)
+            throw std::runtime_error("layernorm length must have 2 or 4 dimensions");
+        break;
+    case TraceOpFamily::Softmax:
+        if(op.Get("length").size() != 3 && op.Get("length").size() != 4)
+            throw std::runtime_error("softmax length must have 3 or 4 dimensions");
+        for(auto dim : op.Get("reduce"))
+        {
+            if(dim >= static_cast<std::int64_t>(op.Get("length").size()))
+                throw std::runtime_error("softmax reduce dimension out of range");
+        }
+        break;
+    case TraceOpFamily::Attention:
+        op.params.emplace("hdim_v", op.Get("hdim_q"));
+        require({"batch", "heads", "seqlen_q", "seqlen_k", "hdim_q", "hdim_v"});
+        break;
+    }
+}
+
+} // namespace detail
+
+// the op of one trace line, none for a blank or comment line
+inline std::optional<TraceOp> parse_trace_op(const std::string& line)
+{
+    std::istringstream is(line.substr(0, line.find('#')));
+
+    TraceOp op;
+    std::string family;
+    if(!(is >> op.layer))
+        return std::nullopt;
+    if(!(is >> family))
+        throw std::runtime_error("missing op family");
+
+    const auto parsed_family = parse_trace_op_family(family);
+    if(!parsed_family)
+        throw std::runtime_error("unknown op family \"" + family + "\"");
+    op.family = *parsed_family;
+
+    for(std::string token; is >> token;)
+    {
+        const auto equal = token.find('=');
+        if(equal == std::string::npos || equal == 0)
+            throw std::runtime_error("expected <name>=<value>, got \"" + token + "\"");
+
+        const std::string name  = token.substr(0, equal);
+        const std::string value = token.substr(equal + 1);
+
+        if(name == "dtype")
+            op.data_type = value;
+        else if(name == "layout")
+            op.layout = value;
+        else if(name == "count")
+            op.count = detail::parse_trace_value(value).at(0);
+        else if(!op.params.emplace(name, detail::parse_trace_value(value)).second)
+            throw std::runtime_error("repeated parameter " + name);
+    }
+
+    if(op.data_type.empty())
+        throw std::runtime_error("missing dtype");
+    if(op.count < 1)
+        throw std::runtime_error("count must be positive");
+
+    detail::check_trace_op(op);
+    return op;
+}
+
+// the ops of a trace, in trace order
+inline std::vector<TraceOp> parse_trace(std::istream& is)
+{
+    std::vector<TraceOp> ops;
+    std::string line;
+    for(int line_number = 1; std::getline(is, line); ++line_number)
+    {
+        try
+        {
+            if(auto op = parse_trace_op(line))
+                ops.push_back(std::move(*op));
+        }
+        catch(const std::exception& e)
+        {
+            throw std::runtime_error("wrong! trace line " + std::to_string(line_number) + ": " +
+                                     e.what());
+        }
+    }
+    return ops;
+}
+
+// the ops of a trace sharing one shape, profiled once
+struct TraceShape
+{
+    TraceOp op;                     // the first op of the shape
+    std::vector<std::size_t> uses;  // indices of the ops of the shape in the trace
+    std::int64_t num_runs = 0;      // runs per model step, summed over the uses
+};
+
+// the shapes of a trace, in the order they first appear
+inline std::vector<TraceShape> dedupe_trace(const std::vector<TraceOp>& ops)
+{
+    std::vector<TraceShape> shapes;
+    std::map<std::string, std::size_t> index;
+
+    for(std::size_t i = 0; i < ops.size(); ++i)
+    {
+        const auto [found, inserted] = index.emplace(ops[i].ShapeKey(), shapes.size());
+        if(inserted)
+            shapes.push_back(TraceShape{ops[i], {}, 0});
+
+        auto& shape = shapes[found->second];
+        shape.uses.push_back(i);
+        shape.num_runs += ops[i].count;
+    }
+    return shapes;
+}
+
+// the flop and HBM bytes of an op, the traffic being one read of every input and one write of
+// the output
+inline RooflineProblem get_trace_roofline_problem(const TraceOp& op)
+{
+    const std::size_t size = get_trace_type_size(op.data_type);
+    auto get               = [&](const char* name) {
+        return static_cast<std::size_t>(op.GetScalar(name));
+    };
+    auto product = [](const TraceOp::Value& value) {
+        std::size_t p = 1;
+        for(auto v : value)
+            p *= static_cast<std::size_t>(v);
+        return p;
+    };
+
+    switch(op.family)
+    {
+    case TraceOpFamily::Gemm:
+    case TraceOpFamily::BatchedGemm: {
+        const std::size_t B = op.family == TraceOpFamily::Gemm ? 1 : get("B");
+        const std::size_t M = get("M"), N = get("N"), K = get("K");
+        return RooflineProblem{2 * B * M * N * K, size * B * (M * K + K * N + M * N)};
+    }
+    case TraceOpFamily::Conv: {
+        const auto& filter = op.Get("filter");
+        const auto& input  = op.Get("input");
+
+        TraceOp::Value output(filter.size());
+        for(std::size_t d = 0; d < filter.size(); ++d)
+        {
+            const auto extent = op.Get("dilation")[d] * (filter[d] - 1) + 1;
+            output[d] = (input[d] + op.Get("left_pad")[d] + op.Get("right_pad")[d] - extent) /
+                            op.Get("stride")[d] +
+                        1;
+        }
+
+        const std::size_t G = get("G"), N = get("N"), K = get("K"), C = get("C");
+        return RooflineProblem{
+            2 * G * N * K * C * product(filter) * product(output),
+            size * G *
+                (N * C * product(input) + K * C * product(filter) + N * K * product(output))};
+    }
+    case TraceOpFamily::Layernorm:
+    case TraceOpFamily::Softmax: return RooflineProblem{0, 2 * size * product(op.Get("length"))};
+    case TraceOpFamily::Attention: {
+        const std::size_t BH = get("batch") * get("heads");
+        const std::size_t Sq = get("seqlen_q"), Sk = get("seqlen_k");
+        const std::size_t Dq = get("hdim_q"), Dv = get("hdim_v");
+        return RooflineProblem{2 * BH * Sq * Sk * (Dq + Dv),
+                               size * BH * (Sq * Dq + Sk * Dq + Sk * Dv + Sq * Dv)};
+    }
+    }
+    return RooflineProblem{0, 0};
+}
+
+// the ckProfiler command line (without the program name) timing an op, without verification;
+// none if no profiler operation covers the op
+inline std::optional<std::vector<std::string>> make_trace_profiler_command(const TraceOp& op)
+{
+    auto index_of = [](const std::string& value,
+                       std::initializer_list<std::initializer_list<const char*>> names)
+        -> std::optional<std::string> {
+        int i = 0;
+        for(const auto& aliases : names)
+        {
+            for(const char* name : aliases)
+            {
+                if(value == name)
+                    return std::to_string(i);
+            }
+            ++i;
+        }
+        return std::nullopt;
+    };
+    auto append = [](std::vector<std::string>& command, const TraceOp::Value& value) {
+        for(auto v : value)
+            command.push_back(std::to_string(v));
+    };
+    auto scalar = [&](const char* name) { return std::to_string(op.GetScalar(name)); };
+
+    // verification, initialization, log, time kernel
+    const std::vector<std::string> control{"0", "1", "0", "1"};
+    const auto gemm_layout = index_of(op.layout, {{"rr"}, {"rc"}, {"cr"}, {"cc"}});
+
+    std::vector<std::string> command;
+    switch(op.family)
+    {
+    case TraceOpFamily::Gemm: {
+        const auto data_type =
+            index_of(op.data_type, {{"fp32"}, {"fp16"}, {"bf16"}, {"int8"}, {"fp8"}});
+        if(!data_type || !gemm_layout)
+            return std::nullopt;
+        command = {"gemm", *data_type, *gemm_layout};
+        command.insert(command.end(), control.begin(), control.end());
+        command.insert(command.end(), {scalar("M"), scalar("N"), scalar("K"), "-1", "-1", "-1"});
+        return command;
+    }
+    case TraceOpFamily::BatchedGemm: {
+        const auto data_type = index_of(op.data_type, {{"fp32"}, {"fp16"}, {"bf16"}, {"int8"}});
+        if(!data_type || !gemm_layout)
+            return std::nullopt;
+        command = {"batched_gemm", *data_type, *gemm_layout};
+        command.insert(command.end(), control.begin(), control.end());
+        command.insert(command.end(),
+                       {scalar("M"), scalar("N"), scalar("K"), "-1", "-1", "-1", "-1", "-1", "-1"});
+        command.push_back(scalar("B"));
+        return command;
+    }
+    case TraceOpFamily::Conv: {
+        const auto data_type =
+            index_of(op.data_type, {{"fp32"}, {"fp16"}, {"bf16"}, {"int8"}, {"fp8"}});
+        const auto layout = index_of(op.layout,
+                                     {{"gnwc", "gnhwc", "gndhwc"},
+                                      {"nwgc", "nhwgc", "ndhwgc"},
+                                      {"ngcw", "ngchw", "ngcdhw"}});
+        if(!data_type || !layout)
+            return std::nullopt;
+        // 32-bit indexing
+        command = {"grouped_conv_fwd", *data_type, *layout, "0"};
+        command.insert(command.end(), control.begin(), control.end());
+        command.push_back(std::to_string(op.Get("filter").size()));
+        command.insert(command.end(), {scalar("G"), scalar("N"), scalar("K"), scalar("C")});
+        for(const char* name :
+            {"filter", "input", "stride", "dilation", "left_pad", "right_pad"})
+            append(command, op.Get(name));
+        return command;
+    }
+    case TraceOpFamily::Layernorm: {
+        // DataTypeEnum values
+        const auto data_type = index_of(op.data_type, {{"fp16"}, {"fp32"}});
+        if(!data_type)
+            return std::nullopt;
+        command = {"layernorm_fwd", *data_type};
+        command.insert(command.end(), control.begin(), control.end());
+        command.push_back("--length");
+        append(command, op.Get("length"));
+        return command;
+    }
+    case TraceOpFamily::Softmax: {
+        const auto data_type = index_of(op.data_type, {{"fp32"}, {"fp16"}, {"bf16"}, {"int8"}});
+        if(!data_type)
+            return std::nullopt;
+        command = {"softmax", *data_type};
+        command.insert(command.end(), control.begin(), control.end());
+        command.push_back("--length");
+        append(command, op.Get("length"));
+        command.push_back("--reduce");
+        append(command, op.Get("reduce"));
+        return command;
+    }
+    case TraceOpFamily::Attention: return std::nullopt;
+    }
+    return std::nullopt;
+}
+
+// whether a best time (ms) a profiler operation printed is one of an instance that ran. The
+// operations start from the float max and print it if no instance supports the problem, rounded
+// to the 6 significant digits of std::cout
+inline bool is_valid_trace_best_time(double ms)
+{
+    constexpr double unset_best_time = 3.40282e38;
+    return std::isfinite(ms) && ms > 0 && ms < unset_best_time;
+}
+
+// the best time (ms) a profiler operation printed: the "Best Perf ..."/"best perf = ..." line of
+// most operations, or the avg_time of the "Best configuration parameters" block of the grouped
+// convolutions. The last one printed counts, and none if it is not a valid time
+inline std::optional<double> parse_trace_best_time(const std::string& log)
+{
+    std::optional<double> best_time;
+    bool in_best_block = false;
+
+    std::istringstream is(log);
+    for(std::string line; std::getline(is, line);)
+    {
+        std::string lower = line;
+        std::transform(lower.begin(), lower.end(), lower.begin(), [](unsigned char c) {
+            return static_cast<char>(std::tolower(c));
+        });
+
+        if(lower.find("best configuration") != std::string::npos)
+        {
+            in_best_block = true;
+            continue;
+        }
+
+        std::size_t number_begin = 0;
+        std::size_t number_end   = 0;
+        if(in_best_block && lower.rfind("avg_time:", 0) == 0)
+        {
+            number_begin  = std::string("avg_time:").size();
+            number_end    = line.size();
+            in_best_block = false;
+        }
+        else if(lower.find("best perf") != std::string::npos)
+        {
+            number_end = lower.find(" ms");
+            if(number_end == std::string::npos)
+                continue;
+            number_begin = number_end;
+            while(number_begin > 0 && std::string("0123456789.e+-").find(lower[number_begin - 1]) !=
+                                          std::string::npos)
+                --number_begin;
+        }
+        else
+        {
+            continue;
+        }
+
+        best_time.reset();
+        try
+        {
+            const double ms = std::stod(line.substr(number_begin, number_end - number_begin));
+            if(is_valid_trace_best_time(ms))
+                best_time = ms;
+        }
+        catch(const std::exception&)
+        {
+        }
+    }
+    return best_time;
+}
+
+// Times of trace shapes measured on earlier replays, per arch: one "arch<TAB>shape key<TAB>ms"
+// line per shape
+class TraceTimingDatabase
+{
+    public:
+    std::optional<double> Find(const std::string& arch, const std::string& shape_key) const
+    {
+        const auto found = times_.find({arch, shape_key});
+        if(found == times_.end())
+            return std::nullopt;
+        return found->second;
+    }
+
+    void Set(const std::string& arch, const std::string& shape_key, double ave_time)
+    {
+        times_[{arch, shape_key}] = ave_time;
+    }
+
+    std::size_t Size() const { return times_.size(); }
+
+    void Save(std::ostream& os) const
+    {
+        for(const auto& [key, ave_time] : times_)
+            os << key.first << '\t' << key.second << '\t' << ave_time << '\n';
+    }
+
+    // adds the times of a database written by Save, returns how many; malformed lines are skipped
+    std::size_t Load(std::istream& is)
+    {
+        std::size_t num_loaded = 0;
+        for(std::string line; std::getline(is, line);)
+        {
+            const auto tab0 = line.find('\t');
+            const auto tab1 = line.find('\t', tab0 == std::string::npos ? tab0 : tab0 + 1);
+            if(tab0 == std::string::npos || tab1 == std::string::npos)
+                continue;
+
+            try
+            {
+                const auto value      = line.substr(tab1 + 1);
+                std::size_t pos       = 0;
+                const double ave_time = std::stod(value, &pos);
+                if(pos != value.size() || !(ave_time > 0))
+                    continue;
+                Set(line.substr(0, tab0), line.substr(tab0 + 1, tab1 - tab0 - 1), ave_time);
+                ++num_loaded;
+            }
+            catch(const std::exception&)
+            {
+            }
+        }
+        return num_loaded;
+    }
+
+    private:
+    std::map<std::pair<std::string, std::string>, double> times_;
+};
+
+enum struct TraceTimeSource
+{
+    None,     // neither profiled nor estimated
+    Measured, // profiled in this replay
+    Database, // from the timing database
+    Roofline, // time at the roofline, a lower bound
+};
+
+inline const char* to_string(TraceTimeSource source)
+{
+    switch(source)
+    {
+    case TraceTimeSource::None: return "none";
+    case TraceTimeSource::Measured: return "measured";
+    case TraceTimeSource::Database: return "database";
+    case TraceTimeSource::Roofline: return "roofline";
+    }
+    return "";
+}
+
+struct TraceShapeTime
+{
+    double ave_time = 0; // ms per run
+    TraceTimeSource source = TraceTimeSource::None;
+};
+
+// the order to profile the shapes in: the heaviest first, a shape weighing its time at the
+// roofline (its flop and bytes without peaks) times its runs per step, so that a replay stopped
+// early has measured the shapes that dominate the model
+inline std::vector<std::size_t> schedule_trace_shapes(const std::vector<TraceShape>& shapes,
+                                                      const std::optional<RooflinePeaks>& peaks)
+{
+    std::vector<double> weight(shapes.size());
+    for(std::size_t i = 0; i < shapes.size(); ++i)
+    {
+        const auto problem = get_trace_roofline_problem(shapes[i].op);
+        const double cost =
+            peaks ? roofline_time(*peaks, get_trace_compute_type(shapes[i].op.data_type), problem)
+                  : static_cast<double>(problem.flop + problem.bytes);
+        weight[i] = cost * shapes[i].num_runs;
+    }
+
+    std::vector<std::size_t> order(shapes.size());
+    for(std::size_t i = 0; i < order.size(); ++i)
+        order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&](auto lhs, auto rhs) {
+        return weight[lhs] > weight[rhs];
+    });
+    return order;
+}
+
+struct TraceLayerReport
+{
+    std::string layer;
+    std::string families;  // of its ops, in trace order, '+' separated
+    double total_time = 0; // ms per model step
+    bool estimated    = false; // some op timed at its roofline
+    bool incomplete   = false; // some op neither timed nor estimated
+    std::optional<double> efficiency; // roofline time / time, of the timed ops
+};
+
+struct TraceFamilyReport
+{
+    TraceOpFamily family;
+    double total_time = 0; // ms per model step
+    double share      = 0; // of the total time
+    std::int64_t num_runs  = 0;
+    std::size_t num_shapes = 0;
+};
+
+struct TraceReport
+{
+    std::vector<TraceLayerReport> layers;   // in trace order
+    std::vector<TraceFamilyReport> families; // the most expensive first
+    double total_time = 0;                   // ms per model step
+
+    void Print(std::ostream& os) const
+    {
+        std::size_t width = 5;
+        for(const auto& layer : layers)
+            width = std::max(width, layer.layer.size());
+
+        os << std::left << std::setw(width) << "layer" << "  " << std::setw(24) << "ops"
+           << std::right << std::setw(12) << "time (ms)" << std::setw(10) << "roofline"
+           << std::endl;
+        for(const auto& layer : layers)
+        {
+            os << std::left << std::setw(width) << layer.layer << "  " << std::setw(24)
+               << layer.families << std::right << std::fixed << std::setprecision(4)
+               << std::setw(12) << layer.total_time << std::setw(10);
+            if(layer.efficiency)
+                os << FormatPercent(*layer.efficiency);
+            else
+                os << "-";
+            os << (layer.estimated ? "  (roofline estimate)" : "")
+               << (layer.incomplete ? "  (not profiled)" : "") << std::endl;
+        }
+
+        os << "total: " << std::fixed << std::setprecision(4) << total_time << " ms" << std::endl;
+        for(const auto& family : families)
+        {
+            os << "  " << std::left << std::setw(14) << to_string(family.family) << std::right
+               << std::setw(7) << FormatPercent(family.share) << std::setw(12)
+               << std::setprecision(4) << family.total_time << " ms, " << family.num_runs
+               << " runs of " << family.num_shapes << " shapes" << std::endl;
+        }
+    }
+
+    private:
+    static std::string FormatPercent(double fraction)
+    {
+        std::ostringstream os;
+        os << std::fixed << std::setprecision(1) << fraction * 100. << '%';
+        return os.str();
+    }
+};
+
+// the per-layer and per-family times of a trace, given the time of each of its shapes; with
+// peaks, the timed layers are placed against their roofline
+inline TraceReport aggregate_trace(const std::vector<TraceOp>& ops,
+                                   const std::vector<TraceShape>& shapes,
+                                   const std::vector<TraceShapeTime>& times,
+                                   const std::optional<RooflinePeaks>& peaks = std::nullopt)
+{
+    if(times.size() != shapes.size())
+        throw std::runtime_error("wrong! one time per shape is needed");
+
+    std::vector<std::size_t> shape_of(ops.size());
+    for(std::size_t s = 0; s < shapes.size(); ++s)
+    {
+        for(auto i : shapes[s].uses)
+            shape_of.at(i) = s;
+    }
+
+    TraceReport report;
+    std::map<std::string, std::size_t> layer_index;
+    std::map<TraceOpFamily, std::size_t> family_index;
+    std::map<std::string, double> roof_time, timed_time; // of the timed ops, per layer
+
+    for(std::size_t i = 0; i < ops.size(); ++i)
+    {
+        const auto& op   = ops[i];
+        const auto& time = times[shape_of[i]];
+        const double total_time = time.ave_time * op.count;
+
+        const auto [found, inserted] = layer_index.emplace(op.layer, report.layers.size());
+        if(inserted)
+            report.layers.push_back(
+                TraceLayerReport{op.layer, to_string(op.family), 0, false, false, std::nullopt});
+        auto& layer = report.layers[found->second];
+        if(!inserted && ("+" + layer.families + "+").find(std::string("+") +
+                                                         to_string(op.family) + "+") ==
+                            std::string::npos)
+            layer.families += std::string("+") + to_string(op.family);
+
+        layer.total_time += total_time;
+        layer.estimated  = layer.estimated || time.source == TraceTimeSource::Roofline;
+        layer.incomplete = layer.incomplete || time.source == TraceTimeSource::None;
+
+        if(peaks && (time.source == TraceTimeSource::Measured ||
+                     time.source == TraceTimeSource::Database))
+        {
+            roof_time[op.layer] += roofline_time(*peaks,
+                                                 get_trace_compute_type(op.data_type),
+                                                 get_trace_roofline_problem(op)) *
+                                   op.count;
+            timed_time[op.layer] += total_time;
+        }
+
+        const auto [family_found, family_inserted] =
+            family_index.emplace(op.family, report.families.size());
+        if(family_inserted)
+            report.families.push_back(TraceFamilyReport{op.family});
+        auto& family = report.families[family_found->second];
+        family.total_time += total_time;
+        family.num_runs += op.count;
+
+        report.total_time += total_time;
+    }
+
+    for(const auto& shape : shapes)
+        report.families[family_index.at(shape.op.family)].num_shapes++;
+
+    for(auto& layer : report.layers)
+    {
+        if(timed_time[layer.layer] > 0)
+            layer.efficiency = roof_time[layer.layer] / timed_time[layer.layer];
+    }
+
+    for(auto& family : report.families)
+        family.share = report.total_time > 0 ? family.total_time / report.total_time : 0.;
+    std::stable_sort(report.families.begin(),
+                     report.families.end(),
+                     [](const auto& lhs, const auto& rhs) {
+                         return lhs.total_time > rhs.total_time;
+                     });
+
+    return report;
+}
+
+} // namespace profiler
+} // namespace ck
@@ -12,6 +12,7 @@
 #include "ck/library/utility/host_tensor.hpp"
 #include "ck/library/utility/host_tensor_generator.hpp"
 #include "ck/library/utility/literals.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_pool_window.hpp"
 #include "ck/library/reference_tensor_operation/cpu/reference_avgpool_bwd.hpp"
 
 namespace ck {
@@ -78,16 +79,14 @@ bool profile_avg_pool2d_bwd_impl(int do_verification,
     const int Ho = out_length[2];
     const int Wo = out_length[3];
 
-    auto f_host_tensor_descriptor =
-        [](std::size_t N_, std::size_t C_, std::size_t H, std::size_t W) {
-            using namespace ck::literals;
+    using ck::tensor_operation::host::make_pool_host_tensor_descriptor;
 
-            return HostTensorDescriptor({N_, C_, H, W}, {C_ * H * W, 1_uz, W * C_, C_});
-        };
-
-    Tensor<DOutDataType> out_n_c_ho_wo_host(f_host_tensor_descriptor(N, C, Ho, Wo));
-    Tensor<DInDataType> in_n_c_hi_wi_device(f_host_tensor_descriptor(N, C, Hi, Wi));
-    Tensor<DInDataType> in_n_c_hi_wi_host(f_host_tensor_descriptor(N, C, Hi, Wi));
+    Tensor<DOutDataType> out_n_c_ho_wo_host(
+        make_pool_host_tensor_descriptor<DOutLayout>(N, C, Ho, Wo));
+    Tensor<DInDataType> in_n_c_hi_wi_device(
+        make_pool_host_tensor_descriptor<DInLayout>(N, C, Hi, Wi));
+    Tensor<DInDataType> in_n_c_hi_wi_host(
+        make_pool_host_tensor_descriptor<DInLayout>(N, C, Hi, Wi));
 
     switch(init_method)
     {
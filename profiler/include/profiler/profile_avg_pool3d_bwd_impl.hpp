@@ -13,6 +13,7 @@
 #include "ck/library/utility/host_tensor.hpp"
 #include "ck/library/utility/host_tensor_generator.hpp"
 #include "ck/library/utility/literals.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_pool_window.hpp"
 #include "ck/library/reference_tensor_operation/cpu/reference_avgpool_bwd.hpp"
 
 namespace ck {
@@ -88,17 +89,14 @@ bool profile_avg_pool3d_bwd_impl(int do_verification,
     int Ho = out_length[3];
     int Wo = out_length[4];
 
-    auto f_host_tensor_descriptor =
-        [](std::size_t N_, std::size_t C_, std::size_t D, std::size_t H, std::size_t W) {
-            using namespace ck::literals;
+    using ck::tensor_operation::host::make_pool_host_tensor_descriptor;
 
-            return HostTensorDescriptor({N_, C_, D, H, W},
-                                        {D * C_ * H * W, 1_uz, C_ * H * W, W * C_, C_});
-        };
-
-    Tensor<DOutDataType> dout_n_c_do_ho_wo(f_host_tensor_descriptor(N, C, Do, Ho, Wo));
-    Tensor<DInDataType> din_n_c_di_hi_wi_device(f_host_tensor_descriptor(N, C, Di, Hi, Wi));
-    Tensor<DInDataType> din_n_c_di_hi_wi_host(f_host_tensor_descriptor(N, C, Di, Hi, Wi));
+    Tensor<DOutDataType> dout_n_c_do_ho_wo(
+        make_pool_host_tensor_descriptor<DOutLayout>(N, C, Do, Ho, Wo));
+    Tensor<DInDataType> din_n_c_di_hi_wi_device(
+        make_pool_host_tensor_descriptor<DInLayout>(N, C, Di, Hi, Wi));
+    Tensor<DInDataType> din_n_c_di_hi_wi_host(
+        make_pool_host_tensor_descriptor<DInLayout>(N, C, Di, Hi, Wi));
 
     switch(init_method)
     {
@@ -21,6 +21,8 @@
 #include "ck/library/utility/literals.hpp"
 #include "ck/library/reference_tensor_operation/cpu/reference_batched_gemm.hpp"
 
+#include "profiler/roofline.hpp"
+
 namespace ck {
 namespace profiler {
 
@@ -220,7 +222,8 @@ bool profile_batched_gemm_impl(int do_verification,
             float gb_per_sec = num_btype / 1.E6 / ave_time;
 
             std::cout << "Perf: " << ave_time << " ms, " << tflops << " TFlops, " << gb_per_sec
-                      << " GB/s, " << op_name << std::endl;
+                      << " GB/s" << roofline_annotation<ADataType>(flop, num_btype, ave_time)
+                      << ", " << op_name << std::endl;
 
             if(tflops > best_tflops)
             {
@@ -23,6 +23,8 @@
 #include "ck/library/reference_tensor_operation/cpu/reference_gemm.hpp"
 #include "ck/library/utility/fill.hpp"
 
+#include "profiler/roofline.hpp"
+
 namespace ck {
 namespace profiler {
 
@@ -180,7 +182,9 @@ int profile_gemm_impl(int do_verification,
             float gb_per_sec = num_btype / 1.E6 / avg_time;
 
             std::cout << "Perf: " << std::setw(10) << avg_time << " ms, " << tflops << " TFlops, "
-                      << gb_per_sec << " GB/s, " << op_name << std::endl;
+                      << gb_per_sec << " GB/s"
+                      << roofline_annotation<ADataType>(flop, num_btype, avg_time) << ", "
+                      << op_name << std::endl;
 
             if(tflops > best_tflops)
             {
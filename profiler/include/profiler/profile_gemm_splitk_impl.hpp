@@ -21,6 +21,8 @@
 #include "ck/library/utility/literals.hpp"
 #include "ck/library/reference_tensor_operation/cpu/reference_gemm.hpp"
 
+#include "profiler/roofline.hpp"
+
 namespace ck {
 namespace profiler {
 
@@ -216,8 +218,9 @@ bool profile_gemm_splitk_impl(int do_verification,
                 float gb_per_sec = num_btype / 1.E6 / ave_time;
 
                 std::cout << "Perf: " << std::setw(10) << ave_time << " ms, " << tflops
-                          << " TFlops, " << gb_per_sec << " GB/s, " << op_name << ", KBatch "
-                          << kbatch_curr << std::endl;
+                          << " TFlops, " << gb_per_sec << " GB/s"
+                          << roofline_annotation<ADataType>(flop, num_btype, ave_time) << ", "
+                          << op_name << ", KBatch " << kbatch_curr << std::endl;
 
 #if defined CK_ENABLE_FP8
                 // set softer tolerances for fp8
@@ -21,6 +21,8 @@
 #include "ck/library/utility/literals.hpp"
 #include "ck/library/reference_tensor_operation/cpu/reference_gemm.hpp"
 
+#include "profiler/roofline.hpp"
+
 namespace ck {
 namespace profiler {
 
@@ -153,6 +155,7 @@ bool profile_gemm_universal_impl(int do_verification,
     float best_ave_time   = 0;
     float best_tflops     = 0;
     float best_gb_per_sec = 0;
+    std::string best_roofline;
     float best_kbatch     = 0;
 
     // profile device GEMM instances
@@ -339,8 +342,9 @@ bool profile_gemm_universal_impl(int do_verification,
                 float gb_per_sec = num_btype / 1.E6 / ave_time;
 
                 std::cout << "Perf: " << std::setw(10) << ave_time << " ms, " << tflops
-                          << " TFlops, " << gb_per_sec << " GB/s, " << op_name << ", KBatch "
-                          << kbatch_curr << std::endl;
+                          << " TFlops, " << gb_per_sec << " GB/s"
+                          << roofline_annotation<ComputeDataType>(flop, num_btype, ave_time)
+                          << ", " << op_name << ", KBatch " << kbatch_curr << std::endl;
 
                 if(tflops > best_tflops && ave_time > 1e-10)
                 {
@@ -350,6 +354,8 @@ bool profile_gemm_universal_impl(int do_verification,
                     best_ave_time       = ave_time;
                     best_gb_per_sec     = gb_per_sec;
                     best_kbatch         = kbatch_curr;
+                    best_roofline =
+                        roofline_summary<ComputeDataType>(flop, num_btype, ave_time);
                 }
             }
             else
@@ -403,6 +409,8 @@ bool profile_gemm_universal_impl(int do_verification,
     if(best_op_object_name)
         std::cout << best_op_object_name.value() << std::endl;
 
+    std::cout << best_roofline;
+
     return pass;
 }
 
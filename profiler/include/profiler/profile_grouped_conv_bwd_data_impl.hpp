@@ -20,6 +20,8 @@
 #include "ck/library/reference_tensor_operation/cpu/reference_conv_bwd_data.hpp"
 #include "ck/library/tensor_operation_instance/gpu/grouped_convolution_backward_data.hpp"
 
+#include "profiler/roofline.hpp"
+
 namespace ck {
 namespace profiler {
 
@@ -145,7 +147,9 @@ bool profile_grouped_conv_bwd_data_impl(int do_verification,
             float gb_per_sec = num_btype / 1.E6 / avg_time;
 
             std::cout << "Perf: " << std::setw(10) << avg_time << " ms, " << tflops << " TFlops, "
-                      << gb_per_sec << " GB/s, " << op_name << std::endl;
+                      << gb_per_sec << " GB/s"
+                      << roofline_annotation<OutDataType>(flop, num_btype, avg_time) << ", "
+                      << op_name << std::endl;
 
             if(tflops > best_tflops)
             {
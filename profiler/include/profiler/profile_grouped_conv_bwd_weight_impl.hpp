@@ -24,6 +24,8 @@
 #include "ck/library/utility/convolution_host_tensor_descriptor_helper.hpp"
 #include "ck/library/reference_tensor_operation/cpu/reference_conv_bwd_weight.hpp"
 
+#include "profiler/roofline.hpp"
+
 namespace ck {
 namespace profiler {
 
@@ -224,8 +226,9 @@ bool profile_grouped_conv_bwd_weight_impl(int do_verification,
                 float gb_per_sec = num_btype / 1.E6 / avg_time;
 
                 std::cout << "Perf: " << std::setw(10) << avg_time << " ms, " << tflops
-                          << " TFlops, " << gb_per_sec << " GB/s, " << op_name << ", SplitK "
-                          << split_k_list[split_k_id] << std::endl;
+                          << " TFlops, " << gb_per_sec << " GB/s"
+                          << roofline_annotation<ComputeTypeA>(flop, num_btype, avg_time) << ", "
+                          << op_name << ", SplitK " << split_k_list[split_k_id] << std::endl;
 
                 if(tflops > best_tflops)
                 {
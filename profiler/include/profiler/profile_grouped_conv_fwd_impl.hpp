@@ -22,6 +22,8 @@
 #include "ck/library/utility/convolution_host_tensor_descriptor_helper.hpp"
 #include "ck/library/reference_tensor_operation/cpu/reference_conv_fwd.hpp"
 
+#include "profiler/roofline.hpp"
+
 namespace ck {
 namespace profiler {
 
@@ -143,6 +145,7 @@ bool profile_grouped_conv_fwd_impl(int do_verification,
     float best_avg_time   = 0;
     float best_tflops     = 0;
     float best_gb_per_sec = 0;
+    std::string best_roofline;
 
     // profile device op instances
     bool pass = true;
@@ -173,7 +176,9 @@ bool profile_grouped_conv_fwd_impl(int do_verification,
             float gb_per_sec = num_btype / 1.E6 / avg_time;
 
             std::cout << "Perf: " << std::setw(10) << avg_time << " ms, " << tflops << " TFlops, "
-                      << gb_per_sec << " GB/s, " << op_name << std::endl;
+                      << gb_per_sec << " GB/s"
+                      << roofline_annotation<AComputeType>(flop, num_btype, avg_time) << ", "
+                      << op_name << std::endl;
 
             if(tflops > best_tflops)
             {
@@ -181,6 +186,7 @@ bool profile_grouped_conv_fwd_impl(int do_verification,
                 best_tflops     = tflops;
                 best_avg_time   = avg_time;
                 best_gb_per_sec = gb_per_sec;
+                best_roofline   = roofline_summary<AComputeType>(flop, num_btype, avg_time);
             }
 
             if(do_verification)
@@ -255,6 +261,7 @@ bool profile_grouped_conv_fwd_impl(int do_verification,
     std::cout << "Best configuration parameters:"
               << "\nname: " << best_op_name << "\navg_time: " << best_avg_time
               << "\ntflops: " << best_tflops << "\nGB/s: " << best_gb_per_sec << std::endl;
+    std::cout << best_roofline;
 
     return pass;
 }
@@ -0,0 +1,282 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "ck/ck.hpp"
+#include "ck/host_utility/timing_statistics.hpp"
+#include "ck/tensor_operation/gpu/device/device_base.hpp"
+#include "ck/library/tensor_operation_instance/device_operation_instance_factory.hpp"
+
+namespace ck {
+namespace profiler {
+
+// Number of calls to the global operator new. Counts only if the executable replaces operator
+// new to bump it, as ckHostOverheadBenchmark does.
+inline std::atomic<std::size_t>& host_allocation_count()
+{
+    static std::atomic<std::size_t> count{0};
+    return count;
+}
+
+enum struct HostApi
+{
+    MakeArgument = 0,
+    IsSupportedArgument,
+    GetWorkSpaceSize,
+    GetTypeString,
+    MakeInvoker,
+    NumHostApi,
+};
+
+constexpr std::size_t NumHostApi = static_cast<std::size_t>(HostApi::NumHostApi);
+
+inline const char* get_host_api_name(std::size_t api)
+{
+    static constexpr std::array<const char*, NumHostApi> names{"MakeArgumentPointer",
+                                                               "IsSupportedArgument",
+                                                               "GetWorkSpaceSize",
+                                                               "GetTypeString",
+                                                               "MakeInvokerPointer"};
+    return names[api];
+}
+
+struct HostApiSample
+{
+    // median over the repetitions
+    double ns_          = 0;
+    double allocations_ = 0;
+};
+
+// host cost of one instance for one problem
+struct HostOverheadRecord
+{
+    std::string instance_;
+    std::string shape_;
+    bool supported_             = false;
+    std::size_t workspace_size_ = 0;
+    std::array<HostApiSample, NumHostApi> samples_{};
+};
+
+struct HostOverheadResult
+{
+    std::string family_;
+    std::size_t num_instances_ = 0;
+    std::size_t num_shapes_    = 0;
+
+    // instance/shape pairs whose host calls threw
+    std::size_t num_failed_ = 0;
+
+    double get_instances_ns_ = 0;
+
+    std::vector<HostOverheadRecord> records_;
+};
+
+// time nrepeat calls of f(i), i = 0, ..., nrepeat - 1, one by one
+template <typename F>
+HostApiSample measure_host_api(F&& f, int nrepeat)
+{
+    using Clock = std::chrono::steady_clock;
+
+    std::vector<float> ns(nrepeat);
+
+    const std::size_t allocations_before = host_allocation_count().load();
+
+    for(int i = 0; i < nrepeat; ++i)
+    {
+        const auto start = Clock::now();
+        f(i);
+        const auto stop = Clock::now();
+
+        ns[i] = std::chrono::duration<float, std::nano>(stop - start).count();
+    }
+
+    const std::size_t allocations = host_allocation_count().load() - allocations_before;
+
+    std::sort(ns.begin(), ns.end());
+
+    HostApiSample sample;
+    sample.ns_          = ck::timing::Percentile(ns, 50.f);
+    sample.allocations_ = static_cast<double>(allocations) / nrepeat;
+
+    return sample;
+}
+
+//
+// Measure the host side APIs of every instance of DeviceOp over a list of problems, without
+// launching anything. make_argument(op, shape) returns the argument of one problem, to_string
+// names a problem.
+//
+template <typename DeviceOp, typename Shape, typename MakeArgument, typename ToString>
+HostOverheadResult profile_host_overhead_impl(const std::string& family,
+                                              const std::vector<Shape>& shapes,
+                                              MakeArgument&& make_argument,
+                                              ToString&& to_string,
+                                              int nrepeat)
+{
+    using Clock = std::chrono::steady_clock;
+
+    HostOverheadResult result;
+    result.family_     = family;
+    result.num_shapes_ = shapes.size();
+
+    const auto start = Clock::now();
+    const auto op_ptrs =
+        ck::tensor_operation::device::instance::DeviceOperationInstanceFactory<
+            DeviceOp>::GetInstances();
+    result.get_instances_ns_ =
+        std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+
+    result.num_instances_ = op_ptrs.size();
+
+    for(const auto& op_ptr : op_ptrs)
+    {
+        for(const auto& shape : shapes)
+        {
+            HostOverheadRecord record;
+            record.shape_ = to_string(shape);
+
+            try
+            {
+                // keep the arguments alive so that their destruction is not timed
+                std::vector<std::unique_ptr<ck::tensor_operation::device::BaseArgument>> args(
+                    nrepeat);
+
+                record.samples_[static_cast<std::size_t>(HostApi::MakeArgument)] =
+                    measure_host_api([&](int i) { args[i] = make_argument(*op_ptr, shape); },
+                                     nrepeat);
+
+                auto* p_arg = args.front().get();
+
+                record.samples_[static_cast<std::size_t>(HostApi::IsSupportedArgument)] =
+                    measure_host_api(
+                        [&](int) { record.supported_ = op_ptr->IsSupportedArgument(p_arg); },
+                        nrepeat);
+
+                record.samples_[static_cast<std::size_t>(HostApi::GetWorkSpaceSize)] =
+                    measure_host_api(
+                        [&](int) { record.workspace_size_ = op_ptr->GetWorkSpaceSize(p_arg); },
+                        nrepeat);
+
+                record.samples_[static_cast<std::size_t>(HostApi::GetTypeString)] =
+                    measure_host_api([&](int) { record.instance_ = op_ptr->GetTypeString(); },
+                                     nrepeat);
+
+                std::vector<std::unique_ptr<ck::tensor_operation::device::BaseInvoker>> invokers(
+                    nrepeat);
+
+                record.samples_[static_cast<std::size_t>(HostApi::MakeInvoker)] =
+                    measure_host_api([&](int i) { invokers[i] = op_ptr->MakeInvokerPointer(); },
+                                     nrepeat);
+            }
+            catch(const std::exception& e)
+            {
+                if(ck::EnvIsEnabled(CK_ENV(CK_LOGGING)))
+                {
+                    std::cout << op_ptr->GetTypeString() << " " << record.shape_ << ": "
+                              << e.what() << std::endl;
+                }
+                result.num_failed_++;
+                continue;
+            }
+
+            result.records_.push_back(std::move(record));
+        }
+    }
+
+    return result;
+}
+
+//
+// Per API: the median/p90/max over all instance and problem pairs, and the cost of calling it
+// on every instance for one problem, as a candidate scan does
+//
+inline void print_host_overhead_result(const HostOverheadResult& result, std::ostream& os)
+{
+    const std::size_t num_supported =
+        std::count_if(result.records_.begin(), result.records_.end(), [](const auto& r) {
+            return r.supported_;
+        });
+
+    os << result.family_ << ": " << result.num_instances_ << " instances, "
+       << result.num_shapes_ << " shapes, " << num_supported << " supported, "
+       << result.num_failed_ << " failed, GetInstances "
+       << result.get_instances_ns_ / 1000. << " us" << std::endl;
+
+    if(result.records_.empty())
+        return;
+
+    // clang-format off
+    os << std::left << std::setw(22) << "  api" << std::right
+       << std::setw(12) << "median ns"
+       << std::setw(12) << "p90 ns"
+       << std::setw(12) << "max ns"
+       << std::setw(16) << "us per shape"
+       << std::setw(14) << "allocs/call" << std::endl;
+    // clang-format on
+
+    for(std::size_t api = 0; api < NumHostApi; ++api)
+    {
+        std::vector<float> ns;
+        double allocations = 0;
+        double total_ns    = 0;
+
+        for(const auto& record : result.records_)
+        {
+            ns.push_back(static_cast<float>(record.samples_[api].ns_));
+            allocations += record.samples_[api].allocations_;
+            total_ns += record.samples_[api].ns_;
+        }
+
+        std::sort(ns.begin(), ns.end());
+
+        // clang-format off
+        os << std::left << std::setw(22) << std::string("  ") + get_host_api_name(api)
+           << std::right << std::fixed << std::setprecision(1)
+           << std::setw(12) << ck::timing::Percentile(ns, 50.f)
+           << std::setw(12) << ck::timing::Percentile(ns, 90.f)
+           << std::setw(12) << ns.back()
+           << std::setw(16) << total_ns / 1000. / std::max<std::size_t>(result.num_shapes_, 1)
+           << std::setw(14) << allocations / result.records_.size() << std::endl;
+        // clang-format on
+    }
+
+    os << std::defaultfloat << std::setprecision(6);
+}
+
+// one line per instance, problem and API
+inline void write_host_overhead_csv(const std::vector<HostOverheadResult>& results,
+                                    std::ostream& os)
+{
+    os << "family,instance,shape,supported,workspace_size,api,ns,allocations" << std::endl;
+
+    for(const auto& result : results)
+    {
+        for(const auto& record : result.records_)
+        {
+            for(std::size_t api = 0; api < NumHostApi; ++api)
+            {
+                os << result.family_ << ",\"" << record.instance_ << "\",\"" << record.shape_
+                   << "\"," << record.supported_ << "," << record.workspace_size_ << ","
+                   << get_host_api_name(api) << "," << record.samples_[api].ns_ << ","
+                   << record.samples_[api].allocations_ << std::endl;
+            }
+        }
+    }
+}
+
+} // namespace profiler
+} // namespace ck
@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+// Copyright (c) 2024-2025, Advanced Micro Devices, Inc. All rights reserved.
 
 #pragma once
 
@@ -13,6 +13,7 @@
 #include "ck/library/utility/host_tensor.hpp"
 #include "ck/library/utility/host_tensor_generator.hpp"
 #include "ck/library/utility/literals.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_pool_window.hpp"
 #include "ck/library/reference_tensor_operation/cpu/reference_pool_fwd.hpp"
 #include "ck/library/reference_tensor_operation/cpu/reference_maxpool_bwd.hpp"
 
@@ -78,20 +79,19 @@ bool profile_max_pool2d_bwd_impl(int do_verification,
     int Ho = out_length[2];
     int Wo = out_length[3];
 
-    auto f_host_tensor_descriptor =
-        [](std::size_t N_, std::size_t C_, std::size_t H, std::size_t W) {
-            using namespace ck::literals;
+    // the layout the device instances take
+    using Layout = ck::tensor_layout::convolution::NHWC;
+    using ck::tensor_operation::host::make_pool_host_tensor_descriptor;
 
-            return HostTensorDescriptor({N_, C_, H, W}, {C_ * H * W, 1_uz, W * C_, C_});
-        };
+    Tensor<InDataType> in_n_c_hi_wi(make_pool_host_tensor_descriptor<Layout>(N, C, Hi, Wi));
+    Tensor<OutDataType> out_n_c_ho_wo(make_pool_host_tensor_descriptor<Layout>(N, C, Ho, Wo));
+    Tensor<IndexDataType> out_indices_n_c_ho_wo(
+        make_pool_host_tensor_descriptor<Layout>(N, C, Ho, Wo));
+    Tensor<DOutDataType> dout_n_c_ho_wo(make_pool_host_tensor_descriptor<Layout>(N, C, Ho, Wo));
+    Tensor<DInDataType> din_n_c_hi_wi_host(make_pool_host_tensor_descriptor<Layout>(N, C, Hi, Wi));
 
-    Tensor<InDataType> in_n_c_hi_wi(f_host_tensor_descriptor(N, C, Hi, Wi));
-    Tensor<OutDataType> out_n_c_ho_wo(f_host_tensor_descriptor(N, C, Ho, Wo));
-    Tensor<IndexDataType> out_indices_n_c_ho_wo(f_host_tensor_descriptor(N, C, Ho, Wo));
-    Tensor<DOutDataType> dout_n_c_ho_wo(f_host_tensor_descriptor(N, C, Ho, Wo));
-    Tensor<DInDataType> din_n_c_hi_wi_host(f_host_tensor_descriptor(N, C, Hi, Wi));
-
-    Tensor<DInDataType> din_n_c_hi_wi_device(f_host_tensor_descriptor(N, C, Hi, Wi));
+    Tensor<DInDataType> din_n_c_hi_wi_device(
+        make_pool_host_tensor_descriptor<Layout>(N, C, Hi, Wi));
 
     switch(init_method)
     {
@@ -170,8 +170,15 @@ bool profile_max_pool2d_bwd_impl(int do_verification,
                                                             PassThrough>;
 
         ReferencePoolingBwdInstance ref_pooling_bwd;
-        auto ref_pooling_bwd_argument = ref_pooling_bwd.MakeArgument(
-            dout_n_c_ho_wo, out_indices_n_c_ho_wo, din_n_c_hi_wi_host, PassThrough{});
+        auto ref_pooling_bwd_argument = ref_pooling_bwd.MakeArgument(dout_n_c_ho_wo,
+                                                                     out_indices_n_c_ho_wo,
+                                                                     din_n_c_hi_wi_host,
+                                                                     window_spatial_lengths,
+                                                                     window_strides,
+                                                                     window_dilations,
+                                                                     input_left_pads,
+                                                                     input_right_pads,
+                                                                     PassThrough{});
         auto ref_invoker = ref_pooling_bwd.MakeInvoker();
         ref_invoker.Run(ref_pooling_bwd_argument);
     }
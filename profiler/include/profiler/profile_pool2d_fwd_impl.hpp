@@ -12,8 +12,11 @@
 #include "ck/library/utility/host_tensor.hpp"
 #include "ck/library/utility/host_tensor_generator.hpp"
 #include "ck/library/utility/literals.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_pool_window.hpp"
 #include "ck/library/reference_tensor_operation/cpu/reference_pool_fwd.hpp"
 
+#include "profiler/roofline.hpp"
+
 namespace ck {
 namespace profiler {
 
@@ -70,19 +73,18 @@ bool profile_pool2d_fwd_impl(int do_verification,
     int Ho = out_length[2];
     int Wo = out_length[3];
 
-    auto f_host_tensor_descriptor =
-        [](std::size_t N_, std::size_t C_, std::size_t H, std::size_t W) {
-            using namespace ck::literals;
-
-            return HostTensorDescriptor({N_, C_, H, W}, {C_ * H * W, 1_uz, W * C_, C_});
-        };
+    using ck::tensor_operation::host::make_pool_host_tensor_descriptor;
 
-    Tensor<InDataType> in_n_c_hi_wi(f_host_tensor_descriptor(N, C, Hi, Wi));
-    Tensor<OutDataType> out_n_c_ho_wo_host(f_host_tensor_descriptor(N, C, Ho, Wo));
-    Tensor<IndexDataType> out_indices_n_c_ho_wo_host(f_host_tensor_descriptor(N, C, Ho, Wo));
+    Tensor<InDataType> in_n_c_hi_wi(make_pool_host_tensor_descriptor<InLayout>(N, C, Hi, Wi));
+    Tensor<OutDataType> out_n_c_ho_wo_host(
+        make_pool_host_tensor_descriptor<OutLayout>(N, C, Ho, Wo));
+    Tensor<IndexDataType> out_indices_n_c_ho_wo_host(
+        make_pool_host_tensor_descriptor<OutLayout>(N, C, Ho, Wo));
 
-    Tensor<OutDataType> out_n_c_ho_wo_device(f_host_tensor_descriptor(N, C, Ho, Wo));
-    Tensor<IndexDataType> out_indices_n_c_ho_wo_device(f_host_tensor_descriptor(N, C, Ho, Wo));
+    Tensor<OutDataType> out_n_c_ho_wo_device(
+        make_pool_host_tensor_descriptor<OutLayout>(N, C, Ho, Wo));
+    Tensor<IndexDataType> out_indices_n_c_ho_wo_device(
+        make_pool_host_tensor_descriptor<OutLayout>(N, C, Ho, Wo));
 
     switch(init_method)
     {
@@ -194,7 +196,8 @@ bool profile_pool2d_fwd_impl(int do_verification,
         float gb_per_sec = num_bytes / 1.E6 / avg_time;
 
         if(time_kernel)
-            std::cout << "Perf: " << std::setw(10) << avg_time << " ms, " << gb_per_sec << " GB/s, "
+            std::cout << "Perf: " << std::setw(10) << avg_time << " ms, " << gb_per_sec << " GB/s"
+                      << roofline_annotation<ComputeDataType>(0, num_bytes, avg_time) << ", "
                       << inst_ptr->GetTypeString() << std::endl;
 
         if(avg_time < best_avg_time)
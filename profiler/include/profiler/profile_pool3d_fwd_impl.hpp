@@ -12,8 +12,11 @@
 #include "ck/library/utility/host_tensor.hpp"
 #include "ck/library/utility/host_tensor_generator.hpp"
 #include "ck/library/utility/literals.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_pool_window.hpp"
 #include "ck/library/reference_tensor_operation/cpu/reference_pool_fwd.hpp"
 
+#include "profiler/roofline.hpp"
+
 namespace ck {
 namespace profiler {
 
@@ -86,21 +89,19 @@ bool profile_pool3d_fwd_impl(PoolFwdInputParams& in_params, PoolFwdKernelParams&
     int Ho = out_length[3];
     int Wo = out_length[4];
 
-    auto f_host_tensor_descriptor =
-        [](std::size_t N_, std::size_t C_, std::size_t D, std::size_t H, std::size_t W) {
-            using namespace ck::literals;
-
-            return HostTensorDescriptor({N_, C_, D, H, W},
-                                        {D * C_ * H * W, 1_uz, C_ * H * W, W * C_, C_});
-        };
+    using ck::tensor_operation::host::make_pool_host_tensor_descriptor;
 
-    Tensor<InDataType> in_n_c_di_hi_wi(f_host_tensor_descriptor(N, C, Di, Hi, Wi));
-    Tensor<OutDataType> out_n_c_do_ho_wo_host(f_host_tensor_descriptor(N, C, Do, Ho, Wo));
-    Tensor<IndexDataType> out_indices_n_c_do_ho_wo_host(f_host_tensor_descriptor(N, C, Do, Ho, Wo));
+    Tensor<InDataType> in_n_c_di_hi_wi(
+        make_pool_host_tensor_descriptor<InLayout>(N, C, Di, Hi, Wi));
+    Tensor<OutDataType> out_n_c_do_ho_wo_host(
+        make_pool_host_tensor_descriptor<OutLayout>(N, C, Do, Ho, Wo));
+    Tensor<IndexDataType> out_indices_n_c_do_ho_wo_host(
+        make_pool_host_tensor_descriptor<OutLayout>(N, C, Do, Ho, Wo));
 
-    Tensor<OutDataType> out_n_c_do_ho_wo_device(f_host_tensor_descriptor(N, C, Do, Ho, Wo));
+    Tensor<OutDataType> out_n_c_do_ho_wo_device(
+        make_pool_host_tensor_descriptor<OutLayout>(N, C, Do, Ho, Wo));
     Tensor<IndexDataType> out_indices_n_c_do_ho_wo_device(
-        f_host_tensor_descriptor(N, C, Do, Ho, Wo));
+        make_pool_host_tensor_descriptor<OutLayout>(N, C, Do, Ho, Wo));
 
     constexpr int inDataRangeTensor1{1};
     constexpr int inDataRangeTensor2{5};
@@ -226,7 +227,8 @@ bool profile_pool3d_fwd_impl(PoolFwdInputParams& in_params, PoolFwdKernelParams&
         float gb_per_sec = num_bytes / 1.E6 / avg_time;
 
         if(in_params.time_kernel)
-            std::cout << "Perf: " << std::setw(10) << avg_time << " ms, " << gb_per_sec << " GB/s, "
+            std::cout << "Perf: " << std::setw(10) << avg_time << " ms, " << gb_per_sec << " GB/s"
+                      << roofline_annotation<ComputeDataType>(0, num_bytes, avg_time) << ", "
                       << inst_ptr->GetTypeString() << std::endl;
 
         if(avg_time < best_avg_time)
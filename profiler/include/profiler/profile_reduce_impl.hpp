@@ -14,6 +14,8 @@
 #include "ck/library/utility/host_common_util.hpp"
 #include "ck/library/utility/host_tensor_generator.hpp"
 
+#include "profiler/roofline.hpp"
+
 namespace ck {
 namespace tensor_operation {
 namespace device {
@@ -389,7 +391,8 @@ bool profile_reduce_impl_impl(bool do_verification,
             float gb_per_sec = num_bytes / 1.E6 / avg_time;
 
             if(time_kernel)
-                std::cout << "Perf: " << avg_time << " ms, " << gb_per_sec << " GB/s, "
+                std::cout << "Perf: " << avg_time << " ms, " << gb_per_sec << " GB/s"
+                          << roofline_annotation<AccDataType>(0, num_bytes, avg_time) << ", "
                           << reduce_name << std::endl;
 
             if(gb_per_sec > best_gb_per_sec)
@@ -20,6 +20,8 @@
 #include "ck/tensor_operation/gpu/element/element_wise_operation.hpp"
 #include "ck/utility/data_type.hpp"
 
+#include "profiler/roofline.hpp"
+
 namespace ck {
 namespace profiler {
 
@@ -159,7 +161,8 @@ bool profile_softmax_impl(int do_verification,
                 (beta == 0.0f ? 1 : 2) * out.GetElementSize() * sizeof(OutDataType);
             float gb_per_sec = num_bytes / 1.E6 / avg_time;
 
-            std::cout << "Perf: " << std::setw(10) << avg_time << " ms, " << gb_per_sec << " GB/s, "
+            std::cout << "Perf: " << std::setw(10) << avg_time << " ms, " << gb_per_sec << " GB/s"
+                      << roofline_annotation<AccDataType>(0, num_bytes, avg_time) << ", "
                       << inst_ptr->GetTypeString() << std::endl;
 
             if(avg_time < best_avg_time)
@@ -0,0 +1,62 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+#include "ck/ck.hpp"
+#include "ck/utility/data_type.hpp"
+#include "profiler/data_type_enum.hpp"
+#include "profiler/roofline_model.hpp"
+
+// The roofline annotations of the profiler results, by the compute data type of the instances.
+// The model itself is in roofline_model.hpp
+namespace ck {
+namespace profiler {
+
+// the peak rates a data type computes at
+template <typename T>
+constexpr DataTypeEnum get_roofline_compute_type()
+{
+    if constexpr(is_same_v<T, double>)
+        return DataTypeEnum::Double;
+    else if constexpr(is_same_v<T, half_t>)
+        return DataTypeEnum::Half;
+    else if constexpr(is_same_v<T, bhalf_t>)
+        return DataTypeEnum::BFloat16;
+    else if constexpr(is_same_v<T, f8_t> || is_same_v<T, bf8_t>)
+        return DataTypeEnum::Float8;
+    else if constexpr(is_same_v<T, int8_t>)
+        return DataTypeEnum::Int8;
+    else
+        return DataTypeEnum::Float;
+}
+
+// the roofline point of a result measured on the current device
+template <typename ComputeDataType>
+std::optional<RooflinePoint>
+evaluate_device_roofline(std::size_t flop, std::size_t bytes, float ave_time)
+{
+    return evaluate_device_roofline(
+        get_roofline_compute_type<ComputeDataType>(), flop, bytes, ave_time);
+}
+
+template <typename ComputeDataType>
+std::string roofline_annotation(std::size_t flop, std::size_t bytes, float ave_time)
+{
+    return roofline_annotation(get_roofline_compute_type<ComputeDataType>(), flop, bytes, ave_time);
+}
+
+template <typename ComputeDataType>
+std::string roofline_summary(std::size_t flop, std::size_t bytes, float best_ave_time)
+{
+    return roofline_summary(
+        get_roofline_compute_type<ComputeDataType>(), flop, bytes, best_ave_time);
+}
+
+} // namespace profiler
+} // namespace ck
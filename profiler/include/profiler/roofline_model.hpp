@@ -0,0 +1,253 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iomanip>
+#include <optional>
+#include <sstream>
+#include <string>
+
+#include "ck/host_utility/device_prop.hpp"
+#include "ck/host_utility/hip_runtime.hpp"
+#include "profiler/data_type_enum.hpp"
+
+// The roofline of the devices in sizes, flop and bytes only, free of the ck data types so that
+// host-only tools and tests can use it
+namespace ck {
+namespace profiler {
+
+// peak rates of one architecture. The flop rates are those of the dense matrix core instructions
+// (MFMA/WMMA) of the data type the kernel computes in, per CU and clock; multiplied by the CU
+// count and the peak engine clock they give the datasheet numbers
+struct RooflinePeaks
+{
+    std::string arch;
+    int num_cu;
+    double clock_ghz;
+
+    double f64_flop_per_clock;
+    double f32_flop_per_clock;
+    double f16_flop_per_clock;
+    double bf16_flop_per_clock;
+    double f8_flop_per_clock; // 0 if not supported
+    double i8_op_per_clock;
+
+    double hbm_gb_per_sec;
+    double lds_byte_per_clock;
+
+    double FlopPerClock(DataTypeEnum compute_type) const
+    {
+        switch(compute_type)
+        {
+        case DataTypeEnum::Double: return f64_flop_per_clock;
+        case DataTypeEnum::Half: return f16_flop_per_clock;
+        case DataTypeEnum::BFloat16: return bf16_flop_per_clock;
+        case DataTypeEnum::Float8: return f8_flop_per_clock;
+        case DataTypeEnum::Int8:
+        case DataTypeEnum::Int8x4: return i8_op_per_clock;
+        default: return f32_flop_per_clock;
+        }
+    }
+
+    double PeakTFlops(DataTypeEnum compute_type) const
+    {
+        return FlopPerClock(compute_type) * num_cu * clock_ghz / 1.E3;
+    }
+
+    double HbmGBPerSec() const { return hbm_gb_per_sec; }
+
+    double LdsGBPerSec() const { return lds_byte_per_clock * num_cu * clock_ghz; }
+};
+
+// the full-chip configuration of each architecture (one GCD for gfx90a)
+inline std::optional<RooflinePeaks> get_roofline_peaks(const std::string& arch)
+{
+    // clang-format off
+    // arch, CUs, GHz, flop/clock/CU of f64 f32 f16 bf16 f8 i8, HBM GB/s, LDS byte/clock/CU
+    static const RooflinePeaks table[] = {
+        RooflinePeaks{"gfx908",  120, 1.502,   64,  256, 1024,  512,    0, 1024, 1228.8,  128},
+        RooflinePeaks{"gfx90a",  110, 1.7,    256,  256, 1024, 1024,    0, 1024, 1638.4,  128},
+        RooflinePeaks{"gfx940",  304, 2.1,    256,  256, 2048, 2048, 4096, 4096, 5300.0,  128},
+        RooflinePeaks{"gfx941",  304, 2.1,    256,  256, 2048, 2048, 4096, 4096, 5300.0,  128},
+        RooflinePeaks{"gfx942",  304, 2.1,    256,  256, 2048, 2048, 4096, 4096, 5300.0,  128},
+        RooflinePeaks{"gfx1100",  96, 2.5,      8,  256,  512,  512,    0, 1024,  960.0,  128},
+        RooflinePeaks{"gfx1201",  64, 2.97,     4,  256, 1024, 1024, 2048, 2048,  644.6,  128},
+    };
+    // clang-format on
+
+    for(const auto& peaks : table)
+    {
+        if(peaks.arch == arch)
+            return peaks;
+    }
+    return std::nullopt;
+}
+
+// the peaks of the current device, with the CU count and clock it reports (partitioned or
+// binned parts have fewer CUs than the table). With a device name override set, the table entry
+// of that arch is used as is
+inline std::optional<RooflinePeaks> get_device_roofline_peaks()
+{
+    auto peaks = get_roofline_peaks(get_device_name());
+    if(!peaks || ck::has_device_name_override())
+        return peaks;
+
+    int device;
+    hipDeviceProp_t props{};
+    if(hipGetDevice(&device) == hipSuccess && hipGetDeviceProperties(&props, device) == hipSuccess)
+    {
+        if(props.multiProcessorCount > 0)
+            peaks->num_cu = props.multiProcessorCount;
+        if(props.clockRate > 0)
+            peaks->clock_ghz = props.clockRate / 1.E6;
+    }
+    return peaks;
+}
+
+enum struct RooflineBound
+{
+    Compute,
+    Memory, // HBM bandwidth
+    Lds,
+};
+
+inline const char* to_string(RooflineBound bound)
+{
+    switch(bound)
+    {
+    case RooflineBound::Compute: return "compute-bound";
+    case RooflineBound::Memory: return "memory-bound";
+    case RooflineBound::Lds: return "lds-bound";
+    }
+    return "";
+}
+
+// the flop and bytes a problem moves; lds_bytes is optional, 0 leaves the LDS ceiling out
+struct RooflineProblem
+{
+    std::size_t flop;
+    std::size_t bytes;
+    std::size_t lds_bytes = 0;
+
+    double ArithmeticIntensity() const
+    {
+        return bytes == 0 ? 0. : static_cast<double>(flop) / bytes;
+    }
+};
+
+struct RooflinePoint
+{
+    double arithmetic_intensity; // flop/byte of HBM traffic
+    double ridge_point;          // intensity above which the peak flop rate is attainable
+    double attainable_tflops;
+    double achieved_tflops;
+    double efficiency; // time at the roofline / measured time
+    RooflineBound bound;
+
+    double Headroom() const { return 1. - efficiency; }
+
+    // whether tuning may still pay off: the result is further than min_headroom from its roof
+    bool WorthTuning(double min_headroom = 0.2) const { return Headroom() > min_headroom; }
+
+    std::string ToString() const
+    {
+        std::ostringstream os;
+        os << std::fixed << std::setprecision(1) << efficiency * 100. << "% of roofline, "
+           << to_string(bound) << " (" << std::setprecision(2) << arithmetic_intensity
+           << " flop/B)";
+        return os.str();
+    }
+};
+
+// the time (ms) a problem takes at the roofline of peaks, a lower bound of its run time
+inline double roofline_time(const RooflinePeaks& peaks,
+                            DataTypeEnum compute_type,
+                            const RooflineProblem& problem)
+{
+    const double peak_tflops  = peaks.PeakTFlops(compute_type);
+    const double compute_time = peak_tflops > 0 ? problem.flop / 1.E9 / peak_tflops : 0.;
+    const double memory_time  = problem.bytes / 1.E6 / peaks.HbmGBPerSec();
+    const double lds_time     = problem.lds_bytes / 1.E6 / peaks.LdsGBPerSec();
+    return std::max({compute_time, memory_time, lds_time});
+}
+
+// places a problem measured at ave_time (ms) under the roofline of peaks: the problem takes at
+// least max(flop / peak flop rate, bytes / HBM bandwidth, lds_bytes / LDS bandwidth), the largest
+// term is the bound
+inline RooflinePoint evaluate_roofline(const RooflinePeaks& peaks,
+                                       DataTypeEnum compute_type,
+                                       const RooflineProblem& problem,
+                                       float ave_time)
+{
+    const double peak_tflops = peaks.PeakTFlops(compute_type);
+
+    // in ms
+    const double compute_time = peak_tflops > 0 ? problem.flop / 1.E9 / peak_tflops : 0.;
+    const double memory_time  = problem.bytes / 1.E6 / peaks.HbmGBPerSec();
+    const double lds_time     = problem.lds_bytes / 1.E6 / peaks.LdsGBPerSec();
+    const double roof_time    = std::max({compute_time, memory_time, lds_time});
+
+    RooflinePoint point{};
+    point.arithmetic_intensity = problem.ArithmeticIntensity();
+    point.ridge_point          = peak_tflops * 1.E3 / peaks.HbmGBPerSec();
+    point.attainable_tflops =
+        std::min(peak_tflops, point.arithmetic_intensity * peaks.HbmGBPerSec() / 1.E3);
+    point.achieved_tflops = ave_time > 0 ? problem.flop / 1.E9 / ave_time : 0.;
+    point.efficiency      = ave_time > 0 ? roof_time / ave_time : 0.;
+
+    if(roof_time == lds_time && lds_time > 0)
+        point.bound = RooflineBound::Lds;
+    else if(roof_time == compute_time && compute_time > 0)
+        point.bound = RooflineBound::Compute;
+    else
+        point.bound = RooflineBound::Memory;
+
+    return point;
+}
+
+// the roofline point of a result measured on the current device, none if the device is not in the
+// roofline table or the kernel was not timed
+inline std::optional<RooflinePoint> evaluate_device_roofline(DataTypeEnum compute_type,
+                                                             std::size_t flop,
+                                                             std::size_t bytes,
+                                                             float ave_time)
+{
+    static const auto peaks = get_device_roofline_peaks();
+    if(!peaks || ave_time <= 0)
+        return std::nullopt;
+
+    return evaluate_roofline(*peaks, compute_type, RooflineProblem{flop, bytes}, ave_time);
+}
+
+// the ", <efficiency> of roofline, <bound>" suffix of a profiler result line
+inline std::string
+roofline_annotation(DataTypeEnum compute_type, std::size_t flop, std::size_t bytes, float ave_time)
+{
+    const auto point = evaluate_device_roofline(compute_type, flop, bytes, ave_time);
+    return point ? ", " + point->ToString() : std::string();
+}
+
+// the line summarizing where the best instance of a problem stands, and whether the problem is
+// worth more tuning effort
+inline std::string roofline_summary(DataTypeEnum compute_type,
+                                    std::size_t flop,
+                                    std::size_t bytes,
+                                    float best_ave_time)
+{
+    const auto point = evaluate_device_roofline(compute_type, flop, bytes, best_ave_time);
+    if(!point)
+        return std::string();
+
+    std::ostringstream os;
+    os << "Roofline: best instance at " << point->ToString() << ", ridge " << std::fixed
+       << std::setprecision(2) << point->ridge_point << " flop/B, " << point->attainable_tflops
+       << " TFlops attainable, "
+       << (point->WorthTuning() ? "worth tuning" : "near the roofline") << std::endl;
+    return os.str();
+}
+
+} // namespace profiler
+} // namespace ck
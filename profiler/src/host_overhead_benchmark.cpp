@@ -0,0 +1,340 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+
+//
+// Host side latency and allocation count of the device operation APIs (MakeArgumentPointer,
+// IsSupportedArgument, GetWorkSpaceSize, GetTypeString, MakeInvokerPointer) of every instance
+// of some DeviceOp families over a shape corpus. No kernel is launched and no device memory is
+// allocated, so with --device set the benchmark runs on machines without a GPU.
+//
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "ck/ck.hpp"
+#include "ck/host_utility/device_prop.hpp"
+#include "ck/tensor_operation/gpu/device/tensor_layout.hpp"
+#include "ck/tensor_operation/gpu/element/element_wise_operation.hpp"
+
+#include "ck/library/tensor_operation_instance/gpu/gemm_universal.hpp"
+#include "ck/library/tensor_operation_instance/gpu/grouped_convolution_forward.hpp"
+
+#include "ck/library/utility/algorithm.hpp"
+#include "ck/library/utility/convolution_parameter.hpp"
+#include "ck/library/utility/convolution_host_tensor_descriptor_helper.hpp"
+
+#include "profiler/profile_host_overhead_impl.hpp"
+
+// count every allocation of the process
+void* operator new(std::size_t size)
+{
+    ck::profiler::host_allocation_count().fetch_add(1, std::memory_order_relaxed);
+
+    if(void* p = std::malloc(size == 0 ? 1 : size))
+        return p;
+
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+using F16         = ck::half_t;
+using PassThrough = ck::tensor_operation::element_wise::PassThrough;
+
+using Row = ck::tensor_layout::gemm::RowMajor;
+using Col = ck::tensor_layout::gemm::ColumnMajor;
+
+using NHWGC = ck::tensor_layout::convolution::NHWGC;
+using GKYXC = ck::tensor_layout::convolution::GKYXC;
+using NHWGK = ck::tensor_layout::convolution::NHWGK;
+
+struct GemmShape
+{
+    ck::index_t M, N, K;
+};
+
+struct ConvShape
+{
+    ck::utils::conv::ConvParam param_;
+
+    std::array<ck::index_t, 5> a_g_n_c_wis_lengths_{};
+    std::array<ck::index_t, 5> a_g_n_c_wis_strides_{};
+    std::array<ck::index_t, 5> b_g_k_c_xs_lengths_{};
+    std::array<ck::index_t, 5> b_g_k_c_xs_strides_{};
+    std::array<ck::index_t, 5> e_g_n_k_wos_lengths_{};
+    std::array<ck::index_t, 5> e_g_n_k_wos_strides_{};
+    std::array<ck::index_t, 2> conv_filter_strides_{};
+    std::array<ck::index_t, 2> conv_filter_dilations_{};
+    std::array<ck::index_t, 2> input_left_pads_{};
+    std::array<ck::index_t, 2> input_right_pads_{};
+
+    explicit ConvShape(const ck::utils::conv::ConvParam& param) : param_{param}
+    {
+        const auto in_desc =
+            ck::utils::conv::make_input_host_tensor_descriptor_g_n_c_wis_packed<NHWGC>(param);
+        const auto wei_desc =
+            ck::utils::conv::make_weight_host_tensor_descriptor_g_k_c_xs_packed<GKYXC>(param);
+        const auto out_desc =
+            ck::utils::conv::make_output_host_tensor_descriptor_g_n_k_wos_packed<NHWGK>(param);
+
+        auto copy = [](const auto& x, auto& y) { ck::ranges::copy(x, y.begin()); };
+
+        copy(in_desc.GetLengths(), a_g_n_c_wis_lengths_);
+        copy(in_desc.GetStrides(), a_g_n_c_wis_strides_);
+        copy(wei_desc.GetLengths(), b_g_k_c_xs_lengths_);
+        copy(wei_desc.GetStrides(), b_g_k_c_xs_strides_);
+        copy(out_desc.GetLengths(), e_g_n_k_wos_lengths_);
+        copy(out_desc.GetStrides(), e_g_n_k_wos_strides_);
+        copy(param.conv_filter_strides_, conv_filter_strides_);
+        copy(param.conv_filter_dilations_, conv_filter_dilations_);
+        copy(param.input_left_pads_, input_left_pads_);
+        copy(param.input_right_pads_, input_right_pads_);
+    }
+};
+
+// a few shapes of LLM inference GEMMs and ResNet-50 convolutions
+std::vector<GemmShape> default_gemm_shapes()
+{
+    return {{1, 4096, 4096},
+            {16, 4096, 4096},
+            {128, 11008, 4096},
+            {1024, 1024, 1024},
+            {3840, 4096, 4096}};
+}
+
+std::vector<ConvShape> default_conv_shapes()
+{
+    using ck::utils::conv::ConvParam;
+
+    const std::vector<ConvParam> params{
+        {2, 1, 1, 64, 3, {7, 7}, {224, 224}, {2, 2}, {1, 1}, {3, 3}, {3, 3}},
+        {2, 1, 1, 64, 64, {3, 3}, {56, 56}, {1, 1}, {1, 1}, {1, 1}, {1, 1}},
+        {2, 1, 32, 256, 64, {1, 1}, {56, 56}, {1, 1}, {1, 1}, {0, 0}, {0, 0}},
+        {2, 1, 32, 512, 512, {3, 3}, {7, 7}, {1, 1}, {1, 1}, {1, 1}, {1, 1}},
+        {2, 32, 1, 32, 32, {3, 3}, {28, 28}, {1, 1}, {1, 1}, {1, 1}, {1, 1}}};
+
+    return std::vector<ConvShape>(params.begin(), params.end());
+}
+
+//
+// Shape file, one problem per line, '#' starts a comment:
+//   gemm M N K
+//   conv2d G N K C Y X Hi Wi Sy Sx Dy Dx LeftPy LeftPx RightPy RightPx
+//
+void read_shapes(const std::string& path,
+                 std::vector<GemmShape>& gemm_shapes,
+                 std::vector<ConvShape>& conv_shapes)
+{
+    std::ifstream file(path);
+    if(!file)
+        throw std::runtime_error("cannot open shape file " + path);
+
+    std::string line;
+    while(std::getline(file, line))
+    {
+        line = line.substr(0, line.find('#'));
+
+        std::istringstream is(line);
+        std::vector<std::string> tokens;
+        for(std::string token; is >> token;)
+            tokens.push_back(token);
+
+        if(tokens.empty())
+            continue;
+
+        if(tokens[0] == "gemm" && tokens.size() == 4)
+        {
+            gemm_shapes.push_back(
+                {std::stoi(tokens[1]), std::stoi(tokens[2]), std::stoi(tokens[3])});
+        }
+        else if(tokens[0] == "conv2d" && tokens.size() == 17)
+        {
+            std::vector<char*> argv;
+            for(auto& token : tokens)
+                argv.push_back(token.data());
+
+            conv_shapes.emplace_back(ck::utils::conv::parse_conv_param(2, 1, argv.data()));
+        }
+        else
+        {
+            throw std::runtime_error("wrong shape: " + line);
+        }
+    }
+}
+
+ck::profiler::HostOverheadResult profile_gemm(const std::vector<GemmShape>& shapes, int nrepeat)
+{
+    using DeviceOp = ck::tensor_operation::device::
+        DeviceGemmV2<Row, Col, Row, F16, F16, F16, PassThrough, PassThrough, PassThrough>;
+
+    return ck::profiler::profile_host_overhead_impl<DeviceOp>(
+        "gemm_universal_f16_rcr",
+        shapes,
+        [](DeviceOp& op, const GemmShape& s) {
+            return op.MakeArgumentPointer(nullptr,
+                                          nullptr,
+                                          nullptr,
+                                          s.M,
+                                          s.N,
+                                          s.K,
+                                          s.K,
+                                          s.K,
+                                          s.N,
+                                          1,
+                                          PassThrough{},
+                                          PassThrough{},
+                                          PassThrough{});
+        },
+        [](const GemmShape& s) {
+            return std::to_string(s.M) + "x" + std::to_string(s.N) + "x" + std::to_string(s.K);
+        },
+        nrepeat);
+}
+
+ck::profiler::HostOverheadResult profile_conv_fwd(const std::vector<ConvShape>& shapes,
+                                                  int nrepeat)
+{
+    using DeviceOp =
+        ck::tensor_operation::device::DeviceGroupedConvFwdMultipleABD<2,
+                                                                      NHWGC,
+                                                                      GKYXC,
+                                                                      ck::Tuple<>,
+                                                                      NHWGK,
+                                                                      F16,
+                                                                      F16,
+                                                                      ck::Tuple<>,
+                                                                      F16,
+                                                                      PassThrough,
+                                                                      PassThrough,
+                                                                      PassThrough>;
+
+    return ck::profiler::profile_host_overhead_impl<DeviceOp>(
+        "grouped_conv2d_fwd_f16_nhwgc",
+        shapes,
+        [](DeviceOp& op, const ConvShape& s) {
+            return op.MakeArgumentPointer(nullptr,
+                                          nullptr,
+                                          {},
+                                          nullptr,
+                                          s.a_g_n_c_wis_lengths_,
+                                          s.a_g_n_c_wis_strides_,
+                                          s.b_g_k_c_xs_lengths_,
+                                          s.b_g_k_c_xs_strides_,
+                                          {},
+                                          {},
+                                          s.e_g_n_k_wos_lengths_,
+                                          s.e_g_n_k_wos_strides_,
+                                          s.conv_filter_strides_,
+                                          s.conv_filter_dilations_,
+                                          s.input_left_pads_,
+                                          s.input_right_pads_,
+                                          PassThrough{},
+                                          PassThrough{},
+                                          PassThrough{});
+        },
+        [](const ConvShape& s) {
+            std::ostringstream os;
+            os << s.param_;
+            return os.str();
+        },
+        nrepeat);
+}
+
+void print_help()
+{
+    std::cout << "ckHostOverheadBenchmark [options]\n"
+              << "  --family <all|gemm|conv_fwd>  device op families to measure (default all)\n"
+              << "  --shapes <file>               shape corpus instead of the built-in one\n"
+              << "  --repeat <n>                  calls per instance and shape (default 20)\n"
+              << "  --device <gfx942>             device name used by IsSupportedArgument,\n"
+              << "                                required on machines without a GPU\n"
+              << "  --csv <file>                  write every measurement to a csv file\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    std::string family = "all";
+    std::string shape_file;
+    std::string csv_file;
+    int nrepeat = 20;
+
+    for(int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+
+        if(arg == "--help" || i + 1 == argc)
+        {
+            print_help();
+            return arg == "--help" ? 0 : 1;
+        }
+
+        const std::string value = argv[++i];
+
+        if(arg == "--family")
+            family = value;
+        else if(arg == "--shapes")
+            shape_file = value;
+        else if(arg == "--repeat")
+            nrepeat = std::max(1, std::stoi(value));
+        else if(arg == "--device")
+            ck::set_device_name_override(value);
+        else if(arg == "--csv")
+            csv_file = value;
+        else
+        {
+            print_help();
+            return 1;
+        }
+    }
+
+    std::vector<GemmShape> gemm_shapes;
+    std::vector<ConvShape> conv_shapes;
+
+    if(shape_file.empty())
+    {
+        gemm_shapes = default_gemm_shapes();
+        conv_shapes = default_conv_shapes();
+    }
+    else
+    {
+        read_shapes(shape_file, gemm_shapes, conv_shapes);
+    }
+
+    std::cout << "device: " << ck::get_device_name() << ", repeat: " << nrepeat << std::endl;
+
+    std::vector<ck::profiler::HostOverheadResult> results;
+
+    if((family == "all" || family == "gemm") && !gemm_shapes.empty())
+        results.push_back(profile_gemm(gemm_shapes, nrepeat));
+
+    if((family == "all" || family == "conv_fwd") && !conv_shapes.empty())
+        results.push_back(profile_conv_fwd(conv_shapes, nrepeat));
+
+    for(const auto& result : results)
+    {
+        std::cout << std::endl;
+        ck::profiler::print_host_overhead_result(result, std::cout);
+    }
+
+    if(!csv_file.empty())
+    {
+        std::ofstream csv(csv_file);
+        ck::profiler::write_host_overhead_csv(results, csv);
+    }
+
+    return 0;
+}
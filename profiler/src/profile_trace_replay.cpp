@@ -0,0 +1,190 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "ck/host_utility/device_prop.hpp"
+#include "profiler/model_trace.hpp"
+#include "profiler/roofline_model.hpp"
+#include "profiler_operation_registry.hpp"
+
+#define OP_NAME "trace_replay"
+#define OP_DESC "Model Trace Replay"
+
+namespace {
+
+static void print_helper_msg()
+{
+    std::cout << "arg1: tensor operation (" OP_NAME ": " OP_DESC ")\n"
+              << "arg2: trace file, one op per line:\n"
+              << "      <layer> <family> dtype=<type> [layout=<layout>] <param>=<value>... "
+                 "[count=<runs>]\n"
+              << "      (see profiler/include/profiler/model_trace.hpp for the families)\n"
+              << "optional:\n"
+              << "arg3: timing database, its shapes are not profiled again and the new times are\n"
+              << "      added to it (-: none)\n"
+              << "arg4: profiling budget in seconds, the remaining shapes are estimated at their\n"
+              << "      roofline (0: no limit, default)\n"
+              << std::endl;
+}
+
+// collects what std::cout receives while alive
+class CoutCapture
+{
+    public:
+    CoutCapture() : buf_(std::cout.rdbuf(os_.rdbuf())) {}
+    ~CoutCapture() { std::cout.rdbuf(buf_); }
+
+    std::string Get() const { return os_.str(); }
+
+    private:
+    std::ostringstream os_;
+    std::streambuf* buf_;
+};
+
+// runs a ckProfiler operation in this process, returns the best time it printed
+std::optional<double> run_profiler_command(const std::vector<std::string>& command)
+{
+    const auto operation = ProfilerOperationRegistry::GetInstance().Get(command[0]);
+    if(!operation)
+        return std::nullopt;
+
+    std::vector<std::string> args{"ckProfiler"};
+    args.insert(args.end(), command.begin(), command.end());
+    std::vector<char*> argv;
+    for(auto& arg : args)
+        argv.push_back(arg.data());
+    argv.push_back(nullptr);
+
+    std::string log;
+    try
+    {
+        CoutCapture capture;
+        (*operation)(static_cast<int>(args.size()), argv.data());
+        log = capture.Get();
+    }
+    catch(const std::exception& e)
+    {
+        std::cout << " (" << command[0] << " failed: " << e.what() << ")";
+        return std::nullopt;
+    }
+
+    return ck::profiler::parse_trace_best_time(log);
+}
+
+} // namespace
+
+int profile_trace_replay(int argc, char* argv[])
+{
+    using namespace ck::profiler;
+
+    if(argc < 3 || argc > 5)
+    {
+        print_helper_msg();
+        return 1;
+    }
+
+    const std::string trace_path = argv[2];
+    const std::string db_path    = argc > 3 && std::string(argv[3]) != "-" ? argv[3] : "";
+    const double budget          = argc > 4 ? std::stod(argv[4]) : 0.;
+
+    std::vector<TraceOp> ops;
+    {
+        std::ifstream trace(trace_path);
+        if(!trace)
+        {
+            std::cerr << "cannot open trace " << trace_path << std::endl;
+            return 1;
+        }
+        try
+        {
+            ops = parse_trace(trace);
+        }
+        catch(const std::exception& e)
+        {
+            std::cerr << trace_path << ": " << e.what() << std::endl;
+            return 1;
+        }
+    }
+
+    const auto shapes = dedupe_trace(ops);
+    const auto peaks  = get_device_roofline_peaks();
+    const auto arch   = ck::get_device_name();
+
+    TraceTimingDatabase db;
+    if(!db_path.empty())
+    {
+        std::ifstream db_file(db_path);
+        db.Load(db_file);
+    }
+
+    std::cout << trace_path << ": " << ops.size() << " ops, " << shapes.size() << " shapes, "
+              << arch << (peaks ? "" : " (no roofline data)") << std::endl;
+
+    std::vector<TraceShapeTime> times(shapes.size());
+    for(std::size_t i = 0; i < shapes.size(); ++i)
+    {
+        if(const auto ave_time = db.Find(arch, shapes[i].op.ShapeKey()))
+            times[i] = TraceShapeTime{*ave_time, TraceTimeSource::Database};
+    }
+
+    // profile the heaviest shapes first
+    const auto start = std::chrono::steady_clock::now();
+    for(const auto i : schedule_trace_shapes(shapes, peaks))
+    {
+        if(times[i].source != TraceTimeSource::None)
+            continue;
+
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        if(budget > 0 && elapsed.count() > budget)
+            break;
+
+        const auto command = make_trace_profiler_command(shapes[i].op);
+        if(!command)
+            continue;
+
+        std::cout << "profiling " << shapes[i].op.ShapeKey() << std::flush;
+        if(const auto ave_time = run_profiler_command(*command))
+        {
+            times[i] = TraceShapeTime{*ave_time, TraceTimeSource::Measured};
+            db.Set(arch, shapes[i].op.ShapeKey(), *ave_time);
+            std::cout << ": " << *ave_time << " ms" << std::endl;
+        }
+        else
+        {
+            std::cout << ": no result" << std::endl;
+        }
+    }
+
+    // the shapes left (no profiler operation, no supported instance, over budget)
+    for(std::size_t i = 0; i < shapes.size(); ++i)
+    {
+        if(times[i].source == TraceTimeSource::None && peaks)
+        {
+            times[i] = TraceShapeTime{roofline_time(*peaks,
+                                                    get_trace_compute_type(shapes[i].op.data_type),
+                                                    get_trace_roofline_problem(shapes[i].op)),
+                                      TraceTimeSource::Roofline};
+        }
+    }
+
+    aggregate_trace(ops, shapes, times, peaks).Print(std::cout);
+
+    if(!db_path.empty())
+    {
+        std::ofstream db_file(db_path);
+        db.Save(db_file);
+    }
+
+    return 0;
+}
+
+REGISTER_PROFILER_OPERATION(OP_NAME, OP_DESC, profile_trace_replay);
@@ -8,6 +8,7 @@ from dataclasses import replace
 from functools import lru_cache
 from typing import List
 
+from ..manifest import ops_from_manifest
 from ..util import library_path
 
 from .op import CKBatchedGemmOperation
@@ -84,8 +85,7 @@ def parse_instances(str_instances: List[str]) -> List[CKBatchedGemmOperation]:
     return op_instances
 
 
-@lru_cache(None)
-def gen_ops_library() -> List[CKBatchedGemmOperation]:
+def scan_ops_library() -> List[CKBatchedGemmOperation]:
     """
     Parse the Universal Gemm instances defined in the composable kernel library folder.
     """
@@ -145,5 +145,17 @@ def gen_ops_library() -> List[CKBatchedGemmOperation]:
     return substitute_instances
 
 
+@lru_cache(None)
+def gen_ops_library() -> List[CKBatchedGemmOperation]:
+    """
+    Instances from the build-time manifest if one is installed, else scanned from the library sources.
+    """
+    manifest_ops = ops_from_manifest("batched_universal_gemm")
+    if manifest_ops is not None:
+        log.debug("ck instances from manifest: %d", len(manifest_ops))
+        return manifest_ops
+    return scan_ops_library()
+
+
 if __name__ == "__main__":
     print(gen_ops_library())
@@ -8,6 +8,7 @@ from dataclasses import replace
 from functools import lru_cache
 from typing import List
 
+from ..manifest import ops_from_manifest
 from ..util import library_path
 
 from .op import CKGroupedConvFwdOp
@@ -91,8 +92,7 @@ def parse_instances(str_instances: List[str]) -> List[CKGroupedConvFwdOp]:
     return op_instances
 
 
-@lru_cache(None)
-def gen_conv_ops_library() -> List[CKGroupedConvFwdOp]:
+def scan_conv_ops_library() -> List[CKGroupedConvFwdOp]:
     """
     Parse the Grouped Convolution Forward instances
     defined in the Composable Kernel library folder.
@@ -161,5 +161,17 @@ def gen_conv_ops_library() -> List[CKGroupedConvFwdOp]:
     return substitute_instances
 
 
+@lru_cache(None)
+def gen_conv_ops_library() -> List[CKGroupedConvFwdOp]:
+    """
+    Instances from the build-time manifest if one is installed, else scanned from the library sources.
+    """
+    manifest_ops = ops_from_manifest("grouped_conv_fwd")
+    if manifest_ops is not None:
+        log.debug("ck instances from manifest: %d", len(manifest_ops))
+        return manifest_ops
+    return scan_conv_ops_library()
+
+
 if __name__ == "__main__":
     print(gen_conv_ops_library())
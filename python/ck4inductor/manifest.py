@@ -0,0 +1,477 @@
+# SPDX-License-Identifier: MIT
+# Copyright (c) 2018-2025, Advanced Micro Devices, Inc. All rights reserved.
+
+"""
+Machine-readable manifest of the CK template instances used by ck4inductor.
+
+The manifest is emitted once at build time, into the package by the Python build (see
+setup.py) and next to the C++ install by the `ck4inductor_manifest` CMake target. It
+records, for every instance, its template parameters together with the constraints
+checked by the device operation's `IsSupportedArgument`. At compile time inductor loads
+the manifest, drops the instances which cannot run the problem and only autotunes a short,
+pre-ranked list instead of every instance found in the library sources.
+"""
+
+import argparse
+import json
+import logging
+import math
+import os
+from dataclasses import asdict, dataclass, fields
+from functools import lru_cache
+from typing import Dict, List, Mapping, Optional, Sequence, Tuple, Union
+
+from .util import library_path
+
+log = logging.getLogger(__name__)
+
+MANIFEST_VERSION = 1
+MANIFEST_FILENAME = "ck4inductor_instances_manifest.json"
+
+# families known to the manifest: package, instance dataclass and the function scanning
+# the library sources for its instances
+FAMILIES = {
+    "universal_gemm": ("universal_gemm", "CKGemmOperation", "scan_ops_library"),
+    "batched_universal_gemm": (
+        "batched_universal_gemm",
+        "CKBatchedGemmOperation",
+        "scan_ops_library",
+    ),
+    "grouped_conv_fwd": (
+        "grouped_conv_fwd",
+        "CKGroupedConvFwdOp",
+        "scan_conv_ops_library",
+    ),
+}
+
+
+@dataclass
+class GemmProblem:
+    """
+    GEMM problem description used to filter and rank manifest entries.
+
+    Alignments are in elements and describe the leading dimension / base pointer of the
+    corresponding tensor; `None` means only the problem sizes are checked.
+    """
+
+    M: int
+    N: int
+    K: int
+    a_layout: str = "Row"
+    b_layout: str = "Col"
+    c_layout: str = "Row"
+    a_alignment: Optional[int] = None
+    b_alignment: Optional[int] = None
+    c_alignment: Optional[int] = None
+    k_batch: int = 1
+
+
+@dataclass
+class ConvProblem:
+    """
+    Grouped convolution forward problem description used to filter and rank manifest
+    entries. Spatial parameters are given per spatial dimension; empty strides, dilations
+    and pads mean 1, 1 and 0.
+    """
+
+    G: int
+    N: int
+    K: int
+    C: int
+    input_spatial: Tuple[int, ...]
+    filter_spatial: Tuple[int, ...]
+    strides: Tuple[int, ...] = ()
+    dilations: Tuple[int, ...] = ()
+    left_pads: Tuple[int, ...] = ()
+    right_pads: Tuple[int, ...] = ()
+    a_layout: str = "NHWGC"
+    b_layout: str = "GKYXC"
+    e_layout: str = "NHWGK"
+    c_alignment: Optional[int] = None
+    k_alignment: Optional[int] = None
+
+    @property
+    def n_dim_spatial(self) -> int:
+        return len(self.input_spatial)
+
+    def _per_dim(self, values: Tuple[int, ...], default: int) -> Tuple[int, ...]:
+        return tuple(values) if values else (default,) * self.n_dim_spatial
+
+    def output_spatial(self) -> Tuple[int, ...]:
+        return tuple(
+            (x + lp + rp - d * (y - 1) - 1) // s + 1
+            for x, y, s, d, lp, rp in zip(
+                self.input_spatial,
+                self.filter_spatial,
+                self._per_dim(self.strides, 1),
+                self._per_dim(self.dilations, 1),
+                self._per_dim(self.left_pads, 0),
+                self._per_dim(self.right_pads, 0),
+            )
+        )
+
+    def is_filter1x1_pad0(self) -> bool:
+        return all(y == 1 for y in self.filter_spatial) and all(
+            p == 0
+            for p in self._per_dim(self.left_pads, 0) + self._per_dim(self.right_pads, 0)
+        )
+
+    def is_filter1x1_stride1_pad0(self) -> bool:
+        return self.is_filter1x1_pad0() and all(
+            s == 1 for s in self._per_dim(self.strides, 1)
+        )
+
+    def gemm_problem(self) -> GemmProblem:
+        """
+        Implicit GEMM of one group: M over the output pixels, N over K, K over the filter
+        window and C
+        """
+        return GemmProblem(
+            M=self.N * math.prod(self.output_spatial()),
+            N=self.K,
+            K=self.C * math.prod(self.filter_spatial),
+        )
+
+
+Problem = Union[GemmProblem, ConvProblem]
+
+
+def _op_class(family: str):
+    module_name, class_name, _ = FAMILIES[family]
+    module = __import__(f"ck4inductor.{module_name}.op", fromlist=[class_name])
+    return getattr(module, class_name)
+
+
+def _gen_library(family: str):
+    module_name, _, gen_name = FAMILIES[family]
+    module = __import__(
+        f"ck4inductor.{module_name}.gen_instances", fromlist=[gen_name]
+    )
+    return getattr(module, gen_name)
+
+
+def _scalar(value):
+    # some instance families spell scalar parameters as a one element sequence, e.g. S<8>
+    if isinstance(value, (tuple, list)):
+        return int(value[0]) if len(value) > 0 else 1
+    return value
+
+
+def _padded_dims(gemm_specialization: str) -> str:
+    spec = gemm_specialization.split("::")[-1]
+    if spec == "Default":
+        return ""
+    return spec.replace("Padding", "")
+
+
+def gemm_constraints(op) -> Dict[str, object]:
+    """
+    Constraints mirrored from GridwiseGemm_xdl_cshuffle_v3::CheckValidity
+    """
+    padded = _padded_dims(op.gemm_specialization)
+    c_vector = _scalar(
+        getattr(
+            op,
+            "c_shuffle_block_transfer_scalar_per_vector_n_per_block",
+            getattr(op, "cde_block_transfer_scalar_per_vector_n_per_block", 1),
+        )
+    )
+    # the contiguous dimension of each operand determines what the vector width must divide
+    a_contiguous = "K" if op.a_layout == "Row" else "M"
+    b_contiguous = "N" if op.b_layout == "Row" else "K"
+    c_contiguous = "N" if op.c_layout == "Row" else "M"
+    return {
+        "m_divisible_by": 1 if "M" in padded else op.m_per_block,
+        "n_divisible_by": 1 if "N" in padded else op.n_per_block,
+        "k_divisible_by": 1 if "K" in padded else op.k_per_block,
+        "a_vector": {"dim": a_contiguous, "width": _scalar(op.a_block_transfer_src_scalar_per_vector)},
+        "b_vector": {"dim": b_contiguous, "width": _scalar(op.b_block_transfer_src_scalar_per_vector)},
+        "c_vector": {"dim": c_contiguous, "width": c_vector},
+    }
+
+
+def conv_constraints(op) -> Dict[str, object]:
+    """
+    Grouped conv fwd instances vectorize along C (A and B) and K (E), their implicit GEMM
+    has the tile constraints of a universal GEMM
+    """
+    padded = _padded_dims(op.gemm_specialization)
+    return {
+        "conv_forward_specialization": op.conv_forward_specialization,
+        "c_divisible_by": _scalar(op.a_block_transfer_src_scalar_per_vector),
+        "k_divisible_by": _scalar(op.cde_block_transfer_scalar_per_vector_n_per_block),
+        "gemm_m_divisible_by": 1 if "M" in padded else op.m_per_block,
+        "gemm_n_divisible_by": 1 if "N" in padded else op.n_per_block,
+        "gemm_k_divisible_by": 1 if "K" in padded else op.k_per_block,
+    }
+
+
+def _entry(family: str, op) -> Dict[str, object]:
+    constraints = (
+        conv_constraints(op) if family == "grouped_conv_fwd" else gemm_constraints(op)
+    )
+    return {
+        "family": family,
+        "name": op.name(),
+        "params": asdict(op),
+        "constraints": constraints,
+    }
+
+
+def build_manifest(
+    families: Sequence[str] = tuple(FAMILIES),
+    instances: Optional[Mapping[str, Sequence[object]]] = None,
+) -> Dict[str, object]:
+    """
+    Collect the instances of the given families into a JSON serializable manifest.
+    `instances` maps families to the instances to record instead of the ones scanned
+    from the library sources.
+    """
+    entries = []
+    for family in families:
+        if instances is not None and family in instances:
+            ops = instances[family]
+        else:
+            ops = _gen_library(family)()
+        log.debug("manifest: %d %s instances", len(ops), family)
+        entries.extend(_entry(family, op) for op in ops)
+    return {"version": MANIFEST_VERSION, "instances": entries}
+
+
+def write_manifest(
+    path: str,
+    families: Sequence[str] = tuple(FAMILIES),
+    instances: Optional[Mapping[str, Sequence[object]]] = None,
+) -> None:
+    manifest = build_manifest(families, instances)
+    os.makedirs(os.path.dirname(os.path.abspath(path)), exist_ok=True)
+    with open(path, "w") as f:
+        json.dump(manifest, f, indent=1, sort_keys=True)
+
+
+def default_manifest_path() -> str:
+    return os.environ.get(
+        "CK4INDUCTOR_MANIFEST", os.path.join(library_path(), MANIFEST_FILENAME)
+    )
+
+
+def _from_params(family: str, params: Dict[str, object]):
+    op_class = _op_class(family)
+    kwargs = {}
+    for field in fields(op_class):
+        if field.name not in params:
+            continue
+        value = params[field.name]
+        # json turns tuples into lists
+        kwargs[field.name] = tuple(value) if isinstance(value, list) else value
+    return op_class(**kwargs)
+
+
+@dataclass
+class ManifestEntry:
+    family: str
+    op: object
+    constraints: Dict[str, object]
+
+
+@lru_cache(None)
+def load_manifest(path: Optional[str] = None) -> Optional[List[ManifestEntry]]:
+    """
+    Load the manifest; returns None if it does not exist or has an unknown version,
+    in which case callers should fall back to parsing the library sources
+    """
+    path = path or default_manifest_path()
+    if not os.path.exists(path):
+        log.debug("CK instance manifest %s does not exist", path)
+        return None
+    with open(path) as f:
+        manifest = json.load(f)
+    if manifest.get("version") != MANIFEST_VERSION:
+        log.warning(
+            "CK instance manifest %s has version %s, expected %d",
+            path,
+            manifest.get("version"),
+            MANIFEST_VERSION,
+        )
+        return None
+    return [
+        ManifestEntry(e["family"], _from_params(e["family"], e["params"]), e["constraints"])
+        for e in manifest["instances"]
+    ]
+
+
+def ops_from_manifest(family: str, path: Optional[str] = None) -> Optional[List[object]]:
+    entries = load_manifest(path)
+    if entries is None:
+        return None
+    return [e.op for e in entries if e.family == family]
+
+
+def _vector_ok(vector, problem: GemmProblem, alignment: Optional[int]) -> bool:
+    width = vector["width"]
+    extent = {"M": problem.M, "N": problem.N, "K": problem.K}[vector["dim"]]
+    if extent % width != 0:
+        return False
+    return alignment is None or alignment % width == 0
+
+
+def _is_gemm_supported(entry: ManifestEntry, problem: GemmProblem) -> bool:
+    op = entry.op
+    if (op.a_layout, op.b_layout, op.c_layout) != (
+        problem.a_layout,
+        problem.b_layout,
+        problem.c_layout,
+    ):
+        return False
+    c = entry.constraints
+    if problem.M % c["m_divisible_by"] != 0 or problem.N % c["n_divisible_by"] != 0:
+        return False
+    if problem.K % (c["k_divisible_by"] * problem.k_batch) != 0 and c["k_divisible_by"] > 1:
+        return False
+    return (
+        _vector_ok(c["a_vector"], problem, problem.a_alignment)
+        and _vector_ok(c["b_vector"], problem, problem.b_alignment)
+        and _vector_ok(c["c_vector"], problem, problem.c_alignment)
+    )
+
+
+def _is_conv_supported(entry: ManifestEntry, problem: ConvProblem) -> bool:
+    op = entry.op
+    if op.n_dim_spatial != problem.n_dim_spatial or (
+        op.a_layout,
+        op.b_layout,
+        op.e_layout,
+    ) != (problem.a_layout, problem.b_layout, problem.e_layout):
+        return False
+    c = entry.constraints
+    spec = c["conv_forward_specialization"].split("::")[-1]
+    if spec == "Filter1x1Pad0" and not problem.is_filter1x1_pad0():
+        return False
+    if spec == "Filter1x1Stride1Pad0" and not problem.is_filter1x1_stride1_pad0():
+        return False
+    # A and B are read along C, E is written along K
+    for extent, alignment, width in (
+        (problem.C, problem.c_alignment, c["c_divisible_by"]),
+        (problem.K, problem.k_alignment, c["k_divisible_by"]),
+    ):
+        if extent % width != 0 or (alignment is not None and alignment % width != 0):
+            return False
+    gemm = problem.gemm_problem()
+    return (
+        gemm.M % c.get("gemm_m_divisible_by", 1) == 0
+        and gemm.N % c.get("gemm_n_divisible_by", 1) == 0
+        and gemm.K % c.get("gemm_k_divisible_by", 1) == 0
+    )
+
+
+def is_supported(entry: ManifestEntry, problem: Problem) -> bool:
+    """
+    Host side equivalent of IsSupportedArgument for the recorded constraints
+    """
+    if isinstance(problem, ConvProblem):
+        return entry.family == "grouped_conv_fwd" and _is_conv_supported(entry, problem)
+    return entry.family != "grouped_conv_fwd" and _is_gemm_supported(entry, problem)
+
+
+def _default_family(problem: Problem) -> str:
+    return "grouped_conv_fwd" if isinstance(problem, ConvProblem) else "universal_gemm"
+
+
+def filter_instances(
+    entries: Sequence[ManifestEntry],
+    problem: Problem,
+    family: Optional[str] = None,
+) -> List[ManifestEntry]:
+    """
+    Entries of `family` (by default the universal GEMMs for a GemmProblem and the grouped
+    conv fwd instances for a ConvProblem) which can run `problem`
+    """
+    family = family or _default_family(problem)
+    return [e for e in entries if e.family == family and is_supported(e, problem)]
+
+
+def estimate_cost(op, problem: GemmProblem, num_cu: int, machine_balance: float) -> float:
+    """
+    Relative run time of `op` on `problem`: number of workgroup waves over the CUs times
+    the time of one tile, which is bound either by its MFMA work or by loading its A/B
+    slices. `machine_balance` is the flop per byte ratio of a CU (with typical L2 reuse).
+    Padding waste in M/N/K is paid for in full.
+    """
+    m_tiles = math.ceil(problem.M / op.m_per_block)
+    n_tiles = math.ceil(problem.N / op.n_per_block)
+    k_padded = math.ceil(problem.K / (op.k_per_block * problem.k_batch)) * op.k_per_block
+    waves = math.ceil(m_tiles * n_tiles * problem.k_batch / num_cu)
+    # per unit of K: 2*M*N flops against (M+N) elements, the factor 2 cancels with fp16 bytes
+    tile_flops = op.m_per_block * op.n_per_block
+    tile_bytes = op.m_per_block + op.n_per_block
+    return waves * k_padded * max(tile_flops, machine_balance * tile_bytes)
+
+
+def rank_instances(
+    entries: Sequence[ManifestEntry],
+    problem: Problem,
+    num_cu: int = 304,
+    limit: Optional[int] = None,
+    machine_balance: float = 32.0,
+) -> List[ManifestEntry]:
+    """
+    Order supported entries by estimated cost; ties go to larger tiles and to
+    instances without padding. Convolutions are ranked on the implicit GEMM of all
+    their groups.
+    """
+    if isinstance(problem, ConvProblem):
+        gemm = problem.gemm_problem()
+        # the groups add workgroups along M
+        gemm_problem = GemmProblem(M=gemm.M * problem.G, N=gemm.N, K=gemm.K)
+    else:
+        gemm_problem = problem
+
+    def score(entry):
+        op = entry.op
+        return (
+            estimate_cost(op, gemm_problem, num_cu, machine_balance),
+            -(op.m_per_block * op.n_per_block),
+            _padded_dims(op.gemm_specialization) != "",
+            op.name(),
+        )
+
+    ranked = sorted(entries, key=score)
+    return ranked if limit is None else ranked[:limit]
+
+
+def preselect(
+    problem: Problem,
+    family: Optional[str] = None,
+    limit: int = 16,
+    num_cu: int = 304,
+    path: Optional[str] = None,
+) -> Optional[List[object]]:
+    """
+    Short list of instances to autotune for `problem`, or None if there is no manifest
+    """
+    entries = load_manifest(path)
+    if entries is None:
+        return None
+    candidates = filter_instances(entries, problem, family)
+    return [e.op for e in rank_instances(candidates, problem, num_cu, limit)]
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Emit the ck4inductor instance manifest")
+    parser.add_argument("--output", required=True, help="manifest json file to write")
+    parser.add_argument(
+        "--library-path",
+        help="CK library directory to scan instead of the installed package",
+    )
+    parser.add_argument(
+        "--families", nargs="*", default=list(FAMILIES), choices=list(FAMILIES)
+    )
+    args = parser.parse_args()
+    if args.library_path:
+        os.environ["CK4INDUCTOR_LIBRARY_PATH"] = args.library_path
+        library_path.cache_clear()
+    write_manifest(args.output, args.families)
+
+
+if __name__ == "__main__":
+    main()
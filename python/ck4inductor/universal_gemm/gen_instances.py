@@ -8,6 +8,7 @@ from dataclasses import replace
 from functools import lru_cache, partial
 from typing import List
 
+from ..manifest import ops_from_manifest
 from ..util import library_path
 
 from .op import CKGemmOperation
@@ -137,8 +138,7 @@ def default_instances() -> List[CKGemmOperation]:
     ]
 
 
-@lru_cache(None)
-def gen_ops_library() -> List[CKGemmOperation]:
+def scan_ops_library() -> List[CKGemmOperation]:
     """
     Parse the Universal Gemm instances defined in the composable kernel library folder.
     """
@@ -568,5 +568,17 @@ def gen_ops_preselected() -> List[CKGemmOperation]:
     ]
 
 
+@lru_cache(None)
+def gen_ops_library() -> List[CKGemmOperation]:
+    """
+    Instances from the build-time manifest if one is installed, else scanned from the library sources.
+    """
+    manifest_ops = ops_from_manifest("universal_gemm")
+    if manifest_ops is not None:
+        log.debug("ck instances from manifest: %d", len(manifest_ops))
+        return manifest_ops
+    return scan_ops_library()
+
+
 if __name__ == "__main__":
     print(gen_ops_library())
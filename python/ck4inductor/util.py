@@ -7,4 +7,7 @@ import os
 
 @functools.lru_cache(None)
 def library_path():
+    # overridden when scanning a source tree, e.g. while emitting the instance manifest
+    if "CK4INDUCTOR_LIBRARY_PATH" in os.environ:
+        return os.environ["CK4INDUCTOR_LIBRARY_PATH"]
     return os.path.join(os.path.dirname(__file__), "library")
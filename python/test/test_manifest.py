@@ -0,0 +1,194 @@
+# SPDX-License-Identifier: MIT
+# Copyright (c) 2018-2025, Advanced Micro Devices, Inc. All rights reserved.
+import os
+import tempfile
+import unittest
+
+from ck4inductor.grouped_conv_fwd.gen_instances import scan_conv_ops_library
+from ck4inductor.manifest import (
+    ConvProblem,
+    GemmProblem,
+    build_manifest,
+    filter_instances,
+    load_manifest,
+    rank_instances,
+    write_manifest,
+)
+from ck4inductor.universal_gemm.gen_instances import gen_ops_preselected
+
+
+class TestManifest(unittest.TestCase):
+    def setUp(self):
+        # the preselected instances do not need the library sources
+        fd, self.path = tempfile.mkstemp(suffix=".json")
+        os.close(fd)
+        write_manifest(
+            self.path,
+            families=["universal_gemm"],
+            instances={"universal_gemm": gen_ops_preselected()},
+        )
+
+    def tearDown(self):
+        os.remove(self.path)
+
+    def test_round_trip(self):
+        entries = load_manifest(self.path)
+        self.assertEqual(
+            [e.op for e in entries],
+            list(gen_ops_preselected()),
+        )
+
+    def test_filter_by_shape(self):
+        entries = load_manifest(self.path)
+        # not a multiple of any tile, only padding instances remain
+        problem = GemmProblem(M=1000, N=1000, K=1000)
+        supported = filter_instances(entries, problem)
+        self.assertTrue(supported)
+        for e in supported:
+            self.assertNotEqual(e.op.gemm_specialization, "GemmSpecialization::Default")
+
+    def test_filter_by_alignment(self):
+        entries = load_manifest(self.path)
+        # K is the contiguous dimension of row-major A, vector loads of 8 need K % 8 == 0
+        self.assertFalse(filter_instances(entries, GemmProblem(M=256, N=256, K=1001)))
+        self.assertFalse(
+            filter_instances(entries, GemmProblem(M=256, N=256, K=1024, a_alignment=4))
+        )
+        self.assertTrue(
+            filter_instances(entries, GemmProblem(M=256, N=256, K=1024, a_alignment=8))
+        )
+
+    def test_layout_mismatch(self):
+        entries = load_manifest(self.path)
+        problem = GemmProblem(M=256, N=256, K=256, b_layout="Row")
+        self.assertFalse(filter_instances(entries, problem))
+
+    def test_rank_small_m(self):
+        entries = load_manifest(self.path)
+        problem = GemmProblem(M=16, N=4096, K=4096)
+        ranked = rank_instances(filter_instances(entries, problem), problem, limit=4)
+        self.assertEqual(len(ranked), 4)
+        # tiles taller than the problem waste most of the work
+        self.assertLessEqual(ranked[0].op.m_per_block, 32)
+
+    def test_build_manifest_without_library(self):
+        # families without sources simply contribute no instances
+        manifest = build_manifest(families=())
+        self.assertEqual(manifest["instances"], [])
+
+
+class TestConvManifest(unittest.TestCase):
+    def setUp(self):
+        ops = scan_conv_ops_library()
+        if not ops:
+            self.skipTest("no grouped conv fwd instances in the library sources")
+        fd, self.path = tempfile.mkstemp(suffix=".json")
+        os.close(fd)
+        write_manifest(
+            self.path,
+            families=["grouped_conv_fwd"],
+            instances={"grouped_conv_fwd": ops},
+        )
+        self.entries = load_manifest(self.path)
+
+    def tearDown(self):
+        os.remove(self.path)
+
+    def test_filter_by_specialization(self):
+        # 3x3 filter: no 1x1 specialization applies
+        problem = ConvProblem(
+            G=1,
+            N=8,
+            K=64,
+            C=64,
+            input_spatial=(28, 28),
+            filter_spatial=(3, 3),
+            left_pads=(1, 1),
+            right_pads=(1, 1),
+        )
+        supported = filter_instances(self.entries, problem)
+        self.assertTrue(supported)
+        for e in supported:
+            self.assertNotIn("Filter1x1", e.op.conv_forward_specialization)
+
+        # strided 1x1: the stride 1 specialization does not apply, the other one does
+        problem = ConvProblem(
+            G=1,
+            N=8,
+            K=64,
+            C=64,
+            input_spatial=(28, 28),
+            filter_spatial=(1, 1),
+            strides=(2, 2),
+        )
+        specs = {
+            e.op.conv_forward_specialization
+            for e in filter_instances(self.entries, problem)
+        }
+        self.assertIn("ConvolutionForwardSpecialization::Filter1x1Pad0", specs)
+        self.assertNotIn(
+            "ConvolutionForwardSpecialization::Filter1x1Stride1Pad0", specs
+        )
+
+    def test_filter_by_layout_and_alignment(self):
+        problem = ConvProblem(
+            G=1, N=8, K=64, C=3, input_spatial=(28, 28), filter_spatial=(3, 3)
+        )
+        for e in filter_instances(self.entries, problem):
+            self.assertEqual(3 % e.constraints["c_divisible_by"], 0)
+
+        problem = ConvProblem(
+            G=1,
+            N=8,
+            K=64,
+            C=64,
+            input_spatial=(28, 28),
+            filter_spatial=(3, 3),
+            a_layout="NGCHW",
+            e_layout="NGKHW",
+        )
+        for e in filter_instances(self.entries, problem):
+            self.assertEqual(e.op.a_layout, "NGCHW")
+
+        # 3d problems have no 2d instance
+        problem = ConvProblem(
+            G=1,
+            N=8,
+            K=64,
+            C=64,
+            input_spatial=(8, 28, 28),
+            filter_spatial=(3, 3, 3),
+            a_layout="NDHWGC",
+            b_layout="GKZYXC",
+            e_layout="NDHWGK",
+        )
+        self.assertFalse(filter_instances(self.entries, problem))
+
+    def test_gemm_problem_is_not_a_conv(self):
+        problem = GemmProblem(M=256, N=256, K=256)
+        self.assertFalse(filter_instances(self.entries, problem, "grouped_conv_fwd"))
+
+    def test_rank(self):
+        problem = ConvProblem(
+            G=1,
+            N=1,
+            K=64,
+            C=64,
+            input_spatial=(7, 7),
+            filter_spatial=(3, 3),
+            left_pads=(1, 1),
+            right_pads=(1, 1),
+        )
+        self.assertEqual(problem.output_spatial(), (7, 7))
+        self.assertEqual(problem.gemm_problem().M, 49)
+        self.assertEqual(problem.gemm_problem().K, 576)
+
+        ranked = rank_instances(
+            filter_instances(self.entries, problem), problem, limit=4
+        )
+        self.assertTrue(ranked)
+        # 49 output pixels: the smallest M tile wastes the least
+        self.assertEqual(
+            ranked[0].op.m_per_block,
+            min(e.op.m_per_block for e in filter_instances(self.entries, problem)),
+        )
@@ -0,0 +1,43 @@
+# SPDX-License-Identifier: MIT
+# Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+
+import os
+import subprocess
+import sys
+
+from setuptools import setup
+from setuptools.command.build_py import build_py
+
+ROOT = os.path.dirname(os.path.abspath(__file__))
+
+
+class BuildPyWithManifest(build_py):
+    """
+    Generate the ck4inductor instance manifest into the built package, next to the
+    library sources it describes, where ck4inductor.manifest looks for it
+    """
+
+    def run(self):
+        super().run()
+        output = os.path.join(
+            self.build_lib,
+            "ck4inductor",
+            "library",
+            "ck4inductor_instances_manifest.json",
+        )
+        env = dict(os.environ, PYTHONPATH=os.path.join(ROOT, "python"))
+        subprocess.check_call(
+            [
+                sys.executable,
+                "-m",
+                "ck4inductor.manifest",
+                "--library-path",
+                os.path.join(ROOT, "library"),
+                "--output",
+                output,
+            ],
+            env=env,
+        )
+
+
+setup(cmdclass={"build_py": BuildPyWithManifest})
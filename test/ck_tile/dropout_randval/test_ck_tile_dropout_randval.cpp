@@ -0,0 +1,92 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <cstdint>
+#include <cstring>
+#include <tuple>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "ck_tile/core.hpp"
+#include "ck_tile/host.hpp"
+#include "ck_tile/ops/fmha.hpp"
+
+using ck_tile::index_t;
+
+// the host regenerates the tiles the kernel draws
+static_assert(ck_tile::detail::kDropoutTileM == ck_tile::BlockDropout::kRandValTileM &&
+              ck_tile::detail::kDropoutTileN == ck_tile::BlockDropout::kRandValTileN);
+
+TEST(CkTileDropoutRandval, PhiloxKnownAnswer)
+{
+    // the Random123 known answer of philox4x32 with 7 rounds, zero counter and key
+    const ck_tile::philox ph(0, 0);
+
+    uint8_t bytes[16];
+    ph.get_random_16x8(bytes, 0);
+
+    uint32_t words[4];
+    std::memcpy(words, bytes, sizeof(words));
+
+    EXPECT_EQ(words[0], 0x5f6fb709u);
+    EXPECT_EQ(words[1], 0x0d893f64u);
+    EXPECT_EQ(words[2], 0x4f121f81u);
+    EXPECT_EQ(words[3], 0x4f730a48u);
+}
+
+TEST(CkTileDropoutRandval, KnownValues)
+{
+    constexpr unsigned long long seed   = 0x0123456789abcdefull;
+    constexpr unsigned long long offset = 1000;
+    constexpr index_t nhead             = 3;
+
+    // seqlen_q and seqlen_k are not multiples of the 32x32 tiles
+    ck_tile::HostTensor<uint8_t> randval_b0({nhead, 40, 70});
+    ck_tile::HostTensor<uint8_t> randval_b1({nhead, 40, 70});
+    ck_tile::reference_batched_dropout_randval(randval_b0, 0, nhead, seed, offset);
+    ck_tile::reference_batched_dropout_randval(randval_b1, 1, nhead, seed, offset);
+
+    // (batch, head, m, n, value), computed with an independent philox checked against the
+    // Random123 known answers, and the lane/byte mapping of the 32x32 SwizzleA C layout
+    const std::vector<std::tuple<index_t, index_t, index_t, index_t, int>> expected{
+        {1, 0, 0, 0, 73},      // lane 0, byte 0
+        {1, 0, 0, 1, 0},       // lane 1, byte 0
+        {1, 0, 8, 0, 141},     // lane 32, byte 0
+        {1, 0, 16, 0, 130},    // lane 0, byte 8
+        {1, 0, 31, 31, 90},    // lane 63, byte 15
+        {1, 2, 33, 40, 158},   // tile (1, 1)
+        {1, 1, 39, 69, 188},   // tile (1, 2), last element
+        {0, 2, 17, 64, 75}};   // other batch
+
+    for(const auto& [b, h, m, n, value] : expected)
+    {
+        const auto& randval = b == 0 ? randval_b0 : randval_b1;
+        EXPECT_EQ(randval(h, m, n), value) << "batch " << b << " head " << h << " m " << m
+                                           << " n " << n;
+    }
+}
+
+TEST(CkTileDropoutRandval, DropoutFollowsRandval)
+{
+    constexpr unsigned long long seed   = 7;
+    constexpr unsigned long long offset = 11;
+    constexpr index_t nhead = 2, seqlen_q = 50, seqlen_k = 77;
+
+    ck_tile::HostTensor<uint8_t> randval({nhead, seqlen_q, seqlen_k});
+    ck_tile::reference_batched_dropout_randval(randval, 1, nhead, seed, offset);
+
+    ck_tile::HostTensor<float> p({nhead, seqlen_q, seqlen_k});
+    for(index_t h = 0; h < nhead; ++h)
+        for(index_t m = 0; m < seqlen_q; ++m)
+            for(index_t n = 0; n < seqlen_k; ++n)
+                p(h, m, n) = 1.f;
+
+    const uint8_t p_undrop_in_uint8_t = 204;
+    ck_tile::reference_batched_dropout(p, 1, nhead, seed, offset, p_undrop_in_uint8_t, 1.25f);
+
+    for(index_t h = 0; h < nhead; ++h)
+        for(index_t m = 0; m < seqlen_q; ++m)
+            for(index_t n = 0; n < seqlen_k; ++n)
+                ASSERT_EQ(p(h, m, n), randval(h, m, n) <= p_undrop_in_uint8_t ? 1.25f : 0.f);
+}
@@ -0,0 +1,168 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "ck_tile/core.hpp"
+#include "ck_tile/host.hpp"
+#include "ck_tile/ops/elementwise.hpp"
+
+using ck_tile::index_t;
+
+namespace {
+
+struct FusedMoeProblem
+{
+    index_t tokens;
+    index_t experts;
+    index_t topk;
+    index_t hidden_size;
+    index_t intermediate_size; // of gate/up
+    index_t block_m;
+    index_t gate_only;
+};
+
+template <typename T>
+void FillUniform(ck_tile::HostTensor<T>& t, std::mt19937& gen)
+{
+    std::uniform_real_distribution<float> dist(-.5f, .5f);
+    for(auto& v : t.mData)
+        v = ck_tile::type_convert<T>(dist(gen));
+}
+
+template <typename Activation>
+void TestGroupedMatchesPerToken(const FusedMoeProblem& p)
+{
+    using DataType   = float;
+    using IndexType  = index_t;
+    using WeightType = float;
+
+    const index_t intermediate_size_1 = p.intermediate_size / (p.gate_only ? 1 : 2);
+
+    ck_tile::HostTensor<DataType> a({p.tokens, p.hidden_size});
+    ck_tile::HostTensor<DataType> g({p.experts, p.intermediate_size, p.hidden_size});
+    ck_tile::HostTensor<DataType> d({p.experts, p.hidden_size, intermediate_size_1});
+    ck_tile::HostTensor<DataType> sa({p.tokens});
+    ck_tile::HostTensor<DataType> sg({p.intermediate_size});
+    ck_tile::HostTensor<DataType> sd({intermediate_size_1});
+    ck_tile::HostTensor<DataType> sy({intermediate_size_1});
+    ck_tile::HostTensor<IndexType> topk_ids({p.tokens, p.topk});
+    ck_tile::HostTensor<WeightType> topk_weight({p.tokens, p.topk});
+
+    std::mt19937 gen(p.tokens * 131 + p.experts);
+    FillUniform(a, gen);
+    FillUniform(g, gen);
+    FillUniform(d, gen);
+    FillUniform(topk_weight, gen);
+
+    // topk distinct experts per token
+    std::vector<IndexType> experts(p.experts);
+    for(index_t t = 0; t < p.tokens; t++)
+    {
+        std::iota(experts.begin(), experts.end(), 0);
+        std::shuffle(experts.begin(), experts.end(), gen);
+        for(index_t k = 0; k < p.topk; k++)
+            topk_ids(t, k) = experts[k];
+    }
+
+    const index_t max_num_tokens_padded = p.topk * p.tokens + p.experts * p.block_m - p.topk;
+    ck_tile::HostTensor<IndexType> sorted_token_ids({max_num_tokens_padded});
+    ck_tile::HostTensor<WeightType> sorted_weight({max_num_tokens_padded});
+    ck_tile::HostTensor<IndexType> sorted_expert_ids(
+        {(max_num_tokens_padded + p.block_m - 1) / p.block_m});
+    ck_tile::HostTensor<IndexType> num_sorted_tiles({1});
+
+    ck_tile::reference_moe_sorting<WeightType, IndexType>(topk_ids,
+                                                          topk_weight,
+                                                          sorted_token_ids,
+                                                          sorted_weight,
+                                                          sorted_expert_ids,
+                                                          num_sorted_tiles.mData[0],
+                                                          p.experts,
+                                                          p.block_m);
+
+    auto run = [&](auto reference) {
+        ck_tile::HostTensor<DataType> o({p.tokens, p.hidden_size});
+        reference(a,
+                  g,
+                  d,
+                  sa,
+                  sg,
+                  sd,
+                  sy,
+                  o,
+                  sorted_token_ids,
+                  sorted_weight,
+                  sorted_expert_ids,
+                  num_sorted_tiles,
+                  topk_ids,
+                  p.block_m,
+                  p.tokens,
+                  p.experts,
+                  p.hidden_size,
+                  p.intermediate_size,
+                  p.topk,
+                  p.gate_only);
+        return o;
+    };
+
+    const auto o_per_token =
+        run(ck_tile::reference_fused_moe_per_token<float,
+                                                   Activation,
+                                                   DataType,
+                                                   DataType,
+                                                   DataType,
+                                                   DataType,
+                                                   DataType,
+                                                   DataType,
+                                                   DataType,
+                                                   DataType,
+                                                   WeightType,
+                                                   IndexType>);
+    const auto o_grouped = run(ck_tile::reference_fused_moe<float,
+                                                            Activation,
+                                                            DataType,
+                                                            DataType,
+                                                            DataType,
+                                                            DataType,
+                                                            DataType,
+                                                            DataType,
+                                                            DataType,
+                                                            DataType,
+                                                            WeightType,
+                                                            IndexType>);
+
+    ASSERT_EQ(o_grouped.mData.size(), o_per_token.mData.size());
+    for(std::size_t i = 0; i < o_grouped.mData.size(); i++)
+    {
+        // bit for bit
+        uint32_t grouped, per_token;
+        std::memcpy(&grouped, &o_grouped.mData[i], sizeof(grouped));
+        std::memcpy(&per_token, &o_per_token.mData[i], sizeof(per_token));
+        ASSERT_EQ(grouped, per_token) << "token " << i / p.hidden_size << " n "
+                                      << i % p.hidden_size;
+    }
+}
+
+} // namespace
+
+TEST(CkTileFusedMoeReference, GroupedMatchesPerToken)
+{
+    using Gelu = ck_tile::element_wise::Gelu;
+
+    // hidden and intermediate sizes not multiples of the column block
+    TestGroupedMatchesPerToken<Gelu>({37, 8, 2, 96, 160, 32, 0});
+    // gate only
+    TestGroupedMatchesPerToken<Gelu>({130, 16, 4, 64, 128, 16, 1});
+    // every token on every expert, each expert split over several row groups
+    TestGroupedMatchesPerToken<Gelu>({300, 3, 3, 72, 96, 32, 0});
+    // few tokens over many experts, most of them without any
+    TestGroupedMatchesPerToken<Gelu>({5, 64, 6, 32, 64, 32, 0});
+}
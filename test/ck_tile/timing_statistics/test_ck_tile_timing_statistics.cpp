@@ -0,0 +1,115 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <cstddef>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "ck_tile/host/timing_statistics.hpp"
+
+using ck_tile::compute_timing_statistics;
+using ck_tile::measure_iterations;
+
+namespace {
+
+// virtual clock, every launch advances it by the next scripted duration
+struct fake_timer
+{
+    double now = 0;
+    std::vector<double> marks;
+
+    void start() { marks.push_back(now); }
+    void stop() { marks.push_back(now); }
+
+    std::vector<float> collect()
+    {
+        std::vector<float> samples;
+        for(std::size_t i = 0; i + 1 < marks.size(); i += 2)
+            samples.push_back(static_cast<float>(marks[i + 1] - marks[i]));
+        marks.clear();
+        return samples;
+    }
+};
+
+struct scripted_kernel
+{
+    fake_timer& timer;
+    std::vector<double> durations;
+    std::size_t launches = 0;
+
+    void operator()() { timer.now += durations[launches++ % durations.size()]; }
+};
+
+} // namespace
+
+TEST(CkTileTimingStatistics, Percentiles)
+{
+    const auto stats = compute_timing_statistics({5, 1, 4, 2, 3});
+
+    EXPECT_FLOAT_EQ(stats.median, 3.f);
+    EXPECT_FLOAT_EQ(stats.min, 1.f);
+    EXPECT_FLOAT_EQ(stats.max, 5.f);
+    EXPECT_FLOAT_EQ(stats.mean, 3.f);
+    EXPECT_FLOAT_EQ(stats.p10, 1.4f);
+    EXPECT_FLOAT_EQ(stats.p90, 4.6f);
+    EXPECT_EQ(stats.num_outliers, 0);
+    // samples are kept in launch order
+    EXPECT_EQ(stats.samples, (std::vector<float>{5, 1, 4, 2, 3}));
+
+    EXPECT_TRUE(compute_timing_statistics({}).samples.empty());
+}
+
+TEST(CkTileTimingStatistics, OutlierDoesNotMoveMedian)
+{
+    std::vector<float> samples(49, 1.f);
+    samples.push_back(100.f); // one preempted launch
+
+    const auto stats = compute_timing_statistics(samples);
+
+    EXPECT_FLOAT_EQ(stats.median, 1.f);
+    EXPECT_EQ(stats.num_outliers, 1);
+    EXPECT_GT(stats.mean, 2.f);
+    EXPECT_GT(stats.cv, 1.f);
+}
+
+TEST(CkTileTimingStatistics, FixedRepetition)
+{
+    fake_timer timer;
+    scripted_kernel kernel{timer, {1.0, 2.0}};
+
+    const auto stats = measure_iterations(timer, kernel, 10);
+
+    EXPECT_EQ(kernel.launches, 10u);
+    EXPECT_EQ(stats.samples.size(), 10u);
+    EXPECT_FLOAT_EQ(stats.median, 1.5f);
+    EXPECT_TRUE(stats.converged);
+}
+
+TEST(CkTileTimingStatistics, Adaptive)
+{
+    // stable launches stop after the first batch
+    fake_timer timer;
+    scripted_kernel stable{timer, {1.0, 1.001, 0.999}};
+    EXPECT_TRUE(measure_iterations(timer, stable, 10, 1000, 0.01f).converged);
+    EXPECT_EQ(stable.launches, 10u);
+
+    // alternating fast and slow ones never narrow the median interval below 1%
+    scripted_kernel noisy{timer, {1.0, 2.0}};
+    const auto noisy_stats = measure_iterations(timer, noisy, 10, 100, 0.01f);
+    EXPECT_FALSE(noisy_stats.converged);
+    EXPECT_EQ(noisy.launches, 100u);
+
+    // a noisy start is outgrown
+    std::vector<double> durations(10, 1.0);
+    for(std::size_t i = 0; i < durations.size(); i += 2)
+        durations[i] = 3.0;
+    durations.resize(1000, 1.0);
+    scripted_kernel settling{timer, durations};
+
+    const auto stats = measure_iterations(timer, settling, 10, 1000, 0.01f);
+    EXPECT_TRUE(stats.converged);
+    EXPECT_GT(settling.launches, 10u);
+    EXPECT_LT(settling.launches, 1000u);
+    EXPECT_FLOAT_EQ(stats.median, 1.f);
+}
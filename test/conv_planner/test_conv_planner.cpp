@@ -0,0 +1,319 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "ck/library/utility/convolution_planner.hpp"
+
+using ck::long_index_t;
+using ck::utils::conv::ConvAlgorithm;
+using ck::utils::conv::ConvDataTypeSize;
+using ck::utils::conv::ConvDirection;
+using ck::utils::conv::ConvParam;
+using ck::utils::conv::ConvPlan;
+
+namespace {
+
+constexpr long_index_t TwoGB = long_index_t{1} << 31;
+
+const ConvDataTypeSize F16{2, 2, 2};
+const ConvDataTypeSize F32{4, 4, 4};
+
+ConvParam MakeConv2d(
+    long_index_t G, long_index_t N, long_index_t K, long_index_t C, long_index_t Y, long_index_t Hi)
+{
+    const long_index_t pad = Y / 2;
+    return ConvParam(long_index_t{2},
+                     G,
+                     N,
+                     K,
+                     C,
+                     {Y, Y},
+                     {Hi, Hi},
+                     {long_index_t{1}, long_index_t{1}},
+                     {long_index_t{1}, long_index_t{1}},
+                     {pad, pad},
+                     {pad, pad});
+}
+
+// regular, grouped, depthwise, huge and odd shapes
+std::vector<ConvParam> Problems()
+{
+    return {MakeConv2d(1, 32, 256, 64, 1, 56),
+            MakeConv2d(1, 4, 64, 64, 3, 56),
+            MakeConv2d(32, 16, 8, 8, 3, 28),
+            MakeConv2d(256, 8, 1, 1, 3, 56),
+            MakeConv2d(96, 3, 1, 1, 5, 17),
+            MakeConv2d(64, 2, 2, 1, 3, 7),
+            MakeConv2d(1, 256, 256, 128, 3, 256),
+            MakeConv2d(1, 7, 64, 64, 3, 2048),
+            MakeConv2d(1, 2, 256, 256, 3, 4096),
+            ConvParam(long_index_t{3},
+                      long_index_t{48},
+                      long_index_t{2},
+                      long_index_t{1},
+                      long_index_t{1},
+                      {3, 3, 3},
+                      {16, 32, 32},
+                      {1, 2, 2},
+                      {1, 1, 1},
+                      {1, 1, 1},
+                      {1, 1, 1})};
+}
+
+long_index_t Product(const std::vector<long_index_t>& v)
+{
+    long_index_t p = 1;
+    for(auto x : v)
+        p *= x;
+    return p;
+}
+
+//
+// The rules of the device ops and their transforms, written out independently of the planner
+//
+void ExpectLegal(const ConvParam& p, const ConvDataTypeSize& type_size, const ConvPlan& plan)
+{
+    const auto& config       = plan.config_;
+    const long_index_t merge = config.num_groups_to_merge_;
+
+    ASSERT_NE(config.algorithm_, ConvAlgorithm::Unknown);
+    ASSERT_GE(merge, 1);
+    EXPECT_EQ(p.G_ % merge, 0);
+    EXPECT_GE(plan.k_batch_, 1);
+    EXPECT_GT(plan.num_tiles_, 0);
+    EXPECT_GT(plan.predicted_ns_, 0);
+
+    const long_index_t in_byte  = p.G_ * p.N_ * p.C_ * Product(p.input_spatial_lengths_) * 2;
+    const long_index_t out_byte = p.G_ * p.N_ * p.K_ * Product(p.output_spatial_lengths_) * 2;
+    const long_index_t in_byte_per_n =
+        in_byte / 2 * static_cast<long_index_t>(type_size.in_) / p.N_;
+    const long_index_t out_byte_per_n =
+        out_byte / 2 * static_cast<long_index_t>(type_size.out_) / p.N_;
+
+    switch(config.algorithm_)
+    {
+    case ConvAlgorithm::FwdXdl:
+        // TransformConvFwdToGemm<..., SplitN = true, ..., NumGroupsToMerge>
+        EXPECT_EQ(p.N_ % plan.n_per_launch_, 0);
+        EXPECT_LE(std::max(in_byte_per_n, out_byte_per_n) * plan.n_per_launch_, TwoGB);
+        EXPECT_TRUE(merge == 1 || p.C_ == 1);
+        EXPECT_EQ(plan.gemm_m_, plan.n_per_launch_ * Product(p.output_spatial_lengths_));
+        EXPECT_EQ(plan.gemm_n_, p.K_ * merge);
+        EXPECT_EQ(plan.gemm_k_, p.C_ * Product(p.filter_spatial_lengths_));
+        EXPECT_EQ(plan.k_batch_, 1);
+        break;
+    case ConvAlgorithm::FwdLargeTensor:
+        EXPECT_EQ(merge, 1);
+        EXPECT_EQ(plan.n_per_launch_, p.N_);
+        EXPECT_EQ(plan.k_batch_, 1);
+        break;
+    case ConvAlgorithm::BwdWeightAtomic:
+    case ConvAlgorithm::BwdWeightTwoStage:
+        // TransformConvBwdWeightToGemmV2<..., NumGroupsToMerge>
+        EXPECT_EQ(plan.gemm_m_, p.K_ * merge);
+        EXPECT_EQ(plan.gemm_n_, p.C_ * Product(p.filter_spatial_lengths_) * merge);
+        EXPECT_EQ(plan.gemm_k_, p.N_ * Product(p.output_spatial_lengths_));
+        EXPECT_LE((plan.k_batch_ - 1) * config.k_per_block_, plan.gemm_k_);
+        if(config.algorithm_ == ConvAlgorithm::BwdWeightAtomic)
+        {
+            EXPECT_EQ(merge, 1);
+            EXPECT_EQ(plan.workspace_byte_, 0);
+        }
+        else
+        {
+            if(merge > 1)
+            {
+                EXPECT_EQ(p.C_, 1);
+                EXPECT_EQ(p.K_, 1);
+                EXPECT_LE(plan.gemm_m_, config.m_per_block_);
+                EXPECT_LE(plan.gemm_n_, config.n_per_block_);
+            }
+            EXPECT_EQ(plan.workspace_byte_,
+                      p.G_ * p.K_ * p.C_ * Product(p.filter_spatial_lengths_) * sizeof(float));
+        }
+        break;
+    case ConvAlgorithm::Unknown: break;
+    }
+}
+
+struct FakeInstance
+{
+    std::string type_string_;
+    std::string GetTypeString() const { return type_string_; }
+};
+
+} // namespace
+
+TEST(ConvPlanner, SplitNMatchesTransform)
+{
+    // under 2GB, no split
+    EXPECT_EQ(ck::utils::conv::get_split_n_size(MakeConv2d(1, 32, 256, 64, 3, 56), F16), 32);
+
+    // 8GB output, least divisor 4
+    const auto big = MakeConv2d(1, 256, 256, 128, 3, 256);
+    EXPECT_EQ(ck::utils::conv::get_split_n_size(big, F16), 64);
+    EXPECT_EQ(ck::utils::conv::get_split_n_size(big, F32), 32);
+
+    // 7 has no divisor up to its square root, one image per launch
+    EXPECT_EQ(ck::utils::conv::get_split_n_size(MakeConv2d(1, 7, 64, 64, 3, 2048), F32), 1);
+
+    // a single image over 2GB cannot be split
+    EXPECT_EQ(ck::utils::conv::get_split_n_size(MakeConv2d(1, 2, 256, 256, 3, 4096), F16), 2);
+}
+
+TEST(ConvPlanner, EveryPlanIsLegal)
+{
+    for(const auto& type_size : {F16, F32})
+    {
+        for(const auto& p : Problems())
+        {
+            for(auto direction : {ConvDirection::Forward, ConvDirection::BackwardWeight})
+            {
+                const auto plans =
+                    ck::utils::conv::enumerate_conv_plans(p, direction, type_size);
+                ASSERT_FALSE(plans.empty());
+
+                for(const auto& plan : plans)
+                {
+                    EXPECT_TRUE(ck::utils::conv::is_conv_plan_legal(p, type_size, plan));
+                    EXPECT_EQ(ck::utils::conv::get_conv_direction(plan.config_.algorithm_),
+                              direction);
+                    ExpectLegal(p, type_size, plan);
+                }
+
+                const auto best = ck::utils::conv::make_conv_plan(p, direction, type_size);
+                ExpectLegal(p, type_size, best);
+                for(const auto& plan : plans)
+                    EXPECT_LE(best.predicted_ns_, plan.predicted_ns_);
+            }
+        }
+    }
+}
+
+TEST(ConvPlanner, IllegalPlansAreRejected)
+{
+    const auto p = MakeConv2d(32, 16, 8, 8, 3, 28);
+    auto plan    = ck::utils::conv::make_conv_plan(p, ConvDirection::Forward, F16);
+    ASSERT_TRUE(ck::utils::conv::is_conv_plan_legal(p, F16, plan));
+
+    // merging groups needs C == 1
+    auto merged                         = plan;
+    merged.config_.num_groups_to_merge_ = 8;
+    merged.gemm_n_                      = p.K_ * 8;
+    EXPECT_FALSE(ck::utils::conv::is_conv_plan_legal(p, F16, merged));
+
+    // N per launch is decided by the transform
+    auto split          = plan;
+    split.n_per_launch_ = 8;
+    split.gemm_m_       = 8 * Product(p.output_spatial_lengths_);
+    EXPECT_FALSE(ck::utils::conv::is_conv_plan_legal(p, F16, split));
+
+    // depthwise with 96 groups, no merging by 64
+    const auto dw = MakeConv2d(96, 3, 1, 1, 5, 17);
+    auto dw_plan  = ck::utils::conv::make_conv_plan(dw, ConvDirection::BackwardWeight, F16);
+    dw_plan.config_.num_groups_to_merge_ = 64;
+    EXPECT_FALSE(ck::utils::conv::is_conv_plan_legal(dw, F16, dw_plan));
+}
+
+TEST(ConvPlanner, Strategies)
+{
+    // regular convolution, no group merging
+    const auto regular = ck::utils::conv::make_conv_plan<float, float, float>(
+        MakeConv2d(1, 32, 256, 64, 3, 56), ConvDirection::Forward);
+    EXPECT_EQ(regular.config_.algorithm_, ConvAlgorithm::FwdXdl);
+    EXPECT_EQ(regular.config_.num_groups_to_merge_, 1);
+
+    // depthwise, groups are merged in both directions
+    const auto dw     = MakeConv2d(256, 8, 1, 1, 3, 56);
+    const auto dw_fwd = ck::utils::conv::make_conv_plan(dw, ConvDirection::Forward, F16);
+    EXPECT_EQ(dw_fwd.config_.algorithm_, ConvAlgorithm::FwdXdl);
+    EXPECT_GT(dw_fwd.config_.num_groups_to_merge_, 1);
+
+    const auto dw_bwd = ck::utils::conv::make_conv_plan(dw, ConvDirection::BackwardWeight, F16);
+    EXPECT_EQ(dw_bwd.config_.algorithm_, ConvAlgorithm::BwdWeightTwoStage);
+    EXPECT_GT(dw_bwd.config_.num_groups_to_merge_, 1);
+
+    // tensors over 2GB, N is split, or the large tensor implementation if that is not enough
+    const auto big = ck::utils::conv::make_conv_plan(
+        MakeConv2d(1, 256, 256, 128, 3, 256), ConvDirection::Forward, F16);
+    EXPECT_EQ(big.config_.algorithm_, ConvAlgorithm::FwdXdl);
+    EXPECT_EQ(big.n_per_launch_, 64);
+
+    const auto huge = ck::utils::conv::make_conv_plan(
+        MakeConv2d(1, 2, 256, 256, 3, 4096), ConvDirection::Forward, F16);
+    EXPECT_EQ(huge.config_.algorithm_, ConvAlgorithm::FwdLargeTensor);
+
+    // small weight and a long reduction, split K
+    const auto reduction = ck::utils::conv::make_conv_plan(
+        MakeConv2d(1, 8, 64, 64, 3, 28), ConvDirection::BackwardWeight, F32);
+    EXPECT_GT(reduction.k_batch_, 1);
+    EXPECT_EQ(reduction.config_.algorithm_, ConvAlgorithm::BwdWeightAtomic);
+
+    // 16 bit atomics are slow, the reduction goes through the fp32 workspace
+    const auto reduction_f16 = ck::utils::conv::make_conv_plan(
+        MakeConv2d(1, 8, 64, 64, 3, 28), ConvDirection::BackwardWeight, F16);
+    EXPECT_GT(reduction_f16.k_batch_, 1);
+    EXPECT_EQ(reduction_f16.config_.algorithm_, ConvAlgorithm::BwdWeightTwoStage);
+}
+
+TEST(ConvPlanner, TypeStrings)
+{
+    const std::string fwd = "DeviceGroupedConvFwdMultipleABD_Xdl_CShuffle<64, 64, 16, 16, "
+                            "Default, 16, 16, 4, 1, 1, 1, 1, 1, 1, 16>";
+    const std::string large = "DeviceGroupedConvFwdMultipleD_Xdl_CShuffle_Large_Tensor<256, 256, "
+                              "128, 32, Default, 32, 32, 4, 2, 8, 8, 8, 1, 1>";
+    const std::string two_stage = "DeviceGroupedConvBwdWeightTwoStage_Xdl_CShuffle<64, 32, 64, "
+                                  "32, Default, 8, 1, 2, 4, 4, 4, 4, 1, 1, 4, "
+                                  "BlkGemmPipelineScheduler: Intrawave, "
+                                  "BlkGemmPipelineVersion: v1, 4, "
+                                  "TransposeTransferSrcScalarPerVector: 1, "
+                                  "TransposeTransferDstScalarPerVector: 1>";
+    const std::string atomic = "DeviceGroupedConvBwdWeight_Xdl_CShuffle<256, 128, 128, 4, "
+                               "Default, 8, 2, 2, 8, 8, 8, 8, 1, 1, 8>";
+
+    EXPECT_EQ(ck::utils::conv::get_conv_algorithm(fwd), ConvAlgorithm::FwdXdl);
+    EXPECT_EQ(ck::utils::conv::get_conv_algorithm(large), ConvAlgorithm::FwdLargeTensor);
+    EXPECT_EQ(ck::utils::conv::get_conv_algorithm(two_stage), ConvAlgorithm::BwdWeightTwoStage);
+    EXPECT_EQ(ck::utils::conv::get_conv_algorithm(atomic), ConvAlgorithm::BwdWeightAtomic);
+    EXPECT_EQ(ck::utils::conv::get_conv_algorithm("DeviceGroupedConvFwdMultipleABD_Wmma<1>"),
+              ConvAlgorithm::Unknown);
+
+    EXPECT_EQ(ck::utils::conv::get_num_groups_to_merge(fwd), 16);
+    EXPECT_EQ(ck::utils::conv::get_num_groups_to_merge(large), 1);
+    EXPECT_EQ(ck::utils::conv::get_num_groups_to_merge(two_stage), 4);
+    EXPECT_EQ(ck::utils::conv::get_num_groups_to_merge(atomic), 1);
+}
+
+TEST(ConvPlanner, FilterInstances)
+{
+    const auto make = [](const std::string& s) {
+        return std::make_unique<FakeInstance>(FakeInstance{s});
+    };
+
+    std::vector<std::unique_ptr<FakeInstance>> op_ptrs;
+    op_ptrs.push_back(make("DeviceGroupedConvFwdMultipleABD_Xdl_CShuffle<256, 128, 32, 1>"));
+    op_ptrs.push_back(make("DeviceGroupedConvFwdMultipleABD_Xdl_CShuffle<64, 16, 16, 8>"));
+    op_ptrs.push_back(make("DeviceGroupedConvFwdMultipleABD_Xdl_CShuffle<64, 16, 16, 16>"));
+    op_ptrs.push_back(make("DeviceGroupedConvFwdMultipleABD_Xdl_CShuffle<64, 16, 16, 32>"));
+    op_ptrs.push_back(make("DeviceGroupedConvFwdMultipleD_Xdl_CShuffle_Large_Tensor<256, 128>"));
+    op_ptrs.push_back(make("DeviceGroupedConvFwdMultipleABD_Wmma_CShuffle<128, 64>"));
+
+    const auto plan = ck::utils::conv::make_conv_plan(
+        MakeConv2d(256, 8, 1, 1, 3, 56), ConvDirection::Forward, F16);
+    ASSERT_EQ(plan.config_.algorithm_, ConvAlgorithm::FwdXdl);
+    ASSERT_GT(plan.config_.num_groups_to_merge_, 1);
+
+    ck::utils::conv::filter_conv_instances(op_ptrs, plan);
+
+    // the instance of the planned merge factor and the one the planner does not model
+    ASSERT_EQ(op_ptrs.size(), 2);
+    EXPECT_EQ(ck::utils::conv::get_num_groups_to_merge(op_ptrs[0]->GetTypeString()),
+              plan.config_.num_groups_to_merge_);
+    EXPECT_EQ(ck::utils::conv::get_conv_algorithm(op_ptrs[1]->GetTypeString()),
+              ConvAlgorithm::Unknown);
+}
@@ -0,0 +1,137 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "ck/ck.hpp"
+#include "ck/host_utility/split_k_advisor.hpp"
+#include "ck/tensor_operation/gpu/device/tensor_layout.hpp"
+#include "ck/tensor_operation/gpu/device/gemm_specialization.hpp"
+#include "ck/tensor_operation/gpu/device/impl/device_gemm_xdl_cshuffle_v3.hpp"
+#include "ck/tensor_operation/gpu/element/element_wise_operation.hpp"
+
+#include "ck/library/utility/check_err.hpp"
+#include "ck/library/utility/device_memory.hpp"
+#include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/utility/host_tensor_generator.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_gemm.hpp"
+
+template <ck::index_t... Is>
+using S = ck::Sequence<Is...>;
+
+using F16 = ck::half_t;
+using F32 = float;
+
+using Row = ck::tensor_layout::gemm::RowMajor;
+using Col = ck::tensor_layout::gemm::ColumnMajor;
+
+using PassThrough = ck::tensor_operation::element_wise::PassThrough;
+
+static constexpr auto GemmMNKPadding =
+    ck::tensor_operation::device::GemmSpecialization::MNKPadding;
+
+// KPerBlock 256 and AK1 = BK1 = 8: the K batches are multiples of 8, not of KPerBlock
+// clang-format off
+using DeviceGemmInstance = ck::tensor_operation::device::DeviceGemm_Xdl_CShuffleV3
+    < Row, Col, Row, F16, F16, F16, F32, F16, PassThrough, PassThrough, PassThrough, GemmMNKPadding, 64, 16, 16, 256, 8, 8, 16, 16, 1, 1, S<32, 2, 1>, S<1, 0, 2>, S<1, 0, 2>, 2, 8, 8, 0, S<32, 2, 1>, S<1, 0, 2>, S<1, 0, 2>, 2, 8, 8, 0, 1, 1, S<1, 16, 1, 4>, 4, ck::BlockGemmPipelineScheduler::Interwave, ck::BlockGemmPipelineVersion::v2>;
+// clang-format on
+
+using ReferenceGemmInstance = ck::tensor_operation::host::
+    ReferenceGemm<F16, F16, F16, F32, PassThrough, PassThrough, PassThrough>;
+
+TEST(GemmUniversalAutoKBatch, AdvisorCutsKAsTheDevice)
+{
+    constexpr ck::index_t M = 16, N = 16;
+
+    const ck::SplitKInstance instance{16, 16, 256, 8};
+    for(ck::index_t K : {256, 320, 1000, 4096, 4104})
+    {
+        for(ck::index_t k_batch : {1, 2, 3, 5, 8, 64})
+        {
+            const auto argument = DeviceGemmInstance::MakeArgument(nullptr,
+                                                                   nullptr,
+                                                                   nullptr,
+                                                                   M,
+                                                                   N,
+                                                                   K,
+                                                                   K,
+                                                                   K,
+                                                                   N,
+                                                                   k_batch,
+                                                                   PassThrough{},
+                                                                   PassThrough{},
+                                                                   PassThrough{});
+
+            const ck::index_t k_length = ck::detail::get_split_k_batch_length(K, instance, k_batch);
+            EXPECT_EQ(argument.KRead, k_length) << "K " << K << ", K-batch " << k_batch;
+
+            // the K-batches the advisor ranks are the ones the device runs
+            if(ck::is_xdl_supported())
+            {
+                EXPECT_EQ(DeviceGemmInstance::IsSupportedArgument(argument),
+                          (k_batch - 1) * k_length < K)
+                    << "K " << K << ", K-batch " << k_batch;
+            }
+        }
+    }
+}
+
+TEST(GemmUniversalAutoKBatch, AutomaticKBatch)
+{
+    // 16 output tiles, exact in fp16 whatever the order of the K-batch sums
+    constexpr ck::index_t M = 16, N = 256, K = 1000;
+
+    Tensor<F16> a_m_k({M, K}, {K, 1});
+    Tensor<F16> b_k_n({K, N}, {1, K});
+    Tensor<F16> c_m_n_host({M, N}, {N, 1});
+    Tensor<F16> c_m_n_device({M, N}, {N, 1});
+    a_m_k.GenerateTensorValue(GeneratorTensor_2<F16>{-1, 2});
+    b_k_n.GenerateTensorValue(GeneratorTensor_2<F16>{-1, 2});
+
+    DeviceMem a_device(sizeof(F16) * a_m_k.GetElementSpaceSize());
+    DeviceMem b_device(sizeof(F16) * b_k_n.GetElementSpaceSize());
+    DeviceMem c_device(sizeof(F16) * c_m_n_device.GetElementSpaceSize());
+    a_device.ToDevice(a_m_k.mData.data());
+    b_device.ToDevice(b_k_n.mData.data());
+
+    // a K-batch <= 0 is the one GetAutoKBatch picks
+    const ck::index_t k_batch = DeviceGemmInstance::GetAutoKBatch(M, N, K, K, K, N);
+    EXPECT_GE(k_batch, 1);
+
+    for(ck::index_t auto_k_batch : {0, -1})
+    {
+        auto gemm     = DeviceGemmInstance{};
+        auto argument = gemm.MakeArgument(static_cast<F16*>(a_device.GetDeviceBuffer()),
+                                          static_cast<F16*>(b_device.GetDeviceBuffer()),
+                                          static_cast<F16*>(c_device.GetDeviceBuffer()),
+                                          M,
+                                          N,
+                                          K,
+                                          K,
+                                          K,
+                                          N,
+                                          auto_k_batch,
+                                          PassThrough{},
+                                          PassThrough{},
+                                          PassThrough{});
+        EXPECT_EQ(argument.KBatch, k_batch);
+
+        if(!gemm.IsSupportedArgument(argument))
+        {
+            GTEST_SKIP() << "the instance does not support this device";
+        }
+
+        c_device.SetValue(ck::type_convert<F16>(1.f));
+        gemm.MakeInvoker().Run(argument, StreamConfig{nullptr, false});
+
+        auto ref_gemm     = ReferenceGemmInstance{};
+        auto ref_argument = ref_gemm.MakeArgument(
+            a_m_k, b_k_n, c_m_n_host, PassThrough{}, PassThrough{}, PassThrough{});
+        ref_gemm.MakeInvoker().Run(ref_argument);
+
+        c_device.FromDevice(c_m_n_device.mData.data());
+        EXPECT_TRUE(ck::utils::check_err(c_m_n_device, c_m_n_host));
+    }
+}
@@ -0,0 +1,334 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "ck/ck.hpp"
+#include "ck/tensor_operation/gpu/device/tensor_layout.hpp"
+#include "ck/tensor_operation/gpu/device/gemm_specialization.hpp"
+#include "ck/tensor_operation/gpu/device/impl/device_grouped_gemm_xdl.hpp"
+#include "ck/tensor_operation/gpu/device/impl/device_grouped_gemm_multiple_d_xdl_cshuffle_tile_loop.hpp"
+#include "ck/tensor_operation/gpu/element/element_wise_operation.hpp"
+
+#include "ck/library/utility/check_err.hpp"
+#include "ck/library/utility/device_memory.hpp"
+#include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/utility/host_tensor_generator.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_gemm.hpp"
+
+template <ck::index_t... Is>
+using S = ck::Sequence<Is...>;
+
+using F16 = ck::half_t;
+using F32 = float;
+
+using Row = ck::tensor_layout::gemm::RowMajor;
+using Col = ck::tensor_layout::gemm::ColumnMajor;
+
+using PassThrough = ck::tensor_operation::element_wise::PassThrough;
+
+using Empty_Tuple = ck::Tuple<>;
+
+using ck::tensor_operation::device::GemmDesc;
+using ck::tensor_operation::device::GroupedGemmKernelArgument;
+
+static constexpr auto GemmDefault = ck::tensor_operation::device::GemmSpecialization::Default;
+static constexpr auto GemmMNKPadding =
+    ck::tensor_operation::device::GemmSpecialization::MNKPadding;
+
+// clang-format off
+using DeviceGroupedGemmXdlInstance = ck::tensor_operation::device::DeviceGroupedGemm_Xdl
+    < Row, Col, Empty_Tuple, Row, F16, F16, F32, F16, Empty_Tuple, F16, PassThrough, PassThrough, PassThrough, GemmDefault, 1, 256, 256, 128, 32, 8, 8, 32, 32, 4, 2, S<4, 64, 1>, S<1, 0, 2>, S<1, 0, 2>, 2, 8, 8, 1, S<4, 64, 1>, S<1, 0, 2>, S<1, 0, 2>, 2, 8, 8, 1, 1, 1, S<1, 32, 1, 8>, 8>;
+
+using DeviceGroupedGemmTileLoopInstance = ck::tensor_operation::device::DeviceGroupedGemmMultipleDXdlCShuffleTileLoop
+    < Row, Col, Empty_Tuple, Row, F16, F16, F32, F32, Empty_Tuple, F16, PassThrough, PassThrough, PassThrough, GemmMNKPadding, 1, 256, 128, 128, 64, 8, 8, 32, 32, 2, 2, S<8, 32, 1>, S<1, 0, 2>, S<1, 0, 2>, 2, 8, 8, 1, S<8, 32, 1>, S<1, 0, 2>, S<1, 0, 2>, 2, 8, 8, 1, 1, 1, S<1, 32, 1, 8>, S<8>>;
+// clang-format on
+
+using ReferenceGemmInstance = ck::tensor_operation::host::
+    ReferenceGemm<F16, F16, F16, F32, PassThrough, PassThrough, PassThrough>;
+
+namespace {
+
+// the A, B and E tensors of one group, on the host and on the device, with room for max_M rows
+struct GroupBuffers
+{
+    GroupBuffers(ck::index_t max_M, ck::index_t N, ck::index_t K)
+        : a_m_k({max_M, K}, {K, 1}),
+          b_k_n({K, N}, {1, K}),
+          e_m_n({max_M, N}, {N, 1}),
+          a_device(sizeof(F16) * a_m_k.GetElementSpaceSize()),
+          b_device(sizeof(F16) * b_k_n.GetElementSpaceSize()),
+          e_device(sizeof(F16) * e_m_n.GetElementSpaceSize())
+    {
+        a_m_k.GenerateTensorValue(GeneratorTensor_2<F16>{-5, 5});
+        b_k_n.GenerateTensorValue(GeneratorTensor_2<F16>{-5, 5});
+
+        a_device.ToDevice(a_m_k.mData.data());
+        b_device.ToDevice(b_k_n.mData.data());
+        e_device.SetZero();
+    }
+
+    // the first M rows of E computed on the device match the host reference
+    bool Check(ck::index_t M)
+    {
+        const ck::index_t N = b_k_n.mDesc.GetLengths()[1];
+        const ck::index_t K = a_m_k.mDesc.GetLengths()[1];
+
+        Tensor<F16> a({M, K}, {K, 1});
+        std::copy_n(a_m_k.mData.begin(), M * K, a.mData.begin());
+
+        Tensor<F16> e_host({M, N}, {N, 1});
+        Tensor<F16> e_result({M, N}, {N, 1});
+
+        auto ref_gemm     = ReferenceGemmInstance{};
+        auto ref_argument = ref_gemm.MakeArgument(
+            a, b_k_n, e_host, PassThrough{}, PassThrough{}, PassThrough{});
+        ref_gemm.MakeInvoker().Run(ref_argument);
+
+        e_m_n.mData.assign(e_m_n.mData.size(), F16{});
+        e_device.FromDevice(e_m_n.mData.data());
+        std::copy_n(e_m_n.mData.begin(), M * N, e_result.mData.begin());
+
+        return ck::utils::check_err(e_result, e_host);
+    }
+
+    bool IsZero()
+    {
+        e_device.FromDevice(e_m_n.mData.data());
+        return std::all_of(e_m_n.mData.begin(), e_m_n.mData.end(), [](F16 x) {
+            return ck::type_convert<float>(x) == 0.f;
+        });
+    }
+
+    Tensor<F16> a_m_k;
+    Tensor<F16> b_k_n;
+    Tensor<F16> e_m_n;
+
+    DeviceMem a_device;
+    DeviceMem b_device;
+    DeviceMem e_device;
+};
+
+GroupedGemmKernelArgument<0> MakeKernelArgument(GroupBuffers& buffers, ck::index_t M)
+{
+    const ck::index_t N = buffers.b_k_n.mDesc.GetLengths()[1];
+    const ck::index_t K = buffers.a_m_k.mDesc.GetLengths()[1];
+
+    return {buffers.a_device.GetDeviceBuffer(),
+            buffers.b_device.GetDeviceBuffer(),
+            {},
+            buffers.e_device.GetDeviceBuffer(),
+            M,
+            N,
+            K,
+            K,
+            K,
+            {},
+            N};
+}
+
+} // namespace
+
+TEST(GroupedGemmRebind, XdlUpdatePointers)
+{
+    constexpr ck::index_t M = 256, N = 128, K = 64;
+
+    std::vector<std::unique_ptr<GroupBuffers>> first, second;
+    for(int i = 0; i < 2; ++i)
+    {
+        first.push_back(std::make_unique<GroupBuffers>(M, N, K));
+        second.push_back(std::make_unique<GroupBuffers>(M, N, K));
+    }
+
+    const auto get_pointers = [](auto& buffers, auto& p_As, auto& p_Bs, auto& p_Es) {
+        p_As.clear();
+        p_Bs.clear();
+        p_Es.clear();
+        for(auto& b : buffers)
+        {
+            p_As.push_back(b->a_device.GetDeviceBuffer());
+            p_Bs.push_back(b->b_device.GetDeviceBuffer());
+            p_Es.push_back(b->e_device.GetDeviceBuffer());
+        }
+    };
+
+    std::vector<const void*> p_As, p_Bs;
+    std::vector<std::array<const void*, 0>> p_Ds;
+    std::vector<void*> p_Es;
+    get_pointers(first, p_As, p_Bs, p_Es);
+
+    std::vector<GemmDesc> gemm_descs(2, GemmDesc{M, N, K, K, K, N, {}});
+
+    auto gemm     = DeviceGroupedGemmXdlInstance{};
+    auto invoker  = gemm.MakeInvoker();
+    auto argument = gemm.MakeArgument(
+        p_As, p_Bs, p_Ds, p_Es, gemm_descs, PassThrough{}, PassThrough{}, PassThrough{});
+
+    if(!gemm.IsSupportedArgument(argument))
+    {
+        GTEST_SKIP() << "the instance does not support this device";
+    }
+
+    DeviceMem workspace(gemm.GetWorkSpaceSize(&argument));
+    gemm.SetWorkSpacePointer(&argument, workspace.GetDeviceBuffer());
+
+    invoker.Run(argument, StreamConfig{nullptr, false});
+    for(auto& b : first)
+        EXPECT_TRUE(b->Check(M));
+
+    // the same shapes on other tensors, the first results are left alone
+    for(auto& b : first)
+        b->e_device.SetZero();
+
+    get_pointers(second, p_As, p_Bs, p_Es);
+    gemm.UpdatePointers(&argument, p_As, p_Bs, p_Ds, p_Es);
+
+    invoker.Run(argument, StreamConfig{nullptr, false});
+    for(auto& b : second)
+        EXPECT_TRUE(b->Check(M));
+    for(auto& b : first)
+        EXPECT_TRUE(b->IsZero());
+
+    // another op wrote the workspace: setting it again uploads all the kernel arguments
+    workspace.SetZero();
+    for(auto& b : second)
+        b->e_device.SetZero();
+    gemm.SetWorkSpacePointer(&argument, workspace.GetDeviceBuffer());
+
+    invoker.Run(argument, StreamConfig{nullptr, false});
+    for(auto& b : second)
+        EXPECT_TRUE(b->Check(M));
+
+    EXPECT_THROW(gemm.UpdatePointers(&argument, {p_As[0]}, p_Bs, p_Ds, p_Es), std::runtime_error);
+}
+
+TEST(GroupedGemmRebind, XdlValidityCache)
+{
+    constexpr ck::index_t M = 256, N = 128, K = 64;
+
+    std::vector<const void*> p_As(3, nullptr), p_Bs(3, nullptr);
+    std::vector<std::array<const void*, 0>> p_Ds;
+    std::vector<void*> p_Es(3, nullptr);
+
+    std::vector<GemmDesc> gemm_descs{
+        {M, N, K, K, K, N, {}}, {M, N, K, K, K, N, {}}, {2 * M, N, K, K, K, N, {}}};
+
+    auto& cache = DeviceGroupedGemmXdlInstance::GetValidityCache();
+    cache.Clear();
+
+    // two distinct shapes
+    auto gemm      = DeviceGroupedGemmXdlInstance{};
+    auto argument0 = gemm.MakeArgument(
+        p_As, p_Bs, p_Ds, p_Es, gemm_descs, PassThrough{}, PassThrough{}, PassThrough{});
+    EXPECT_EQ(cache.GetNumMisses(), 2);
+    EXPECT_EQ(cache.GetNumHits(), 1);
+
+    // an argument rebuilt with the same shapes does not check them again
+    auto argument1 = gemm.MakeArgument(
+        p_As, p_Bs, p_Ds, p_Es, gemm_descs, PassThrough{}, PassThrough{}, PassThrough{});
+    EXPECT_EQ(cache.GetNumMisses(), 2);
+    EXPECT_EQ(cache.GetNumHits(), 4);
+
+    EXPECT_EQ(gemm.IsSupportedArgument(argument0), gemm.IsSupportedArgument(argument1));
+}
+
+TEST(GroupedGemmRebind, TileLoopUpdateDeviceKernelArgs)
+{
+    constexpr ck::index_t max_M = 256, N = 128, K = 64;
+
+    std::vector<std::unique_ptr<GroupBuffers>> buffers;
+    for(int i = 0; i < 4; ++i)
+        buffers.push_back(std::make_unique<GroupBuffers>(max_M, N, K));
+
+    // the shapes are only known at launch time
+    std::vector<const void*> p_As, p_Bs;
+    std::vector<std::array<const void*, 0>> p_Ds;
+    std::vector<void*> p_Es;
+    std::vector<GemmDesc> gemm_descs(2, GemmDesc{0, N, K, K, K, N, {}});
+
+    auto gemm     = DeviceGroupedGemmTileLoopInstance{};
+    auto invoker  = gemm.MakeInvoker();
+    auto argument = gemm.MakeArgument(
+        p_As, p_Bs, p_Ds, p_Es, gemm_descs, PassThrough{}, PassThrough{}, PassThrough{});
+
+    std::vector<GroupedGemmKernelArgument<0>> kernel_args{MakeKernelArgument(*buffers[0], 64),
+                                                          MakeKernelArgument(*buffers[1], 200)};
+
+    DeviceMem kernel_args_device(gemm.GetDeviceKernelArgSize(&argument));
+    gemm.SetDeviceKernelArgs(argument, kernel_args_device.GetDeviceBuffer(), kernel_args.data());
+
+    // the argument checks the shapes of the kernel arguments, not the ones it was made with
+    if(!gemm.IsSupportedArgument(argument))
+    {
+        GTEST_SKIP() << "the instance does not support this device";
+    }
+
+    invoker.Run(argument, StreamConfig{nullptr, false});
+    EXPECT_TRUE(buffers[0]->Check(64));
+    EXPECT_TRUE(buffers[1]->Check(200));
+
+    // new tensors and new M on the same argument
+    kernel_args = {MakeKernelArgument(*buffers[2], 256), MakeKernelArgument(*buffers[3], 1)};
+    gemm.UpdateDeviceKernelArgs(argument, kernel_args.data());
+
+    invoker.Run(argument, StreamConfig{nullptr, false});
+    EXPECT_TRUE(buffers[2]->Check(256));
+    EXPECT_TRUE(buffers[3]->Check(1));
+
+    // something else wrote the buffer (another op it was lent to): binding it again with the
+    // same kernel arguments uploads them all
+    kernel_args_device.SetZero();
+    buffers[2]->e_device.SetZero();
+    buffers[3]->e_device.SetZero();
+    gemm.SetDeviceKernelArgs(argument, kernel_args_device.GetDeviceBuffer(), kernel_args.data());
+
+    invoker.Run(argument, StreamConfig{nullptr, false});
+    EXPECT_TRUE(buffers[2]->Check(256));
+    EXPECT_TRUE(buffers[3]->Check(1));
+}
+
+TEST(GroupedGemmRebind, TileLoopValidityFollowsShapes)
+{
+    constexpr ck::index_t M = 128, N = 128, K = 64;
+
+    GroupBuffers buffers(M, N, K);
+
+    std::vector<const void*> p_As, p_Bs;
+    std::vector<std::array<const void*, 0>> p_Ds;
+    std::vector<void*> p_Es;
+    std::vector<GemmDesc> gemm_descs{GemmDesc{M, N, K, K, K, N, {}}};
+
+    auto gemm     = DeviceGroupedGemmTileLoopInstance{};
+    auto argument = gemm.MakeArgument(
+        p_As, p_Bs, p_Ds, p_Es, gemm_descs, PassThrough{}, PassThrough{}, PassThrough{});
+
+    if(!gemm.IsSupportedArgument(argument))
+    {
+        GTEST_SKIP() << "the instance does not support this device";
+    }
+
+    // the argument keeps its own copy of the shapes
+    gemm_descs[0].K_ = 7;
+    EXPECT_TRUE(gemm.IsSupportedArgument(argument));
+
+    std::vector<GroupedGemmKernelArgument<0>> kernel_args{MakeKernelArgument(buffers, M)};
+
+    DeviceMem kernel_args_device(gemm.GetDeviceKernelArgSize(&argument));
+    gemm.SetDeviceKernelArgs(argument, kernel_args_device.GetDeviceBuffer(), kernel_args.data());
+    EXPECT_TRUE(gemm.IsSupportedArgument(argument));
+
+    // K is not a multiple of the A vector loads, the cached result is dropped
+    kernel_args[0].K       = 7;
+    kernel_args[0].StrideA = 7;
+    EXPECT_THROW(gemm.UpdateDeviceKernelArgs(argument, kernel_args.data()), std::runtime_error);
+    EXPECT_FALSE(gemm.IsSupportedArgument(argument));
+
+    kernel_args[0] = MakeKernelArgument(buffers, M);
+    gemm.UpdateDeviceKernelArgs(argument, kernel_args.data());
+    EXPECT_TRUE(gemm.IsSupportedArgument(argument));
+}
@@ -0,0 +1,396 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "ck/library/tensor_operation_instance/instance_selection_cache.hpp"
+
+using ck::tensor_operation::device::BaseArgument;
+using ck::tensor_operation::device::BaseInvoker;
+using ck::tensor_operation::device::BaseOperator;
+using ck::tensor_operation::device::instance::InstanceSelectionCache;
+using ck::tensor_operation::device::instance::InstanceSelector;
+using ck::tensor_operation::device::instance::SelectionEntry;
+using ck::tensor_operation::device::instance::SelectionKey;
+using ck::tensor_operation::device::instance::SelectionPolicy;
+using ck::tensor_operation::device::instance::ShapeBucketing;
+
+namespace {
+
+struct FakeArgument : public BaseArgument
+{
+    FakeArgument(std::int64_t M, std::int64_t N, std::int64_t K) : M_(M), N_(N), K_(K) {}
+
+    std::int64_t M_;
+    std::int64_t N_;
+    std::int64_t K_;
+};
+
+// a GEMM instance supporting M in multiples of its tile unless it pads, and K in multiples of
+// its vector width
+struct FakeGemm : public BaseOperator
+{
+    FakeGemm(std::string name, std::int64_t m_per_block, std::int64_t k_per_vector, bool pad_m)
+        : name_(std::move(name)),
+          m_per_block_(m_per_block),
+          k_per_vector_(k_per_vector),
+          pad_m_(pad_m)
+    {
+    }
+
+    bool IsSupportedArgument(const BaseArgument* p_arg) override
+    {
+        const auto& arg = *dynamic_cast<const FakeArgument*>(p_arg);
+        return (pad_m_ || arg.M_ % m_per_block_ == 0) && arg.K_ % k_per_vector_ == 0;
+    }
+
+    std::string GetTypeString() const override { return name_; }
+
+    std::unique_ptr<BaseInvoker> MakeInvokerPointer() { return std::make_unique<BaseInvoker>(); }
+
+    std::string name_;
+    std::int64_t m_per_block_;
+    std::int64_t k_per_vector_;
+    bool pad_m_;
+};
+
+using Selector = InstanceSelector<FakeGemm>;
+
+std::vector<std::unique_ptr<FakeGemm>> MakeInstances()
+{
+    std::vector<std::unique_ptr<FakeGemm>> instances;
+    instances.push_back(std::make_unique<FakeGemm>("Gemm_256x128_K8", 256, 8, false));
+    instances.push_back(std::make_unique<FakeGemm>("Gemm_128x128_K8", 128, 8, false));
+    instances.push_back(std::make_unique<FakeGemm>("Gemm_64x64_K8_MPad", 64, 8, true));
+    instances.push_back(std::make_unique<FakeGemm>("Gemm_64x64_K1_MPad", 64, 1, true));
+    return instances;
+}
+
+// mocked timings: the bigger tiles are faster, padding costs
+struct MockTimer
+{
+    float operator()(FakeGemm& op, BaseArgument*)
+    {
+        ++*calls;
+        static const std::map<std::string, float> times = {{"Gemm_256x128_K8", 1.f},
+                                                           {"Gemm_128x128_K8", 2.f},
+                                                           {"Gemm_64x64_K8_MPad", 3.f},
+                                                           {"Gemm_64x64_K1_MPad", 4.f}};
+        return times.at(op.GetTypeString());
+    }
+
+    std::shared_ptr<std::atomic<int>> calls = std::make_shared<std::atomic<int>>(0);
+};
+
+Selector::MakeArgument Problem(std::int64_t M, std::int64_t N, std::int64_t K)
+{
+    return [=](FakeGemm&) { return std::make_unique<FakeArgument>(M, N, K); };
+}
+
+Selector::Selection Select(Selector& selector, std::int64_t M, std::int64_t N, std::int64_t K)
+{
+    return selector.Select({M, N, K}, {K, N}, Problem(M, N, K));
+}
+
+} // namespace
+
+TEST(ShapeBucketing, Bucket)
+{
+    const ShapeBucketing bucketing;
+    for(std::int64_t length = 0; length <= 16; ++length)
+        EXPECT_EQ(bucketing.Bucket(length), length);
+
+    EXPECT_EQ(bucketing.Bucket(17), 20);
+    EXPECT_EQ(bucketing.Bucket(1000), 1024);
+    EXPECT_EQ(bucketing.Bucket(1024), 1024);
+    EXPECT_EQ(bucketing.Bucket(1025), 1280);
+    EXPECT_EQ(bucketing.Bucket(3840), 4096);
+    EXPECT_EQ(bucketing.Bucket(4097), 5120);
+
+    for(std::int64_t length = 17; length < 100000; ++length)
+    {
+        const auto bucket = bucketing.Bucket(length);
+        ASSERT_GE(bucket, length);
+        ASSERT_LT(bucket - length, length / 4 + 1);
+        ASSERT_EQ(bucketing.Bucket(bucket), bucket);
+        ASSERT_LE(bucketing.Bucket(length - 1), bucket);
+    }
+
+    const ShapeBucketing coarse{16, 0, 16};
+    EXPECT_EQ(coarse.Bucket(1025), 2048);
+    EXPECT_EQ(coarse.Bucket(std::vector<std::int64_t>{3, 33, 100}),
+              (std::vector<std::int64_t>{3, 64, 128}));
+}
+
+TEST(ShapeBucketing, Alignment)
+{
+    const ShapeBucketing bucketing;
+    EXPECT_EQ(bucketing.Alignment({4096, 4096}), 16);
+    EXPECT_EQ(bucketing.Alignment({4096, 24}), 8);
+    EXPECT_EQ(bucketing.Alignment({4096, 4095}), 1);
+    EXPECT_EQ(bucketing.Alignment({}), 16);
+}
+
+TEST(InstanceSelector, AutotuneOncePerBucket)
+{
+    InstanceSelectionCache cache;
+    MockTimer timer;
+    Selector selector(MakeInstances(), SelectionPolicy::Autotune, cache, {}, "gfx942");
+    selector.SetTimeInstance(timer);
+
+    auto selection = Select(selector, 4096, 4096, 4096);
+    ASSERT_NE(selection.op, nullptr);
+    EXPECT_EQ(selection.op->GetTypeString(), "Gemm_256x128_K8");
+    EXPECT_FALSE(selection.cached);
+    EXPECT_EQ(dynamic_cast<FakeArgument*>(selection.argument.get())->M_, 4096);
+    EXPECT_EQ(*timer.calls, 4);
+
+    // same bucket and alignment class: no more timing
+    selection = Select(selector, 3840, 4000, 4096);
+    EXPECT_EQ(selection.op->GetTypeString(), "Gemm_256x128_K8");
+    EXPECT_TRUE(selection.cached);
+    EXPECT_EQ(dynamic_cast<FakeArgument*>(selection.argument.get())->M_, 3840);
+    EXPECT_EQ(*timer.calls, 4);
+
+    // K not a multiple of 8: another alignment class, only the K1 instance supports it
+    selection = Select(selector, 4096, 4096, 4095);
+    EXPECT_EQ(selection.op->GetTypeString(), "Gemm_64x64_K1_MPad");
+    EXPECT_FALSE(selection.cached);
+    EXPECT_EQ(*timer.calls, 5);
+
+    EXPECT_EQ(cache.GetNumEntries(), 2);
+    EXPECT_EQ(cache.GetNumMisses(), 2);
+    EXPECT_EQ(cache.GetNumHits(), 1);
+}
+
+TEST(InstanceSelector, FirstSupported)
+{
+    InstanceSelectionCache cache;
+    MockTimer timer;
+    Selector selector(MakeInstances(), SelectionPolicy::FirstSupported, cache, {}, "gfx942");
+    selector.SetTimeInstance(timer);
+
+    EXPECT_EQ(Select(selector, 128, 128, 64).op->GetTypeString(), "Gemm_128x128_K8");
+    EXPECT_EQ(Select(selector, 100, 128, 64).op->GetTypeString(), "Gemm_64x64_K8_MPad");
+    EXPECT_EQ(*timer.calls, 0);
+}
+
+TEST(InstanceSelector, FallbackWhenBucketInstanceDoesNotFit)
+{
+    InstanceSelectionCache cache;
+    MockTimer timer;
+    Selector selector(MakeInstances(), SelectionPolicy::Autotune, cache, {}, "gfx942");
+    selector.SetTimeInstance(timer);
+
+    EXPECT_EQ(Select(selector, 1024, 1024, 1024).op->GetTypeString(), "Gemm_256x128_K8");
+
+    // 1000 shares the bucket of 1024, but M is no multiple of 256 or 128
+    const auto selection = Select(selector, 1000, 1024, 1024);
+    EXPECT_EQ(selection.op->GetTypeString(), "Gemm_64x64_K8_MPad");
+    EXPECT_FALSE(selection.cached);
+    EXPECT_EQ(selector.GetNumFallbacks(), 1);
+
+    // the bucket keeps its selection
+    EXPECT_EQ(Select(selector, 1024, 1024, 1024).op->GetTypeString(), "Gemm_256x128_K8");
+    EXPECT_EQ(cache.GetNumEntries(), 1);
+}
+
+TEST(InstanceSelector, NoSupportedInstance)
+{
+    InstanceSelectionCache cache;
+    std::vector<std::unique_ptr<FakeGemm>> instances;
+    instances.push_back(std::make_unique<FakeGemm>("Gemm_256x128_K8", 256, 8, false));
+    Selector selector(std::move(instances), SelectionPolicy::Autotune, cache, {}, "gfx942");
+    selector.SetTimeInstance(MockTimer{});
+
+    const auto selection = Select(selector, 100, 128, 64);
+    EXPECT_EQ(selection.op, nullptr);
+    EXPECT_EQ(selection.argument, nullptr);
+}
+
+TEST(InstanceSelector, StableOpKey)
+{
+    InstanceSelectionCache cache;
+    const Selector selector(MakeInstances(), SelectionPolicy::Autotune, cache, {}, "gfx942");
+
+    // the same instances give the same key, whatever the process or compiler
+    EXPECT_EQ(selector.GetOpKey(),
+              Selector(MakeInstances(), SelectionPolicy::Autotune, cache, {}, "gfx942")
+                  .GetOpKey());
+    EXPECT_EQ(selector.GetOpKey().rfind("instances:4:", 0), 0);
+
+    auto instances = MakeInstances();
+    instances.pop_back();
+    EXPECT_NE(selector.GetOpKey(),
+              Selector(std::move(instances), SelectionPolicy::Autotune, cache, {}, "gfx942")
+                  .GetOpKey());
+
+    const Selector named(
+        MakeInstances(), SelectionPolicy::Autotune, cache, {}, "gfx942", std::string("gemm"));
+    EXPECT_EQ(named.GetOpKey(), "gemm");
+}
+
+TEST(InstanceSelector, InstancesSharingATypeString)
+{
+    // type strings leaving out the K vector width
+    std::vector<std::unique_ptr<FakeGemm>> instances;
+    instances.push_back(std::make_unique<FakeGemm>("Gemm_64x64_MPad", 64, 8, true));
+    instances.push_back(std::make_unique<FakeGemm>("Gemm_64x64_MPad", 64, 1, true));
+
+    InstanceSelectionCache cache;
+    Selector selector(std::move(instances), SelectionPolicy::FirstSupported, cache, {}, "gfx942");
+    EXPECT_EQ(selector.GetInstanceNames(),
+              (std::vector<std::string>{"Gemm_64x64_MPad", "Gemm_64x64_MPad#1"}));
+
+    // only the second one supports K = 4095, the cache must bind that one
+    auto selection = Select(selector, 64, 64, 4095);
+    ASSERT_NE(selection.op, nullptr);
+    EXPECT_EQ(selection.op, selector.GetInstances()[1].get());
+
+    selection = Select(selector, 64, 64, 4095);
+    EXPECT_TRUE(selection.cached);
+    EXPECT_EQ(selection.op, selector.GetInstances()[1].get());
+    EXPECT_EQ(cache.Find(selector.MakeKey({64, 64, 4095}, {4095, 64}))->instance,
+              "Gemm_64x64_MPad#1");
+    EXPECT_EQ(selector.GetNumFallbacks(), 0);
+}
+
+TEST(InstanceSelectionCache, LeastRecentlyUsedEviction)
+{
+    InstanceSelectionCache cache(2);
+    const SelectionKey a{"op", "gfx942", {1}, 16};
+    const SelectionKey b{"op", "gfx942", {2}, 16};
+    const SelectionKey c{"op", "gfx942", {3}, 16};
+
+    cache.Insert(a, SelectionEntry{"A", 1});
+    cache.Insert(b, SelectionEntry{"B", 1});
+    EXPECT_TRUE(cache.Find(a)); // a is now more recent than b
+    cache.Insert(c, SelectionEntry{"C", 1});
+
+    EXPECT_EQ(cache.GetNumEntries(), 2);
+    EXPECT_TRUE(cache.Find(a));
+    EXPECT_FALSE(cache.Find(b));
+    EXPECT_EQ(cache.Find(c)->instance, "C");
+
+    // re-inserting replaces the entry
+    cache.Insert(c, SelectionEntry{"C2", 1});
+    EXPECT_EQ(cache.GetNumEntries(), 2);
+    EXPECT_EQ(cache.Find(c)->instance, "C2");
+}
+
+TEST(InstanceSelectionCache, Invalidate)
+{
+    InstanceSelectionCache cache;
+    cache.Insert(SelectionKey{"gemm", "gfx942", {1}, 16}, SelectionEntry{"A", 1});
+    cache.Insert(SelectionKey{"gemm", "gfx90a", {1}, 16}, SelectionEntry{"A", 1});
+    cache.Insert(SelectionKey{"conv", "gfx942", {1}, 16}, SelectionEntry{"B", 1});
+    cache.Insert(SelectionKey{"conv", "gfx942", {2}, 16}, SelectionEntry{"B", 5});
+
+    EXPECT_EQ(cache.InvalidateArch("gfx90a"), 1);
+    EXPECT_EQ(cache.Invalidate(SelectionKey{"conv", "gfx942", {2}, 16}), 1);
+    EXPECT_EQ(cache.Invalidate(SelectionKey{"conv", "gfx942", {2}, 16}), 0);
+    EXPECT_EQ(cache.InvalidateOp("gemm"), 1);
+    EXPECT_EQ(cache.GetNumEntries(), 1);
+    EXPECT_EQ(cache.InvalidateIf([](const SelectionKey&, const SelectionEntry& e) {
+                  return e.instance == "B";
+              }),
+              1);
+    EXPECT_EQ(cache.GetNumEntries(), 0);
+}
+
+TEST(InstanceSelectionCache, OfflineDatabase)
+{
+    InstanceSelectionCache tuned;
+    {
+        MockTimer timer;
+        Selector selector(MakeInstances(), SelectionPolicy::Autotune, tuned, {}, "gfx942");
+        selector.SetTimeInstance(timer);
+        Select(selector, 4096, 4096, 4096);
+        Select(selector, 64, 4096, 4095);
+    }
+
+    std::stringstream db;
+    tuned.Save(db);
+    db << "malformed line\n";
+
+    InstanceSelectionCache cache;
+    EXPECT_EQ(cache.Load(db), 2);
+
+    MockTimer timer;
+    Selector selector(MakeInstances(), SelectionPolicy::Autotune, cache, {}, "gfx942");
+    selector.SetTimeInstance(timer);
+    EXPECT_TRUE(Select(selector, 4096, 4096, 4096).cached);
+    EXPECT_EQ(Select(selector, 64, 4096, 4095).op->GetTypeString(), "Gemm_64x64_K1_MPad");
+    EXPECT_EQ(*timer.calls, 0);
+
+    // the database of another arch does not apply
+    Selector other_arch(MakeInstances(), SelectionPolicy::Autotune, cache, {}, "gfx90a");
+    other_arch.SetTimeInstance(timer);
+    EXPECT_FALSE(Select(other_arch, 4096, 4096, 4096).cached);
+    EXPECT_EQ(*timer.calls, 4);
+}
+
+TEST(InstanceSelectionCache, StaleDatabaseEntry)
+{
+    InstanceSelectionCache cache;
+    MockTimer timer;
+    Selector selector(MakeInstances(), SelectionPolicy::Autotune, cache, {}, "gfx942");
+    selector.SetTimeInstance(timer);
+
+    // an instance of another build of the library
+    cache.Insert(selector.MakeKey({4096, 4096, 4096}, {4096, 4096}),
+                 SelectionEntry{"Gemm_512x256_K8", 0.5f});
+
+    const auto selection = Select(selector, 4096, 4096, 4096);
+    EXPECT_EQ(selection.op->GetTypeString(), "Gemm_256x128_K8");
+    EXPECT_EQ(*timer.calls, 4);
+    EXPECT_EQ(cache.Find(selector.MakeKey({4096, 4096, 4096}, {4096, 4096}))->instance,
+              "Gemm_256x128_K8");
+}
+
+TEST(InstanceSelectionCache, ConcurrentMissesTuneOnce)
+{
+    InstanceSelectionCache cache;
+    auto calls = std::make_shared<std::atomic<int>>(0);
+    Selector selector(MakeInstances(), SelectionPolicy::Autotune, cache, {}, "gfx942");
+    selector.SetTimeInstance([calls](FakeGemm& op, BaseArgument* arg) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        MockTimer timer{calls};
+        return timer(op, arg);
+    });
+
+    std::vector<std::thread> threads;
+    std::vector<std::string> selected(8);
+    for(int i = 0; i < 8; ++i)
+        threads.emplace_back([&, i] {
+            selected[i] = Select(selector, 2048, 2048, 2048).op->GetTypeString();
+        });
+    for(auto& thread : threads)
+        thread.join();
+
+    for(const auto& name : selected)
+        EXPECT_EQ(name, "Gemm_256x128_K8");
+    EXPECT_EQ(*calls, 4);
+    EXPECT_EQ(cache.GetNumMisses(), 1);
+}
+
+TEST(InstanceSelectionCache, FailedSelectionIsRetried)
+{
+    InstanceSelectionCache cache;
+    const SelectionKey key{"op", "gfx942", {1}, 16};
+
+    EXPECT_THROW(cache.GetOrSelect(key, []() -> SelectionEntry { throw std::runtime_error(""); }),
+                 std::runtime_error);
+    EXPECT_EQ(cache.GetNumEntries(), 0);
+    EXPECT_EQ(cache.GetOrSelect(key, [] { return SelectionEntry{"A", 1}; }).instance, "A");
+}
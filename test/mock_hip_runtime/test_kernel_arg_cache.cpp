@@ -0,0 +1,174 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "ck/host_utility/kernel_arg_cache.hpp"
+#include "ck/library/utility/device_memory.hpp"
+
+using ck::KernelArgUploader;
+using ck::ValidityCache;
+
+namespace {
+
+struct KernelArg
+{
+    const void* p_a;
+    void* p_e;
+    int M;
+    int N;
+    int K;
+    int stride;
+};
+
+std::vector<KernelArg> MakeArgs(int count)
+{
+    std::vector<KernelArg> args(count);
+    for(int i = 0; i < count; ++i)
+        args[i] = KernelArg{nullptr, nullptr, 64 + i, 128, 256, 256};
+    return args;
+}
+
+std::vector<KernelArg> Download(const DeviceMem& buf, std::size_t count)
+{
+    std::vector<KernelArg> args(count);
+    buf.FromDevice(args.data());
+    return args;
+}
+
+bool Equal(const std::vector<KernelArg>& a, const std::vector<KernelArg>& b)
+{
+    return a.size() == b.size() &&
+           std::memcmp(a.data(), b.data(), a.size() * sizeof(KernelArg)) == 0;
+}
+
+} // namespace
+
+TEST(KernelArgUploader, FirstUploadCopiesEverything)
+{
+    const auto args = MakeArgs(100);
+    DeviceMem buf(args.size() * sizeof(KernelArg));
+
+    KernelArgUploader uploader;
+    EXPECT_EQ(uploader.Upload(buf.GetDeviceBuffer(), args.data(), args.size(), nullptr),
+              args.size() * sizeof(KernelArg));
+    EXPECT_TRUE(Equal(Download(buf, args.size()), args));
+
+    // nothing changed, nothing copied
+    EXPECT_EQ(uploader.Upload(buf.GetDeviceBuffer(), args.data(), args.size(), nullptr), 0);
+}
+
+TEST(KernelArgUploader, OnlyChangedGroupsAreCopied)
+{
+    auto args = MakeArgs(100);
+    DeviceMem buf(args.size() * sizeof(KernelArg));
+
+    // no merging of runs, so the copied size is exact
+    KernelArgUploader uploader(0);
+    uploader.Upload(buf.GetDeviceBuffer(), args.data(), args.size(), nullptr);
+
+    int dummy[4];
+    args[3].p_a  = &dummy[0];
+    args[4].p_e  = &dummy[1];
+    args[50].M   = 1;
+    args[99].p_a = &dummy[2];
+
+    EXPECT_EQ(uploader.Upload(buf.GetDeviceBuffer(), args.data(), args.size(), nullptr),
+              4 * sizeof(KernelArg));
+    EXPECT_TRUE(Equal(Download(buf, args.size()), args));
+}
+
+TEST(KernelArgUploader, CloseRunsAreMerged)
+{
+    auto args = MakeArgs(100);
+    DeviceMem buf(args.size() * sizeof(KernelArg));
+
+    KernelArgUploader uploader(4 * sizeof(KernelArg));
+    uploader.Upload(buf.GetDeviceBuffer(), args.data(), args.size(), nullptr);
+
+    args[10].M = 1;
+    args[13].M = 1;
+    args[90].M = 1;
+
+    // [10, 14) in one copy, 90 in another
+    EXPECT_EQ(uploader.Upload(buf.GetDeviceBuffer(), args.data(), args.size(), nullptr),
+              5 * sizeof(KernelArg));
+    EXPECT_TRUE(Equal(Download(buf, args.size()), args));
+}
+
+TEST(KernelArgUploader, NewBufferOrCountUploadsEverything)
+{
+    auto args = MakeArgs(10);
+    DeviceMem buf0(20 * sizeof(KernelArg));
+    DeviceMem buf1(20 * sizeof(KernelArg));
+
+    KernelArgUploader uploader;
+    uploader.Upload(buf0.GetDeviceBuffer(), args.data(), args.size(), nullptr);
+
+    EXPECT_EQ(uploader.Upload(buf1.GetDeviceBuffer(), args.data(), args.size(), nullptr),
+              args.size() * sizeof(KernelArg));
+    EXPECT_TRUE(Equal(Download(buf1, args.size()), args));
+
+    args = MakeArgs(20);
+    EXPECT_EQ(uploader.Upload(buf1.GetDeviceBuffer(), args.data(), args.size(), nullptr),
+              args.size() * sizeof(KernelArg));
+    EXPECT_TRUE(Equal(Download(buf1, args.size()), args));
+
+    uploader.Invalidate();
+    EXPECT_EQ(uploader.Upload(buf1.GetDeviceBuffer(), args.data(), args.size(), nullptr),
+              args.size() * sizeof(KernelArg));
+}
+
+TEST(ValidityCache, ChecksOncePerKey)
+{
+    ValidityCache cache;
+    int num_checks = 0;
+
+    const auto check = [&](bool result) {
+        return [&num_checks, result] {
+            ++num_checks;
+            return result;
+        };
+    };
+
+    EXPECT_TRUE(cache.Get({64, 128, 256}, check(true)));
+    EXPECT_FALSE(cache.Get({65, 128, 256}, check(false)));
+    EXPECT_TRUE(cache.Get({64, 128, 256}, check(false)));
+    EXPECT_FALSE(cache.Get({65, 128, 256}, check(true)));
+
+    EXPECT_EQ(num_checks, 2);
+    EXPECT_EQ(cache.GetNumEntries(), 2);
+    EXPECT_EQ(cache.GetNumHits(), 2);
+    EXPECT_EQ(cache.GetNumMisses(), 2);
+
+    cache.Clear();
+    EXPECT_EQ(cache.GetNumEntries(), 0);
+    EXPECT_TRUE(cache.Get({65, 128, 256}, check(true)));
+    EXPECT_EQ(num_checks, 3);
+}
+
+TEST(ValidityCache, BoundedAndThreadSafe)
+{
+    ValidityCache cache(16);
+
+    std::vector<std::thread> threads;
+    for(int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([&cache] {
+            for(int i = 0; i < 1000; ++i)
+            {
+                const bool valid = cache.Get({i % 32, 7}, [i] { return i % 2 == 0; });
+                EXPECT_EQ(valid, i % 2 == 0);
+            }
+        });
+    }
+    for(auto& thread : threads)
+        thread.join();
+
+    EXPECT_LE(cache.GetNumEntries(), 16);
+    EXPECT_EQ(cache.GetNumHits() + cache.GetNumMisses(), 4000);
+}
@@ -0,0 +1,178 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "ck/host_utility/device_prop.hpp"
+#include "ck/host_utility/kernel_launch.hpp"
+#include "ck/host_utility/stream_utility.hpp"
+#include "ck/library/utility/device_memory.hpp"
+
+using ck::mock::LaunchRecord;
+using ck::mock::Runtime;
+
+namespace {
+
+__global__ void kernel_a(const float*, float*, int) {}
+__global__ void kernel_b(int) {}
+
+class MockHipRuntime : public ::testing::Test
+{
+    protected:
+    void SetUp() override { Runtime::Get().Reset(); }
+    void TearDown() override { Runtime::Get().Reset(); }
+};
+
+} // namespace
+
+TEST_F(MockHipRuntime, DeviceMem)
+{
+    const std::size_t allocated = Runtime::Get().GetAllocatedBytes();
+
+    std::vector<float> src(1000);
+    std::iota(src.begin(), src.end(), 0.f);
+    {
+        DeviceMem buf(src.size() * sizeof(float));
+        EXPECT_EQ(Runtime::Get().GetAllocatedBytes(), allocated + 4000);
+
+        buf.ToDevice(src.data());
+        // the mock device memory is host memory
+        EXPECT_EQ(static_cast<float*>(buf.GetDeviceBuffer())[999], 999.f);
+
+        std::vector<float> dst(src.size());
+        buf.FromDevice(dst.data());
+        EXPECT_EQ(dst, src);
+
+        buf.SetValue(2.5f);
+        buf.FromDevice(dst.data());
+        EXPECT_EQ(dst.front(), 2.5f);
+        EXPECT_EQ(dst.back(), 2.5f);
+
+        buf.SetZero();
+        buf.FromDevice(dst.data());
+        EXPECT_EQ(dst[500], 0.f);
+
+        buf.Realloc(8000);
+        EXPECT_EQ(Runtime::Get().GetAllocatedBytes(), allocated + 8000);
+    }
+    EXPECT_EQ(Runtime::Get().GetAllocatedBytes(), allocated);
+    EXPECT_GE(Runtime::Get().GetPeakAllocatedBytes(), allocated + 8000);
+}
+
+TEST_F(MockHipRuntime, Errors)
+{
+    int not_a_device_pointer = 0;
+    EXPECT_THROW(hip_check_error(hipFree(&not_a_device_pointer)), std::runtime_error);
+
+    // the failure is also reported once by hipGetLastError
+    EXPECT_EQ(hipGetLastError(), hipErrorInvalidValue);
+    EXPECT_EQ(hipGetLastError(), hipSuccess);
+}
+
+TEST_F(MockHipRuntime, RecordsLaunches)
+{
+    const float* a = nullptr;
+    float* b       = nullptr;
+
+    launch_and_time_kernel(StreamConfig{}, kernel_a, dim3(304, 2), dim3(256), 1024, a, b, 7);
+    launch_and_time_kernel(StreamConfig{}, kernel_b, dim3(1), dim3(64), 0, 1);
+
+    const auto launches = Runtime::Get().GetLaunches();
+    ASSERT_EQ(launches.size(), 2);
+
+    EXPECT_EQ(launches[0].kernel_, reinterpret_cast<const void*>(&kernel_a));
+    EXPECT_EQ(launches[0].GetNumBlocks(), 608);
+    EXPECT_EQ(launches[0].GetBlockSize(), 256);
+    EXPECT_EQ(launches[0].lds_byte_, 1024);
+    EXPECT_EQ(launches[1].kernel_, reinterpret_cast<const void*>(&kernel_b));
+    EXPECT_EQ(launches[1].start_ms_, launches[0].start_ms_ + launches[0].duration_ms_);
+}
+
+TEST_F(MockHipRuntime, VirtualClockTiming)
+{
+    // 1 us per block
+    Runtime::Get().SetLaunchCostModel(
+        [](const LaunchRecord& r) { return 0.001f * static_cast<float>(r.GetNumBlocks()); });
+
+    StreamConfig config{nullptr, true};
+    config.cold_niters_ = 3;
+    config.nrepeat_     = 10;
+
+    const float ave_time =
+        launch_and_time_kernel(config, kernel_a, dim3(500), dim3(256), 0, nullptr, nullptr, 0);
+
+    EXPECT_FLOAT_EQ(ave_time, 0.5f);
+    EXPECT_EQ(Runtime::Get().GetNumLaunches(), 13);
+    EXPECT_NEAR(Runtime::Get().GetClock(), 13 * 0.5f, 1e-4f);
+}
+
+TEST_F(MockHipRuntime, PerLaunchStatistics)
+{
+    int n = 0;
+    // alternating 1 ms and 3 ms launches
+    Runtime::Get().SetLaunchCostModel([&](const LaunchRecord&) { return (n++ % 2) ? 3.f : 1.f; });
+
+    ck::TimingStatistics stats;
+
+    StreamConfig config{nullptr, true};
+    config.cold_niters_  = 0;
+    config.nrepeat_      = 20;
+    config.timing_stats_ = &stats;
+
+    launch_and_time_kernel(config, kernel_b, dim3(1), dim3(64), 0, 0);
+
+    ASSERT_EQ(stats.samples_.size(), 20);
+    EXPECT_FLOAT_EQ(stats.min_, 1.f);
+    EXPECT_FLOAT_EQ(stats.max_, 3.f);
+    EXPECT_FLOAT_EQ(stats.mean_, 2.f);
+}
+
+TEST_F(MockHipRuntime, StreamsHaveTheirOwnClock)
+{
+    hipStream_t stream;
+    hip_check_error(hipStreamCreate(&stream));
+
+    StreamConfig config{stream};
+    launch_and_time_kernel(config, kernel_b, dim3(1), dim3(64), 0, 0);
+
+    EXPECT_GT(Runtime::Get().GetClock(stream), 0.f);
+    EXPECT_EQ(Runtime::Get().GetClock(), 0.f);
+    EXPECT_EQ(Runtime::Get().GetLaunches()[0].stream_, stream);
+
+    hip_check_error(hipStreamDestroy(stream));
+}
+
+TEST_F(MockHipRuntime, DeviceProperties)
+{
+    EXPECT_EQ(ck::get_device_name(), "gfx942");
+    EXPECT_TRUE(ck::is_xdl_supported());
+    EXPECT_EQ(getAvailableComputeUnitCount(StreamConfig{}), 304);
+
+    Runtime::Get().SetArchName("gfx1100", 48);
+    EXPECT_EQ(ck::get_device_name(), "gfx1100");
+    EXPECT_TRUE(ck::is_gfx11_supported());
+    EXPECT_FALSE(ck::is_xdl_supported());
+    EXPECT_EQ(getAvailableComputeUnitCount(StreamConfig{}), 48);
+}
+
+TEST_F(MockHipRuntime, DeviceNameOverride)
+{
+    EXPECT_FALSE(ck::has_device_name_override());
+
+    ck::set_device_name_override("gfx90a");
+    EXPECT_TRUE(ck::has_device_name_override());
+    EXPECT_EQ(ck::get_device_name(), "gfx90a");
+    EXPECT_TRUE(ck::is_xdl_supported());
+
+    // whatever the runtime reports
+    Runtime::Get().SetArchName("gfx1100", 48);
+    EXPECT_EQ(ck::get_device_name(), "gfx90a");
+
+    ck::set_device_name_override("");
+    EXPECT_FALSE(ck::has_device_name_override());
+    EXPECT_EQ(ck::get_device_name(), "gfx1100");
+}
@@ -0,0 +1,190 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "ck/library/utility/host_quantization.hpp"
+
+using ck::f8_t;
+using ck::half_t;
+using ck::pk_i4_t;
+using ck::utils::QuantBlock;
+using ck::utils::QuantizationConfig;
+using ck::utils::QuantRoundingMode;
+
+namespace {
+
+Tensor<float> MakeNormal(std::size_t rows, std::size_t cols, unsigned seed)
+{
+    Tensor<float> x({rows, cols});
+    std::mt19937 gen(seed);
+    std::normal_distribution<float> dist;
+    for(auto& v : x.mData)
+        v = dist(gen);
+    return x;
+}
+
+float MaxAbsDiff(const Tensor<float>& a, const Tensor<float>& b)
+{
+    float err = 0;
+    for(std::size_t i = 0; i < a.mData.size(); ++i)
+        err = std::max(err, std::abs(a.mData[i] - b.mData[i]));
+    return err;
+}
+
+} // namespace
+
+TEST(HostQuantization, ScaleLengths)
+{
+    const auto block_lens = ck::utils::GetQuantScaleLengths(300, 200, QuantBlock::Block2D(128, 64));
+    EXPECT_EQ(block_lens[0], 3);
+    EXPECT_EQ(block_lens[1], 4);
+
+    const auto row_lens = ck::utils::GetQuantScaleLengths(300, 200, QuantBlock::PerRow());
+    EXPECT_EQ(row_lens[0], 300);
+    EXPECT_EQ(row_lens[1], 1);
+
+    const auto tensor_lens = ck::utils::GetQuantScaleLengths(300, 200, QuantBlock::PerTensor());
+    EXPECT_EQ(tensor_lens[0], 1);
+    EXPECT_EQ(tensor_lens[1], 1);
+}
+
+TEST(HostQuantization, Int8PerRowRoundTrip)
+{
+    const auto x = MakeNormal(64, 96, 1);
+
+    Tensor<int8_t> q({64, 96});
+    Tensor<float> scale({64, 1});
+    Tensor<float> y({64, 96});
+
+    QuantizationConfig config;
+    config.block = QuantBlock::PerRow();
+
+    ck::utils::Quantize(x, q, scale, config);
+    ck::utils::Dequantize(q, scale, y, config.block);
+
+    for(std::size_t m = 0; m < 64; ++m)
+    {
+        float amax = 0;
+        for(std::size_t k = 0; k < 96; ++k)
+            amax = std::max(amax, std::abs(x(m, k)));
+        EXPECT_FLOAT_EQ(scale(m, 0), amax / 127.f);
+
+        // round to nearest is off by at most half a step
+        for(std::size_t k = 0; k < 96; ++k)
+            EXPECT_LE(std::abs(y(m, k) - x(m, k)), 0.5f * scale(m, 0) * (1.f + 1e-5f));
+    }
+}
+
+TEST(HostQuantization, StochasticRoundingIsUnbiased)
+{
+    Tensor<float> x({128, 128});
+    for(auto& v : x.mData)
+        v = 0.3f;
+    // pin the scale to 1 so the grid is the integers
+    x.mData[0] = 127.f;
+
+    Tensor<int8_t> q({128, 128});
+    Tensor<float> scale({1, 1});
+
+    QuantizationConfig config;
+    config.block    = QuantBlock::PerTensor();
+    config.rounding = QuantRoundingMode::Stochastic;
+
+    ck::utils::Quantize(x, q, scale, config);
+    ASSERT_FLOAT_EQ(scale.mData[0], 1.f);
+
+    double sum = 0;
+    for(std::size_t i = 1; i < q.mData.size(); ++i)
+    {
+        EXPECT_TRUE(q.mData[i] == 0 || q.mData[i] == 1);
+        sum += q.mData[i];
+    }
+    EXPECT_NEAR(sum / (q.mData.size() - 1), 0.3, 0.02);
+
+    // the same seed gives the same result
+    Tensor<int8_t> q2({128, 128});
+    ck::utils::Quantize(x, q2, scale, config);
+    EXPECT_EQ(q.mData, q2.mData);
+}
+
+TEST(HostQuantization, GemmABScaleFp8)
+{
+    constexpr ck::index_t M = 256, N = 384, K = 512;
+
+    const auto a = MakeNormal(M, K, 2);
+    const auto b = MakeNormal(K, N, 3);
+
+    const auto ops =
+        ck::utils::QuantizeGemmABScale<f8_t, float, f8_t, float>(a, b, 128, 128, 128);
+
+    EXPECT_EQ(ops.a_scale.mDesc.GetLengths()[0], 2);
+    EXPECT_EQ(ops.a_scale.mDesc.GetLengths()[1], 4);
+    EXPECT_EQ(ops.b_scale.mDesc.GetLengths()[0], 4);
+    EXPECT_EQ(ops.b_scale.mDesc.GetLengths()[1], 3);
+
+    Tensor<float> a_deq({M, K});
+    Tensor<float> b_deq({K, N});
+    ck::utils::Dequantize(ops.a_m_k, ops.a_scale, a_deq, QuantBlock::Block2D(128, 128));
+    ck::utils::Dequantize(ops.b_k_n, ops.b_scale, b_deq, QuantBlock::Block2D(128, 128));
+
+    // within a couple of fp8 ulps of the block maximum
+    EXPECT_LT(MaxAbsDiff(a, a_deq), 0.25f);
+    EXPECT_LT(MaxAbsDiff(b, b_deq), 0.25f);
+}
+
+TEST(HostQuantization, GemmABScaleLayouts)
+{
+    using Row = ck::tensor_layout::gemm::RowMajor;
+    using Col = ck::tensor_layout::gemm::ColumnMajor;
+
+    constexpr ck::index_t M = 256, N = 384, K = 512;
+
+    const auto a = MakeNormal(M, K, 2);
+    const auto b = MakeNormal(K, N, 3);
+
+    // 2 x 4 A scales, 4 x 3 B scales
+    const auto ops =
+        ck::utils::QuantizeGemmABScale<f8_t, float, f8_t, float, Col, Row>(a, b, 128, 128, 128);
+
+    EXPECT_EQ(ops.StrideA, M);
+    EXPECT_EQ(ops.StrideB, N);
+    EXPECT_EQ(ops.Scale_Stride_AM, 2);
+    EXPECT_EQ(ops.Scale_Stride_BN, 3);
+    EXPECT_EQ(ops.a_scale.mDesc.GetStrides()[1], 2);
+    EXPECT_EQ(ops.b_scale.mDesc.GetStrides()[0], 3);
+    EXPECT_EQ(ops.a_scale.mDesc.GetElementSpaceSize(), 2 * 4);
+    EXPECT_EQ(ops.b_scale.mDesc.GetElementSpaceSize(), 4 * 3);
+
+    const auto ref = ck::utils::QuantizeGemmABScale<f8_t, float, f8_t, float>(a, b, 128, 128, 128);
+    for(std::size_t i = 0; i < 2; ++i)
+        for(std::size_t j = 0; j < 4; ++j)
+            EXPECT_EQ(ops.a_scale(i, j), ref.a_scale(i, j));
+    for(std::size_t i = 0; i < 4; ++i)
+        for(std::size_t j = 0; j < 3; ++j)
+            EXPECT_EQ(ops.b_scale(i, j), ref.b_scale(i, j));
+}
+
+TEST(HostQuantization, GemmBScalePkInt4)
+{
+    constexpr ck::index_t N = 64, K = 256;
+
+    const auto b = MakeNormal(K, N, 4);
+
+    const auto ops = ck::utils::QuantizeGemmBScale<half_t>(b, 1, 128);
+
+    Tensor<float> b_deq({K, N});
+    ck::utils::Dequantize(ops.b_k_n, ops.b_scale, b_deq, QuantBlock::Block2D(128, 1));
+
+    for(std::size_t n = 0; n < N; ++n)
+        for(std::size_t kb = 0; kb < K / 128; ++kb)
+        {
+            const float s = ck::type_convert<float>(ops.b_scale(kb, n));
+            for(std::size_t k = kb * 128; k < (kb + 1) * 128; ++k)
+                EXPECT_LE(std::abs(b_deq(k, n) - b(k, n)), 0.5f * s * 1.01f);
+        }
+}
@@ -0,0 +1,207 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <random>
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include "ck/library/utility/host_weight_packing.hpp"
+
+using ck::half_t;
+using ck::index_t;
+using ck::pk_i4_t;
+using ck::utils::WeightPackingSpec;
+
+using Row = ck::tensor_layout::gemm::RowMajor;
+using Col = ck::tensor_layout::gemm::ColumnMajor;
+
+namespace {
+
+Tensor<int8_t> MakeWeight(std::size_t K, std::size_t N, int lo, int hi, unsigned seed)
+{
+    // row major, the packer must not depend on the source layout
+    Tensor<int8_t> w({K, N});
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<int> dist(lo, hi);
+    for(auto& v : w.mData)
+        v = static_cast<int8_t>(dist(gen));
+    return w;
+}
+
+// the reference path of example/01_gemm: column major pk_i4 B, then the nibble permute
+Tensor<pk_i4_t> MakeReferencePkI4(const Tensor<int8_t>& w)
+{
+    const std::size_t K = w.mDesc.GetLengths()[0];
+    const std::size_t N = w.mDesc.GetLengths()[1];
+
+    Tensor<pk_i4_t> b(ck::utils::MakeGemmOperandDescriptor(K, N, K, Col{}));
+    for(std::size_t n = 0; n < N; ++n)
+        for(std::size_t k = 0; k < K; k += 2)
+            b.mData[(n * K + k) / 2] =
+                static_cast<int8_t>(((w(k, n) + 8) << 4) | ((w(k + 1, n) + 8) & 0xf));
+
+    ck::utils::PermutePkI4ForGemm(b);
+    return b;
+}
+
+} // namespace
+
+TEST(WeightPacking, PkI4MatchesExamplePermute)
+{
+    const auto w   = MakeWeight(256, 96, -8, 7, 1);
+    const auto ref = MakeReferencePkI4(w);
+
+    const auto packed =
+        ck::utils::PackWeight<pk_i4_t, half_t>(w, nullptr, nullptr, WeightPackingSpec::PkI4());
+
+    EXPECT_EQ(packed.StrideB, 256);
+    ASSERT_EQ(packed.b_k_n.mData.size(), ref.mData.size());
+    for(std::size_t i = 0; i < ref.mData.size(); ++i)
+        ASSERT_EQ(packed.b_k_n.mData[i].data, ref.mData[i].data) << i;
+}
+
+TEST(WeightPacking, PkI4PermuteBTiling)
+{
+    constexpr std::size_t K = 256, N = 48, K1 = 128;
+
+    const auto w   = MakeWeight(K, N, -8, 7, 2);
+    const auto ref = MakeReferencePkI4(w);
+
+    const auto packed =
+        ck::utils::PackWeight<pk_i4_t, half_t>(w, nullptr, nullptr, WeightPackingSpec::PkI4(K1));
+
+    // K0 x N x K1, as in example/01_gemm with PermuteB = true
+    for(std::size_t j = 0; j < K / K1; ++j)
+        for(std::size_t n = 0; n < N; ++n)
+            for(std::size_t jj = 0; jj < K1; jj += 2)
+                ASSERT_EQ(packed.b_k_n.mData[(j * N * K1 + n * K1 + jj) / 2].data,
+                          ref.mData[(n * K + j * K1 + jj) / 2].data);
+}
+
+TEST(WeightPacking, BScaleAndZeroPoints)
+{
+    constexpr index_t K = 256, N = 32;
+
+    // unsigned 4 bit weights with a zero point per 128 x 1 block
+    const auto w = MakeWeight(K, N, 4, 11, 3);
+
+    Tensor<float> scale({K / 128, N});
+    Tensor<int8_t> zero_point({K / 128, N});
+    for(auto& s : scale.mData)
+        s = 0.25f;
+    for(auto& z : zero_point.mData)
+        z = 7;
+
+    const auto packed = ck::utils::PackWeight<pk_i4_t, half_t>(
+        w, &scale, &zero_point, WeightPackingSpec::PkI4BScale(128));
+
+    EXPECT_EQ(packed.StrideScale, 2);
+    EXPECT_EQ(packed.scale.mDesc.GetStrides()[1], 2);
+    EXPECT_EQ(ck::type_convert<float>(packed.scale(1, 5)), 0.25f);
+
+    Tensor<int8_t> folded({K, N});
+    for(index_t k = 0; k < K; ++k)
+        for(index_t n = 0; n < N; ++n)
+            folded(k, n) = w(k, n) - 7;
+
+    const auto ref = MakeReferencePkI4(folded);
+    EXPECT_EQ(packed.b_k_n.mData.size(), ref.mData.size());
+    for(std::size_t i = 0; i < ref.mData.size(); ++i)
+        ASSERT_EQ(packed.b_k_n.mData[i].data, ref.mData[i].data);
+
+    // without the zero points the values do not fit int4
+    EXPECT_THROW((ck::utils::PackWeight<pk_i4_t, half_t>(
+                     w, &scale, nullptr, WeightPackingSpec::PkI4BScale(128))),
+                 std::runtime_error);
+}
+
+TEST(WeightPacking, FpAintB)
+{
+    constexpr index_t K = 64, N = 40;
+
+    const auto w = MakeWeight(K, N, -128, 127, 4);
+
+    Tensor<float> scale({1, N});
+    for(index_t n = 0; n < N; ++n)
+        scale(0, n) = 0.5f + n;
+
+    const auto packed = ck::utils::PackWeight<uint8_t, half_t>(w, scale, WeightPackingSpec{});
+
+    for(index_t k = 0; k < K; ++k)
+        for(index_t n = 0; n < N; ++n)
+            ASSERT_EQ(packed.b_k_n(k, n), static_cast<uint8_t>(w(k, n) + 128));
+
+    // broadcast [1, N] scale of example/64_fpAintB_gemm
+    EXPECT_EQ(packed.StrideScale, 0);
+    EXPECT_EQ(packed.scale.mData.size(), N);
+    EXPECT_EQ(ck::type_convert<float>(packed.scale(17, 3)), 3.5f);
+
+    // one scale per column only
+    Tensor<float> block_scale({2, N});
+    EXPECT_THROW((ck::utils::PackWeight<uint8_t, half_t>(
+                     w, block_scale, WeightPackingSpec::PkI4BScale(32))),
+                 std::runtime_error);
+}
+
+TEST(WeightPacking, Int8RowMajor)
+{
+    const auto w = MakeWeight(64, 40, -128, 127, 5);
+
+    const auto packed = ck::utils::PackWeight<int8_t, float, Row>(w, nullptr, nullptr);
+
+    EXPECT_EQ(packed.StrideB, 40);
+    EXPECT_EQ(packed.b_k_n.mData, w.mData);
+}
+
+TEST(WeightPacking, KeyDoesNotDependOnThreads)
+{
+    const auto w = MakeWeight(1024, 1536, -8, 7, 6);
+
+    WeightPackingSpec spec = WeightPackingSpec::PkI4();
+    spec.num_thread        = 1;
+    const auto key1 =
+        ck::utils::GetWeightPackingKey<pk_i4_t, half_t, Col>(w, nullptr, nullptr, spec);
+    spec.num_thread = 7;
+    const auto key7 =
+        ck::utils::GetWeightPackingKey<pk_i4_t, half_t, Col>(w, nullptr, nullptr, spec);
+    EXPECT_EQ(key1, key7);
+
+    spec.k_per_block = 128;
+    EXPECT_NE(key1,
+              (ck::utils::GetWeightPackingKey<pk_i4_t, half_t, Col>(w, nullptr, nullptr, spec)));
+
+    auto w2 = w;
+    w2.mData.back() ^= 1;
+    spec.k_per_block = 0;
+    EXPECT_NE(key1,
+              (ck::utils::GetWeightPackingKey<pk_i4_t, half_t, Col>(w2, nullptr, nullptr, spec)));
+}
+
+TEST(WeightPacking, Cache)
+{
+    const auto w1 = MakeWeight(256, 64, -8, 7, 7);
+    const auto w2 = MakeWeight(256, 64, -8, 7, 8);
+
+    // room for one packed weight: 256 * 64 / 2 bytes plus one half scale
+    ck::utils::WeightPackingCache<pk_i4_t, half_t> cache(256 * 64 / 2 + 2);
+
+    const auto p1       = cache.GetOrPack(w1, nullptr, nullptr);
+    const auto p1_again = cache.GetOrPack(w1, nullptr, nullptr);
+    EXPECT_EQ(p1, p1_again);
+    EXPECT_EQ(cache.GetNumHits(), 1);
+    EXPECT_EQ(cache.GetNumMisses(), 1);
+
+    const auto p2 = cache.GetOrPack(w2, nullptr, nullptr);
+    EXPECT_NE(p1, p2);
+    EXPECT_EQ(cache.GetNumEntries(), 1);
+    EXPECT_EQ(cache.Find(p1->key), nullptr);
+    EXPECT_EQ(cache.Find(p2->key), p2);
+
+    // evicted entries stay valid while referenced
+    EXPECT_EQ(p1->b_k_n.mData.size(), 256 * 64 / 2);
+
+    cache.Clear();
+    EXPECT_EQ(cache.GetNumEntries(), 0);
+    EXPECT_EQ(cache.GetSizeInBytes(), 0);
+}
@@ -0,0 +1,329 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <cmath>
+#include <cstddef>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "ck/ck.hpp"
+#include "ck/tensor_operation/gpu/element/element_wise_operation.hpp"
+
+#include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_accumulation.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_conv_fwd.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_gemm.hpp"
+
+namespace {
+
+using ck::index_t;
+using ck::tensor_operation::host::accumulate_products;
+using ck::tensor_operation::host::AccumulationMode;
+using ck::tensor_operation::host::AccumulationPolicy;
+using ck::tensor_operation::host::get_accumulation_error_report;
+using ck::tensor_operation::host::make_split_k_accumulation_policy;
+using ck::tensor_operation::host::make_stream_k_accumulation_policy;
+using ck::tensor_operation::host::make_universal_split_k_accumulation_policy;
+
+using PassThrough = ck::tensor_operation::element_wise::PassThrough;
+
+using ReferenceGemm = ck::tensor_operation::host::
+    ReferenceGemm<float, float, float, float, PassThrough, PassThrough, PassThrough>;
+
+// values of very different magnitudes, so the order of the sums shows
+void FillSpread(Tensor<float>& t, int seed)
+{
+    int i = seed;
+    for(auto& v : t.mData)
+    {
+        v = std::ldexp(static_cast<float>((i * 7) % 13 - 6), (i * 5) % 17 - 8) + 0.1f;
+        ++i;
+    }
+}
+
+// small integers, so every order of the sums is exact
+void FillExact(Tensor<float>& t, int seed)
+{
+    int i = seed;
+    for(auto& v : t.mData)
+        v = static_cast<float>((i++ * 5) % 9 - 4);
+}
+
+std::vector<float> MakeProducts(index_t K)
+{
+    Tensor<float> p(HostTensorDescriptor({static_cast<std::size_t>(K)}));
+    FillSpread(p, 1);
+    return p.mData;
+}
+
+float Accumulate(const std::vector<float>& products, const AccumulationPolicy& policy)
+{
+    return accumulate_products<float>(
+        static_cast<index_t>(products.size()), policy, [&](auto k, float& a, float& b) {
+            a = products[k];
+            b = 1.f;
+        });
+}
+
+Tensor<float> RunGemm(const Tensor<float>& a,
+                      const Tensor<float>& b,
+                      const AccumulationPolicy& policy = {})
+{
+    Tensor<float> c(HostTensorDescriptor({a.mDesc.GetLengths()[0], b.mDesc.GetLengths()[1]}));
+
+    auto ref = ReferenceGemm{};
+    ref.MakeInvoker().Run(
+        ref.MakeArgument(a, b, c, PassThrough{}, PassThrough{}, PassThrough{}, policy));
+    return c;
+}
+
+} // namespace
+
+TEST(ReferenceAccumulation, Policies)
+{
+    const auto split_k = make_split_k_accumulation_policy(100, 8, 3);
+    EXPECT_EQ(split_k.k_per_block, 8);
+    EXPECT_EQ(split_k.k_split_begins, (std::vector<index_t>{0, 40, 80}));
+    EXPECT_FALSE(split_k.IsDefault());
+
+    const auto stream_k = make_stream_k_accumulation_policy(16, {0, 3, 5});
+    EXPECT_EQ(stream_k.k_split_begins, (std::vector<index_t>{0, 48, 80}));
+
+    EXPECT_TRUE(AccumulationPolicy{}.IsDefault());
+    EXPECT_TRUE((AccumulationPolicy{AccumulationMode::Sequential, 0, {0}}.IsDefault()));
+    EXPECT_FALSE((AccumulationPolicy{AccumulationMode::Kahan, 0, {}}.IsDefault()));
+
+    // the universal GEMMs cut K at multiples of lcm(AK1, BK1), not of KPerBlock
+    const auto universal = make_universal_split_k_accumulation_policy(4096, 64, 8, 3);
+    EXPECT_EQ(universal.k_per_block, 64);
+    EXPECT_EQ(universal.k_split_begins, (std::vector<index_t>{0, 1368, 2736}));
+    EXPECT_EQ(make_universal_split_k_accumulation_policy(100, 32, 4, 4).k_split_begins,
+              (std::vector<index_t>{0, 28, 56, 84}));
+    // the batches past K are empty
+    EXPECT_EQ(make_universal_split_k_accumulation_policy(10, 32, 8, 4).k_split_begins,
+              (std::vector<index_t>{0, 8}));
+
+    EXPECT_THROW(make_split_k_accumulation_policy(100, 0, 3), std::runtime_error);
+    EXPECT_THROW(make_universal_split_k_accumulation_policy(100, 32, 0, 3), std::runtime_error);
+}
+
+TEST(ReferenceAccumulation, Order)
+{
+    const auto products = MakeProducts(100);
+
+    float sequential = 0;
+    for(float p : products)
+        sequential += p;
+    EXPECT_EQ(Accumulate(products, {}), sequential);
+
+    // split-K: three batches of K tiles of 8, the batch results added in order
+    float split_k = 0;
+    for(std::size_t begin : {0, 40, 80})
+    {
+        float batch = 0;
+        for(std::size_t k0 = begin; k0 < std::min<std::size_t>(begin + 40, 100); k0 += 8)
+        {
+            float tile = 0;
+            for(std::size_t k = k0; k < std::min<std::size_t>(k0 + 8, 100); ++k)
+                tile += products[k];
+            batch += tile;
+        }
+        split_k += batch;
+    }
+    EXPECT_EQ(Accumulate(products, make_split_k_accumulation_policy(100, 8, 3)), split_k);
+
+    // the tiles of a range start at the range, wherever it begins
+    auto sum = [&](std::size_t k0, std::size_t k1) {
+        float v_acc = 0;
+        for(std::size_t k = k0; k < k1; ++k)
+            v_acc += products[k];
+        return v_acc;
+    };
+    const float first_range  = sum(0, 8) + sum(8, 10);
+    const float second_range = (sum(10, 18) + sum(18, 26)) + sum(26, 30);
+    const std::vector<float> head(products.begin(), products.begin() + 30);
+    EXPECT_EQ(Accumulate(head, {AccumulationMode::Sequential, 8, {0, 10}}),
+              first_range + second_range);
+
+    // universal split-K: batches of 28, not a multiple of the K tiles of 8, each running its tiles
+    // from its own start
+    float universal = 0;
+    for(std::size_t begin : {0, 28, 56, 84})
+    {
+        const std::size_t end = std::min<std::size_t>(begin + 28, 100);
+        float batch           = 0;
+        for(std::size_t k0 = begin; k0 < end; k0 += 8)
+            batch += sum(k0, std::min(k0 + 8, end));
+        universal += batch;
+    }
+    EXPECT_EQ(Accumulate(products, make_universal_split_k_accumulation_policy(100, 8, 4, 4)),
+              universal);
+
+    const float pairwise_4 = ((products[0] + products[1]) + (products[2] + products[3]));
+    const std::vector<float> four(products.begin(), products.begin() + 4);
+    EXPECT_EQ(Accumulate(four, {AccumulationMode::Pairwise, 0, {}}), pairwise_4);
+
+    EXPECT_THROW(Accumulate(products, {AccumulationMode::Sequential, 0, {50, 20}}),
+                 std::runtime_error);
+    EXPECT_THROW(Accumulate(products, {AccumulationMode::Sequential, 0, {0, 101}}),
+                 std::runtime_error);
+}
+
+TEST(ReferenceAccumulation, Modes)
+{
+    // one large value then many small ones, each lost against the running sum
+    std::vector<float> products(20001, 1e-8f);
+    products[0] = 1.f;
+    const double exact = 1. + 20000 * static_cast<double>(1e-8f);
+
+    const float sequential = Accumulate(products, {});
+    const float kahan      = Accumulate(products, {AccumulationMode::Kahan, 0, {}});
+    const float pairwise   = Accumulate(products, {AccumulationMode::Pairwise, 0, {}});
+    const float fp64       = Accumulate(products, {AccumulationMode::Fp64, 0, {}});
+
+    EXPECT_EQ(sequential, 1.f);
+    EXPECT_EQ(fp64, static_cast<float>(exact));
+    EXPECT_EQ(kahan, fp64);
+    EXPECT_NEAR(pairwise, exact, 1e-6);
+
+    // the tiles of split-K catch part of the small values
+    const float split_k = Accumulate(products, make_split_k_accumulation_policy(20001, 256, 4));
+    EXPECT_GT(split_k, sequential);
+    EXPECT_LT(std::abs(split_k - exact), std::abs(sequential - exact));
+}
+
+TEST(ReferenceAccumulation, Gemm)
+{
+    const std::size_t M = 5, N = 7, K = 300;
+
+    Tensor<float> a(HostTensorDescriptor({M, K})), b(HostTensorDescriptor({K, N}));
+    FillSpread(a, 0);
+    FillSpread(b, 3);
+
+    // the default policy is the plain loop
+    const auto c = RunGemm(a, b);
+    for(std::size_t m = 0; m < M; ++m)
+        for(std::size_t n = 0; n < N; ++n)
+        {
+            float v_acc = 0;
+            for(std::size_t k = 0; k < K; ++k)
+                v_acc += a(m, k) * b(k, n);
+            ASSERT_EQ(c(m, n), v_acc);
+        }
+
+    const auto policy  = make_split_k_accumulation_policy(K, 32, 4);
+    const auto split_k = RunGemm(a, b, policy);
+    for(std::size_t m = 0; m < M; ++m)
+        for(std::size_t n = 0; n < N; ++n)
+        {
+            std::vector<float> products(K);
+            for(std::size_t k = 0; k < K; ++k)
+                products[k] = a(m, k) * b(k, n);
+            ASSERT_EQ(split_k(m, n), Accumulate(products, policy));
+        }
+
+    // the emulated order is within its own error of the oracle
+    const auto oracle = RunGemm(a, b, {AccumulationMode::Fp64, 0, {}});
+    const auto report = get_accumulation_error_report(split_k, split_k, oracle);
+    EXPECT_EQ(report.num_elements, M * N);
+    EXPECT_EQ(report.num_over_budget, 0);
+    EXPECT_EQ(report.max_observed_error, report.max_expected_error);
+    EXPECT_GT(report.max_observed_error, 0.);
+}
+
+TEST(ReferenceAccumulation, ErrorReport)
+{
+    Tensor<float> oracle(HostTensorDescriptor({std::size_t{4}}));
+    Tensor<float> emulated(oracle.mDesc), result(oracle.mDesc);
+    oracle.mData   = {1.f, -2.f, 4.f, 8.f};
+    emulated.mData = {1.f, -2.f, 4.f + std::ldexp(1.f, -18), 8.f};
+
+    // off by the emulated error, and by an ulp of the output type
+    result.mData = {1.f, -2.f + std::ldexp(1.f, -22), 4.f - std::ldexp(1.f, -18), 8.f};
+    auto report  = get_accumulation_error_report(result, emulated, oracle);
+    EXPECT_EQ(report.num_over_budget, 0);
+    EXPECT_DOUBLE_EQ(report.max_abs_oracle, 8.);
+    EXPECT_DOUBLE_EQ(report.max_expected_error, std::ldexp(1., -18));
+    EXPECT_DOUBLE_EQ(report.max_observed_error, std::ldexp(1., -18));
+    EXPECT_DOUBLE_EQ(report.GetRelativeThreshold(), std::ldexp(1., -21));
+
+    // past the budget
+    result.mData[3] = 8.f + std::ldexp(1.f, -10);
+    report          = get_accumulation_error_report(result, emulated, oracle);
+    EXPECT_EQ(report.num_over_budget, 1);
+    EXPECT_DOUBLE_EQ(report.max_observed_error, std::ldexp(1., -10));
+
+    std::ostringstream os;
+    report.Print(os);
+    EXPECT_NE(os.str().find("1 of 4 elements over budget"), std::string::npos) << os.str();
+
+    Tensor<float> other(HostTensorDescriptor({std::size_t{3}}));
+    EXPECT_THROW(get_accumulation_error_report(other, emulated, oracle), std::runtime_error);
+}
+
+TEST(ReferenceAccumulation, ConvFwd)
+{
+    using ReferenceConvFwd = ck::tensor_operation::host::
+        ReferenceConvFwd<2, float, float, float, PassThrough, PassThrough, PassThrough>;
+
+    // [G, N, C, Hi, Wi], [G, K, C, Y, X], [G, N, K, Ho, Wo]; 3x3 filter, stride 2, padding 1
+    const std::size_t G = 2, N = 2, C = 5, K = 3, Hi = 7, Wi = 6, Y = 3, X = 3, Ho = 4, Wo = 3;
+
+    Tensor<float> in(HostTensorDescriptor({G, N, C, Hi, Wi}));
+    Tensor<float> wei(HostTensorDescriptor({G, K, C, Y, X}));
+    FillExact(in, 0);
+    FillExact(wei, 2);
+
+    auto run = [&](const AccumulationPolicy& policy) {
+        Tensor<float> out(HostTensorDescriptor({G, N, K, Ho, Wo}));
+        auto ref = ReferenceConvFwd{};
+        ref.MakeInvoker().Run(ref.MakeArgument(in,
+                                               wei,
+                                               out,
+                                               {2, 2},
+                                               {1, 1},
+                                               {1, 1},
+                                               {1, 1},
+                                               PassThrough{},
+                                               PassThrough{},
+                                               PassThrough{},
+                                               {},
+                                               {},
+                                               {},
+                                               policy));
+        return out;
+    };
+
+    // exact sums: the GEMM K path indexes as the loops do
+    const auto out = run({});
+    EXPECT_EQ(run({AccumulationMode::Fp64, 0, {}}).mData, out.mData);
+    EXPECT_EQ(run(make_split_k_accumulation_policy(Y * X * C, 8, 2)).mData, out.mData);
+
+    // [Y, X, C] order, padding adding zeros
+    FillSpread(in, 0);
+    FillSpread(wei, 2);
+    const auto policy  = make_split_k_accumulation_policy(Y * X * C, 8, 2);
+    const auto split_k = run(policy);
+    for(std::size_t g = 0; g < G; ++g)
+        for(std::size_t n = 0; n < N; ++n)
+            for(std::size_t k = 0; k < K; ++k)
+                for(std::size_t ho = 0; ho < Ho; ++ho)
+                    for(std::size_t wo = 0; wo < Wo; ++wo)
+                    {
+                        std::vector<float> products;
+                        for(std::size_t y = 0; y < Y; ++y)
+                            for(std::size_t x = 0; x < X; ++x)
+                                for(std::size_t c = 0; c < C; ++c)
+                                {
+                                    const long hi = ho * 2 + y - 1, wi = wo * 2 + x - 1;
+                                    const bool in_range =
+                                        hi >= 0 && hi < long(Hi) && wi >= 0 && wi < long(Wi);
+                                    products.push_back(
+                                        in_range ? in(g, n, c, hi, wi) * wei(g, k, c, y, x) : 0.f);
+                                }
+                        ASSERT_EQ(split_k(g, n, k, ho, wo), Accumulate(products, policy));
+                    }
+}
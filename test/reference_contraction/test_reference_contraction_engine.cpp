@@ -0,0 +1,257 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <complex>
+#include <cstddef>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "ck/ck.hpp"
+#include "ck/tensor_operation/gpu/element/element_wise_operation.hpp"
+
+#include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_contraction.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_contraction_engine.hpp"
+
+namespace {
+
+using PassThrough = ck::tensor_operation::element_wise::PassThrough;
+using Scale       = ck::tensor_operation::element_wise::Scale;
+using Bilinear    = ck::tensor_operation::element_wise::Bilinear;
+
+using ck::tensor_operation::host::ReferenceContractionEngine;
+using ck::tensor_operation::host::split_complex;
+
+// small integers, so that every sum is exact whatever its order
+template <typename T>
+void FillSeq(Tensor<T>& t, int seed)
+{
+    int i = seed;
+    for(auto& v : t.mData)
+        v = static_cast<T>((i++ * 7) % 11 - 5);
+}
+
+// sum over every index of every mode, one element at a time
+template <typename T>
+std::vector<std::complex<double>> NaiveContraction(const std::string& spec,
+                                                   const Tensor<T>& a_re,
+                                                   const Tensor<T>& a_im,
+                                                   const Tensor<T>& b_re,
+                                                   const Tensor<T>& b_im,
+                                                   const HostTensorDescriptor& c_desc)
+{
+    const auto comma     = spec.find(',');
+    const auto arrow     = spec.find("->");
+    const auto a_modes   = spec.substr(0, comma);
+    const auto b_modes   = spec.substr(comma + 1, arrow - comma - 1);
+    const auto c_modes   = spec.substr(arrow + 2);
+    const auto all_modes = a_modes + b_modes + c_modes;
+
+    std::map<char, std::size_t> lengths;
+    for(std::size_t i = 0; i < a_modes.size(); ++i)
+        lengths[a_modes[i]] = a_re.mDesc.GetLengths()[i];
+    for(std::size_t i = 0; i < b_modes.size(); ++i)
+        lengths[b_modes[i]] = b_re.mDesc.GetLengths()[i];
+
+    auto offset = [&](const std::string& modes,
+                      const HostTensorDescriptor& desc,
+                      const std::map<char, std::size_t>& index) {
+        std::size_t o = 0;
+        for(std::size_t i = 0; i < modes.size(); ++i)
+            o += index.at(modes[i]) * desc.GetStrides()[i];
+        return o;
+    };
+
+    std::vector<std::complex<double>> c(c_desc.GetElementSpaceSize());
+    std::map<char, std::size_t> index;
+    for(const auto& [mode, length] : lengths)
+        index[mode] = 0;
+
+    while(true)
+    {
+        const auto ia = offset(a_modes, a_re.mDesc, index);
+        const auto ib = offset(b_modes, b_re.mDesc, index);
+        c[offset(c_modes, c_desc, index)] +=
+            std::complex<double>(a_re.mData[ia], a_im.mData[ia]) *
+            std::complex<double>(b_re.mData[ib], b_im.mData[ib]);
+
+        auto it = index.begin();
+        for(; it != index.end(); ++it)
+        {
+            if(++it->second < lengths[it->first])
+                break;
+            it->second = 0;
+        }
+        if(it == index.end())
+            break;
+    }
+
+    return c;
+}
+
+template <typename T>
+void ExpectRealContraction(const std::string& spec,
+                           const HostTensorDescriptor& a_desc,
+                           const HostTensorDescriptor& b_desc,
+                           const HostTensorDescriptor& c_desc)
+{
+    Tensor<T> a(a_desc), b(b_desc), zero_a(a_desc), zero_b(b_desc), c(c_desc);
+    FillSeq(a, 1);
+    FillSeq(b, 2);
+
+    ReferenceContractionEngine{spec, a_desc, b_desc, c_desc}.Run<T>(
+        a, b, c, PassThrough{}, PassThrough{}, [](T& e, const T& v) { e = v; });
+
+    const auto ref = NaiveContraction(spec, a, zero_a, b, zero_b, c_desc);
+    for(std::size_t i = 0; i < ref.size(); ++i)
+        ASSERT_EQ(c.mData[i], static_cast<T>(ref[i].real())) << spec << " at " << i;
+}
+
+} // namespace
+
+TEST(ReferenceContractionEngine, Plan)
+{
+    const ReferenceContractionEngine engine{"gmxk,kng->ngmx",
+                                            HostTensorDescriptor({2, 3, 4, 5}),
+                                            HostTensorDescriptor({5, 6, 2}),
+                                            HostTensorDescriptor({6, 2, 3, 4})};
+
+    const auto& plan = engine.GetPlan();
+    EXPECT_EQ(plan.GetGModes(), "g");
+    EXPECT_EQ(plan.GetMModes(), "mx");
+    EXPECT_EQ(plan.GetNModes(), "n");
+    EXPECT_EQ(plan.GetKModes(), "k");
+    EXPECT_EQ(plan.GetG(), 2);
+    EXPECT_EQ(plan.GetM(), 12);
+    EXPECT_EQ(plan.GetN(), 6);
+    EXPECT_EQ(plan.GetK(), 5);
+}
+
+TEST(ReferenceContractionEngine, Layouts)
+{
+    // plain GEMM, larger than a tile in every dimension
+    ExpectRealContraction<float>("mk,kn->mn",
+                                 HostTensorDescriptor({131, 300}),
+                                 HostTensorDescriptor({300, 67}),
+                                 HostTensorDescriptor({131, 67}));
+    // batch modes, permuted output and several modes per GEMM dimension
+    ExpectRealContraction<double>("gmxk,kng->ngmx",
+                                  HostTensorDescriptor({2, 3, 4, 5}),
+                                  HostTensorDescriptor({5, 6, 2}),
+                                  HostTensorDescriptor({6, 2, 3, 4}));
+    // strided operands: A transposed, C padded
+    ExpectRealContraction<float>("abkl,lkcd->acbd",
+                                 HostTensorDescriptor({3, 4, 5, 6}, {1, 3, 12 * 6, 12}),
+                                 HostTensorDescriptor({6, 5, 2, 7}),
+                                 HostTensorDescriptor({3, 2, 4, 7}, {200, 90, 20, 2}));
+    // no K modes: an outer product
+    ExpectRealContraction<float>("m,n->nm",
+                                 HostTensorDescriptor({9}),
+                                 HostTensorDescriptor({70}),
+                                 HostTensorDescriptor({70, 9}));
+}
+
+TEST(ReferenceContractionEngine, ReferenceContractionAnyRank)
+{
+    Tensor<float> a({2, 3, 1, 2, 4}), b({4, 1, 2, 4}), c({2, 3, 1, 4, 1});
+    FillSeq(a, 3);
+    FillSeq(b, 4);
+
+    using ReferenceOp = ck::tensor_operation::host::
+        ReferenceContraction_M2_N2_K2<3, 2, 2, float, float, float, float, float, Scale, Scale>;
+
+    auto ref_op  = ReferenceOp{};
+    auto invoker = ref_op.MakeInvoker();
+    invoker.Run(ref_op.MakeArgument(a, b, c, Scale{2.f}, Scale{0.5f}));
+
+    for(std::size_t m0 = 0; m0 < 2; ++m0)
+        for(std::size_t m1 = 0; m1 < 3; ++m1)
+            for(std::size_t n0 = 0; n0 < 4; ++n0)
+            {
+                float ref = 0;
+                for(std::size_t k0 = 0; k0 < 2; ++k0)
+                    for(std::size_t k1 = 0; k1 < 4; ++k1)
+                        ref += a(m0, m1, 0, k0, k1) * b(n0, 0, k0, k1);
+                EXPECT_EQ(c(m0, m1, 0, n0, 0), ref);
+            }
+}
+
+TEST(ReferenceContractionEngine, BilinearEpilogue)
+{
+    Tensor<float> a({5, 70}), b({3, 70, 2}), d({3, 5, 2}, {1, 9, 3}), e({3, 5, 2});
+    FillSeq(a, 5);
+    FillSeq(b, 6);
+    FillSeq(d, 7);
+
+    ReferenceContractionEngine{"mk,xky->xmy", a.mDesc, b.mDesc, e.mDesc}.Run<float>(
+        a, b, e, PassThrough{}, PassThrough{}, Bilinear{2.f, -1.f}, d);
+
+    for(std::size_t x = 0; x < 3; ++x)
+        for(std::size_t m = 0; m < 5; ++m)
+            for(std::size_t y = 0; y < 2; ++y)
+            {
+                float c = 0;
+                for(std::size_t k = 0; k < 70; ++k)
+                    c += a(m, k) * b(x, k, y);
+                EXPECT_EQ(e(x, m, y), 2.f * c - d(x, m, y));
+            }
+}
+
+TEST(ReferenceContractionEngine, Complex)
+{
+    const std::string spec = "mkg,nkg->gmn";
+    Tensor<float> a_re({70, 9, 2}), a_im({70, 9, 2}), b_re({3, 9, 2}), b_im({3, 9, 2});
+    Tensor<float> d_re({2, 70, 3}), d_im({2, 70, 3}), e_re({2, 70, 3}), e_im({2, 70, 3});
+    FillSeq(a_re, 1);
+    FillSeq(a_im, 2);
+    FillSeq(b_re, 3);
+    FillSeq(b_im, 4);
+    FillSeq(d_re, 5);
+    FillSeq(d_im, 6);
+
+    using Complex = std::complex<float>;
+    const Complex beta{0, 1};
+
+    ReferenceContractionEngine{spec, a_re.mDesc, b_re.mDesc, e_re.mDesc}.RunComplex<float>(
+        split_complex(a_re, a_im),
+        split_complex(b_re, b_im),
+        split_complex(e_re, e_im),
+        PassThrough{},
+        PassThrough{},
+        [&](Complex& e, const Complex& c, const Complex& d) { e = c + beta * d; },
+        split_complex(d_re, d_im));
+
+    const auto ref = NaiveContraction(spec, a_re, a_im, b_re, b_im, e_re.mDesc);
+    for(std::size_t i = 0; i < ref.size(); ++i)
+    {
+        const auto expected = ref[i] + std::complex<double>(-d_im.mData[i], d_re.mData[i]);
+        ASSERT_EQ(e_re.mData[i], static_cast<float>(expected.real())) << i;
+        ASSERT_EQ(e_im.mData[i], static_cast<float>(expected.imag())) << i;
+    }
+}
+
+TEST(ReferenceContractionEngine, InvalidSpec)
+{
+    const HostTensorDescriptor mk({2, 3}), kn({3, 4}), mn({2, 4}), nm({4, 2});
+
+    auto plan = [](const std::string& spec, auto a, auto b, auto c) {
+        ReferenceContractionEngine{spec, a, b, c};
+    };
+
+    EXPECT_NO_THROW(plan("mk,kn->mn", mk, kn, mn));
+    EXPECT_THROW(plan("mk,kn", mk, kn, mn), std::runtime_error);
+    EXPECT_THROW(plan("mk,kn->mnx", mk, kn, mn), std::runtime_error);
+    EXPECT_THROW(plan("mk,kn->mn", mk, kn, nm), std::runtime_error);
+    EXPECT_THROW(plan("mm,kn->mn", mk, kn, mn), std::runtime_error);
+    EXPECT_THROW(plan("mk,xn->mn", mk, kn, mn), std::runtime_error);
+    EXPECT_THROW(plan("m1,1n->mn", mk, kn, mn), std::runtime_error);
+
+    Tensor<float> a(mk), b(kn), c(mn), d(nm);
+    EXPECT_THROW(ReferenceContractionEngine("mk,kn->mn", mk, kn, mn)
+                     .Run<float>(a, b, c, PassThrough{}, PassThrough{}, Bilinear{}, d),
+                 std::runtime_error);
+}
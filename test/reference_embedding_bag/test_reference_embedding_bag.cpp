@@ -0,0 +1,347 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "ck/ck.hpp"
+
+#include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_embedding_bag_forward.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_sparse_embedding3_forward_layernorm.hpp"
+
+namespace {
+
+using ck::tensor_operation::host::EmbeddingBagPoolMode;
+using ck::tensor_operation::host::get_embedding_bag_gather_stats;
+
+using IndexType = int64_t;
+
+using ReferenceEmbeddingBag = ck::tensor_operation::host::
+    ReferenceEmbeddingBagForward<float, IndexType, float, float, float, float, float>;
+
+// small integers, so every pooling order gives the same sums
+void FillSeq(Tensor<float>& t, int seed)
+{
+    int i = seed;
+    for(auto& v : t.mData)
+        v = static_cast<float>((i++ * 7) % 11 - 5);
+}
+
+// the lookups of one table: bag b of sample b has (b * 5 + t) % 4 rows (some empty), most of them
+// among a few hot rows
+struct TableLookups
+{
+    TableLookups(std::size_t batch, std::size_t num_rows, int t)
+        : emb(HostTensorDescriptor({num_rows, std::size_t{24}})),
+          offsets(HostTensorDescriptor({batch + 1})),
+          indices(HostTensorDescriptor({std::size_t{0}})),
+          weights(HostTensorDescriptor({std::size_t{0}}))
+    {
+        FillSeq(emb, t);
+
+        std::vector<IndexType> rows;
+        for(std::size_t b = 0; b < batch; ++b)
+        {
+            offsets.mData[b] = rows.size();
+            for(std::size_t j = 0; j < (b * 5 + t) % 4; ++j)
+                rows.push_back(j % 2 == 0 ? (b + j) % 3 : (b * 13 + j * 7 + t) % num_rows);
+        }
+        offsets.mData[batch] = rows.size();
+
+        indices = Tensor<IndexType>(HostTensorDescriptor({rows.size()}));
+        weights = Tensor<float>(HostTensorDescriptor({rows.size()}));
+        indices.mData = rows;
+        for(std::size_t j = 0; j < rows.size(); ++j)
+            weights.mData[j] = static_cast<float>(j % 3) - 1.f;
+    }
+
+    Tensor<float> emb;
+    Tensor<IndexType> offsets;
+    Tensor<IndexType> indices;
+    Tensor<float> weights;
+};
+
+struct EmbeddingBagProblem
+{
+    EmbeddingBagProblem(std::size_t batch_, std::size_t num_tables) : batch(batch_)
+    {
+        for(std::size_t t = 0; t < num_tables; ++t)
+            tables.emplace_back(batch, 40 + t * 10, static_cast<int>(t));
+    }
+
+    std::vector<const Tensor<float>*> Embs() const
+    {
+        std::vector<const Tensor<float>*> embs;
+        for(const auto& t : tables)
+            embs.push_back(&t.emb);
+        return embs;
+    }
+    std::vector<const Tensor<IndexType>*> Indices() const
+    {
+        std::vector<const Tensor<IndexType>*> indices;
+        for(const auto& t : tables)
+            indices.push_back(&t.indices);
+        return indices;
+    }
+    std::vector<const Tensor<IndexType>*> Offsets() const
+    {
+        std::vector<const Tensor<IndexType>*> offsets;
+        for(const auto& t : tables)
+            offsets.push_back(&t.offsets);
+        return offsets;
+    }
+    std::vector<const Tensor<float>*> Weights() const
+    {
+        std::vector<const Tensor<float>*> weights;
+        for(const auto& t : tables)
+            weights.push_back(&t.weights);
+        return weights;
+    }
+
+    std::size_t batch;
+    std::vector<TableLookups> tables;
+};
+
+constexpr std::size_t kDim = 24;
+
+// one sample, one lookup at a time
+Tensor<float> NaiveEmbeddingBag(const EmbeddingBagProblem& p,
+                                EmbeddingBagPoolMode pool_mode,
+                                bool weighted,
+                                const Tensor<float>* gamma,
+                                const Tensor<float>* beta,
+                                float epsilon)
+{
+    Tensor<float> out(HostTensorDescriptor({p.batch, kDim}));
+    for(std::size_t b = 0; b < p.batch; ++b)
+    {
+        std::vector<float> x(kDim, 0.f);
+        for(const auto& t : p.tables)
+        {
+            const std::size_t begin = t.offsets.mData[b], end = t.offsets.mData[b + 1];
+            if(begin == end)
+                continue;
+            for(std::size_t d = 0; d < kDim; ++d)
+            {
+                float bag = pool_mode == EmbeddingBagPoolMode::Max
+                                ? std::numeric_limits<float>::lowest()
+                                : 0.f;
+                for(std::size_t j = begin; j < end; ++j)
+                {
+                    const float v = t.emb(t.indices.mData[j], d);
+                    if(pool_mode == EmbeddingBagPoolMode::Max)
+                        bag = std::max(bag, v);
+                    else
+                        bag += weighted ? t.weights.mData[j] * v : v;
+                }
+                if(pool_mode == EmbeddingBagPoolMode::Mean)
+                    bag /= static_cast<float>(end - begin);
+                x[d] += bag;
+            }
+        }
+
+        float mean = 0, var = 0;
+        for(float v : x)
+        {
+            mean += v;
+            var += v * v;
+        }
+        mean = mean / kDim;
+        var  = var / kDim - mean * mean;
+
+        for(std::size_t d = 0; d < kDim; ++d)
+            out(b, d) = gamma == nullptr
+                            ? x[d]
+                            : (x[d] - mean) / std::sqrt(var + epsilon) * gamma->mData[d] +
+                                  beta->mData[d];
+    }
+    return out;
+}
+
+void TestEmbeddingBag(const EmbeddingBagProblem& p,
+                      EmbeddingBagPoolMode pool_mode,
+                      bool weighted,
+                      bool layernorm)
+{
+    Tensor<float> gamma(HostTensorDescriptor({kDim})), beta(HostTensorDescriptor({kDim}));
+    FillSeq(gamma, 3);
+    FillSeq(beta, 4);
+    const float epsilon = 1e-4f;
+
+    Tensor<float> out(HostTensorDescriptor({p.batch, kDim}));
+
+    auto ref = ReferenceEmbeddingBag{};
+    ref.MakeInvoker().Run(ref.MakeArgument(out,
+                                           p.Embs(),
+                                           p.Indices(),
+                                           p.Offsets(),
+                                           weighted ? p.Weights()
+                                                    : std::vector<const Tensor<float>*>{},
+                                           pool_mode,
+                                           layernorm ? &gamma : nullptr,
+                                           layernorm ? &beta : nullptr,
+                                           epsilon));
+
+    const auto expected = NaiveEmbeddingBag(
+        p, pool_mode, weighted, layernorm ? &gamma : nullptr, layernorm ? &beta : nullptr, epsilon);
+    EXPECT_EQ(out.mData, expected.mData);
+}
+
+} // namespace
+
+TEST(ReferenceEmbeddingBag, Pooling)
+{
+    // three blocks of samples, the last one partial
+    const EmbeddingBagProblem p(150, 3);
+
+    TestEmbeddingBag(p, EmbeddingBagPoolMode::Sum, false, false);
+    TestEmbeddingBag(p, EmbeddingBagPoolMode::Sum, true, false);
+    TestEmbeddingBag(p, EmbeddingBagPoolMode::Mean, false, false);
+    TestEmbeddingBag(p, EmbeddingBagPoolMode::Max, false, false);
+}
+
+TEST(ReferenceEmbeddingBag, Layernorm)
+{
+    TestEmbeddingBag(EmbeddingBagProblem(70, 1), EmbeddingBagPoolMode::Sum, false, true);
+    TestEmbeddingBag(EmbeddingBagProblem(70, 4), EmbeddingBagPoolMode::Mean, false, true);
+}
+
+TEST(ReferenceEmbeddingBag, GatherStats)
+{
+    const EmbeddingBagProblem p(150, 2);
+
+    std::size_t num_lookups = 0;
+    for(const auto& t : p.tables)
+        num_lookups += t.indices.mData.size();
+
+    const auto stats = get_embedding_bag_gather_stats(p.Indices(), p.Offsets());
+    EXPECT_EQ(stats.num_lookups, num_lookups);
+    EXPECT_LT(stats.num_unique_rows, num_lookups);
+    EXPECT_GT(stats.Savings(), 0.);
+
+    // one hot row
+    Tensor<IndexType> offsets(HostTensorDescriptor({std::size_t{3}}));
+    Tensor<IndexType> indices(HostTensorDescriptor({std::size_t{8}}));
+    offsets.mData = {0, 5, 8};
+    indices.mData = {7, 7, 2, 7, 2, 7, 9, 7};
+
+    const auto hot = get_embedding_bag_gather_stats<IndexType>({&indices}, {&offsets});
+    EXPECT_EQ(hot.num_lookups, 8);
+    EXPECT_EQ(hot.num_unique_rows, 3);
+    EXPECT_DOUBLE_EQ(hot.Savings(), 5. / 8.);
+}
+
+TEST(ReferenceEmbeddingBag, InvalidArgument)
+{
+    const EmbeddingBagProblem p(10, 2);
+    Tensor<float> out(HostTensorDescriptor({p.batch, kDim}));
+
+    auto run = [&](const EmbeddingBagProblem& q,
+                   EmbeddingBagPoolMode pool_mode,
+                   const std::vector<const Tensor<float>*>& weights) {
+        auto ref = ReferenceEmbeddingBag{};
+        ref.MakeInvoker().Run(ref.MakeArgument(out,
+                                               q.Embs(),
+                                               q.Indices(),
+                                               q.Offsets(),
+                                               weights,
+                                               pool_mode,
+                                               nullptr,
+                                               nullptr,
+                                               1e-4f));
+    };
+
+    EXPECT_NO_THROW(run(p, EmbeddingBagPoolMode::Sum, p.Weights()));
+    EXPECT_THROW(run(p, EmbeddingBagPoolMode::Max, p.Weights()), std::runtime_error);
+
+    auto out_of_range = p;
+    out_of_range.tables[1].indices.mData.back() = 1000;
+    EXPECT_THROW(run(out_of_range, EmbeddingBagPoolMode::Sum, {}), std::runtime_error);
+
+    auto unsorted = p;
+    std::swap(unsorted.tables[0].offsets.mData[3], unsorted.tables[0].offsets.mData[5]);
+    EXPECT_THROW(run(unsorted, EmbeddingBagPoolMode::Sum, {}), std::runtime_error);
+}
+
+TEST(ReferenceEmbeddingBag, SparseEmbedding3)
+{
+    using ReferenceSparseEmbedding3 = ck::tensor_operation::host::
+        ReferenceSparseEmbedding3ForwardLayernorm<float, IndexType, float, float, float, float>;
+
+    const std::size_t num_rows = 50, L = 130;
+
+    std::vector<Tensor<float>> embs;
+    std::vector<Tensor<IndexType>> indices;
+    for(int t = 0; t < 3; ++t)
+    {
+        embs.emplace_back(HostTensorDescriptor({num_rows, kDim}));
+        FillSeq(embs.back(), t);
+        indices.emplace_back(HostTensorDescriptor({L}));
+        for(std::size_t i = 0; i < L; ++i)
+            indices.back().mData[i] = (i * (t + 3) + t) % num_rows;
+    }
+    Tensor<float> gamma(HostTensorDescriptor({kDim})), beta(HostTensorDescriptor({kDim}));
+    FillSeq(gamma, 3);
+    FillSeq(beta, 4);
+    const float epsilon = 1e-4f;
+
+    Tensor<float> out(HostTensorDescriptor({L, kDim}));
+    auto ref = ReferenceSparseEmbedding3{};
+    ref.MakeInvoker().Run(ref.MakeArgument(out,
+                                           embs[0],
+                                           embs[1],
+                                           embs[2],
+                                           indices[0],
+                                           indices[1],
+                                           indices[2],
+                                           gamma,
+                                           beta,
+                                           num_rows,
+                                           kDim,
+                                           L,
+                                           epsilon));
+
+    // the three rows of each sample summed and normalized
+    for(std::size_t i = 0; i < L; ++i)
+    {
+        std::vector<float> x(kDim);
+        float mean = 0, var = 0;
+        for(std::size_t d = 0; d < kDim; ++d)
+        {
+            x[d] = embs[0](indices[0].mData[i], d) + embs[1](indices[1].mData[i], d) +
+                   embs[2](indices[2].mData[i], d);
+            mean += x[d];
+            var += x[d] * x[d];
+        }
+        mean = mean / kDim;
+        var  = var / kDim - mean * mean;
+
+        for(std::size_t d = 0; d < kDim; ++d)
+            ASSERT_EQ(out(i, d),
+                      (x[d] - mean) / std::sqrt(var + epsilon) * gamma.mData[d] + beta.mData[d])
+                << i << " " << d;
+    }
+
+    auto bad_rows = ref.MakeArgument(out,
+                                     embs[0],
+                                     embs[1],
+                                     embs[2],
+                                     indices[0],
+                                     indices[1],
+                                     indices[2],
+                                     gamma,
+                                     beta,
+                                     num_rows + 1,
+                                     kDim,
+                                     L,
+                                     epsilon);
+    EXPECT_THROW(ref.MakeInvoker().Run(bad_rows), std::runtime_error);
+}
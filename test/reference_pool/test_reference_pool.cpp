@@ -0,0 +1,268 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "ck/ck.hpp"
+#include "ck/tensor_operation/gpu/device/tensor_layout.hpp"
+#include "ck/tensor_operation/gpu/element/element_wise_operation.hpp"
+
+#include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_avgpool_bwd.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_maxpool_bwd.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_pool_fwd.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_pool_window.hpp"
+
+namespace {
+
+using ck::tensor_operation::host::make_pool_host_tensor_descriptor;
+
+// 3D pooling problem; 2D ones have Di = Do = Z = 1
+struct PoolProblem
+{
+    std::size_t N, C;
+    std::array<ck::index_t, 3> in, window, stride, dilation, left_pad, right_pad;
+
+    std::array<ck::index_t, 3> GetOut() const
+    {
+        std::array<ck::index_t, 3> out;
+        for(int d = 0; d < 3; ++d)
+            out[d] = (in[d] + left_pad[d] + right_pad[d] - (window[d] - 1) * dilation[d] - 1) /
+                         stride[d] +
+                     1;
+        return out;
+    }
+};
+
+// small integers, with ties in every window
+template <typename T>
+void FillSeq(Tensor<T>& t)
+{
+    int i = 0;
+    for(auto& v : t.mData)
+        v = static_cast<T>((i++ * 5) % 7 - 3);
+}
+
+// calls f(n, c, o, taps) for every output, taps being the in-range input positions of its window
+// in [z, y, x] order
+template <typename F>
+void ForEachWindow(const PoolProblem& p, F f)
+{
+    const auto out = p.GetOut();
+    for(std::size_t n = 0; n < p.N; ++n)
+        for(std::size_t c = 0; c < p.C; ++c)
+            for(ck::index_t o0 = 0; o0 < out[0]; ++o0)
+                for(ck::index_t o1 = 0; o1 < out[1]; ++o1)
+                    for(ck::index_t o2 = 0; o2 < out[2]; ++o2)
+                    {
+                        std::vector<std::array<ck::index_t, 3>> taps;
+                        for(ck::index_t z = 0; z < p.window[0]; ++z)
+                            for(ck::index_t y = 0; y < p.window[1]; ++y)
+                                for(ck::index_t x = 0; x < p.window[2]; ++x)
+                                {
+                                    const std::array<ck::index_t, 3> o{o0, o1, o2}, t{z, y, x};
+                                    std::array<ck::index_t, 3> i;
+                                    bool in_range = true;
+                                    for(int d = 0; d < 3; ++d)
+                                    {
+                                        i[d] = o[d] * p.stride[d] + t[d] * p.dilation[d] -
+                                               p.left_pad[d];
+                                        in_range = in_range && i[d] >= 0 && i[d] < p.in[d];
+                                    }
+                                    if(in_range)
+                                        taps.push_back(i);
+                                }
+                        f(n, c, std::array<ck::index_t, 3>{o0, o1, o2}, taps);
+                    }
+}
+
+// the pooling tensors of a problem, in the layout and rank the device instances use
+template <ck::index_t NDimSpatial>
+struct PoolTensors
+{
+    using Layout = std::conditional_t<NDimSpatial == 2,
+                                      ck::tensor_layout::convolution::NHWC,
+                                      ck::tensor_layout::convolution::NDHWC>;
+
+    explicit PoolTensors(const PoolProblem& p)
+        : problem_(p),
+          in_(MakeDesc(p, p.in)),
+          out_(MakeDesc(p, p.GetOut())),
+          indices_(MakeDesc(p, p.GetOut())),
+          dout_(MakeDesc(p, p.GetOut())),
+          din_(MakeDesc(p, p.in))
+    {
+        FillSeq(in_);
+        FillSeq(dout_);
+    }
+
+    static HostTensorDescriptor MakeDesc(const PoolProblem& p, std::array<ck::index_t, 3> s)
+    {
+        if constexpr(NDimSpatial == 2)
+            return make_pool_host_tensor_descriptor<Layout>(p.N, p.C, s[1], s[2]);
+        else
+            return make_pool_host_tensor_descriptor<Layout>(p.N, p.C, s[0], s[1], s[2]);
+    }
+
+    template <typename T>
+    static T& At(Tensor<T>& t, std::size_t n, std::size_t c, std::array<ck::index_t, 3> i)
+    {
+        if constexpr(NDimSpatial == 2)
+            return t(n, c, i[1], i[2]);
+        else
+            return t(n, c, i[0], i[1], i[2]);
+    }
+
+    std::vector<ck::index_t> Params(const std::array<ck::index_t, 3>& v) const
+    {
+        return {v.begin() + 3 - NDimSpatial, v.end()};
+    }
+
+    PoolProblem problem_;
+    Tensor<float> in_, out_;
+    Tensor<ck::index_t> indices_;
+    Tensor<float> dout_, din_;
+};
+
+template <ck::index_t NDimSpatial, ck::ReduceTensorOp ReduceOpId, bool OutputIndex>
+void RunPoolFwd(PoolTensors<NDimSpatial>& t)
+{
+    using ReferencePoolFwd = ck::tensor_operation::host::ReferencePoolingFwd<NDimSpatial + 2,
+                                                                             NDimSpatial,
+                                                                             float,
+                                                                             float,
+                                                                             float,
+                                                                             ck::index_t,
+                                                                             ReduceOpId,
+                                                                             true,
+                                                                             OutputIndex>;
+
+    const auto& p = t.problem_;
+    const auto window = t.Params(p.window), stride = t.Params(p.stride),
+               dilation = t.Params(p.dilation), left_pad = t.Params(p.left_pad),
+               right_pad = t.Params(p.right_pad);
+
+    auto ref = ReferencePoolFwd{};
+    ref.MakeInvoker().Run(ref.MakeArgument(
+        t.in_, t.out_, t.indices_, window, stride, dilation, left_pad, right_pad));
+}
+
+template <ck::index_t NDimSpatial>
+void TestPooling(const PoolProblem& p)
+{
+    using Tensors = PoolTensors<NDimSpatial>;
+
+    {
+        Tensors t(p);
+        RunPoolFwd<NDimSpatial, ck::ReduceTensorOp::MAX, true>(t);
+
+        // gradients of each input: the douts of the windows it is the max of
+        Tensor<float> din_ref(t.din_.mDesc);
+        ForEachWindow(p, [&](auto n, auto c, auto o, const auto& taps) {
+            float max_v           = -1e30f;
+            std::ptrdiff_t argmax = 0;
+            for(const auto& i : taps)
+            {
+                if(Tensors::At(t.in_, n, c, i) > max_v)
+                {
+                    max_v  = Tensors::At(t.in_, n, c, i);
+                    argmax = &Tensors::At(t.in_, n, c, i) - t.in_.mData.data();
+                }
+            }
+            ASSERT_FALSE(taps.empty());
+            ASSERT_EQ(Tensors::At(t.out_, n, c, o), max_v);
+            ASSERT_EQ(Tensors::At(t.indices_, n, c, o), static_cast<ck::index_t>(argmax));
+            din_ref.mData[argmax] += Tensors::At(t.dout_, n, c, o);
+        });
+
+        using ReferenceMaxPoolBwd = ck::tensor_operation::host::ReferenceMaxPoolBwd<
+            float,
+            ck::index_t,
+            float,
+            float,
+            ck::tensor_operation::element_wise::PassThrough>;
+
+        auto ref = ReferenceMaxPoolBwd{};
+        ref.MakeInvoker().Run(ref.MakeArgument(t.dout_,
+                                               t.indices_,
+                                               t.din_,
+                                               t.Params(p.window),
+                                               t.Params(p.stride),
+                                               t.Params(p.dilation),
+                                               t.Params(p.left_pad),
+                                               t.Params(p.right_pad),
+                                               {}));
+        EXPECT_EQ(t.din_.mData, din_ref.mData);
+    }
+
+    {
+        Tensors t(p);
+        RunPoolFwd<NDimSpatial, ck::ReduceTensorOp::AVG, false>(t);
+
+        const float window_size = p.window[0] * p.window[1] * p.window[2];
+        Tensor<float> din_ref(t.din_.mDesc);
+        ForEachWindow(p, [&](auto n, auto c, auto o, const auto& taps) {
+            float sum = 0;
+            for(const auto& i : taps)
+            {
+                sum += Tensors::At(t.in_, n, c, i);
+                Tensors::At(din_ref, n, c, i) += Tensors::At(t.dout_, n, c, o);
+            }
+            ASSERT_EQ(Tensors::At(t.out_, n, c, o), sum / window_size);
+        });
+
+        using ReferenceAvgPoolBwd =
+            ck::tensor_operation::host::ReferenceAvgPoolBwd<NDimSpatial, float, float>;
+
+        auto ref = ReferenceAvgPoolBwd{};
+        ref.MakeInvoker().Run(ref.MakeArgument(t.din_,
+                                               t.dout_,
+                                               t.Params(p.window),
+                                               t.Params(p.stride),
+                                               t.Params(p.dilation),
+                                               t.Params(p.left_pad),
+                                               t.Params(p.right_pad)));
+
+        for(std::size_t i = 0; i < din_ref.mData.size(); ++i)
+            ASSERT_EQ(t.din_.mData[i], din_ref.mData[i] / window_size) << i;
+    }
+}
+
+} // namespace
+
+TEST(ReferencePool, PoolHostTensorDescriptor)
+{
+    namespace layout = ck::tensor_layout::convolution;
+
+    const auto nhwc = make_pool_host_tensor_descriptor<layout::NHWC>(2, 3, 4, 5);
+    EXPECT_EQ(nhwc.GetLengths(), (std::vector<std::size_t>{2, 3, 4, 5}));
+    EXPECT_EQ(nhwc.GetStrides(), (std::vector<std::size_t>{60, 1, 15, 3}));
+
+    const auto ncdhw = make_pool_host_tensor_descriptor<layout::NCDHW>(2, 3, 4, 5, 6);
+    EXPECT_EQ(ncdhw.GetStrides(), (std::vector<std::size_t>{360, 120, 30, 6, 1}));
+}
+
+TEST(ReferencePool, Pool2d)
+{
+    // overlapping windows with padding, more channels than a channel block
+    TestPooling<2>({2, 19, {1, 9, 11}, {1, 3, 3}, {1, 2, 1}, {1, 1, 1}, {0, 1, 1}, {0, 1, 1}});
+    // dilated windows, strided past the window
+    TestPooling<2>({1, 3, {1, 12, 10}, {1, 2, 3}, {1, 3, 4}, {1, 2, 2}, {0, 0, 1}, {0, 0, 0}});
+}
+
+TEST(ReferencePool, Pool3d)
+{
+    TestPooling<3>({2, 5, {5, 6, 7}, {2, 3, 2}, {1, 2, 2}, {1, 1, 2}, {0, 1, 1}, {1, 1, 0}});
+}
+
+TEST(ReferencePool, ManyTiles)
+{
+    // several tiles of output along every dimension, the windows of neighbouring tiles overlapping
+    TestPooling<2>({1, 17, {1, 41, 35}, {1, 4, 3}, {1, 1, 2}, {1, 2, 1}, {0, 3, 1}, {0, 2, 1}});
+    TestPooling<3>({1, 2, {19, 18, 21}, {3, 2, 3}, {2, 1, 2}, {1, 1, 1}, {1, 0, 1}, {1, 1, 1}});
+}
@@ -0,0 +1,193 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <cstddef>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "profiler/roofline_model.hpp"
+
+using ck::DataTypeEnum;
+using ck::mock::Runtime;
+using ck::profiler::evaluate_roofline;
+using ck::profiler::get_device_roofline_peaks;
+using ck::profiler::get_roofline_peaks;
+using ck::profiler::RooflineBound;
+using ck::profiler::RooflinePeaks;
+using ck::profiler::RooflineProblem;
+
+namespace {
+
+RooflineProblem MakeGemm(std::size_t M, std::size_t N, std::size_t K, std::size_t type_size)
+{
+    return RooflineProblem{2 * M * N * K, type_size * (M * K + K * N + M * N)};
+}
+
+RooflinePeaks Gfx942() { return get_roofline_peaks("gfx942").value(); }
+
+} // namespace
+
+TEST(Roofline, PeaksMatchDatasheet)
+{
+    const auto mi300x = Gfx942();
+    EXPECT_NEAR(mi300x.PeakTFlops(DataTypeEnum::Half), 1307.4, 0.1);
+    EXPECT_NEAR(mi300x.PeakTFlops(DataTypeEnum::BFloat16), 1307.4, 0.1);
+    EXPECT_NEAR(mi300x.PeakTFlops(DataTypeEnum::Float8), 2614.9, 0.1);
+    EXPECT_NEAR(mi300x.PeakTFlops(DataTypeEnum::Int8), 2614.9, 0.1);
+    EXPECT_NEAR(mi300x.PeakTFlops(DataTypeEnum::Float), 163.4, 0.1);
+    EXPECT_NEAR(mi300x.PeakTFlops(DataTypeEnum::Double), 163.4, 0.1);
+    EXPECT_NEAR(mi300x.LdsGBPerSec(), 81715.2, 0.1);
+
+    const auto mi250x_gcd = get_roofline_peaks("gfx90a").value();
+    EXPECT_NEAR(mi250x_gcd.PeakTFlops(DataTypeEnum::Half), 191.5, 0.1);
+    EXPECT_NEAR(mi250x_gcd.PeakTFlops(DataTypeEnum::Double), 47.9, 0.1);
+    EXPECT_EQ(mi250x_gcd.PeakTFlops(DataTypeEnum::Float8), 0.);
+
+    const auto mi100 = get_roofline_peaks("gfx908").value();
+    EXPECT_NEAR(mi100.PeakTFlops(DataTypeEnum::Half), 184.6, 0.1);
+    EXPECT_NEAR(mi100.PeakTFlops(DataTypeEnum::BFloat16), 92.3, 0.1);
+
+    EXPECT_FALSE(get_roofline_peaks("gfx803"));
+    EXPECT_FALSE(get_roofline_peaks(""));
+}
+
+TEST(Roofline, LargeGemmIsComputeBound)
+{
+    const auto peaks   = Gfx942();
+    const auto problem = MakeGemm(8192, 8192, 8192, 2);
+    // at the peak flop rate, and twice as long
+    const float roof_time = problem.flop / 1.E9 / peaks.PeakTFlops(DataTypeEnum::Half);
+
+    const auto point = evaluate_roofline(peaks, DataTypeEnum::Half, problem, 2 * roof_time);
+    EXPECT_EQ(point.bound, RooflineBound::Compute);
+    EXPECT_NEAR(point.arithmetic_intensity, 8192. / 3, 1.E-6);
+    EXPECT_NEAR(point.ridge_point, 1307.4 / 5.3, 0.1);
+    EXPECT_NEAR(point.attainable_tflops, 1307.4, 0.1);
+    EXPECT_NEAR(point.achieved_tflops, 1307.4 / 2, 0.1);
+    EXPECT_NEAR(point.efficiency, 0.5, 1.E-6);
+    EXPECT_TRUE(point.WorthTuning());
+
+    const auto at_roof = evaluate_roofline(peaks, DataTypeEnum::Half, problem, roof_time);
+    EXPECT_NEAR(at_roof.efficiency, 1., 1.E-6);
+    EXPECT_FALSE(at_roof.WorthTuning());
+
+    // the same GEMM in fp32 is still compute-bound, against an 8x lower roof
+    const auto f32 =
+        evaluate_roofline(peaks, DataTypeEnum::Float, MakeGemm(8192, 8192, 8192, 4), 1);
+    EXPECT_EQ(f32.bound, RooflineBound::Compute);
+    EXPECT_NEAR(f32.attainable_tflops, 163.4, 0.1);
+}
+
+TEST(Roofline, SkinnyGemmIsMemoryBound)
+{
+    const auto peaks   = Gfx942();
+    const auto problem = MakeGemm(1, 8192, 8192, 2);
+    const float roof_time = problem.bytes / 1.E6 / peaks.HbmGBPerSec();
+
+    const auto point = evaluate_roofline(peaks, DataTypeEnum::Half, problem, 4 * roof_time);
+    EXPECT_EQ(point.bound, RooflineBound::Memory);
+    EXPECT_LT(point.arithmetic_intensity, 1.);
+    EXPECT_NEAR(point.attainable_tflops, point.arithmetic_intensity * 5.3, 1.E-6);
+    EXPECT_NEAR(point.efficiency, 0.25, 1.E-6);
+    EXPECT_NEAR(point.Headroom(), 0.75, 1.E-6);
+}
+
+TEST(Roofline, RidgePointSplitsRegimes)
+{
+    const auto peaks = Gfx942();
+    const double ridge =
+        evaluate_roofline(peaks, DataTypeEnum::Half, RooflineProblem{1, 1}, 1).ridge_point;
+
+    const std::size_t bytes = 1 << 20;
+    const auto below        = RooflineProblem{static_cast<std::size_t>(bytes * ridge * 0.9), bytes};
+    const auto above        = RooflineProblem{static_cast<std::size_t>(bytes * ridge * 1.1), bytes};
+    EXPECT_EQ(evaluate_roofline(peaks, DataTypeEnum::Half, below, 1).bound, RooflineBound::Memory);
+    EXPECT_EQ(evaluate_roofline(peaks, DataTypeEnum::Half, above, 1).bound, RooflineBound::Compute);
+
+    // fp8 doubles the peak, and the ridge
+    EXPECT_NEAR(
+        evaluate_roofline(peaks, DataTypeEnum::Float8, below, 1).ridge_point, 2 * ridge, 1.E-6);
+}
+
+TEST(Roofline, DataMovementOps)
+{
+    // a softmax/layernorm/pooling result carries no flop, it is measured against the bandwidth
+    const auto peaks   = Gfx942();
+    const auto problem = RooflineProblem{0, std::size_t{1} << 30};
+    const float roof_time = problem.bytes / 1.E6 / peaks.HbmGBPerSec();
+
+    const auto point = evaluate_roofline(peaks, DataTypeEnum::Half, problem, roof_time / 0.8f);
+    EXPECT_EQ(point.bound, RooflineBound::Memory);
+    EXPECT_EQ(point.arithmetic_intensity, 0.);
+    EXPECT_EQ(point.achieved_tflops, 0.);
+    EXPECT_NEAR(point.efficiency, 0.8, 1.E-6);
+    EXPECT_FALSE(point.WorthTuning());
+    EXPECT_TRUE(point.WorthTuning(0.1));
+}
+
+TEST(Roofline, LdsCeiling)
+{
+    const auto peaks = Gfx942();
+    auto problem     = MakeGemm(8192, 8192, 8192, 2);
+    // every MFMA operand read from LDS, with no register reuse
+    problem.lds_bytes = problem.flop;
+
+    const auto point = evaluate_roofline(peaks, DataTypeEnum::Half, problem, 1);
+    EXPECT_EQ(point.bound, RooflineBound::Lds);
+    EXPECT_NEAR(point.efficiency, problem.lds_bytes / 1.E6 / peaks.LdsGBPerSec(), 1.E-6);
+}
+
+TEST(Roofline, NotTimed)
+{
+    const auto point = evaluate_roofline(Gfx942(), DataTypeEnum::Half, MakeGemm(64, 64, 64, 2), 0);
+    EXPECT_EQ(point.efficiency, 0.);
+    EXPECT_EQ(point.achieved_tflops, 0.);
+    EXPECT_EQ(ck::profiler::roofline_annotation(DataTypeEnum::Half, 1, 1, 0), "");
+}
+
+TEST(Roofline, ToString)
+{
+    const auto peaks   = Gfx942();
+    const auto problem = MakeGemm(8192, 8192, 8192, 2);
+    const float roof_time = problem.flop / 1.E9 / peaks.PeakTFlops(DataTypeEnum::Half);
+
+    EXPECT_EQ(evaluate_roofline(peaks, DataTypeEnum::Half, problem, 4 * roof_time).ToString(),
+              "25.0% of roofline, compute-bound (2730.67 flop/B)");
+}
+
+TEST(Roofline, Summary)
+{
+    Runtime::Get().Reset();
+    const auto problem = MakeGemm(8192, 8192, 8192, 2);
+    const float roof_time = problem.flop / 1.E9 / Gfx942().PeakTFlops(DataTypeEnum::Half);
+
+    using ck::profiler::roofline_annotation;
+    using ck::profiler::roofline_summary;
+
+    EXPECT_EQ(roofline_summary(DataTypeEnum::Half, problem.flop, problem.bytes, 2 * roof_time),
+              "Roofline: best instance at 50.0% of roofline, compute-bound (2730.67 flop/B), "
+              "ridge 246.69 flop/B, 1307.44 TFlops attainable, worth tuning\n");
+    EXPECT_EQ(
+        roofline_annotation(DataTypeEnum::Half, problem.flop, problem.bytes, roof_time / 0.9f),
+        ", 90.0% of roofline, compute-bound (2730.67 flop/B)");
+    EXPECT_EQ(roofline_summary(DataTypeEnum::Half, problem.flop, problem.bytes, 0), "");
+}
+
+TEST(Roofline, DevicePeaks)
+{
+    Runtime::Get().Reset();
+    // a CPX partition of an MI300X
+    Runtime::Get().SetArchName("gfx942:sramecc+:xnack-", 38);
+
+    const auto peaks = get_device_roofline_peaks().value();
+    EXPECT_EQ(peaks.arch, "gfx942");
+    EXPECT_EQ(peaks.num_cu, 38);
+    EXPECT_NEAR(peaks.clock_ghz, 2.1, 1.E-6);
+    EXPECT_NEAR(peaks.PeakTFlops(DataTypeEnum::Half), 1307.4 / 8, 0.1);
+
+    Runtime::Get().SetArchName("gfx803", 64);
+    EXPECT_FALSE(get_device_roofline_peaks());
+
+    Runtime::Get().Reset();
+}
@@ -0,0 +1,23 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+#include "profiler/roofline.hpp"
+
+using ck::DataTypeEnum;
+using ck::profiler::get_roofline_compute_type;
+
+TEST(Roofline, ComputeType)
+{
+    EXPECT_EQ(get_roofline_compute_type<double>(), DataTypeEnum::Double);
+    EXPECT_EQ(get_roofline_compute_type<float>(), DataTypeEnum::Float);
+    EXPECT_EQ(get_roofline_compute_type<ck::half_t>(), DataTypeEnum::Half);
+    EXPECT_EQ(get_roofline_compute_type<ck::bhalf_t>(), DataTypeEnum::BFloat16);
+    EXPECT_EQ(get_roofline_compute_type<ck::f8_t>(), DataTypeEnum::Float8);
+    EXPECT_EQ(get_roofline_compute_type<ck::bf8_t>(), DataTypeEnum::Float8);
+    EXPECT_EQ(get_roofline_compute_type<int8_t>(), DataTypeEnum::Int8);
+    EXPECT_EQ(get_roofline_compute_type<int32_t>(), DataTypeEnum::Float);
+}
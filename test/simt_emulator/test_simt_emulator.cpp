@@ -0,0 +1,397 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <array>
+#include <cstdint>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "ck/host_utility/hip_runtime.hpp"
+#include "ck/host_utility/kernel_launch.hpp"
+#include "ck/utility/get_id.hpp"
+#include "ck/utility/synchronization.hpp"
+
+namespace simt = ck::simt;
+
+namespace {
+
+struct WriteIds
+{
+    void operator()(int* ids) const
+    {
+        const int block = blockIdx.x + blockIdx.y * gridDim.x;
+        const int tid   = threadIdx.x + threadIdx.y * blockDim.x;
+        const int index = block * blockDim.x * blockDim.y + tid;
+        simt::GlobalStore(&ids[index], ids[index] + index + 1);
+    }
+};
+
+// tree reduction of 256 values through LDS
+struct BlockReduce
+{
+    void operator()(const float* in, float* out) const
+    {
+        __shared__ float partial[256];
+
+        const int tid = ck::get_thread_local_1d_id();
+        partial[tid]  = in[ck::get_block_1d_id() * 256 + tid];
+        ck::block_sync_lds();
+
+        for(int stride = 128; stride > 0; stride /= 2)
+        {
+            if(tid < stride)
+                partial[tid] += partial[tid + stride];
+            ck::block_sync_lds();
+        }
+
+        if(tid == 0)
+            out[ck::get_block_1d_id()] = partial[0];
+    }
+};
+
+// C[M, N] = A[M, K] * B[K, N], row-major, one kTile x kTile tile of C per block and kTile x kTile
+// threads, with the tiles of A and B staged through the dynamic LDS
+struct TiledGemm
+{
+    static constexpr int kTile = 8;
+
+    void operator()(const float* a, const float* b, float* c, int M, int N, int K) const
+    {
+        float* a_lds = simt::GetLds<float>();
+        float* b_lds = a_lds + kTile * kTile;
+
+        const int tx = threadIdx.x;
+        const int ty = threadIdx.y;
+        const int m  = blockIdx.y * kTile + ty;
+        const int n  = blockIdx.x * kTile + tx;
+
+        float acc = 0;
+        for(int k0 = 0; k0 < K; k0 += kTile)
+        {
+            // out of bounds reads 0, as buffer loads on hardware
+            const bool a_in = m < M && k0 + tx < K;
+            const bool b_in = k0 + ty < K && n < N;
+            simt::LdsStore(&a_lds[ty * kTile + tx],
+                           a_in ? simt::BufferLoad(a, m * K + k0 + tx, M * K) : 0.f);
+            simt::LdsStore(&b_lds[ty * kTile + tx],
+                           b_in ? simt::BufferLoad(b, (k0 + ty) * N + n, K * N) : 0.f);
+            __syncthreads();
+
+            for(int k = 0; k < kTile; ++k)
+                acc += simt::LdsLoad(&a_lds[ty * kTile + k]) *
+                       simt::LdsLoad(&b_lds[k * kTile + tx]);
+            __syncthreads();
+        }
+
+        if(m < M && n < N)
+            simt::GlobalStore(&c[m * N + n], acc);
+    }
+};
+
+// a value of the register layout of an MFMA operand: element reg_ of lane lane_
+struct MfmaSlot
+{
+    int lane_;
+    int reg_;
+};
+
+// A[m][k] = 1 and B[k][n] = 1, the other operand values 0, make C[m][n] = 1. The slots are those
+// of the AMD matrix instruction calculator (for the 32x32x8 MFMA, A[m][k] is in lane
+// m + 32 * (k / 4) and C[m][n] in element 4 * (m / 8) + m % 4 of lane n + 32 * (m / 4 % 2))
+struct MfmaCase
+{
+    MfmaSlot a_;
+    MfmaSlot b_;
+    MfmaSlot c_;
+};
+
+template <int M, std::size_t CPerLane>
+void TestMfmaLayout(const std::vector<MfmaCase>& cases)
+{
+    for(const auto& test : cases)
+    {
+        std::vector<std::array<float, CPerLane>> c(64);
+
+        const auto stats = simt::Launch(dim3(1), dim3(64), 0, [&]() {
+            const int lane = __lane_id();
+
+            std::array<float, 4> a_lane{}, b_lane{};
+            if(lane == test.a_.lane_)
+                a_lane[test.a_.reg_] = 1.f;
+            if(lane == test.b_.lane_)
+                b_lane[test.b_.reg_] = 1.f;
+
+            std::array<float, CPerLane> c_lane{};
+            if constexpr(M == 32)
+                simt::Mfma32x32x8(a_lane, b_lane, c_lane);
+            else
+                simt::Mfma16x16x16(a_lane, b_lane, c_lane);
+            c[lane] = c_lane;
+        });
+
+        for(int lane = 0; lane < 64; ++lane)
+        {
+            for(int reg = 0; reg < static_cast<int>(CPerLane); ++reg)
+            {
+                const bool expected = lane == test.c_.lane_ && reg == test.c_.reg_;
+                ASSERT_EQ(c[lane][reg], expected ? 1.f : 0.f)
+                    << "a " << test.a_.lane_ << "/" << test.a_.reg_ << " b " << test.b_.lane_
+                    << "/" << test.b_.reg_ << ": lane " << lane << " reg " << reg;
+            }
+        }
+        EXPECT_EQ(stats.blocks_[0].num_mfmas_, 1);
+    }
+}
+
+} // namespace
+
+TEST(SimtEmulator, EveryBlockAndLaneRunsOnce)
+{
+    const dim3 grid(3, 2), block(16, 8);
+    std::vector<int> ids(3 * 2 * 16 * 8, 0);
+
+    const auto stats = simt::Launch(grid, block, 0, WriteIds{}, ids.data());
+
+    for(std::size_t i = 0; i < ids.size(); ++i)
+        ASSERT_EQ(ids[i], static_cast<int>(i) + 1);
+    ASSERT_EQ(stats.blocks_.size(), 6);
+    EXPECT_EQ(stats.blocks_[0].global_write_byte_, 128 * sizeof(int));
+    EXPECT_EQ(stats.GetTotal().global_write_byte_, ids.size() * sizeof(int));
+    EXPECT_EQ(stats.GetTotal().num_barriers_, 0);
+}
+
+TEST(SimtEmulator, BarriersOrderSharedMemory)
+{
+    std::vector<float> in(4 * 256), out(4);
+    std::iota(in.begin(), in.end(), 0.f);
+
+    const auto stats = simt::Launch(dim3(4), dim3(256), 0, BlockReduce{}, in.data(), out.data());
+
+    for(int block = 0; block < 4; ++block)
+        EXPECT_EQ(out[block], 256.f * 256 * block + 255 * 128) << block;
+    // the initial one and one per step
+    EXPECT_EQ(stats.blocks_[0].num_barriers_, 9);
+}
+
+TEST(SimtEmulator, WarpExchanges)
+{
+    std::vector<int> rotated(128), segments(128), first(2);
+    std::vector<std::uint64_t> ballots(2);
+
+    simt::Launch(dim3(1), dim3(128), 0, [&]() {
+        const int tid  = threadIdx.x;
+        const int lane = __lane_id();
+
+        rotated[tid]  = __shfl(tid, lane + 1);
+        segments[tid] = __shfl(tid, 0, 16);
+        const auto ballot = __ballot(tid % 3 == 0);
+
+        // the first lanes of warp 1 are gone
+        if(tid >= 64 && tid < 70)
+            return;
+        const int first_tid = simt::ReadFirstLane(tid);
+        if(lane == 10)
+        {
+            ballots[simt::WarpId()] = ballot;
+            first[simt::WarpId()]   = first_tid;
+        }
+    });
+
+    for(int tid = 0; tid < 128; ++tid)
+    {
+        EXPECT_EQ(rotated[tid], tid / 64 * 64 + (tid + 1) % 64);
+        EXPECT_EQ(segments[tid], tid / 16 * 16);
+    }
+    EXPECT_EQ(first[0], 0);
+    EXPECT_EQ(first[1], 70);
+
+    for(int warp = 0; warp < 2; ++warp)
+        for(int lane = 0; lane < 64; ++lane)
+            EXPECT_EQ((ballots[warp] >> lane) & 1, (warp * 64 + lane) % 3 == 0);
+}
+
+TEST(SimtEmulator, Mfma32x32x8)
+{
+    TestMfmaLayout<32, 16>({
+        {{0, 0}, {0, 0}, {0, 0}},     // A[0][0] B[0][0] C[0][0]
+        {{45, 2}, {33, 2}, {33, 5}},  // A[13][6] B[6][1] C[13][1]
+        {{31, 3}, {30, 3}, {62, 15}}, // A[31][3] B[3][30] C[31][30]
+        {{36, 3}, {49, 3}, {49, 0}},  // A[4][7] B[7][17] C[4][17]
+        {{18, 1}, {9, 1}, {9, 10}},   // A[18][1] B[1][9] C[18][9]
+        {{18, 1}, {41, 1}, {-1, 0}},  // A[18][1] B[5][9]: no product
+    });
+}
+
+TEST(SimtEmulator, Mfma16x16x16)
+{
+    TestMfmaLayout<16, 4>({
+        {{0, 0}, {0, 0}, {0, 0}},     // A[0][0] B[0][0] C[0][0]
+        {{53, 2}, {57, 2}, {25, 1}},  // A[5][14] B[14][9] C[5][9]
+        {{31, 3}, {18, 3}, {50, 3}},  // A[15][7] B[7][2] C[15][2]
+        {{10, 0}, {12, 0}, {44, 2}},  // A[10][0] B[0][12] C[10][12]
+        {{10, 0}, {28, 0}, {-1, 0}},  // A[10][0] B[4][12]: no product
+    });
+}
+
+TEST(SimtEmulator, TiledGemmTraffic)
+{
+    constexpr int M = 20, N = 12, K = 20, T = TiledGemm::kTile;
+    std::vector<float> a(M * K), b(K * N), c(M * N, -1.f);
+    for(int i = 0; i < M * K; ++i)
+        a[i] = static_cast<float>(i % 7 - 3);
+    for(int i = 0; i < K * N; ++i)
+        b[i] = static_cast<float>(i % 5 - 2);
+
+    const dim3 grid((N + T - 1) / T, (M + T - 1) / T);
+    const auto stats = simt::Launch(grid,
+                                    dim3(T, T),
+                                    2 * T * T * sizeof(float),
+                                    TiledGemm{},
+                                    a.data(),
+                                    b.data(),
+                                    c.data(),
+                                    M,
+                                    N,
+                                    K);
+
+    for(int m = 0; m < M; ++m)
+    {
+        for(int n = 0; n < N; ++n)
+        {
+            float ref = 0;
+            for(int k = 0; k < K; ++k)
+                ref += a[m * K + k] * b[k * N + n];
+            ASSERT_EQ(c[m * N + n], ref);
+        }
+    }
+
+    // the first block is a full tile: 3 steps over K, each reading a tile of A and B (the last
+    // one partially) and writing both to LDS, then reading T values of each per thread
+    const auto& first = stats.blocks_[0];
+    EXPECT_EQ(first.global_read_byte_, 2 * T * K * sizeof(float));
+    EXPECT_EQ(first.lds_write_byte_, 3 * 2 * T * T * sizeof(float));
+    EXPECT_EQ(first.lds_read_byte_, 3 * 2 * T * T * T * sizeof(float));
+    EXPECT_EQ(first.global_write_byte_, T * T * sizeof(float));
+    EXPECT_EQ(first.num_barriers_, 6);
+    EXPECT_EQ(stats.GetTotal().global_write_byte_, M * N * sizeof(float));
+}
+
+TEST(SimtEmulator, BufferAccessOutOfRange)
+{
+    std::vector<int> data{1, 2, 3, 4};
+    std::vector<int> loaded(8);
+
+    simt::Launch(dim3(1), dim3(8), 0, [&]() {
+        const int tid = threadIdx.x;
+        loaded[tid]   = simt::BufferLoad(data.data(), tid - 2, 4);
+        __syncthreads();
+        simt::BufferStore(data.data(), tid + 2, 4, 0);
+    });
+
+    EXPECT_EQ(loaded, (std::vector<int>{0, 0, 1, 2, 3, 4, 0, 0}));
+    EXPECT_EQ(data, (std::vector<int>{1, 2, 0, 0}));
+}
+
+TEST(SimtEmulator, DynamicLdsIsPerBlock)
+{
+    std::vector<std::uint8_t> initial(2);
+
+    simt::Launch(dim3(2), dim3(64), 16, [&]() {
+        auto* lds = simt::GetLds<std::uint8_t>();
+        if(threadIdx.x == 0)
+            initial[blockIdx.x] = lds[0];
+        __syncthreads();
+        lds[threadIdx.x % 16] = 1;
+    });
+
+    EXPECT_EQ(initial, (std::vector<std::uint8_t>{0xcd, 0xcd}));
+}
+
+TEST(SimtEmulator, SharedMemoryIsPerBlock)
+{
+    std::vector<int> initial(3), last(3);
+
+    simt::Launch(dim3(3), dim3(64), 0, [&]() {
+        __shared__ int values[64];
+
+        if(threadIdx.x == 0)
+            initial[blockIdx.x] = values[63];
+        __syncthreads();
+        values[threadIdx.x] = blockIdx.x + 1;
+        __syncthreads();
+        if(threadIdx.x == 0)
+            last[blockIdx.x] = values[63];
+    });
+
+    // the lanes of a block see each other's stores, a block does not see those of the previous
+    EXPECT_EQ(initial, (std::vector<int>{0, 0, 0}));
+    EXPECT_EQ(last, (std::vector<int>{1, 2, 3}));
+}
+
+TEST(SimtEmulator, StackSize)
+{
+    const auto defaults = simt::GetDefaultOptions();
+    EXPECT_EQ(defaults.stack_byte_, 64 * 1024);
+
+    std::vector<int> sums(64);
+    const auto sum = [&]() {
+        // a 8 KiB frame
+        std::array<int, 2048> values;
+        std::iota(values.begin(), values.end(), static_cast<int>(threadIdx.x));
+        sums[threadIdx.x] = std::accumulate(values.begin(), values.end(), 0);
+    };
+
+    simt::Options options;
+    options.stack_byte_ = simt::kMinStackByte;
+    simt::Launch(options, dim3(1), dim3(64), 0, sum);
+    EXPECT_EQ(sums[1], 2048 * 2049 / 2);
+
+    simt::SetDefaultOptions(options);
+    EXPECT_EQ(simt::GetDefaultOptions().stack_byte_, simt::kMinStackByte);
+    simt::Launch(dim3(1), dim3(64), 0, sum);
+    EXPECT_EQ(sums[63], 2048 * 2047 / 2 + 2048 * 63);
+    simt::SetDefaultOptions(defaults);
+
+    options.stack_byte_ = 1024;
+    EXPECT_THROW(simt::Launch(options, dim3(1), dim3(64), 0, sum), std::invalid_argument);
+    EXPECT_THROW(simt::SetDefaultOptions(options), std::invalid_argument);
+}
+
+TEST(SimtEmulator, Errors)
+{
+    // a barrier half of a warp reaches, with the other half at a warp exchange
+    EXPECT_THROW(simt::Launch(dim3(1), dim3(64), 0,
+                              []() {
+                                  if(threadIdx.x < 32)
+                                      __syncthreads();
+                                  else
+                                      __shfl(0, 0);
+                              }),
+                 std::runtime_error);
+
+    EXPECT_THROW(simt::Launch(dim3(2), dim3(64), 0,
+                              []() {
+                                  __syncthreads();
+                                  if(blockIdx.x == 1 && threadIdx.x == 5)
+                                      throw std::out_of_range("lane 5");
+                                  __syncthreads();
+                              }),
+                 std::out_of_range);
+
+    EXPECT_THROW(simt::ThreadIdx(), std::logic_error);
+}
+
+TEST(SimtEmulator, LaunchThroughMockRuntime)
+{
+    ck::mock::Runtime::Get().Reset();
+    std::vector<float> in(2 * 256, 1.f), out(2);
+
+    launch_and_time_kernel(
+        StreamConfig{nullptr, false}, BlockReduce{}, dim3(2), dim3(256), 0, in.data(), out.data());
+
+    EXPECT_EQ(out, (std::vector<float>{256.f, 256.f}));
+    EXPECT_EQ(ck::mock::Runtime::Get().GetNumLaunches(), 1);
+}
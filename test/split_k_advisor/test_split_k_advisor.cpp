@@ -0,0 +1,190 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "ck/host_utility/split_k_advisor.hpp"
+
+using ck::advise_split_k;
+using ck::get_device_split_k_model;
+using ck::get_split_k_reduction_name;
+using ck::index_t;
+using ck::make_device_split_k_model;
+using ck::rank_split_k;
+using ck::SplitKDecision;
+using ck::SplitKDeviceModel;
+using ck::SplitKGemmShape;
+using ck::SplitKInstance;
+using ck::SplitKReduction;
+using ck::mock::Runtime;
+
+namespace {
+
+// fp16 A, B and C, 128x128x64 tiles, atomic reduction
+SplitKInstance MakeInstance() { return SplitKInstance{128, 128, 64}; }
+
+double GetPredictedNs(const std::vector<SplitKDecision>& decisions,
+                      index_t k_batch,
+                      SplitKReduction reduction)
+{
+    for(const auto& decision : decisions)
+    {
+        if(decision.k_batch_ == k_batch && decision.reduction_ == reduction)
+            return decision.predicted_ns_;
+    }
+    return -1;
+}
+
+} // namespace
+
+TEST(SplitKAdvisor, DecodeGemmSplitsK)
+{
+    // 32 tiles on 304 CUs
+    const std::vector<SplitKGemmShape> gemms{{16, 4096, 4096}};
+    const auto decisions = rank_split_k(gemms, MakeInstance());
+    const auto best      = decisions.front();
+
+    EXPECT_GT(best.k_batch_, 1);
+    EXPECT_EQ(best.reduction_, SplitKReduction::Atomic);
+    EXPECT_LT(best.predicted_ns_, GetPredictedNs(decisions, 1, SplitKReduction::Atomic) / 2);
+
+    EXPECT_EQ(advise_split_k(gemms, MakeInstance()).k_batch_, best.k_batch_);
+}
+
+TEST(SplitKAdvisor, LargeGemmDoesNotSplit)
+{
+    EXPECT_EQ(advise_split_k({{8192, 8192, 8192}}, MakeInstance()).k_batch_, 1);
+    EXPECT_EQ(advise_split_k({{4096, 4096, 4096}}, MakeInstance()).k_batch_, 1);
+
+    // too short a K to be worth another launch
+    EXPECT_EQ(advise_split_k({{64, 64, 64}}, MakeInstance()).k_batch_, 1);
+}
+
+TEST(SplitKAdvisor, RankIsSorted)
+{
+    // 4 K tiles: 3 K-batches would leave the last one empty
+    const auto decisions = rank_split_k({{128, 128, 200}}, MakeInstance());
+
+    std::vector<index_t> k_batches;
+    for(std::size_t i = 0; i < decisions.size(); ++i)
+    {
+        k_batches.push_back(decisions[i].k_batch_);
+        if(i > 0)
+        {
+            EXPECT_LE(decisions[i - 1].predicted_ns_, decisions[i].predicted_ns_);
+        }
+    }
+    std::sort(k_batches.begin(), k_batches.end());
+    EXPECT_EQ(k_batches, (std::vector<index_t>{1, 2, 4}));
+}
+
+TEST(SplitKAdvisor, UniversalGemmKRead)
+{
+    // the universal GEMMs cut K at multiples of lcm(AK1, BK1), not of KPerBlock
+    auto instance        = MakeInstance();
+    instance.k_read_vec_ = 8;
+    EXPECT_EQ(ck::detail::get_split_k_batch_length(4096, instance, 3), 1368);
+    EXPECT_EQ(ck::detail::get_split_k_batch_length(4096, MakeInstance(), 3), 1408);
+
+    // so K-batches emptying the last batch of KPerBlock multiples are valid, others are not
+    SplitKDeviceModel model;
+    model.max_k_batch_ = 8;
+
+    std::vector<index_t> k_batches;
+    for(const auto& decision : rank_split_k({{128, 128, 200}}, instance, model))
+        k_batches.push_back(decision.k_batch_);
+    std::sort(k_batches.begin(), k_batches.end());
+    EXPECT_EQ(k_batches, (std::vector<index_t>{1, 2, 3, 4, 5, 7}));
+
+    // a batch runs whole K tiles: 1368 costs the 22 tiles of 1408
+    const std::vector<SplitKGemmShape> gemms{{128, 128, 4096}};
+    constexpr auto atomic = SplitKReduction::Atomic;
+    EXPECT_DOUBLE_EQ(ck::detail::get_split_k_predicted_ns(gemms, instance, model, 3, atomic),
+                     ck::detail::get_split_k_predicted_ns(gemms, MakeInstance(), model, 3, atomic));
+
+    instance.k_read_vec_ = -1;
+    EXPECT_THROW(rank_split_k({{128, 128, 200}}, instance), std::runtime_error);
+}
+
+TEST(SplitKAdvisor, Reduction)
+{
+    const std::vector<SplitKGemmShape> gemms{{128, 128, 16384}};
+
+    // 16 bit atomics are slow: the workspace wins when the instance has one
+    auto instance       = MakeInstance();
+    instance.workspace_ = true;
+
+    const auto decisions = rank_split_k(gemms, instance);
+    EXPECT_EQ(decisions.front().reduction_, SplitKReduction::Workspace);
+    EXPECT_GT(decisions.front().k_batch_, 1);
+    EXPECT_LT(GetPredictedNs(decisions, 64, SplitKReduction::Workspace),
+              GetPredictedNs(decisions, 64, SplitKReduction::Atomic));
+
+    // fp32 atomics are cheaper
+    auto fp32_instance    = MakeInstance();
+    fp32_instance.c_size_ = 4;
+    const auto fp32_decisions = rank_split_k(gemms, fp32_instance);
+    const auto fp16_decisions = rank_split_k(gemms, MakeInstance());
+    EXPECT_LT(GetPredictedNs(fp32_decisions, 64, SplitKReduction::Atomic),
+              GetPredictedNs(fp16_decisions, 64, SplitKReduction::Atomic));
+
+    // only the reductions of the instance
+    instance.atomic_ = false;
+    for(const auto& decision : rank_split_k(gemms, instance))
+        EXPECT_EQ(decision.reduction_, SplitKReduction::Workspace);
+
+    EXPECT_STREQ(get_split_k_reduction_name(SplitKReduction::Atomic), "Atomic");
+    EXPECT_STREQ(get_split_k_reduction_name(SplitKReduction::Workspace), "Workspace");
+}
+
+TEST(SplitKAdvisor, GroupedGemm)
+{
+    const SplitKGemmShape decode{16, 4096, 4096};
+
+    const auto one_group = advise_split_k({decode}, MakeInstance());
+
+    // the groups fill the device together
+    const auto two_groups = advise_split_k({decode, decode}, MakeInstance());
+    EXPECT_GT(two_groups.k_batch_, 1);
+    EXPECT_LE(two_groups.k_batch_, one_group.k_batch_);
+
+    const std::vector<SplitKGemmShape> many_groups(64, decode);
+    EXPECT_EQ(advise_split_k(many_groups, MakeInstance()).k_batch_, 1);
+
+    // K-batches must leave no group with an empty batch
+    for(const auto& decision : rank_split_k({{128, 128, 4096}, {128, 128, 128}}, MakeInstance()))
+        EXPECT_LE(decision.k_batch_, 2);
+}
+
+TEST(SplitKAdvisor, DeviceModel)
+{
+    Runtime::Get().Reset();
+
+    Runtime::Get().SetArchName("gfx942", 80);
+    const auto small_device = make_device_split_k_model(0);
+    EXPECT_EQ(small_device.num_cu_, 80);
+    EXPECT_EQ(get_device_split_k_model().num_cu_, 80);
+
+    Runtime::Get().SetArchName("gfx942", 304);
+    const auto large_device = make_device_split_k_model(0);
+    EXPECT_EQ(large_device.num_cu_, 304);
+    // the properties of the current device are queried once
+    EXPECT_EQ(get_device_split_k_model().num_cu_, 80);
+
+    // fewer CUs are filled by fewer K-batches
+    const std::vector<SplitKGemmShape> gemms{{16, 4096, 4096}};
+    EXPECT_LT(advise_split_k(gemms, MakeInstance(), small_device).k_batch_,
+              advise_split_k(gemms, MakeInstance(), large_device).k_batch_);
+
+    Runtime::Get().Reset();
+}
+
+TEST(SplitKAdvisor, InvalidProblem)
+{
+    EXPECT_THROW(rank_split_k({}, MakeInstance()), std::runtime_error);
+    EXPECT_THROW(rank_split_k({{16, 16, 16}}, SplitKInstance{0, 128, 64}), std::runtime_error);
+}
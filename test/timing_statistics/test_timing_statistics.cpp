@@ -0,0 +1,146 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <cstddef>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "ck/host_utility/timing_statistics.hpp"
+
+using ck::timing::ComputeStatistics;
+using ck::timing::MeasureIterations;
+using ck::timing::TimingConfig;
+
+namespace {
+
+// Virtual clock: every launch advances time by the next scripted duration
+struct FakeTimer
+{
+    double now_ = 0;
+    std::vector<double> marks_;
+
+    void Start() { marks_.push_back(now_); }
+    void Stop() { marks_.push_back(now_); }
+
+    std::vector<float> Collect()
+    {
+        std::vector<float> samples;
+        for(std::size_t i = 0; i + 1 < marks_.size(); i += 2)
+            samples.push_back(static_cast<float>(marks_[i + 1] - marks_[i]));
+        marks_.clear();
+        return samples;
+    }
+};
+
+struct ScriptedKernel
+{
+    FakeTimer& timer_;
+    std::vector<double> durations_;
+    std::size_t launches_ = 0;
+
+    void operator()() { timer_.now_ += durations_[launches_++ % durations_.size()]; }
+};
+
+} // namespace
+
+TEST(TimingStatistics, Percentiles)
+{
+    const auto stats = ComputeStatistics({5, 1, 4, 2, 3});
+
+    EXPECT_FLOAT_EQ(stats.median_, 3.f);
+    EXPECT_FLOAT_EQ(stats.min_, 1.f);
+    EXPECT_FLOAT_EQ(stats.max_, 5.f);
+    EXPECT_FLOAT_EQ(stats.mean_, 3.f);
+    EXPECT_FLOAT_EQ(stats.p10_, 1.4f);
+    EXPECT_FLOAT_EQ(stats.p90_, 4.6f);
+    EXPECT_EQ(stats.num_outliers_, 0);
+    // samples are kept in launch order
+    EXPECT_EQ(stats.samples_, (std::vector<float>{5, 1, 4, 2, 3}));
+}
+
+TEST(TimingStatistics, OutlierDoesNotMoveMedian)
+{
+    std::vector<float> samples(49, 1.f);
+    samples.push_back(100.f); // one preempted launch
+
+    const auto stats = ComputeStatistics(samples);
+
+    EXPECT_FLOAT_EQ(stats.median_, 1.f);
+    EXPECT_EQ(stats.num_outliers_, 1);
+    EXPECT_GT(stats.mean_, 2.f);
+    EXPECT_GT(stats.cv_, 1.f);
+}
+
+TEST(TimingStatistics, Empty)
+{
+    const auto stats = ComputeStatistics({});
+
+    EXPECT_TRUE(stats.samples_.empty());
+    EXPECT_EQ(stats.median_, 0.f);
+}
+
+TEST(TimingStatistics, FixedRepetition)
+{
+    FakeTimer timer;
+    ScriptedKernel kernel{timer, {1.0, 2.0}};
+
+    const auto stats = MeasureIterations(timer, kernel, TimingConfig{10, 1000, 0.f});
+
+    EXPECT_EQ(kernel.launches_, 10u);
+    EXPECT_EQ(stats.samples_.size(), 10u);
+    EXPECT_FLOAT_EQ(stats.median_, 1.5f);
+    EXPECT_TRUE(stats.converged_);
+}
+
+TEST(TimingStatistics, UntimedWorkIsExcluded)
+{
+    FakeTimer timer;
+    ScriptedKernel kernel{timer, {1.0}};
+
+    const auto stats = MeasureIterations(
+        timer, [&] { timer.now_ += 50.0; }, kernel, TimingConfig{8, 8, 0.f});
+
+    EXPECT_FLOAT_EQ(stats.max_, 1.f);
+}
+
+TEST(TimingStatistics, AdaptiveStopsWhenStable)
+{
+    FakeTimer timer;
+    ScriptedKernel kernel{timer, {1.0, 1.001, 0.999}};
+
+    const auto stats = MeasureIterations(timer, kernel, TimingConfig{10, 1000, 0.01f});
+
+    EXPECT_TRUE(stats.converged_);
+    EXPECT_EQ(kernel.launches_, 10u);
+}
+
+TEST(TimingStatistics, AdaptiveGrowsUntilTarget)
+{
+    FakeTimer timer;
+    // alternating fast and slow launches never narrow the median interval below 1%
+    ScriptedKernel kernel{timer, {1.0, 2.0}};
+
+    const auto stats = MeasureIterations(timer, kernel, TimingConfig{10, 100, 0.01f});
+
+    EXPECT_FALSE(stats.converged_);
+    EXPECT_EQ(kernel.launches_, 100u);
+    EXPECT_EQ(stats.samples_.size(), 100u);
+}
+
+TEST(TimingStatistics, AdaptiveConvergesAfterNoisyStart)
+{
+    FakeTimer timer;
+    std::vector<double> durations(10, 1.0);
+    for(std::size_t i = 0; i < durations.size(); i += 2)
+        durations[i] = 3.0;
+    durations.resize(1000, 1.0);
+    ScriptedKernel kernel{timer, durations};
+
+    const auto stats = MeasureIterations(timer, kernel, TimingConfig{10, 1000, 0.01f});
+
+    EXPECT_TRUE(stats.converged_);
+    EXPECT_GT(kernel.launches_, 10u);
+    EXPECT_LT(kernel.launches_, 1000u);
+    EXPECT_FLOAT_EQ(stats.median_, 1.f);
+}
@@ -0,0 +1,326 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "profiler/model_trace.hpp"
+
+using ck::profiler::aggregate_trace;
+using ck::profiler::dedupe_trace;
+using ck::profiler::get_roofline_peaks;
+using ck::profiler::get_trace_roofline_problem;
+using ck::profiler::make_trace_profiler_command;
+using ck::profiler::parse_trace;
+using ck::profiler::parse_trace_best_time;
+using ck::profiler::parse_trace_op;
+using ck::profiler::schedule_trace_shapes;
+using ck::profiler::TraceOp;
+using ck::profiler::TraceOpFamily;
+using ck::profiler::TraceShapeTime;
+using ck::profiler::TraceTimeSource;
+using ck::profiler::TraceTimingDatabase;
+
+namespace {
+
+// two transformer blocks sharing their shapes, and a convolution stem
+const char* const kTrace =
+    "# layer   family  parameters\n"
+    "stem       conv       dtype=fp16 layout=nhwgc N=32 K=64 C=3 filter=7x7 input=224x224 "
+    "stride=2x2 left_pad=3x3 right_pad=3x3\n"
+    "blk0.ln    layernorm  dtype=fp16 length=4096x1024\n"
+    "blk0.qkv   gemm       dtype=fp16 layout=rc M=4096 N=3072 K=1024\n"
+    "blk0.attn  attention  dtype=fp16 batch=2 heads=16 seqlen_q=2048 seqlen_k=2048 hdim_q=64\n"
+    "blk0.attn  softmax    dtype=fp16 length=32x2048x2048 reduce=2\n"
+    "blk0.mlp   gemm       dtype=fp16 layout=rc M=4096 N=4096 K=1024 count=2   # up and gate\n"
+    "blk1.ln    layernorm  dtype=fp16 length=4096x1024\n"
+    "blk1.qkv   gemm       dtype=fp16 layout=rc M=4096 N=3072 K=1024\n"
+    "blk1.attn  attention  dtype=fp16 batch=2 heads=16 seqlen_q=2048 seqlen_k=2048 hdim_q=64\n"
+    "blk1.attn  softmax    dtype=fp16 length=32x2048x2048 reduce=2\n"
+    "blk1.mlp   gemm       dtype=fp16 layout=rc M=4096 N=4096 K=1024 count=2\n";
+
+std::vector<TraceOp> ParseTrace(const std::string& text)
+{
+    std::istringstream is(text);
+    return parse_trace(is);
+}
+
+TraceOp ParseOp(const std::string& line) { return parse_trace_op(line).value(); }
+
+} // namespace
+
+TEST(TraceReplay, Parse)
+{
+    const auto ops = ParseTrace(kTrace);
+    ASSERT_EQ(ops.size(), 11);
+
+    const auto& stem = ops[0];
+    EXPECT_EQ(stem.layer, "stem");
+    EXPECT_EQ(stem.family, TraceOpFamily::Conv);
+    EXPECT_EQ(stem.data_type, "fp16");
+    EXPECT_EQ(stem.layout, "nhwgc");
+    EXPECT_EQ(stem.Get("input"), (TraceOp::Value{224, 224}));
+    // defaults of the optional convolution parameters
+    EXPECT_EQ(stem.GetScalar("G"), 1);
+    EXPECT_EQ(stem.Get("dilation"), (TraceOp::Value{1, 1}));
+
+    EXPECT_EQ(ops[3].GetScalar("hdim_v"), 64);
+    EXPECT_EQ(ops[5].count, 2);
+    EXPECT_EQ(ops[5].ShapeKey(), "gemm fp16 rc K=1024 M=4096 N=4096");
+    EXPECT_EQ(ops[4].ShapeKey(), "softmax fp16 length=32x2048x2048 reduce=2");
+
+    EXPECT_FALSE(parse_trace_op("   # only a comment"));
+    EXPECT_FALSE(parse_trace_op(""));
+}
+
+TEST(TraceReplay, ParseErrors)
+{
+    auto parse = [](const std::string& line) { return parse_trace_op(line); };
+
+    EXPECT_THROW(parse("l0 gemv dtype=fp16 M=1 N=2 K=3"), std::runtime_error);
+    EXPECT_THROW(parse("l0 gemm layout=rc M=1 N=2 K=3"), std::runtime_error);
+    EXPECT_THROW(parse("l0 gemm dtype=fp64 layout=rc M=1 N=2 K=3"), std::runtime_error);
+    EXPECT_THROW(parse("l0 gemm dtype=fp16 layout=rt M=1 N=2 K=3"), std::runtime_error);
+    EXPECT_THROW(parse("l0 gemm dtype=fp16 layout=rc M=1 N=2"), std::runtime_error);
+    EXPECT_THROW(parse("l0 gemm dtype=fp16 layout=rc M=1 N=2 K=-3"), std::runtime_error);
+    EXPECT_THROW(parse("l0 gemm dtype=fp16 layout=rc M=1 M=1 N=2 K=3"), std::runtime_error);
+    EXPECT_THROW(parse("l0 gemm dtype=fp16 layout=rc M=1x2 N=2 K=3"), std::runtime_error);
+    EXPECT_THROW(parse("l0 gemm dtype=fp16 layout=rc M=1 N=2 K=3 count=0"), std::runtime_error);
+    EXPECT_THROW(parse("l0 conv dtype=fp16 layout=nhwgc N=1 K=2 C=3 filter=3x3 input=8"),
+                 std::runtime_error);
+    EXPECT_THROW(parse("l0 conv dtype=fp16 layout=nhwgc N=1 K=2 C=3 filter=3 input=8 stride=1x1"),
+                 std::runtime_error);
+    EXPECT_THROW(parse("l0 softmax dtype=fp16 length=8x8 reduce=1"), std::runtime_error);
+    EXPECT_THROW(parse("l0 softmax dtype=fp16 length=8x8x8 reduce=3"), std::runtime_error);
+
+    // errors name the line
+    try
+    {
+        ParseTrace("l0 layernorm dtype=fp16 length=8x8\n\nl1 layernorm length=8x8\n");
+        FAIL();
+    }
+    catch(const std::runtime_error& e)
+    {
+        EXPECT_NE(std::string(e.what()).find("line 3"), std::string::npos) << e.what();
+    }
+}
+
+TEST(TraceReplay, Dedupe)
+{
+    const auto ops    = ParseTrace(kTrace);
+    const auto shapes = dedupe_trace(ops);
+
+    // stem, ln, qkv, attention, softmax, mlp
+    ASSERT_EQ(shapes.size(), 6);
+    EXPECT_EQ(shapes[0].op.layer, "stem");
+    EXPECT_EQ(shapes[2].uses, (std::vector<std::size_t>{2, 7}));
+    EXPECT_EQ(shapes[2].num_runs, 2);
+    EXPECT_EQ(shapes[5].uses, (std::vector<std::size_t>{5, 10}));
+    EXPECT_EQ(shapes[5].num_runs, 4);
+
+    // the layout is part of the shape
+    auto other_layout = ops;
+    other_layout[7].layout = "rr";
+    EXPECT_EQ(dedupe_trace(other_layout).size(), 7);
+}
+
+TEST(TraceReplay, ProfilerCommands)
+{
+    using Command = std::vector<std::string>;
+
+    EXPECT_EQ(make_trace_profiler_command(ParseOp("l gemm dtype=bf16 layout=cr M=8 N=16 K=32")),
+              (Command{"gemm", "2", "2", "0", "1", "0", "1", "8", "16", "32", "-1", "-1", "-1"}));
+
+    EXPECT_EQ(
+        make_trace_profiler_command(
+            ParseOp("l batched_gemm dtype=fp32 layout=rr B=4 M=8 N=16 K=32")),
+        (Command{"batched_gemm", "0", "0", "0", "1", "0", "1", "8", "16", "32",
+                 "-1", "-1", "-1", "-1", "-1", "-1", "4"}));
+
+    // 2D grouped convolution: G N K C, filter, input, strides, dilations, left and right pads
+    EXPECT_EQ(make_trace_profiler_command(ParseOp("l conv dtype=fp16 layout=nhwgc G=2 N=32 K=64 "
+                                                  "C=16 filter=3x3 input=28x28 left_pad=1x1 "
+                                                  "right_pad=1x1")),
+              (Command{"grouped_conv_fwd", "1", "1", "0", "0", "1", "0", "1", "2", "2",
+                       "32", "64", "16", "3", "3", "28", "28", "1", "1", "1",
+                       "1", "1", "1", "1", "1"}));
+    EXPECT_EQ(make_trace_profiler_command(
+                  ParseOp("l conv dtype=fp32 layout=ngcdhw N=1 K=8 C=8 filter=1x1x1 input=4x4x4"))
+                  .value()[2],
+              "2");
+
+    EXPECT_EQ(make_trace_profiler_command(ParseOp("l layernorm dtype=fp32 length=64x128")),
+              (Command{"layernorm_fwd", "1", "0", "1", "0", "1", "--length", "64", "128"}));
+    EXPECT_EQ(make_trace_profiler_command(ParseOp("l softmax dtype=fp16 length=8x4x256 reduce=2")),
+              (Command{"softmax", "1", "0", "1", "0", "1", "--length", "8", "4", "256",
+                       "--reduce", "2"}));
+
+    // no profiler operation
+    EXPECT_FALSE(make_trace_profiler_command(ParseOp(
+        "l attention dtype=fp16 batch=1 heads=1 seqlen_q=128 seqlen_k=128 hdim_q=64")));
+    EXPECT_FALSE(make_trace_profiler_command(ParseOp("l layernorm dtype=bf16 length=64x128")));
+    EXPECT_FALSE(make_trace_profiler_command(
+        ParseOp("l batched_gemm dtype=fp8 layout=rr B=4 M=8 N=16 K=32")));
+}
+
+TEST(TraceReplay, ParseBestTime)
+{
+    // the result lines of the profiler operations the replay runs
+    const std::string gemm =
+        "Perf:   0.5 ms, 100 TFlops, 300 GB/s, DeviceGemm<...>\n"
+        "Best Perf for datatype = f16 ALayout =  RowMajor BLayout =  ColumnMajor M = 4096 N = "
+        "4096 K = 1024 StrideA = 1024 StrideB = 1024 StrideC = 4096 : 0.213 ms, 645.2 TFlops, "
+        "472.6 GB/s, DeviceGemmXdl<...>\n";
+    EXPECT_DOUBLE_EQ(parse_trace_best_time(gemm).value(), 0.213);
+
+    EXPECT_DOUBLE_EQ(
+        parse_trace_best_time("Best Perf: 1.5e-02 ms, 3 TFlops, 4 GB/s, DeviceBatchedGemm\n")
+            .value(),
+        0.015);
+    EXPECT_DOUBLE_EQ(
+        parse_trace_best_time("best perf = 0.0421 ms, 800 GB/s, DeviceNormalization\n").value(),
+        0.0421);
+    EXPECT_DOUBLE_EQ(parse_trace_best_time("Best Perf for datatype = f16_f16, length = 8,4,256, "
+                                           "stride = 1024,256,1, reduce dims 2, alpha = 1, "
+                                           "beta = 0, 0.007 ms, 900 GB/s, DeviceSoftmax\n")
+                         .value(),
+                     0.007);
+    EXPECT_DOUBLE_EQ(parse_trace_best_time("Best configuration parameters:\nname: "
+                                           "DeviceGroupedConvFwd<...>\navg_time: 1.25\ntflops: "
+                                           "80\nGB/s: 100\n")
+                         .value(),
+                     1.25);
+
+    EXPECT_FALSE(parse_trace_best_time("Perf:   0.5 ms, 100 TFlops\n"));
+    EXPECT_FALSE(parse_trace_best_time(""));
+
+    // no instance ran: the float max the operations start from, as they print it
+    std::ostringstream unset;
+    unset << "Best Perf: " << std::numeric_limits<float>::max() << " ms, 0 TFlops, 0 GB/s, \n";
+    EXPECT_FALSE(parse_trace_best_time(unset.str()));
+    EXPECT_FALSE(parse_trace_best_time("Best configuration parameters:\nname: \navg_time: " +
+                                       std::to_string(std::numeric_limits<float>::max()) + "\n"));
+
+    // nor times that are not finite and positive
+    EXPECT_FALSE(parse_trace_best_time("Best configuration parameters:\navg_time: inf\n"));
+    EXPECT_FALSE(parse_trace_best_time("Best configuration parameters:\navg_time: nan\n"));
+    EXPECT_FALSE(parse_trace_best_time("Best Perf: 0 ms, 0 TFlops, 0 GB/s, DeviceGemm\n"));
+    EXPECT_FALSE(parse_trace_best_time("Best Perf: -1 ms, 0 TFlops, 0 GB/s, DeviceGemm\n"));
+
+    // the last best time counts, even if it is not valid
+    EXPECT_FALSE(parse_trace_best_time("Best Perf: 0.5 ms, DeviceGemm\n" + unset.str()));
+    EXPECT_DOUBLE_EQ(
+        parse_trace_best_time(unset.str() + "Best Perf: 0.5 ms, DeviceGemm\n").value(), 0.5);
+}
+
+TEST(TraceReplay, TimingDatabase)
+{
+    TraceTimingDatabase db;
+    db.Set("gfx942", "gemm fp16 rc K=1024 M=4096 N=4096", 0.25);
+    db.Set("gfx90a", "gemm fp16 rc K=1024 M=4096 N=4096", 0.75);
+
+    std::stringstream file;
+    db.Save(file);
+    file << "malformed line\n" << "gfx942\tsoftmax fp16 length=8x8x8 reduce=2\tnan?\n";
+
+    TraceTimingDatabase loaded;
+    EXPECT_EQ(loaded.Load(file), 2);
+    EXPECT_EQ(loaded.Size(), 2);
+    EXPECT_DOUBLE_EQ(loaded.Find("gfx942", "gemm fp16 rc K=1024 M=4096 N=4096").value(), 0.25);
+    EXPECT_DOUBLE_EQ(loaded.Find("gfx90a", "gemm fp16 rc K=1024 M=4096 N=4096").value(), 0.75);
+    EXPECT_FALSE(loaded.Find("gfx1100", "gemm fp16 rc K=1024 M=4096 N=4096"));
+}
+
+TEST(TraceReplay, RooflineProblems)
+{
+    const auto gemm =
+        get_trace_roofline_problem(ParseOp("l gemm dtype=fp16 layout=rc M=8 N=16 K=32"));
+    EXPECT_EQ(gemm.flop, 2 * 8 * 16 * 32);
+    EXPECT_EQ(gemm.bytes, 2 * (8 * 32 + 32 * 16 + 8 * 16));
+
+    // 224x224 input, 7x7 filter, stride 2, pad 3: 112x112 output
+    const auto conv = get_trace_roofline_problem(ParseTrace(kTrace)[0]);
+    EXPECT_EQ(conv.flop, 2ull * 32 * 64 * 3 * 49 * 112 * 112);
+    EXPECT_EQ(conv.bytes, 2ull * (32 * 3 * 224 * 224 + 64 * 3 * 49 + 32 * 64 * 112 * 112));
+
+    const auto softmax =
+        get_trace_roofline_problem(ParseOp("l softmax dtype=fp32 length=8x4x256 reduce=2"));
+    EXPECT_EQ(softmax.flop, 0);
+    EXPECT_EQ(softmax.bytes, 2 * 4 * 8 * 4 * 256);
+}
+
+TEST(TraceReplay, Schedule)
+{
+    const auto shapes = dedupe_trace(ParseTrace(kTrace));
+    const auto peaks  = get_roofline_peaks("gfx942");
+
+    const auto order = schedule_trace_shapes(shapes, peaks);
+    ASSERT_EQ(order.size(), shapes.size());
+
+    // heaviest first: the memory bound softmax moves 1 GiB per block, more than the time the four
+    // mlp GEMMs take at the peak of the matrix cores
+    EXPECT_EQ(order, (std::vector<std::size_t>{4, 5, 3, 2, 0, 1}));
+
+    // without roofline data, by flop and bytes
+    EXPECT_EQ(schedule_trace_shapes(shapes, std::nullopt),
+              (std::vector<std::size_t>{5, 3, 2, 0, 4, 1}));
+}
+
+TEST(TraceReplay, Aggregate)
+{
+    const auto ops    = ParseTrace(kTrace);
+    const auto shapes = dedupe_trace(ops);
+
+    // stem, ln, qkv, attention, softmax, mlp
+    const std::vector<TraceShapeTime> times{{1.0, TraceTimeSource::Measured},
+                                            {0.1, TraceTimeSource::Database},
+                                            {0.5, TraceTimeSource::Measured},
+                                            {2.0, TraceTimeSource::Roofline},
+                                            {0.4, TraceTimeSource::Measured},
+                                            {0.0, TraceTimeSource::None}};
+
+    const auto report = aggregate_trace(ops, shapes, times, get_roofline_peaks("gfx942"));
+
+    EXPECT_DOUBLE_EQ(report.total_time, 1.0 + 2 * (0.1 + 0.5 + 2.0 + 0.4));
+
+    ASSERT_EQ(report.layers.size(), 9);
+    EXPECT_EQ(report.layers[0].layer, "stem");
+    EXPECT_DOUBLE_EQ(report.layers[0].total_time, 1.0);
+    EXPECT_TRUE(report.layers[0].efficiency);
+
+    const auto& attn = report.layers[3];
+    EXPECT_EQ(attn.layer, "blk0.attn");
+    EXPECT_EQ(attn.families, "attention+softmax");
+    EXPECT_DOUBLE_EQ(attn.total_time, 2.4);
+    EXPECT_TRUE(attn.estimated);
+    EXPECT_FALSE(attn.incomplete);
+
+    const auto& mlp = report.layers[4];
+    EXPECT_TRUE(mlp.incomplete);
+    EXPECT_FALSE(mlp.efficiency);
+
+    // attention first, then conv, gemm, softmax, layernorm
+    ASSERT_EQ(report.families.size(), 5);
+    EXPECT_EQ(report.families[0].family, TraceOpFamily::Attention);
+    EXPECT_DOUBLE_EQ(report.families[0].share, 4.0 / report.total_time);
+    EXPECT_EQ(report.families[0].num_runs, 2);
+    EXPECT_EQ(report.families[0].num_shapes, 1);
+
+    const auto& gemm = report.families[2];
+    EXPECT_EQ(gemm.family, TraceOpFamily::Gemm);
+    EXPECT_DOUBLE_EQ(gemm.total_time, 1.0);
+    EXPECT_EQ(gemm.num_runs, 6);
+    EXPECT_EQ(gemm.num_shapes, 2);
+
+    std::ostringstream os;
+    report.Print(os);
+    EXPECT_NE(os.str().find("blk1.attn"), std::string::npos);
+    EXPECT_NE(os.str().find("total: 7.0000 ms"), std::string::npos) << os.str();
+
+    EXPECT_THROW(aggregate_trace(ops, shapes, {}), std::runtime_error);
+}
@@ -0,0 +1,328 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "ck/host_utility/workspace_arena.hpp"
+
+using ck::make_workspace_request;
+using ck::plan_workspace;
+using ck::WorkspaceArena;
+using ck::WorkspaceBackingStore;
+using ck::WorkspaceRequest;
+using ck::mock::Runtime;
+
+namespace {
+
+// host memory, recording the allocations
+struct MockBackingStore : public WorkspaceBackingStore
+{
+    struct Log
+    {
+        std::vector<std::size_t> allocations;
+        std::size_t num_frees = 0;
+    };
+
+    explicit MockBackingStore(Log& log) : log_(log) {}
+
+    void* Allocate(std::size_t size_byte) override
+    {
+        log_.allocations.push_back(size_byte);
+        return std::aligned_alloc(WorkspaceArena::DefaultAlignment, size_byte);
+    }
+
+    void Free(void* p) override
+    {
+        ++log_.num_frees;
+        std::free(p);
+    }
+
+    Log& log_;
+};
+
+hipStream_t Stream(std::uintptr_t id) { return reinterpret_cast<hipStream_t>(id); }
+
+// the workspace interface of a device op
+struct FakeDeviceOp
+{
+    struct Argument
+    {
+        std::size_t workspace_size_ = 0;
+        std::size_t kernel_arg_size = 0;
+        void* p_workspace_          = nullptr;
+        void* p_kernel_args_        = nullptr;
+    };
+
+    std::size_t GetWorkSpaceSize(const Argument* p_arg) const { return p_arg->workspace_size_; }
+
+    void SetWorkSpacePointer(Argument* p_arg, void* p_workspace, const StreamConfig&) const
+    {
+        p_arg->p_workspace_ = p_workspace;
+    }
+
+    std::size_t GetDeviceKernelArgSize(const Argument* p_arg) const
+    {
+        return p_arg->kernel_arg_size;
+    }
+
+    void SetDeviceKernelArgs(Argument* p_arg, void* p_kernel_args) const
+    {
+        p_arg->p_kernel_args_ = p_kernel_args;
+    }
+};
+
+} // namespace
+
+TEST(WorkspaceArena, AlignedSlices)
+{
+    MockBackingStore::Log log;
+    WorkspaceArena arena(std::make_unique<MockBackingStore>(log));
+
+    EXPECT_EQ(arena.Acquire(0), nullptr);
+
+    void* p0 = arena.Acquire(100);
+    void* p1 = arena.Acquire(300);
+    void* p2 = arena.Acquire(1);
+
+    for(void* p : {p0, p1, p2})
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(p) % 256, 0);
+
+    EXPECT_EQ(arena.GetInUseBytes(), 256 + 512 + 256);
+    EXPECT_EQ(arena.GetHighWaterMark(), 256 + 512 + 256);
+    EXPECT_EQ(arena.GetNumGrows(), 3);
+
+    // a slice freed in the middle is reused in place
+    arena.Release(p1);
+    EXPECT_EQ(arena.Acquire(400), p1);
+    EXPECT_EQ(arena.GetNumGrows(), 3);
+
+    arena.Release(p0);
+    arena.Release(p1);
+    arena.Release(p2);
+    EXPECT_EQ(arena.GetInUseBytes(), 0);
+}
+
+TEST(WorkspaceArena, SameStreamReuse)
+{
+    MockBackingStore::Log log;
+    WorkspaceArena arena(std::make_unique<MockBackingStore>(log));
+    arena.Reserve(4096);
+
+    // ops one after another on a stream share the memory
+    std::vector<void*> slices;
+    for(std::size_t size : {1000, 3000, 2000, 4096})
+    {
+        slices.push_back(arena.Acquire(size, Stream(1)));
+        arena.Release(slices.back());
+    }
+    EXPECT_EQ(slices, std::vector<void*>(4, slices.front()));
+    EXPECT_EQ(log.allocations, std::vector<std::size_t>{4096});
+    EXPECT_EQ(arena.GetHighWaterMark(), 4096);
+    EXPECT_EQ(arena.GetNumGrows(), 0);
+}
+
+TEST(WorkspaceArena, OtherStreamReusesAfterSynchronize)
+{
+    MockBackingStore::Log log;
+    WorkspaceArena arena(std::make_unique<MockBackingStore>(log));
+    arena.Reserve(1024);
+
+    void* p1 = arena.Acquire(1024, Stream(1));
+    arena.Release(p1);
+
+    // the op of stream 1 may still run
+    void* p2 = arena.Acquire(1024, Stream(2));
+    EXPECT_NE(p2, p1);
+    EXPECT_EQ(arena.GetNumChunks(), 2);
+    arena.Release(p2);
+
+    arena.Synchronize();
+
+    void* p3 = arena.Acquire(1024, Stream(2));
+    EXPECT_EQ(p3, p1);
+    arena.Release(p3);
+}
+
+TEST(WorkspaceArena, Coalesce)
+{
+    MockBackingStore::Log log;
+    WorkspaceArena arena(std::make_unique<MockBackingStore>(log));
+    arena.Reserve(3 * 256);
+
+    void* p0 = arena.Acquire(256);
+    void* p1 = arena.Acquire(256);
+    void* p2 = arena.Acquire(256);
+
+    arena.Release(p1);
+    arena.Release(p0);
+    EXPECT_EQ(arena.Acquire(512), p0);
+
+    arena.Release(p0);
+    arena.Release(p2);
+    EXPECT_EQ(arena.Acquire(768), p0);
+    EXPECT_EQ(arena.GetNumGrows(), 0);
+}
+
+TEST(WorkspaceArena, ReserveHighWaterMark)
+{
+    MockBackingStore::Log log;
+    auto arena = std::make_unique<WorkspaceArena>(std::make_unique<MockBackingStore>(log));
+
+    const auto run = [&]() {
+        void* p0 = arena->Acquire(1000, Stream(1));
+        void* p1 = arena->Acquire(5000, Stream(2));
+        arena->Release(p0);
+        void* p2 = arena->Acquire(300, Stream(1));
+        arena->Release(p1);
+        arena->Release(p2);
+        arena->Synchronize();
+    };
+
+    // a first iteration grows the arena
+    run();
+    EXPECT_EQ(arena->GetNumGrows(), 2);
+    EXPECT_EQ(arena->GetHighWaterMark(), 1024 + 5120);
+
+    arena->Reserve(arena->GetHighWaterMark());
+    EXPECT_EQ(arena->GetNumChunks(), 1);
+    EXPECT_EQ(arena->GetCapacity(), 1024 + 5120);
+
+    // the next ones run within it
+    run();
+    run();
+    EXPECT_EQ(arena->GetNumGrows(), 2);
+    EXPECT_EQ(arena->GetHighWaterMark(), 1024 + 5120);
+
+    arena.reset();
+    EXPECT_EQ(log.num_frees, log.allocations.size());
+}
+
+TEST(WorkspaceArena, Plan)
+{
+    EXPECT_EQ(plan_workspace({}), 0);
+
+    // sequential ops reuse the memory
+    EXPECT_EQ(plan_workspace({{1000}, {3000}, {2000}, {0}}), 3072);
+
+    // concurrent ones do not, the memory released by a stream stays with it
+    const std::vector<WorkspaceRequest> requests{
+        {1000, Stream(1)}, {3000, Stream(2)}, {2000, Stream(1)}, {500, Stream(2)}};
+    EXPECT_EQ(plan_workspace(requests), 1024 + 3072 + 2048);
+    // with larger slices, the 2000 byte op fits in the one its stream released
+    EXPECT_EQ(plan_workspace(requests, 4096), 2 * 4096);
+
+    // an arena reserving the plan replays the ops without growing
+    MockBackingStore::Log log;
+    WorkspaceArena arena(std::make_unique<MockBackingStore>(log));
+    arena.Reserve(plan_workspace(requests));
+
+    void* p0 = arena.Acquire(1000, Stream(1));
+    void* p1 = arena.Acquire(3000, Stream(2));
+    arena.Release(p0);
+    void* p2 = arena.Acquire(2000, Stream(1));
+    arena.Release(p1);
+    void* p3 = arena.Acquire(500, Stream(2));
+    arena.Release(p2);
+    arena.Release(p3);
+
+    EXPECT_EQ(arena.GetNumGrows(), 0);
+    EXPECT_EQ(arena.GetHighWaterMark(), plan_workspace(requests));
+}
+
+TEST(WorkspaceArena, Bind)
+{
+    MockBackingStore::Log log;
+    WorkspaceArena arena(std::make_unique<MockBackingStore>(log));
+
+    const FakeDeviceOp op;
+    FakeDeviceOp::Argument arg;
+    arg.workspace_size_ = 1000;
+    arg.kernel_arg_size = 64;
+
+    void* p_workspace = arena.Bind(op, &arg, StreamConfig{Stream(1)});
+    EXPECT_NE(p_workspace, nullptr);
+    EXPECT_EQ(arg.p_workspace_, p_workspace);
+
+    void* p_kernel_args = arena.BindDeviceKernelArgs(op, &arg, Stream(1));
+    EXPECT_NE(p_kernel_args, nullptr);
+    EXPECT_EQ(arg.p_kernel_args_, p_kernel_args);
+    EXPECT_EQ(arena.GetInUseBytes(), 1024 + 256);
+
+    arena.Release(p_workspace);
+    arena.Release(p_kernel_args);
+
+    // the request holds both slices
+    const auto request = make_workspace_request(op, &arg, Stream(1));
+    EXPECT_EQ(request.size_byte_, 1000);
+    EXPECT_EQ(request.kernel_arg_size_byte_, 64);
+
+    // the plan of the op launched twice on a stream, and then on another one
+    const std::vector<WorkspaceRequest> requests{
+        request, request, make_workspace_request(op, &arg, Stream(2))};
+    EXPECT_EQ(plan_workspace({request, request}), 1024 + 256);
+    EXPECT_EQ(plan_workspace(requests), 2 * (1024 + 256));
+
+    // is what binding them uses
+    WorkspaceArena planned(std::make_unique<MockBackingStore>(log));
+    planned.Reserve(plan_workspace(requests));
+
+    std::map<hipStream_t, std::vector<void*>> live;
+    for(const auto& r : requests)
+    {
+        for(void* p : live[r.stream_])
+            planned.Release(p);
+        live[r.stream_] = {planned.Bind(op, &arg, StreamConfig{r.stream_}),
+                           planned.BindDeviceKernelArgs(op, &arg, r.stream_)};
+    }
+    EXPECT_EQ(planned.GetNumGrows(), 0);
+    EXPECT_EQ(planned.GetHighWaterMark(), plan_workspace(requests));
+
+    // no workspace
+    FakeDeviceOp::Argument empty_arg;
+    empty_arg.p_workspace_ = &empty_arg;
+    EXPECT_EQ(arena.Bind(op, &empty_arg), nullptr);
+    EXPECT_EQ(empty_arg.p_workspace_, nullptr);
+}
+
+TEST(WorkspaceArena, HipBackingStore)
+{
+    Runtime::Get().Reset();
+    {
+        WorkspaceArena arena;
+
+        hipStream_t stream;
+        ASSERT_EQ(hipStreamCreate(&stream), hipSuccess);
+
+        void* p = arena.Acquire(3000, stream);
+        EXPECT_EQ(Runtime::Get().GetAllocatedBytes(), 3072);
+        arena.Release(p);
+        arena.Synchronize();
+
+        ASSERT_EQ(hipStreamDestroy(stream), hipSuccess);
+    }
+    EXPECT_EQ(Runtime::Get().GetAllocatedBytes(), 0);
+    Runtime::Get().Reset();
+}
+
+TEST(WorkspaceArena, Errors)
+{
+    MockBackingStore::Log log;
+    EXPECT_THROW(WorkspaceArena(std::make_unique<MockBackingStore>(log), 100), std::runtime_error);
+    EXPECT_THROW(WorkspaceArena(nullptr), std::runtime_error);
+
+    WorkspaceArena arena(std::make_unique<MockBackingStore>(log));
+    void* p = arena.Acquire(256);
+    arena.Release(p);
+    EXPECT_THROW(arena.Release(p), std::runtime_error);
+
+    int x;
+    EXPECT_THROW(arena.Release(&x), std::runtime_error);
+}